@@ -0,0 +1,8 @@
+// Per-frame camera data, shared by every program
+layout(std140, binding = 0) uniform Camera
+{
+    mat4 V;                 // View transform matrix
+    mat4 P;                 // Projection transform matrix
+    mat4 VP;                // P * V
+    vec4 camera_position;   // World space, w unused
+};
@@ -0,0 +1,76 @@
+// Point and spot lights of the clustered forward pass, must match LightClusters.h
+struct LightData
+{
+    vec4 position_range;    // View space position, range in w
+    vec4 color;             // Color times intensity
+    vec4 direction;         // View space spot direction
+    vec4 spot;              // Cosines of the inner and outer angles, 1 in z for a spot
+};
+
+layout(std140, binding = 2) uniform Clusters
+{
+    uvec4 cluster_grid;     // Tiles across, tiles down, depth slices and light count
+    vec4 cluster_depth;     // Near, far, then slice = log(depth) * z + w
+    vec4 cluster_tile_size; // Pixels per tile
+};
+
+layout(std430, binding = 1) readonly buffer Lights
+{
+    LightData lights[];
+};
+
+// Lights of cluster i are cluster_light_indices[offset, offset + count), offset in x and count in y
+layout(std430, binding = 2) readonly buffer ClusterRanges
+{
+    uvec2 cluster_ranges[];
+};
+
+layout(std430, binding = 3) readonly buffer ClusterLightIndices
+{
+    uint cluster_light_indices[];
+};
+
+uint ClusterIndex(vec2 frag_coord, float view_depth)
+{
+    uvec2 tile = min(uvec2(frag_coord / cluster_tile_size.xy), cluster_grid.xy - 1u);
+    float slice = floor(log(max(view_depth, cluster_depth.x)) * cluster_depth.z + cluster_depth.w);
+    uint z = uint(clamp(slice, 0.0, float(cluster_grid.z - 1u)));
+    return tile.x + tile.y * cluster_grid.x + z * cluster_grid.x * cluster_grid.y;
+}
+
+// Diffuse and specular light of every light in the cluster of the fragment, position and
+// normal in view space
+vec3 ShadeClusterLights(vec3 position, vec3 normal, vec3 Kd, vec3 Ks, float shininess)
+{
+    vec3 result = vec3(0.0);
+    uvec2 range = cluster_ranges[ClusterIndex(gl_FragCoord.xy, -position.z)];
+    vec3 vectorV = normalize(-position);
+
+    for (uint i = range.x; i < range.x + range.y; ++i)
+    {
+        LightData light = lights[cluster_light_indices[i]];
+        vec3 toLight = light.position_range.xyz - position;
+        float lightDistance = length(toLight);
+        float range_ratio = lightDistance / light.position_range.w;
+        if (range_ratio >= 1.0) {
+            continue;
+        }
+        vec3 vectorL = toLight / max(lightDistance, 1e-4);
+
+        // Fades to exactly zero at the range, so the cluster bounds cut nothing visible
+        float window = clamp(1.0 - range_ratio * range_ratio * range_ratio * range_ratio, 0.0, 1.0);
+        float attenuation = window * window / (lightDistance * lightDistance + 1.0);
+        if (light.spot.z > 0.0) {
+            attenuation *= smoothstep(light.spot.y, light.spot.x, dot(-vectorL, light.direction.xyz));
+        }
+
+        float radiantEnergy = max(dot(normal, vectorL), 0.0);
+        vec3 lit = Kd * radiantEnergy;
+        if (0.0 < radiantEnergy) {
+            vec3 vectorH = normalize(vectorV + vectorL);
+            lit += Ks * pow(max(dot(normal, vectorH), 0.0), shininess);
+        }
+        result += light.color.rgb * attenuation * lit;
+    }
+    return result;
+}
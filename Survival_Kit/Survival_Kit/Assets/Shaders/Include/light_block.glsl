@@ -0,0 +1,8 @@
+// Per-frame light data, shared by every program (vec4 for std140, w unused)
+layout(std140, binding = 1) uniform LightBlock
+{
+    vec4 position;      // Position of the light source in the world space
+    vec4 La;            // Ambient light intensity
+    vec4 Ld;            // Diffuse light intensity
+    vec4 Ls;            // Specular light intensity
+} light;
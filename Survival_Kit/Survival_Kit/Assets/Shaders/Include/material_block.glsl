@@ -0,0 +1,45 @@
+// Every material of the scene, indexed per instance (see MaterialTable.h)
+struct MaterialData
+{
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;          // Shininess in w
+    vec4 uv_rect;           // Atlas region, scale in xy and offset in zw
+    uvec2 diffuse_handle;   // Bindless handle
+    uint diffuse_layer;     // Atlas layer
+    uint flags;
+};
+
+// Where the diffuse texture comes from
+const uint MATERIAL_DIFFUSE_ATLAS    = 1u;
+const uint MATERIAL_DIFFUSE_BOUND    = 2u;
+const uint MATERIAL_DIFFUSE_BINDLESS = 4u;
+
+layout(std430, binding = 0) readonly buffer Materials
+{
+    MaterialData materials[];
+};
+
+layout(binding = 0) uniform sampler2D DiffuseTexture;       // Bound by the draw
+layout(binding = 1) uniform sampler2DArray DiffuseAtlas;
+
+// Diffuse texel of a material, white without a texture. The gradients are taken
+// by the caller, outside the branches on the material.
+vec4 SampleDiffuse(MaterialData material, vec2 uv, vec2 uv_dx, vec2 uv_dy)
+{
+    if ((material.flags & MATERIAL_DIFFUSE_ATLAS) != 0u) {
+        // Wrapping happens here, the gutter of the region keeps filtering inside it
+        vec2 scale = material.uv_rect.xy;
+        vec3 atlas_uv = vec3(material.uv_rect.zw + fract(uv) * scale, float(material.diffuse_layer));
+        return textureGrad(DiffuseAtlas, atlas_uv, uv_dx * scale, uv_dy * scale);
+    }
+#ifdef BINDLESS
+    if ((material.flags & MATERIAL_DIFFUSE_BINDLESS) != 0u) {
+        return textureGrad(sampler2D(material.diffuse_handle), uv, uv_dx, uv_dy);
+    }
+#endif
+    if ((material.flags & MATERIAL_DIFFUSE_BOUND) != 0u) {
+        return textureGrad(DiffuseTexture, uv, uv_dx, uv_dy);
+    }
+    return vec4(1.0);
+}
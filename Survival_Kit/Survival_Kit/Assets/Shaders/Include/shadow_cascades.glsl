@@ -0,0 +1,41 @@
+// Cascaded shadow map of the main light, must match UniformBlocks.h and ShadowCascades.h
+layout(std140, binding = 3) uniform Shadows
+{
+    mat4 view_to_shadow[4]; // View space to shadow map texture space and depth
+    vec4 shadow_split;      // View depth where each cascade ends
+    vec4 shadow_texel_size; // World size of a shadow map texel in each cascade
+    vec4 shadow_params;     // Cascade count (0 disables shadows), normal offset in texels, 1 / resolution
+};
+
+layout(binding = 2) uniform sampler2DArrayShadow ShadowMap;
+
+// 1 where the main light reaches a view space position, 0 in full shadow
+float ShadowFactor(vec3 position, vec3 normal)
+{
+    int count = int(shadow_params.x);
+    float depth = -position.z;
+    int cascade = 0;
+    while (cascade < count && depth > shadow_split[cascade]) {
+        ++cascade;
+    }
+    if (cascade >= count) {
+        return 1.0;
+    }
+
+    // Pushed off the surface by about a texel, so it does not shadow itself
+    vec3 offset_position = position + normal * (shadow_texel_size[cascade] * shadow_params.y);
+    vec3 coord = (view_to_shadow[cascade] * vec4(offset_position, 1.0)).xyz;
+    if (any(lessThan(coord.xy, vec2(0.0))) || any(greaterThan(coord.xy, vec2(1.0)))) {
+        return 1.0;
+    }
+
+    // 3x3 taps of the hardware 2x2 comparison
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            vec2 uv = coord.xy + vec2(x, y) * shadow_params.z;
+            lit += texture(ShadowMap, vec4(uv, float(cascade), min(coord.z, 1.0)));
+        }
+    }
+    return lit / 9.0;
+}
@@ -0,0 +1,7 @@
+#version 450 core
+
+// Casters only write depth
+
+void main()
+{
+}
@@ -0,0 +1,19 @@
+#version 450 core
+
+/*
+   This vertex shader places shadow casters in the clip space of one
+   shadow cascade. Only the depth is written.
+*/
+
+layout(location=0) in vec3 VertexPosition;         // Quantized to [0, 1] over the mesh box, or object space
+layout(location=4) in mat4 InstanceModel;          // Model transform matrix, one per instance (locations 4 to 7)
+layout(location=8) in vec4 InstancePositionOffset; // Position dequantization of the mesh,
+layout(location=9) in vec4 InstancePositionScale;  // object space = offset + position * scale
+
+layout(location=0) uniform mat4 LightViewProjection; // World to clip space of the cascade
+
+void main()
+{
+    vec3 ObjectPosition = InstancePositionOffset.xyz + VertexPosition * InstancePositionScale.xyz;
+    gl_Position = LightViewProjection * InstanceModel * vec4(ObjectPosition, 1.0);
+}
@@ -1,4 +1,7 @@
-#version 420 core
+#version 450 core
+#ifdef BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
 //
 //struct Material 
 //{
@@ -8,21 +11,23 @@
 //    float shininess;    // Specular shininess factor
 //};
 //
-struct Light 
-{
-    vec3 position;      // Position of the light source in the world space
-    vec3 La;            // Ambient light intensity
-    vec3 Ld;            // Diffuse light intensity
-    vec3 Ls;            // Specular light intensity
-};
+#include "Include/light_block.glsl"
+#include "Include/camera_block.glsl"
+#include "Include/material_block.glsl"
+#include "Include/cluster_lights.glsl"
+#include "Include/shadow_cascades.glsl"
+
+// Options, compiled in as permutations:
+//   NO_SPECULAR    The main light has no specular intensity, leave its term out
+//   BINDLESS       Materials may sample textures through bindless handles
 
 in vec3 Position;       // In view space
 in vec3 Normal;         // In view space
 in vec3 Color;         
+in vec2 TexCoord;
+flat in uint MaterialIndex;
 
-uniform Light light;
 //uniform Material material;
-uniform mat4 V;         // View transform matrix
 
 layout(location=0) out vec4 FragColor;
 
@@ -70,12 +75,13 @@ void main()
 {
     //FragColor = vec4(BlinnPhong(Position, normalize(Normal), light[0], material, V), 1.0f);
 
-    // Temporary default material and lighting values
-    // Material
-    vec3 material_Ka = vec3(0.3, 0.5, 0.9);  // Ambient
-    vec3 material_Kd = vec3(0.3, 0.5, 0.9);  // Diffuse
-    vec3 material_Ks = vec3(0.8, 0.8, 0.8);  // Specular
-    float shininess = 100.0;
+    // Material of the instance, its diffuse texture tints the ambient and diffuse terms
+    MaterialData material = materials[MaterialIndex];
+    vec4 texel = SampleDiffuse(material, TexCoord, dFdx(TexCoord), dFdy(TexCoord));
+    vec3 material_Ka = material.ambient.rgb * texel.rgb;  // Ambient
+    vec3 material_Kd = material.diffuse.rgb * texel.rgb;  // Diffuse
+    vec3 material_Ks = material.specular.rgb;             // Specular
+    float shininess = material.specular.w;
 
 //    // Light Hardcoded
 //    vec3 light_Pos = vec3(0.0, 5.0, 0.0);
@@ -84,10 +90,10 @@ void main()
 //    vec3 light_Ls = vec3(1.0, 1.0, 1.0);     // Specular
 
     // Light
-    vec3 light_Pos = light.position;
-    vec3 light_La = light.La;     // Ambient
-    vec3 light_Ld = light.Ld;     // Diffuse
-    vec3 light_Ls = light.Ls;     // Specular
+    vec3 light_Pos = light.position.xyz;
+    vec3 light_La = light.La.xyz;     // Ambient
+    vec3 light_Ld = light.Ld.xyz;     // Diffuse
+    vec3 light_Ls = light.Ls.xyz;     // Specular
 
     
     // Temporary default illumination computation
@@ -109,11 +115,21 @@ void main()
     vec3 diffuse = light_Ld * material_Kd * radiantEnergy;
 
     vec3 specular = vec3(0.0);
+#ifndef NO_SPECULAR
     if(0.0 < radiantEnergy) {
         specular = light_Ls * material_Ks * pow(max(dot(Normal, vectorH), 0.0), shininess);
     }
+#endif
+
+    // Only the main light casts shadows, ambient and local lights are left as they are
+    float shadow = ShadowFactor(Position, normalize(Normal));
+    diffuse *= shadow;
+    specular *= shadow;
+
+    // Torches, campfires and every other light near enough to reach this cluster
+    vec3 local = ShadeClusterLights(Position, normalize(Normal), material_Kd, material_Ks, shininess);
 
-    vec3 illumination = ambient + diffuse + specular;
+    vec3 illumination = ambient + diffuse + specular + local;
     FragColor = vec4(illumination, 1.0);
 
 //    vec3 n = normalize(Normal);
@@ -5,17 +5,31 @@
    to camera space and passes them to the fragment shader.
 */
 
-layout(location=0) in vec3 VertexPosition;
-layout(location=1) in vec3 VertexNormal;
+layout(location=0) in vec3 VertexPosition;         // Quantized to [0, 1] over the mesh box, or object space
+layout(location=1) in vec2 VertexNormal;           // Octahedral encoded
 layout(location=2) in vec3 VertexColor;
+layout(location=3) in vec2 VertexTexCoord;
+layout(location=4) in mat4 InstanceModel;          // Model transform matrix, one per instance (locations 4 to 7)
+layout(location=8) in vec4 InstancePositionOffset; // Position dequantization of the mesh,
+layout(location=9) in vec4 InstancePositionScale;  // object space = offset + position * scale
+layout(location=10) in uint InstanceMaterial;      // Index into the material table
 
 out vec3 Position;
 out vec3 Normal;
 out vec3 Color;
+out vec2 TexCoord;
+flat out uint MaterialIndex;
 
-uniform mat4 M; // Model transform matrix
-uniform mat4 V; // View transform matrix
-uniform mat4 P; // Projection transform matrix
+#include "Include/camera_block.glsl"
+
+vec3 OctahedralDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
 
 void main()
 {
@@ -24,13 +38,18 @@ void main()
     //gl_Position = vec4(VertexPosition, 1.0f);
 
     // KENNY TESTING
-    mat4 MV = V * M; // Model-View transform matrix
+    mat4 MV = V * InstanceModel; // Model-View transform matrix
 
     mat3 N = mat3(vec3(MV[0]), vec3(MV[1]), vec3(MV[2])); // Normal transform matrix
-    Normal = normalize(N * VertexNormal);
+    Normal = normalize(N * OctahedralDecode(VertexNormal));
 
-    vec4 VertexPositionInView = MV * vec4(VertexPosition, 1.0f);
+    vec3 ObjectPosition = InstancePositionOffset.xyz + VertexPosition * InstancePositionScale.xyz;
+    vec4 VertexPositionInView = MV * vec4(ObjectPosition, 1.0f);
     Position = VertexPositionInView.xyz;
     gl_Position = P * VertexPositionInView;
 
+    Color = VertexColor;
+    TexCoord = VertexTexCoord;
+    MaterialIndex = InstanceMaterial;
+
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * @file Collider.cpp
+ * @brief Implementation of the Collider Component for the Entity Component System.
+ * @details Contains implementations for all member functions declared in Collider.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Component/Collider.h"
+#include "../Manager/LogManager.h"
+
+#include <glm-0.9.9.8/glm/gtc/quaternion.hpp>
+
+#include <cmath>
+
+namespace gam300 {
+
+    namespace {
+
+        // Same rotation order as Transform3D::getTransformationMatrix (Z * Y * X)
+        glm::mat3 rotationMatrix(const Vector3D& rotation_degrees) {
+            auto quat_x = glm::angleAxis(glm::radians(rotation_degrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
+            auto quat_y = glm::angleAxis(glm::radians(rotation_degrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
+            auto quat_z = glm::angleAxis(glm::radians(rotation_degrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+            return glm::mat3_cast(quat_z * quat_y * quat_x);
+        }
+
+        Vector3D scaled(const Vector3D& v, const Vector3D& scale) {
+            return Vector3D(v.x * scale.x, v.y * scale.y, v.z * scale.z);
+        }
+    }
+
+    Collider::Collider(
+        ColliderShape shape,
+        const Vector3D& half_extents,
+        const float& radius,
+        const Vector3D& offset,
+        const float& restitution,
+        uint32_t layer,
+        uint32_t mask,
+        bool is_trigger) :
+        m_shape(shape),
+        m_offset(offset),
+        m_half_extents(half_extents),
+        m_radius(radius),
+        m_restitution(restitution),
+        m_layer(layer),
+        m_mask(mask),
+        m_is_trigger(is_trigger)
+    {
+    }
+
+    void Collider::init(EntityID entity_id) {
+        m_owner_id = entity_id;
+        LM.writeLog("Collider::init() - Collider component initialized for entity %d", entity_id);
+    }
+
+    void Collider::update(float dt) {
+        (void)dt;
+    }
+
+    Vector3D Collider::getWorldCenter(const Transform3D& transform) const {
+        if (m_offset == Vector3D::ZERO) {
+            return transform.getPosition();
+        }
+
+        Vector3D local = scaled(m_offset, transform.getScale());
+        if (transform.getRotation() != Vector3D::ZERO) {
+            glm::vec3 rotated = rotationMatrix(transform.getRotation()) * static_cast<glm::vec3>(local);
+            local = Vector3D(rotated.x, rotated.y, rotated.z);
+        }
+        return transform.getPosition() + local;
+    }
+
+    float Collider::getWorldRadius(const Transform3D& transform) const {
+        const Vector3D& scale = transform.getScale();
+        float max_scale = std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+        return m_radius * max_scale;
+    }
+
+    AABB Collider::computeWorldAABB(const Transform3D& transform) const {
+        Vector3D center = getWorldCenter(transform);
+
+        if (m_shape == ColliderShape::SPHERE) {
+            float r = getWorldRadius(transform);
+            return AABB::fromCenterExtents(center, Vector3D(r, r, r));
+        }
+
+        const Vector3D& scale = transform.getScale();
+        Vector3D half(std::fabs(m_half_extents.x * scale.x),
+                      std::fabs(m_half_extents.y * scale.y),
+                      std::fabs(m_half_extents.z * scale.z));
+
+        // Bounds of a rotated box are the half extents projected through |R|
+        if (transform.getRotation() != Vector3D::ZERO) {
+            glm::mat3 r = rotationMatrix(transform.getRotation());
+            Vector3D rotated;
+            rotated.x = std::fabs(r[0][0]) * half.x + std::fabs(r[1][0]) * half.y + std::fabs(r[2][0]) * half.z;
+            rotated.y = std::fabs(r[0][1]) * half.x + std::fabs(r[1][1]) * half.y + std::fabs(r[2][1]) * half.z;
+            rotated.z = std::fabs(r[0][2]) * half.x + std::fabs(r[1][2]) * half.y + std::fabs(r[2][2]) * half.z;
+            half = rotated;
+        }
+
+        return AABB::fromCenterExtents(center, half);
+    }
+
+    ColliderShape Collider::stringToShape(const std::string& str)
+    {
+        if (str == "SPHERE") return ColliderShape::SPHERE;
+        if (str == "BOX") return ColliderShape::BOX;
+
+        return ColliderShape::BOX;
+    }
+
+    std::string Collider::shapeToString(ColliderShape shape)
+    {
+        switch (shape) {
+        case ColliderShape::SPHERE: return "SPHERE";
+        case ColliderShape::BOX:    return "BOX";
+        default:                    return "UNKNOWN";
+        }
+    }
+
+} // namespace gam300
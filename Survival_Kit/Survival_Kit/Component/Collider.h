@@ -0,0 +1,109 @@
+/**
+ * @file Collider.h
+ * @brief Declaration of the Collider Component for the Entity Component System.
+ * @details Describes the collision shape of an entity that also owns a RigidBody.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __COLLIDER_H__
+#define __COLLIDER_H__
+
+#include <cstdint>
+#include <string>
+#include "../Component/Component.h"
+#include "../Component/Transform3D.h"
+#include "../Physics/AABB.h"
+#include "../Utility/Vector3D.h"
+
+namespace gam300 {
+
+    enum class ColliderShape
+    {
+        SPHERE,
+        BOX
+    };
+
+    /**
+     * @brief Component for the collision shape of a rigid body.
+     * @details Sizes are in local space and get scaled by the owning Transform3D.
+     *          Boxes are resolved against their world-space bounds, so rotation only
+     *          grows the box, it does not orient it.
+     *          Two colliders only interact when each one's layer is in the other's mask.
+     *          Trigger colliders never push anything, they report enter/stay/exit events.
+     */
+    class Collider : public Component {
+    private:
+
+        ColliderShape m_shape;
+        Vector3D m_offset;          // Local offset from the transform position
+        Vector3D m_half_extents;    // Box half size (BOX only)
+        float m_radius;             // Sphere radius (SPHERE only)
+        float m_restitution;        // Bounciness, 0 = no bounce
+        uint32_t m_layer;           // Layer bits this collider is on
+        uint32_t m_mask;            // Layer bits this collider interacts with
+        bool m_is_trigger;          // Report overlaps instead of colliding
+
+    public:
+
+        Collider(ColliderShape shape = ColliderShape::BOX,
+            const Vector3D& half_extents = Vector3D(0.5f, 0.5f, 0.5f),
+            const float& radius = 0.5f,
+            const Vector3D& offset = Vector3D::ZERO,
+            const float& restitution = 0.2f,
+            uint32_t layer = 1u,
+            uint32_t mask = 0xFFFFFFFFu,
+            bool is_trigger = false);
+
+        void init(EntityID entity_id) override;
+
+        void update(float dt) override;
+
+        ColliderShape getShape() const { return m_shape; }
+        const Vector3D& getOffset() const { return m_offset; }
+        const Vector3D& getHalfExtents() const { return m_half_extents; }
+        float getRadius() const { return m_radius; }
+        float getRestitution() const { return m_restitution; }
+        uint32_t getLayer() const { return m_layer; }
+        uint32_t getMask() const { return m_mask; }
+        bool isTrigger() const { return m_is_trigger; }
+        void setShape(ColliderShape shape) { m_shape = shape; }
+        void setOffset(const Vector3D& offset) { m_offset = offset; }
+        void setHalfExtents(const Vector3D& half_extents) { m_half_extents = half_extents; }
+        void setRadius(float radius) { m_radius = radius; }
+        void setRestitution(float restitution) { m_restitution = restitution; }
+        void setLayer(uint32_t layer) { m_layer = layer; }
+        void setMask(uint32_t mask) { m_mask = mask; }
+        void setTrigger(bool is_trigger) { m_is_trigger = is_trigger; }
+
+        /**
+         * @brief World-space center of the shape.
+         * @param transform Transform of the owning entity.
+         */
+        Vector3D getWorldCenter(const Transform3D& transform) const;
+
+        /**
+         * @brief World-space sphere radius, using the largest scale axis.
+         * @param transform Transform of the owning entity.
+         */
+        float getWorldRadius(const Transform3D& transform) const;
+
+        /**
+         * @brief World-space bounds of the shape.
+         * @param transform Transform of the owning entity.
+         */
+        AABB computeWorldAABB(const Transform3D& transform) const;
+
+        // to return the enum type to string for serialization
+        static ColliderShape stringToShape(const std::string& str);
+
+        // convert back from string to enum for serialization
+        static std::string shapeToString(ColliderShape shape);
+    };
+
+} // namespace gam300
+
+#endif // __COLLIDER_H__
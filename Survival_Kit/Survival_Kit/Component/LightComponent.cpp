@@ -0,0 +1,56 @@
+/**
+ * @file LightComponent.cpp
+ * @brief Implementation of the LightComponent for the Entity Component System.
+ * @details Contains implementations for all member functions declared in LightComponent.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Component/LightComponent.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+
+namespace gam300 {
+
+    LightComponent::LightComponent(LightType type, const glm::vec3& color, float intensity, float range) :
+        m_type(type),
+        m_color(color),
+        m_intensity(intensity),
+        m_range(std::max(range, 0.0f)),
+        m_direction(0.0f, -1.0f, 0.0f),     // Straight down
+        m_inner_angle(20.0f),
+        m_outer_angle(30.0f),
+        m_enabled(true)
+    {
+    }
+
+    void LightComponent::init(EntityID entity_id) {
+        m_owner_id = entity_id;
+        LM.writeLog("LightComponent::init() - LightComponent initialized for entity %d", entity_id);
+    }
+
+    void LightComponent::update(float dt) {
+        (void)dt;
+    }
+
+    void LightComponent::setRange(float range) {
+        m_range = std::max(range, 0.0f);
+    }
+
+    void LightComponent::setDirection(const glm::vec3& direction) {
+        const float length = glm::length(direction);
+        if (length > 0.0f) {
+            m_direction = direction / length;
+        }
+    }
+
+    void LightComponent::setSpotAngles(float inner_angle, float outer_angle) {
+        m_inner_angle = std::clamp(inner_angle, 0.0f, 89.0f);
+        m_outer_angle = std::clamp(outer_angle, m_inner_angle, 89.0f);
+    }
+
+} // namespace gam300
@@ -0,0 +1,80 @@
+/**
+ * @file LightComponent.h
+ * @brief Declaration of the LightComponent for the Entity Component System.
+ * @details Makes an entity a point or spot light, placed by its Transform3D and shaded
+ *          through the light clusters of the GraphicsManager.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __LIGHT_COMPONENT_H__
+#define __LIGHT_COMPONENT_H__
+
+#include <cstdint>
+#include <glm-0.9.9.8/glm/glm.hpp>
+#include "../Component/Component.h"
+
+namespace gam300 {
+
+    enum class LightType : uint8_t {
+        POINT = 0,
+        SPOT
+    };
+
+    /**
+     * @brief Component for a local light like a torch or a campfire.
+     * @details The light reaches nothing beyond its range, which is what lets the
+     *          renderer shade each pixel with only the lights near it. A spot light
+     *          shines along its direction, rotated by the Transform3D of the entity.
+     */
+    class LightComponent : public Component {
+    private:
+
+        LightType m_type;
+        glm::vec3 m_color;          // Linear color
+        float m_intensity;          // Scale of the color
+        float m_range;              // Distance at which the light fades out completely
+        glm::vec3 m_direction;      // Spot direction in object space
+        float m_inner_angle;        // Spot half angle in degrees, full intensity inside
+        float m_outer_angle;        // Spot half angle in degrees, no light outside
+        bool m_enabled;
+
+    public:
+
+        LightComponent(LightType type = LightType::POINT,
+            const glm::vec3& color = glm::vec3(1.0f),
+            float intensity = 1.0f,
+            float range = 10.0f);
+
+        void init(EntityID entity_id) override;
+
+        void update(float dt) override;
+
+        LightType getType() const { return m_type; }
+        const glm::vec3& getColor() const { return m_color; }
+        float getIntensity() const { return m_intensity; }
+        float getRange() const { return m_range; }
+        const glm::vec3& getDirection() const { return m_direction; }
+        float getInnerAngle() const { return m_inner_angle; }
+        float getOuterAngle() const { return m_outer_angle; }
+        bool isEnabled() const { return m_enabled; }
+
+        void setType(LightType type) { m_type = type; }
+        void setColor(const glm::vec3& color) { m_color = color; }
+        void setIntensity(float intensity) { m_intensity = intensity; }
+        void setRange(float range);
+        void setDirection(const glm::vec3& direction);
+
+        /**
+         * @brief Set the cone of a spot light, the outer angle is kept at least the inner one.
+         */
+        void setSpotAngles(float inner_angle, float outer_angle);
+        void setEnabled(bool enabled) { m_enabled = enabled; }
+    };
+
+} // namespace gam300
+
+#endif // __LIGHT_COMPONENT_H__
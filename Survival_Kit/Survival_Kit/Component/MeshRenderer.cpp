@@ -0,0 +1,33 @@
+/**
+ * @file MeshRenderer.cpp
+ * @brief Implementation of the MeshRenderer Component for the Entity Component System.
+ * @details Contains implementations for all member functions declared in MeshRenderer.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Component/MeshRenderer.h"
+#include "../Manager/LogManager.h"
+
+namespace gam300 {
+
+    MeshRenderer::MeshRenderer(uint32_t mesh_id, uint32_t material_id, bool visible) :
+        m_mesh_id(mesh_id),
+        m_material_id(material_id),
+        m_visible(visible)
+    {
+    }
+
+    void MeshRenderer::init(EntityID entity_id) {
+        m_owner_id = entity_id;
+        LM.writeLog("MeshRenderer::init() - MeshRenderer component initialized for entity %d", entity_id);
+    }
+
+    void MeshRenderer::update(float dt) {
+        (void)dt;
+    }
+
+} // namespace gam300
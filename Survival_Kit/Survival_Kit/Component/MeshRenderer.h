@@ -0,0 +1,51 @@
+/**
+ * @file MeshRenderer.h
+ * @brief Declaration of the MeshRenderer Component for the Entity Component System.
+ * @details Tells the GraphicsManager which mesh and material to draw an entity with.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __MESH_RENDERER_H__
+#define __MESH_RENDERER_H__
+
+#include <cstdint>
+#include "../Component/Component.h"
+
+namespace gam300 {
+
+    /**
+     * @brief Component for drawing an entity with a mesh.
+     * @details Entities sharing the same mesh and material are drawn together in one
+     *          instanced draw call. Entities with a Transform3D but no MeshRenderer
+     *          draw the mesh selected in the viewport.
+     */
+    class MeshRenderer : public Component {
+    private:
+
+        uint32_t m_mesh_id;         // Index of the mesh in the GraphicsManager
+        uint32_t m_material_id;     // Index of the material, 0 for the default material
+        bool m_visible;             // Skip drawing when false
+
+    public:
+
+        MeshRenderer(uint32_t mesh_id = 0, uint32_t material_id = 0, bool visible = true);
+
+        void init(EntityID entity_id) override;
+
+        void update(float dt) override;
+
+        uint32_t getMeshID() const { return m_mesh_id; }
+        uint32_t getMaterialID() const { return m_material_id; }
+        bool isVisible() const { return m_visible; }
+        void setMeshID(uint32_t mesh_id) { m_mesh_id = mesh_id; }
+        void setMaterialID(uint32_t material_id) { m_material_id = material_id; }
+        void setVisible(bool visible) { m_visible = visible; }
+    };
+
+} // namespace gam300
+
+#endif // __MESH_RENDERER_H__
@@ -26,7 +26,8 @@ namespace gam300 {
         const Vector3D& torque_accumulator,
         const float& linear_damp, 
         const float& angular_damp,
-        const bool& gravity) : 
+        const bool& gravity,
+        const bool& continuous_collision) : 
         m_bodyType(bodyType),
         m_mass(mass),
         m_linear_velocity(linear_velocity),
@@ -35,7 +36,8 @@ namespace gam300 {
         m_torque_accumulator(torque_accumulator),
         m_linear_damp(linear_damp),
         m_angular_damp(angular_damp),
-        m_gravity(gravity)
+        m_gravity(gravity),
+        m_continuous_collision(continuous_collision)
     {
         if (isStatic() || isKinematic()) {
             m_inverse_mass = 0.0f; 
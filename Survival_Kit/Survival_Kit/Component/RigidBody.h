@@ -44,6 +44,7 @@ namespace gam300 {
         float m_angular_damp;
 
         bool m_gravity;
+        bool m_continuous_collision;    // Sweep the collider each step so fast bodies cannot tunnel
         //bool m_kinematic;
 
 
@@ -57,7 +58,8 @@ namespace gam300 {
             const Vector3D& angular_velocity = Vector3D::ZERO,
             const Vector3D& torque_accumulator = Vector3D::ZERO,
             const float& linear_damp = 0.99f, const float& angular_damp = 0.99f,
-            const bool& gravity = true);
+            const bool& gravity = true,
+            const bool& continuous_collision = false);
 
 
         void init(EntityID entity_id) override;
@@ -73,6 +75,7 @@ namespace gam300 {
         const float& getLinearDamp() const { return m_linear_damp; }
         const float& getAngularDamp() const { return m_angular_damp; }
         const bool& getGravity() const { return m_gravity; }
+        const bool& getContinuousCollision() const { return m_continuous_collision; }
         //const bool& getKinematic() const { return m_kinematic; }
         void setType(BodyType type) { m_bodyType = type; }
         void setMass(const float& mass) { m_mass = mass; }
@@ -84,6 +87,7 @@ namespace gam300 {
         void setLinearDamp(float linearDamp) { m_linear_damp = linearDamp; }
         void setAngularDamp(float angularDamp) { m_angular_damp = angularDamp; }
         void setGravity(bool gravity) { m_gravity = gravity; }
+        void setContinuousCollision(bool continuous_collision) { m_continuous_collision = continuous_collision; }
         //void setKinematic(bool kinematic) { m_kinematic = kinematic; }
 
         void applyForce(const Vector3D& force);
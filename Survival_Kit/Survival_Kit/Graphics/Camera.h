@@ -13,6 +13,7 @@
 #define __CAMERA_H__
 
  // Includes
+#include <array>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -87,6 +88,30 @@ namespace gam300 {
             return glm::perspective(glm::radians(FOV), aspect, nearPlane, farPlane);
         }
 
+        // Compute the six frustum planes (left, right, bottom, top, near, far) in world space
+        // Each plane is (normal, distance) with the normal pointing inwards, so a point p is
+        // inside when dot(normal, p) + distance >= 0 for every plane
+        std::array<glm::vec4, 6> getFrustumPlanes(float aspect = 1.0f) const
+        {
+            // Rows of the view-projection matrix (glm is column major)
+            const glm::mat4 m = getPerspective(aspect) * getLookAt();
+            const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+            const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+            const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+            const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+            std::array<glm::vec4, 6> planes = {
+                row3 + row0, row3 - row0,   // Left, right
+                row3 + row1, row3 - row1,   // Bottom, top
+                row3 + row2, row3 - row2    // Near, far
+            };
+
+            for (glm::vec4& plane : planes) {
+                plane /= glm::length(glm::vec3(plane));
+            }
+            return planes;
+        }
+
         // Handles cursor movement to adjust camera orientation
         void cameraOnCursor(double xoffset, double yoffset, ShaderProgram* shader)
         {
@@ -193,13 +218,18 @@ namespace gam300 {
             //shader->programFree();
         }
 
+        // Position of the camera
+        const glm::vec3& getCamPos() const { return pos; }
+
+        // Distance to the near and far clipping planes
+        float getCamNear() const { return nearPlane; }
+        float getCamFar() const { return farPlane; }
+
         //// Getters for camera data
         //CameraType getCamType() { return camType; }
-        //glm::vec3& getCamPos() { return pos; }
         //glm::vec3& getCamTarget() { return target; }
         //float& getCamFOV() { return FOV; }
         //float& getCamNear() { return nearPlane; }
-        //float& getCamFar() { return farPlane; }
 
         //// Setters for camera data
         //void setCamType(CameraType newType) {
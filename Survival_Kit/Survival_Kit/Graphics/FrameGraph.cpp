@@ -0,0 +1,441 @@
+/**
+ * @file FrameGraph.cpp
+ * @brief Implementation of the frame graph of render passes.
+ * @details Contains implementations for all member functions declared in FrameGraph.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "FrameGraph.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace gam300 {
+
+#pragma region FrameGraphBuilder
+	FrameGraphResource FrameGraphBuilder::create(const std::string& name, const RenderTargetDesc& desc) {
+		FrameGraph::Resource resource;
+		resource.name = name;
+		resource.desc = desc;
+		graph.resources.push_back(std::move(resource));
+		return write(static_cast<FrameGraphResource>(graph.resources.size() - 1));
+	}
+
+	FrameGraphResource FrameGraphBuilder::read(FrameGraphResource resource) {
+		std::vector<FrameGraphResource>& reads = graph.passes[pass].reads;
+		if (std::find(reads.begin(), reads.end(), resource) == reads.end()) {
+			reads.push_back(resource);
+		}
+		return resource;
+	}
+
+	FrameGraphResource FrameGraphBuilder::write(FrameGraphResource resource) {
+		std::vector<FrameGraphResource>& writes = graph.passes[pass].writes;
+		if (std::find(writes.begin(), writes.end(), resource) == writes.end()) {
+			writes.push_back(resource);
+		}
+		return resource;
+	}
+
+	void FrameGraphBuilder::set_side_effect() {
+		graph.passes[pass].side_effect = true;
+	}
+#pragma endregion
+
+#pragma region FrameGraph
+	u32 FrameGraph::add_pass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute) {
+		const u32 index = static_cast<u32>(passes.size());
+		Pass pass;
+		pass.name = name;
+		pass.execute = std::move(execute);
+		passes.push_back(std::move(pass));
+
+		FrameGraphBuilder builder(*this, index);
+		setup(builder);
+		compiled = false;
+		return index;
+	}
+
+	FrameGraphResource FrameGraph::import_texture(const std::string& name, GLuint texture) {
+		Resource resource;
+		resource.name = name;
+		resource.texture = texture;
+		resource.imported = true;
+		resources.push_back(std::move(resource));
+		compiled = false;
+		return static_cast<FrameGraphResource>(resources.size() - 1);
+	}
+
+	bool FrameGraph::compile() {
+		compiled = false;
+		order.clear();
+		physicals.clear();
+		stats = FrameGraphStats();
+		stats.passes = static_cast<u32>(passes.size());
+
+		// A pass that reads what it writes is only a writer, it already runs after the
+		// earlier writers and must not wait for the later ones
+		for (Resource& resource : resources) {
+			resource.writers.clear();
+			resource.readers.clear();
+			resource.physical = INVALID_FRAME_GRAPH_RESOURCE;
+			resource.first_use = INVALID_FRAME_GRAPH_RESOURCE;
+			resource.last_use = 0;
+		}
+		for (u32 pass = 0; pass < passes.size(); ++pass) {
+			for (FrameGraphResource written : passes[pass].writes) {
+				resources[written].writers.push_back(pass);
+			}
+			for (FrameGraphResource read : passes[pass].reads) {
+				const std::vector<FrameGraphResource>& writes = passes[pass].writes;
+				if (std::find(writes.begin(), writes.end(), read) == writes.end()) {
+					resources[read].readers.push_back(pass);
+				}
+			}
+		}
+
+		for (const Resource& resource : resources) {
+			if (!resource.imported && resource.writers.empty() && !resource.readers.empty()) {
+				LM.writeLog("FrameGraph::compile() - Pass %s reads %s, which no pass writes",
+					passes[resource.readers.front()].name.c_str(), resource.name.c_str());
+				return false;
+			}
+		}
+
+		cull_passes();
+		if (!sort_passes()) {
+			return false;
+		}
+		alias_transients();
+		compiled = true;
+		return true;
+	}
+
+	void FrameGraph::cull_passes() {
+		// Start from the outputs and walk back to every pass writing what a running pass uses
+		std::vector<u32> pending;
+		for (u32 pass = 0; pass < passes.size(); ++pass) {
+			const Pass& current = passes[pass];
+			const bool output = current.side_effect || std::any_of(current.writes.begin(), current.writes.end(),
+				[this](FrameGraphResource written) { return resources[written].imported; });
+			passes[pass].culled = !output;
+			if (output) {
+				pending.push_back(pass);
+			}
+		}
+
+		while (!pending.empty()) {
+			const u32 pass = pending.back();
+			pending.pop_back();
+
+			// Reads need every writer, a write builds on the writers added before it
+			auto keep_writers = [&](FrameGraphResource resource, bool earlier_only) {
+				for (u32 writer : resources[resource].writers) {
+					if (earlier_only && writer >= pass) {
+						break;
+					}
+					if (passes[writer].culled) {
+						passes[writer].culled = false;
+						pending.push_back(writer);
+					}
+				}
+			};
+			for (FrameGraphResource read : passes[pass].reads) {
+				keep_writers(read, false);
+			}
+			for (FrameGraphResource written : passes[pass].writes) {
+				keep_writers(written, true);
+			}
+		}
+
+		stats.culled = static_cast<u32>(std::count_if(passes.begin(), passes.end(), [](const Pass& pass) { return pass.culled; }));
+	}
+
+	bool FrameGraph::sort_passes() {
+		// Writers of a resource run in the order they were added, readers after all of them
+		std::vector<std::vector<u32>> successors(passes.size());
+		std::vector<u32> waiting_on(passes.size(), 0);
+		auto depend = [&](u32 before, u32 after) {
+			if (!passes[before].culled && !passes[after].culled) {
+				successors[before].push_back(after);
+				++waiting_on[after];
+			}
+		};
+		for (const Resource& resource : resources) {
+			for (std::size_t i = 1; i < resource.writers.size(); ++i) {
+				depend(resource.writers[i - 1], resource.writers[i]);
+			}
+			for (u32 writer : resource.writers) {
+				for (u32 reader : resource.readers) {
+					depend(writer, reader);
+				}
+			}
+		}
+
+		// Kahn's algorithm, the ready pass added first goes first so the order is stable
+		std::vector<u32> ready;
+		u32 running = 0;
+		for (u32 pass = 0; pass < passes.size(); ++pass) {
+			if (!passes[pass].culled) {
+				++running;
+				if (waiting_on[pass] == 0) {
+					ready.push_back(pass);
+				}
+			}
+		}
+		while (!ready.empty()) {
+			auto first = std::min_element(ready.begin(), ready.end());
+			const u32 pass = *first;
+			ready.erase(first);
+			order.push_back(pass);
+			for (u32 next : successors[pass]) {
+				if (--waiting_on[next] == 0) {
+					ready.push_back(next);
+				}
+			}
+		}
+
+		if (order.size() != running) {
+			LM.writeLog("FrameGraph::compile() - %u passes depend on each other in a cycle",
+				running - static_cast<u32>(order.size()));
+			order.clear();
+			return false;
+		}
+		return true;
+	}
+
+	void FrameGraph::alias_transients() {
+		for (u32 position = 0; position < order.size(); ++position) {
+			const Pass& pass = passes[order[position]];
+			for (const std::vector<FrameGraphResource>* used : { &pass.reads, &pass.writes }) {
+				for (FrameGraphResource resource : *used) {
+					Resource& current = resources[resource];
+					current.first_use = std::min(current.first_use, position);
+					current.last_use = std::max(current.last_use, position);
+				}
+			}
+		}
+
+		// Transients in the order they come to life, each takes the first texture of its
+		// desc that is free by then. Storage is immutable, so only equal descs can share.
+		std::vector<FrameGraphResource> transients;
+		for (FrameGraphResource resource = 0; resource < resources.size(); ++resource) {
+			if (!resources[resource].imported && resources[resource].first_use != INVALID_FRAME_GRAPH_RESOURCE) {
+				transients.push_back(resource);
+			}
+		}
+		std::stable_sort(transients.begin(), transients.end(), [this](FrameGraphResource a, FrameGraphResource b) {
+			return resources[a].first_use < resources[b].first_use;
+		});
+
+		for (FrameGraphResource resource : transients) {
+			Resource& current = resources[resource];
+			auto slot = std::find_if(physicals.begin(), physicals.end(), [&current](const Physical& physical) {
+				return physical.desc == current.desc && physical.last_use < current.first_use;
+			});
+			if (slot == physicals.end()) {
+				Physical physical;
+				physical.desc = current.desc;
+				physical.first_use = current.first_use;
+				physicals.push_back(physical);
+				slot = physicals.end() - 1;
+				stats.allocated_bytes += RenderTargetPool::size_in_bytes(current.desc);
+			}
+			slot->last_use = current.last_use;
+			current.physical = static_cast<u32>(slot - physicals.begin());
+			stats.requested_bytes += RenderTargetPool::size_in_bytes(current.desc);
+		}
+		stats.transients = static_cast<u32>(transients.size());
+		stats.physical_targets = static_cast<u32>(physicals.size());
+	}
+
+	void FrameGraph::execute(RenderTargetPool& pool) {
+		if (!compiled) {
+			return;
+		}
+
+		for (u32 position = 0; position < order.size(); ++position) {
+			for (Physical& physical : physicals) {
+				if (physical.first_use == position) {
+					physical.texture = pool.acquire(physical.desc);
+				}
+			}
+
+			const Pass& pass = passes[order[position]];
+			if (pass.execute) {
+				pass.execute(*this);
+			}
+
+			for (Physical& physical : physicals) {
+				if (physical.last_use == position && physical.texture != 0) {
+					pool.release(physical.texture);
+					physical.texture = 0;
+				}
+			}
+		}
+	}
+
+	void FrameGraph::clear() {
+		passes.clear();
+		resources.clear();
+		physicals.clear();
+		order.clear();
+		compiled = false;
+	}
+
+	GLuint FrameGraph::get_texture(FrameGraphResource resource) const {
+		if (resource >= resources.size()) {
+			return 0;
+		}
+		const Resource& current = resources[resource];
+		if (current.imported) {
+			return current.texture;
+		}
+		return current.physical != INVALID_FRAME_GRAPH_RESOURCE ? physicals[current.physical].texture : 0;
+	}
+
+	bool FrameGraph::validate(std::string& report) {
+		std::ostringstream log;
+		bool ok = true;
+		auto check = [&](bool condition, const std::string& what) {
+			log << (condition ? "  ok    " : "  FAIL  ") << what << "\n";
+			ok = ok && condition;
+		};
+
+		// Names of the passes that run, in order, to compare against the expected order
+		auto order_of = [](const FrameGraph& graph) {
+			std::vector<std::string> names;
+			for (u32 pass : graph.get_order()) {
+				names.push_back(graph.get_pass_name(pass));
+			}
+			return names;
+		};
+
+		const RenderTargetDesc hdr{ 1280, 720, GL_RGBA16F };
+		const RenderTargetDesc depth{ 1280, 720, GL_DEPTH_COMPONENT24 };
+		const RenderTargetDesc ids{ 1280, 720, GL_R32F };
+		FrameGraph graph;
+
+		// A post chain, with a picking pass whose ids nobody reads
+		FrameGraphResource scene_color = INVALID_FRAME_GRAPH_RESOURCE, scene_depth = INVALID_FRAME_GRAPH_RESOURCE;
+		FrameGraphResource bright = INVALID_FRAME_GRAPH_RESOURCE, blur = INVALID_FRAME_GRAPH_RESOURCE;
+		FrameGraphResource picked = INVALID_FRAME_GRAPH_RESOURCE;
+		FrameGraphResource viewport = graph.import_texture("Viewport", 1);
+		graph.add_pass("Scene", [&](FrameGraphBuilder& builder) {
+			scene_color = builder.create("HDR", hdr);
+			scene_depth = builder.create("Depth", depth);
+		}, {});
+		graph.add_pass("Bright", [&](FrameGraphBuilder& builder) {
+			builder.read(scene_color);
+			bright = builder.create("Bright", hdr);
+		}, {});
+		graph.add_pass("Blur", [&](FrameGraphBuilder& builder) {
+			builder.read(bright);
+			blur = builder.create("Blur", hdr);
+		}, {});
+		const u32 picking = graph.add_pass("Picking", [&](FrameGraphBuilder& builder) {
+			builder.read(scene_depth);
+			picked = builder.create("Ids", ids);
+		}, {});
+		graph.add_pass("Tonemap", [&](FrameGraphBuilder& builder) {
+			builder.read(blur);
+			builder.read(scene_color);
+			builder.write(viewport);
+		}, {});
+		check(graph.compile(), "post chain compiles");
+		check(order_of(graph) == std::vector<std::string>{ "Scene", "Bright", "Blur", "Tonemap" }, "post chain runs in dependency order");
+		check(graph.is_culled(picking) && graph.get_stats().culled == 1, "pass whose output nobody reads is culled");
+		check(graph.get_physical(scene_color) != graph.get_physical(bright) && graph.get_physical(scene_color) != graph.get_physical(blur),
+			"target read at the end does not share a texture with the targets in between");
+		check(graph.get_physical(picked) == INVALID_FRAME_GRAPH_RESOURCE, "target used only by a culled pass gets no texture");
+
+		// Each target of a ping-pong chain is dead before the one after next is written
+		graph.clear();
+		FrameGraphResource first = INVALID_FRAME_GRAPH_RESOURCE, second = INVALID_FRAME_GRAPH_RESOURCE, third = INVALID_FRAME_GRAPH_RESOURCE;
+		FrameGraphResource other_format = INVALID_FRAME_GRAPH_RESOURCE;
+		viewport = graph.import_texture("Viewport", 1);
+		graph.add_pass("A", [&](FrameGraphBuilder& builder) { first = builder.create("First", hdr); }, {});
+		graph.add_pass("B", [&](FrameGraphBuilder& builder) {
+			builder.read(first);
+			second = builder.create("Second", hdr);
+		}, {});
+		graph.add_pass("C", [&](FrameGraphBuilder& builder) {
+			builder.read(second);
+			third = builder.create("Third", hdr);
+		}, {});
+		graph.add_pass("D", [&](FrameGraphBuilder& builder) {
+			builder.read(third);
+			other_format = builder.create("Ids", ids);
+		}, {});
+		graph.add_pass("E", [&](FrameGraphBuilder& builder) {
+			builder.read(other_format);
+			builder.write(viewport);
+		}, {});
+		check(graph.compile(), "ping-pong chain compiles");
+		check(graph.get_physical(first) == graph.get_physical(third), "targets with disjoint lifetimes share a texture");
+		check(graph.get_physical(first) != graph.get_physical(second), "targets with overlapping lifetimes do not share a texture");
+		check(graph.get_physical(other_format) != graph.get_physical(first) && graph.get_physical(other_format) != graph.get_physical(second),
+			"targets of different formats do not share a texture");
+		const FrameGraphStats& stats = graph.get_stats();
+		check(stats.transients == 4 && stats.physical_targets == 3, "four transients alias into three textures");
+		check(stats.allocated_bytes == stats.requested_bytes - RenderTargetPool::size_in_bytes(hdr), "aliasing saves the memory of one target");
+
+		// Passes added before the passes they depend on, plus a side effect nobody reads
+		graph.clear();
+		viewport = graph.import_texture("Viewport", 1);
+		const FrameGraphResource shadow_map = graph.import_texture("Shadow map", 2);
+		graph.add_pass("Scene", [&](FrameGraphBuilder& builder) {
+			builder.read(shadow_map);
+			builder.write(viewport);
+		}, {});
+		graph.add_pass("Shadows", [&](FrameGraphBuilder& builder) { builder.write(shadow_map); }, {});
+		const u32 capture = graph.add_pass("Capture", [&](FrameGraphBuilder& builder) {
+			builder.create("Capture", hdr);
+			builder.set_side_effect();
+		}, {});
+		check(graph.compile(), "passes added out of order compile");
+		check(order_of(graph) == std::vector<std::string>{ "Shadows", "Scene", "Capture" }, "writer runs before a reader added earlier");
+		check(!graph.is_culled(capture), "pass with a side effect is kept");
+
+		// Writers of one target run in the order they were added, a read-modify-write included
+		graph.clear();
+		FrameGraphResource color = INVALID_FRAME_GRAPH_RESOURCE;
+		viewport = graph.import_texture("Viewport", 1);
+		graph.add_pass("Clear", [&](FrameGraphBuilder& builder) { color = builder.create("Color", hdr); }, {});
+		graph.add_pass("Opaque", [&](FrameGraphBuilder& builder) { builder.write(color); }, {});
+		graph.add_pass("Blend", [&](FrameGraphBuilder& builder) {
+			builder.read(color);
+			builder.write(color);
+		}, {});
+		graph.add_pass("Present", [&](FrameGraphBuilder& builder) {
+			builder.read(color);
+			builder.write(viewport);
+		}, {});
+		check(graph.compile(), "several writers compile");
+		check(order_of(graph) == std::vector<std::string>{ "Clear", "Opaque", "Blend", "Present" }, "writers run in the order they were added");
+
+		// Two passes each reading what the other writes
+		graph.clear();
+		const FrameGraphResource ping = graph.import_texture("Ping", 3);
+		const FrameGraphResource pong = graph.import_texture("Pong", 4);
+		graph.add_pass("P", [&](FrameGraphBuilder& builder) {
+			builder.read(pong);
+			builder.write(ping);
+		}, {});
+		graph.add_pass("Q", [&](FrameGraphBuilder& builder) {
+			builder.read(ping);
+			builder.write(pong);
+		}, {});
+		check(!graph.compile() && graph.get_order().empty(), "cycle is rejected");
+
+		report = log.str();
+		return ok;
+	}
+#pragma endregion
+
+} // end of namespace gam300
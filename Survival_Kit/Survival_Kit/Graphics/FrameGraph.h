@@ -0,0 +1,191 @@
+/**
+ * @file FrameGraph.h
+ * @brief Declaration of the frame graph of render passes.
+ * @details Passes declare the render targets they read and write, the graph orders them,
+ *          leaves out those whose results nobody uses, and lets transient render targets
+ *          with disjoint lifetimes share one texture.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __FRAME_GRAPH_H__
+#define __FRAME_GRAPH_H__
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/RenderTargetPool.h"
+
+namespace gam300 {
+
+	// Index of a render target in the graph
+	using FrameGraphResource = u32;
+	constexpr FrameGraphResource INVALID_FRAME_GRAPH_RESOURCE = 0xFFFFFFFFu;
+
+	class FrameGraph;
+
+	/**
+	 * @brief Declares what a pass reads and writes, handed to its setup function.
+	 */
+	class FrameGraphBuilder {
+	public:
+		/**
+		 * @brief Create a transient render target, written by this pass.
+		 * @details It only exists from the first pass using it to the last, and may share
+		 *          a texture with other transients of the same desc outside that range.
+		 */
+		FrameGraphResource create(const std::string& name, const RenderTargetDesc& desc);
+
+		FrameGraphResource read(FrameGraphResource resource);
+		FrameGraphResource write(FrameGraphResource resource);
+
+		/**
+		 * @brief Keep the pass even if nothing reads what it writes.
+		 */
+		void set_side_effect();
+
+	private:
+		friend class FrameGraph;
+		FrameGraphBuilder(FrameGraph& graph, u32 pass) : graph(graph), pass(pass) {}
+
+		FrameGraph& graph;
+		u32 pass;
+	};
+
+	// Counters of the last compile()
+	struct FrameGraphStats {
+		u32 passes = 0;
+		u32 culled = 0;                 // Passes left out, their results were not used
+		u32 transients = 0;             // Transient targets used by the passes that run
+		u32 physical_targets = 0;       // Textures they need once aliased
+		u64 requested_bytes = 0;        // Memory of the transients without aliasing
+		u64 allocated_bytes = 0;        // Memory of the textures they alias into
+	};
+
+	/**
+	 * @brief Render passes of one frame and the render targets between them.
+	 * @details A pass that reads a target runs after every pass writing it, and passes
+	 *          writing the same target run in the order they were added. The passes that
+	 *          run are those with a side effect or writing an imported target, plus every
+	 *          pass writing something they use. Imported targets, like the viewport
+	 *          texture, outlive the frame, so writing one counts as an output.
+	 *
+	 *          compile() makes no GL calls, so ordering, culling and aliasing can be
+	 *          checked without a context. execute() takes the textures of the transients
+	 *          from a RenderTargetPool right before their first use and gives them back
+	 *          right after their last.
+	 */
+	class FrameGraph {
+	public:
+		using SetupFunc = std::function<void(FrameGraphBuilder&)>;
+		using ExecuteFunc = std::function<void(const FrameGraph&)>;
+
+		/**
+		 * @brief Add a pass, its setup function runs right away.
+		 * @return Index of the pass.
+		 */
+		u32 add_pass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute);
+
+		/**
+		 * @brief Add a texture the graph does not own.
+		 */
+		FrameGraphResource import_texture(const std::string& name, GLuint texture);
+
+		/**
+		 * @brief Order the passes, cull the unused ones and alias the transients.
+		 * @return false if the passes depend on each other in a cycle or a transient is
+		 *         read without being written, execute() then does nothing.
+		 */
+		bool compile();
+
+		/**
+		 * @brief Run the passes of the last compile() in order.
+		 */
+		void execute(RenderTargetPool& pool);
+
+		/**
+		 * @brief Remove every pass and resource, for the next frame.
+		 */
+		void clear();
+
+		/**
+		 * @brief Texture of a resource, for transients only while execute() runs.
+		 */
+		GLuint get_texture(FrameGraphResource resource) const;
+
+		// Passes that run, in execution order
+		const std::vector<u32>& get_order() const { return order; }
+
+		bool is_culled(u32 pass) const { return passes[pass].culled; }
+		const std::string& get_pass_name(u32 pass) const { return passes[pass].name; }
+		std::size_t pass_count() const { return passes.size(); }
+
+		/**
+		 * @brief Texture a transient was aliased into, INVALID_FRAME_GRAPH_RESOURCE for
+		 *        imported and unused resources.
+		 */
+		u32 get_physical(FrameGraphResource resource) const { return resources[resource].physical; }
+
+		const FrameGraphStats& get_stats() const { return stats; }
+
+		/**
+		 * @brief Compile small graphs and check the result, needs no GL context.
+		 * @details Covers pass ordering, culling, cycle rejection and aliasing of
+		 *          transients. main runs it with --validate-frame-graph.
+		 * @param report Receives one line per check.
+		 * @return True if every check passed.
+		 */
+		static bool validate(std::string& report);
+
+	private:
+		friend class FrameGraphBuilder;
+
+		struct Resource {
+			std::string name;
+			RenderTargetDesc desc;
+			GLuint texture = 0;                 // Imported texture
+			bool imported = false;
+			u32 physical = INVALID_FRAME_GRAPH_RESOURCE;
+			u32 first_use = INVALID_FRAME_GRAPH_RESOURCE;   // Positions in the execution order
+			u32 last_use = 0;
+			std::vector<u32> writers;           // Passes, in the order they were added
+			std::vector<u32> readers;           // Passes reading it without writing it
+		};
+
+		struct Pass {
+			std::string name;
+			ExecuteFunc execute;
+			std::vector<FrameGraphResource> reads;
+			std::vector<FrameGraphResource> writes;
+			bool side_effect = false;
+			bool culled = false;
+		};
+
+		// Texture shared by transients of one desc whose lifetimes do not overlap
+		struct Physical {
+			RenderTargetDesc desc;
+			u32 first_use = 0;
+			u32 last_use = 0;
+			GLuint texture = 0;
+		};
+
+		// Cull, order and alias, each step of compile()
+		void cull_passes();
+		bool sort_passes();
+		void alias_transients();
+
+		std::vector<Pass> passes;
+		std::vector<Resource> resources;
+		std::vector<Physical> physicals;
+		std::vector<u32> order;
+		bool compiled = false;
+		FrameGraphStats stats;
+	};
+
+} // end of namespace gam300
+#endif // __FRAME_GRAPH_H__
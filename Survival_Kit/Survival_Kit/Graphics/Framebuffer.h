@@ -8,6 +8,7 @@
 #include <span>
 
 #include "../Graphics/Common.h"
+#include "../Graphics/GLStateTracker.h"
 
 namespace gam300 {
 
@@ -38,6 +39,10 @@ namespace gam300 {
 		u64  handle() const noexcept { return m_handle; }
 		bool valid() const noexcept { return m_handle != kInvalid; }
 
+		// Binds go through the state tracker, binding what is bound costs nothing
+		inline void bind(GLenum target = GL_FRAMEBUFFER) const { GLS.bind_framebuffer(target, gl_id()); }
+		inline static void unbind(GLenum target = GL_FRAMEBUFFER) { GLS.bind_framebuffer(target, 0); }
+
 		inline void attach_color(GLenum attachment, GLuint tex, GLint level = 0) const {
 			glNamedFramebufferTexture(gl_id(), attachment, tex, level);
 		}
@@ -48,12 +53,17 @@ namespace gam300 {
 
 		inline void attach_depth(GLuint texOrRb, bool isTexture, GLint level = 0) const {
 			if (isTexture) glNamedFramebufferTexture(gl_id(), GL_DEPTH_ATTACHMENT, texOrRb, level);
-			else glNamedFramebufferTexture(gl_id(), GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, texOrRb);
+			else glNamedFramebufferRenderbuffer(gl_id(), GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, texOrRb);
+		}
+
+		// One layer of an array or 3D texture
+		inline void attach_depth_layer(GLuint tex, GLint layer, GLint level = 0) const {
+			glNamedFramebufferTextureLayer(gl_id(), GL_DEPTH_ATTACHMENT, tex, level, layer);
 		}
 
 		inline void attach_depth_stencil(GLuint texOrRb, bool isTexture, GLint level = 0) const {
 			if (isTexture) glNamedFramebufferTexture(gl_id(), GL_DEPTH_STENCIL_ATTACHMENT, texOrRb, level);
-			else glNamedFramebufferRenderbuffer(gl_id(), GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, level);
+			else glNamedFramebufferRenderbuffer(gl_id(), GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, texOrRb);
 		}
 
 		inline void set_draw_buffers(std::span<const GLenum> bufs) const {
@@ -104,7 +114,11 @@ namespace gam300 {
 		explicit FrameBuffer(u64 h) noexcept : m_handle(h) { }
 
 		void destroy() noexcept {
-			if (m_handle != kInvalid) { const GLuint fb = static_cast<GLuint>(m_handle); glDeleteFramebuffers(1, &fb); }
+			if (m_handle != kInvalid) {
+				const GLuint fb = static_cast<GLuint>(m_handle);
+				GLS.framebuffer_deleted(fb);
+				glDeleteFramebuffers(1, &fb);
+			}
 		}
 
 		void move_from(FrameBuffer& o) {
@@ -0,0 +1,287 @@
+/**
+ * @file FrustumCuller.cpp
+ * @brief Implementation of the CPU frustum culling pass.
+ * @details Contains implementations for all member functions declared in FrustumCuller.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Graphics/FrustumCuller.h"
+#include "../Graphics/Camera.h"
+#include "../Manager/JobManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <immintrin.h>
+#include <glm-0.9.9.8/glm/gtc/matrix_transform.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define GAM300_TARGET_AVX
+#else
+#include <cpuid.h>
+#define GAM300_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+namespace gam300 {
+
+	namespace {
+		constexpr std::size_t CULL_GRAIN = 1024;	// Objects per job, a multiple of 8
+		constexpr std::size_t LANES = 8;
+
+		// Scene of benchmark
+		constexpr u32 BENCH_OBJECTS = 100000;
+		constexpr int BENCH_RUNS = 20;
+		constexpr float BENCH_WORLD_SIZE = 400.0f;     // Objects are scattered in a cube around the camera
+	}
+
+	bool FrustumCuller::has_avx() {
+		static const bool supported = []() {
+#if defined(_MSC_VER)
+			int info[4] = {};
+			__cpuid(info, 1);
+			const bool cpu_avx = (info[2] & (1 << 28)) != 0;
+			const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+#else
+			unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+			__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+			const bool cpu_avx = (ecx & (1u << 28)) != 0;
+			bool os_saves_ymm = false;
+			if ((ecx & (1u << 27)) != 0) {
+				unsigned int xcr0_lo = 0, xcr0_hi = 0;
+				__asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+				os_saves_ymm = (xcr0_lo & 0x6) == 0x6;
+			}
+#endif
+			return cpu_avx && os_saves_ymm;
+		}();
+		return supported;
+	}
+
+	void FrustumCuller::clear() {
+		count = 0;
+		center_x.clear(); center_y.clear(); center_z.clear();
+		extent_x.clear(); extent_y.clear(); extent_z.clear();
+		radius.clear();
+	}
+
+	u32 FrustumCuller::add(const glm::mat4& model, const MeshBounds& bounds) {
+		// Center moves with the full transform
+		const glm::vec3 center = glm::vec3(model * glm::vec4(bounds.center, 1.0f));
+
+		// Box extents of the rotated box, |M| * e
+		const glm::vec3 axis_x(model[0]), axis_y(model[1]), axis_z(model[2]);
+		const glm::vec3 extents = glm::abs(axis_x) * bounds.extents.x
+			+ glm::abs(axis_y) * bounds.extents.y
+			+ glm::abs(axis_z) * bounds.extents.z;
+
+		// Sphere grows with the largest axis scale
+		const float max_scale = std::sqrt(std::max(glm::dot(axis_x, axis_x), std::max(glm::dot(axis_y, axis_y), glm::dot(axis_z, axis_z))));
+
+		// Keep the arrays padded with empty objects so the last block of 8 can be loaded whole
+		if (count % LANES == 0) {
+			const std::size_t padded = count + LANES;
+			center_x.resize(padded, 0.0f); center_y.resize(padded, 0.0f); center_z.resize(padded, 0.0f);
+			extent_x.resize(padded, 0.0f); extent_y.resize(padded, 0.0f); extent_z.resize(padded, 0.0f);
+			radius.resize(padded, 0.0f);
+		}
+
+		center_x[count] = center.x; center_y[count] = center.y; center_z[count] = center.z;
+		extent_x[count] = extents.x; extent_y[count] = extents.y; extent_z[count] = extents.z;
+		radius[count] = bounds.radius * max_scale;
+		return static_cast<u32>(count++);
+	}
+
+	void FrustumCuller::cull_range_scalar(const std::array<glm::vec4, 6>& planes, std::size_t begin, std::size_t end, std::vector<u32>& out) const {
+		for (std::size_t i = begin; i < end; ++i) {
+			bool inside = true;
+			for (const glm::vec4& plane : planes) {
+				const float distance = plane.x * center_x[i] + plane.y * center_y[i] + plane.z * center_z[i] + plane.w;
+				const float box_radius = std::fabs(plane.x) * extent_x[i] + std::fabs(plane.y) * extent_y[i] + std::fabs(plane.z) * extent_z[i];
+				if (distance < -std::min(box_radius, radius[i])) {
+					inside = false;
+					break;
+				}
+			}
+			if (inside) {
+				out.push_back(static_cast<u32>(i));
+			}
+		}
+	}
+
+	GAM300_TARGET_AVX
+	void FrustumCuller::cull_range_avx(const std::array<glm::vec4, 6>& planes, std::size_t begin, std::size_t end, std::vector<u32>& out) const {
+		const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+
+		__m256 plane_x[6], plane_y[6], plane_z[6], plane_w[6];
+		__m256 abs_x[6], abs_y[6], abs_z[6];
+		for (int p = 0; p < 6; ++p) {
+			plane_x[p] = _mm256_set1_ps(planes[p].x);
+			plane_y[p] = _mm256_set1_ps(planes[p].y);
+			plane_z[p] = _mm256_set1_ps(planes[p].z);
+			plane_w[p] = _mm256_set1_ps(planes[p].w);
+			abs_x[p] = _mm256_andnot_ps(sign_mask, plane_x[p]);
+			abs_y[p] = _mm256_andnot_ps(sign_mask, plane_y[p]);
+			abs_z[p] = _mm256_andnot_ps(sign_mask, plane_z[p]);
+		}
+
+		for (std::size_t i = begin; i < end; i += LANES) {
+			const __m256 cx = _mm256_loadu_ps(&center_x[i]);
+			const __m256 cy = _mm256_loadu_ps(&center_y[i]);
+			const __m256 cz = _mm256_loadu_ps(&center_z[i]);
+			const __m256 ex = _mm256_loadu_ps(&extent_x[i]);
+			const __m256 ey = _mm256_loadu_ps(&extent_y[i]);
+			const __m256 ez = _mm256_loadu_ps(&extent_z[i]);
+			const __m256 r = _mm256_loadu_ps(&radius[i]);
+
+			__m256 outside = _mm256_setzero_ps();
+			for (int p = 0; p < 6; ++p) {
+				__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(plane_x[p], cx), _mm256_mul_ps(plane_y[p], cy)),
+					_mm256_add_ps(_mm256_mul_ps(plane_z[p], cz), plane_w[p]));
+				__m256 box_radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(abs_x[p], ex), _mm256_mul_ps(abs_y[p], ey)),
+					_mm256_mul_ps(abs_z[p], ez));
+				__m256 reach = _mm256_min_ps(box_radius, r);
+
+				// distance + reach < 0 means fully behind this plane
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), _mm256_setzero_ps(), _CMP_LT_OQ));
+			}
+
+			// Padding past end is dropped here
+			unsigned int visible = static_cast<unsigned int>(~_mm256_movemask_ps(outside)) & 0xFFu;
+			if (end - i < LANES) {
+				visible &= (1u << (end - i)) - 1u;
+			}
+			while (visible) {
+				unsigned int lane = 0;
+				while (!(visible & (1u << lane))) ++lane;
+				out.push_back(static_cast<u32>(i + lane));
+				visible &= visible - 1u;
+			}
+		}
+	}
+
+	void FrustumCuller::cull(const std::array<glm::vec4, 6>& planes, std::vector<u32>& out_visible) {
+		const auto start_time = std::chrono::high_resolution_clock::now();
+
+		out_visible.clear();
+		const bool use_avx = has_avx();
+
+		const std::size_t chunk_count = JobManager::chunkCount(count, CULL_GRAIN);
+		if (chunk_visible.size() < chunk_count) {
+			chunk_visible.resize(chunk_count);
+		}
+
+		JM.parallelFor(count, CULL_GRAIN, [this, &planes, use_avx](std::size_t begin, std::size_t end) {
+			std::vector<u32>& out = chunk_visible[begin / CULL_GRAIN];
+			out.clear();
+			if (use_avx) {
+				cull_range_avx(planes, begin, end, out);
+			}
+			else {
+				cull_range_scalar(planes, begin, end, out);
+			}
+		});
+
+		// Chunks are in object order, so the compacted list is sorted
+		for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+			out_visible.insert(out_visible.end(), chunk_visible[chunk].begin(), chunk_visible[chunk].end());
+		}
+
+		const auto end_time = std::chrono::high_resolution_clock::now();
+		stats.tested = count;
+		stats.visible = out_visible.size();
+		stats.culled = count - out_visible.size();
+		stats.microseconds = std::chrono::duration<double, std::micro>(end_time - start_time).count();
+		stats.used_avx = use_avx;
+	}
+
+	bool FrustumCuller::benchmark(std::string& report) {
+		std::ostringstream log;
+		bool ok = true;
+		auto check = [&](bool condition, const std::string& what) {
+			log << (condition ? "  ok    " : "  FAIL  ") << what << "\n";
+			ok = ok && condition;
+		};
+
+		// Unit cubes, rotated and scaled, all around a camera looking down -z
+		std::mt19937 rng(4u);
+		std::uniform_real_distribution<float> position(-BENCH_WORLD_SIZE * 0.5f, BENCH_WORLD_SIZE * 0.5f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		MeshBounds cube;
+		cube.extents = glm::vec3(0.5f);
+		cube.radius = std::sqrt(0.75f);
+
+		FrustumCuller culler;
+		std::vector<glm::mat4> models(BENCH_OBJECTS);
+		for (glm::mat4& model : models) {
+			const glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.01f));
+			model = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng)))
+				* glm::rotate(glm::mat4(1.0f), unit(rng) * 6.2831853f, axis)
+				* glm::scale(glm::mat4(1.0f), glm::vec3(0.5f + unit(rng) * 2.5f, 0.5f + unit(rng) * 2.5f, 0.5f + unit(rng) * 2.5f));
+			culler.add(model, cube);
+		}
+
+		const Camera3D camera(CameraType::WALKING, glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 2.0f, -1.0f), 60.0f, 0.5f, 150.0f);
+		const std::array<glm::vec4, 6> planes = camera.getFrustumPlanes(16.0f / 9.0f);
+
+		// Best and average of several runs, the first one warms the caches
+		std::vector<u32> visible;
+		double best = 0.0, total = 0.0;
+		for (int run = 0; run < BENCH_RUNS; ++run) {
+			culler.cull(planes, visible);
+			const double microseconds = culler.get_stats().microseconds;
+			best = run == 0 ? microseconds : std::min(best, microseconds);
+			total += microseconds;
+		}
+		const CullStats stats = culler.get_stats();
+
+		// The scalar path on the calling thread, to compare against
+		std::vector<u32> scalar_visible;
+		double scalar_best = 0.0;
+		for (int run = 0; run < BENCH_RUNS; ++run) {
+			scalar_visible.clear();
+			const auto start = std::chrono::high_resolution_clock::now();
+			culler.cull_range_scalar(planes, 0, culler.size(), scalar_visible);
+			const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+			scalar_best = run == 0 ? microseconds : std::min(scalar_best, microseconds);
+		}
+
+		// A culled object has all eight corners of its box behind one plane
+		std::size_t wrongly_culled = 0;
+		std::size_t next_visible = 0;
+		for (u32 object = 0; object < BENCH_OBJECTS; ++object) {
+			if (next_visible < visible.size() && visible[next_visible] == object) {
+				++next_visible;
+				continue;
+			}
+			bool behind_one = false;
+			for (const glm::vec4& plane : planes) {
+				bool behind_all = true;
+				for (int corner = 0; corner < 8 && behind_all; ++corner) {
+					const glm::vec4 local((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f, 1.0f);
+					behind_all = glm::dot(plane, models[object] * local) < 0.0f;
+				}
+				behind_one = behind_one || behind_all;
+			}
+			wrongly_culled += behind_one ? 0 : 1;
+		}
+
+		log << "  " << stats.tested << " objects, " << stats.visible << " submitted, " << stats.culled << " culled, "
+			<< (JM.getWorkerCount() + 1) << " thread(s)\n";
+		log << "  " << (stats.used_avx ? "AVX" : "scalar") << " cull " << best * 1000.0 / BENCH_OBJECTS << " ns per object best, "
+			<< total / BENCH_RUNS * 1000.0 / BENCH_OBJECTS << " ns average\n";
+		log << "  scalar path " << scalar_best * 1000.0 / BENCH_OBJECTS << " ns per object on one thread\n";
+		check(scalar_visible == visible, "cull() and the scalar path submit the same objects");
+		check(wrongly_culled == 0, "every culled object is behind a frustum plane");
+		check(stats.visible > 0 && stats.culled > 0, "the scene has both submitted and culled objects");
+
+		report = log.str();
+		return ok;
+	}
+}
@@ -0,0 +1,108 @@
+/**
+ * @file FrustumCuller.h
+ * @brief Declaration of the CPU frustum culling pass.
+ * @details Objects are stored as world-space bounds in structure-of-arrays form and
+ *          tested against the camera frustum 8 at a time with AVX, on the job system.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __FRUSTUM_CULLER_H__
+#define __FRUSTUM_CULLER_H__
+
+#include <array>
+#include <string>
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/MeshData.h"
+
+namespace gam300 {
+
+	// Counters of the last cull() call
+	struct CullStats {
+		std::size_t tested = 0;
+		std::size_t visible = 0;
+		std::size_t culled = 0;
+		double      microseconds = 0.0;
+		bool        used_avx = false;
+	};
+
+	/**
+	 * @brief Tests world-space bounds against the six frustum planes.
+	 * @details An object is culled when its bounding sphere or its world-space box is
+	 *          fully behind any plane. Both volumes share a center, so each plane needs
+	 *          one distance and the smaller of the two projected radii. Falls back to a
+	 *          scalar loop on CPUs without AVX.
+	 */
+	class FrustumCuller {
+	public:
+
+		/**
+		 * @brief Remove every object, keeps the memory.
+		 */
+		void clear();
+
+		/**
+		 * @brief Add an object.
+		 * @param model Model matrix of the object.
+		 * @param bounds Object-space bounds of its mesh.
+		 * @return Index of the object, reported back by cull().
+		 */
+		u32 add(const glm::mat4& model, const MeshBounds& bounds);
+
+		std::size_t size() const { return count; }
+
+		/**
+		 * @brief World-space bounding sphere of an object, center in xyz and radius in w.
+		 */
+		glm::vec4 get_sphere(u32 object) const { return glm::vec4(center_x[object], center_y[object], center_z[object], radius[object]); }
+
+		/**
+		 * @brief Find the visible objects.
+		 * @param planes Frustum planes from Camera3D::getFrustumPlanes.
+		 * @param out_visible Receives the indices of the visible objects, in ascending order.
+		 */
+		void cull(const std::array<glm::vec4, 6>& planes, std::vector<u32>& out_visible);
+
+		const CullStats& get_stats() const { return stats; }
+
+		/**
+		 * @brief Check if the CPU and OS support AVX.
+		 */
+		static bool has_avx();
+
+		/**
+		 * @brief Time cull() over 100000 scattered objects, needs no GL context.
+		 * @details Reports submitted vs culled counts and ns per object for the AVX and
+		 *          scalar paths, and checks both return the same list and that every culled
+		 *          object really is behind a plane. main runs it with --bench-frustum-cull.
+		 * @param report Receives the timings and counts.
+		 * @return True if the checks passed.
+		 */
+		static bool benchmark(std::string& report);
+
+	private:
+
+		// Test objects [begin, end) and append the visible ones
+		void cull_range_scalar(const std::array<glm::vec4, 6>& planes, std::size_t begin, std::size_t end, std::vector<u32>& out) const;
+		void cull_range_avx(const std::array<glm::vec4, 6>& planes, std::size_t begin, std::size_t end, std::vector<u32>& out) const;
+
+		std::size_t count = 0;
+
+		// World-space bounds, padded to a multiple of 8
+		std::vector<float> center_x, center_y, center_z;
+		std::vector<float> extent_x, extent_y, extent_z;
+		std::vector<float> radius;
+
+		std::vector<std::vector<u32>> chunk_visible;    // Per job chunk, merged in order
+
+		CullStats stats;
+	};
+}
+
+#endif // !__FRUSTUM_CULLER_H__
@@ -13,6 +13,7 @@
 #include <algorithm>
 
 #include "../Graphics/GLResources.h"
+#include "../Graphics/GLStateTracker.h"
 
 namespace gam300 {
 
@@ -59,6 +60,10 @@ namespace gam300 {
 		glNamedBufferSubData(handle, offset, size, data);
 	}
 
+	void VBO::bind_base(GLenum target, GLuint index) const {
+		glBindBufferBase(target, index, handle);
+	}
+
 	void VBO::destroy() {
 		if (handle) glDeleteBuffers(1, &handle);
 	}
@@ -81,7 +86,10 @@ namespace gam300 {
 
 		if (this != &other) {
 
-			if (handle) glDeleteVertexArrays(1, &handle);
+			if (handle) {
+				GLS.vertex_array_deleted(handle);
+				glDeleteVertexArrays(1, &handle);
+			}
 			handle = std::exchange(other.handle, 0);
 		}
 
@@ -98,12 +106,12 @@ namespace gam300 {
 
 	void VAO::bind() const {
 
-		glBindVertexArray(handle);
+		GLS.bind_vertex_array(handle);
 	}
 
-	static void unbind() {
+	void VAO::unbind() {
 		
-		glBindVertexArray(0);
+		GLS.bind_vertex_array(0);
 	}
 
 	void VAO::enable_attrib(GLuint attrib) const {
@@ -120,6 +128,10 @@ namespace gam300 {
 		glVertexArrayAttribFormat(handle, attrib, comps, type, normalized ? GL_TRUE : GL_FALSE, relativeOffset);
 	}
 
+	void VAO::attrib_iformat(GLuint attrib, GLint comps, GLenum type, GLuint relativeOffset) const {
+		glVertexArrayAttribIFormat(handle, attrib, comps, type, relativeOffset);
+	}
+
 	void VAO::attrib_binding(GLuint attrib, GLuint binding) const {
 		glVertexArrayAttribBinding(handle, attrib, binding);
 	}
@@ -128,9 +140,16 @@ namespace gam300 {
 		glVertexArrayElementBuffer(handle, ebo.id());
 	}
 
+	void VAO::binding_divisor(GLuint binding, GLuint divisor) const {
+		glVertexArrayBindingDivisor(handle, binding, divisor);
+	}
+
 	void VAO::destroy() {
 
-		if(handle) glDeleteVertexArrays(1, &handle);
+		if (handle) {
+			GLS.vertex_array_deleted(handle);
+			glDeleteVertexArrays(1, &handle);
+		}
 	}
 #pragma endregion
 }
\ No newline at end of file
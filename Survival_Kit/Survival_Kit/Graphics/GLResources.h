@@ -73,6 +73,12 @@ namespace gam300 {
 		 */
 		void sub_data(GLintptr offset, GLsizeiptr size, const void* data);
 
+		/**
+		 * @brief Binds the buffer to an indexed target, such as a uniform buffer binding point.
+		 * @details Calls glBindBufferBase to achieve this.
+		 */
+		void bind_base(GLenum target, GLuint index) const;
+
 	private:
 	   /**
 		* @brief Helper function in releasing resrouces
@@ -142,10 +148,22 @@ namespace gam300 {
 		
 		void attrib_format(GLuint attrib, GLint comps, GLenum type, bool normalized, GLuint relativeOffset) const;
 
+		/**
+		 * @brief Integer attribute read as is, without conversion to float.
+		 * @details Calls glVertexArrayAttribIFormat to achieve this.
+		 */
+		void attrib_iformat(GLuint attrib, GLint comps, GLenum type, GLuint relativeOffset) const;
+
 		void attrib_binding(GLuint attrib, GLuint binding) const;
 
 		void bind_element_buffer(const VBO& ebo) const;
 
+		/**
+		 * @brief Advance a vertex buffer binding once per divisor instances instead of once per vertex.
+		 * @details Calls glVertexArrayBindingDivisor to achieve this.
+		 */
+		void binding_divisor(GLuint binding, GLuint divisor) const;
+
 	private:
 		/**
 		 * @brief Helper function in releasing resrouces
@@ -0,0 +1,213 @@
+/**
+ * @file GLStateTracker.cpp
+ * @brief Implementation of the OpenGL state tracker.
+ * @details Contains implementations for all member functions declared in GLStateTracker.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "GLStateTracker.h"
+
+#include <numeric>
+
+namespace gam300 {
+
+	u32 GLStateStats::total_issued() const {
+		return std::accumulate(issued.begin(), issued.end(), 0u);
+	}
+
+	u32 GLStateStats::total_elided() const {
+		return std::accumulate(elided.begin(), elided.end(), 0u);
+	}
+
+	GLStateTracker& GLStateTracker::getInstance() {
+		static GLStateTracker instance;
+		return instance;
+	}
+
+	GLStateTracker::GLStateTracker() {
+		invalidate();
+	}
+
+	bool GLStateTracker::changed(GLStateCall call, bool differs) {
+		if (differs) {
+			++stats.issued[static_cast<std::size_t>(call)];
+		}
+		else {
+			++stats.elided[static_cast<std::size_t>(call)];
+		}
+		return differs;
+	}
+
+	void GLStateTracker::use_program(GLuint new_program) {
+		if (changed(GLStateCall::PROGRAM, program != new_program)) {
+			glUseProgram(new_program);
+			program = new_program;
+		}
+	}
+
+	void GLStateTracker::bind_vertex_array(GLuint vao) {
+		if (changed(GLStateCall::VERTEX_ARRAY, vertex_array != vao)) {
+			glBindVertexArray(vao);
+			vertex_array = vao;
+		}
+	}
+
+	void GLStateTracker::bind_framebuffer(GLenum target, GLuint framebuffer) {
+		bool differs = true;
+		switch (target) {
+		case GL_FRAMEBUFFER:      differs = draw_framebuffer != framebuffer || read_framebuffer != framebuffer; break;
+		case GL_DRAW_FRAMEBUFFER: differs = draw_framebuffer != framebuffer; break;
+		case GL_READ_FRAMEBUFFER: differs = read_framebuffer != framebuffer; break;
+		}
+		if (!changed(GLStateCall::FRAMEBUFFER, differs)) {
+			return;
+		}
+
+		glBindFramebuffer(target, framebuffer);
+		if (target != GL_READ_FRAMEBUFFER) {
+			draw_framebuffer = framebuffer;
+		}
+		if (target != GL_DRAW_FRAMEBUFFER) {
+			read_framebuffer = framebuffer;
+		}
+	}
+
+	void GLStateTracker::bind_texture(GLuint unit, GLuint texture) {
+		const bool tracked = unit < MAX_TRACKED_UNITS;
+		if (changed(GLStateCall::TEXTURE, !tracked || textures[unit] != texture)) {
+			glBindTextureUnit(unit, texture);
+			if (tracked) {
+				textures[unit] = texture;
+			}
+		}
+	}
+
+	void GLStateTracker::bind_sampler(GLuint unit, GLuint sampler) {
+		const bool tracked = unit < MAX_TRACKED_UNITS;
+		if (changed(GLStateCall::SAMPLER, !tracked || samplers[unit] != sampler)) {
+			glBindSampler(unit, sampler);
+			if (tracked) {
+				samplers[unit] = sampler;
+			}
+		}
+	}
+
+	void GLStateTracker::set_enabled(GLenum capability, bool enabled) {
+		const i8 state = enabled ? 1 : 0;
+		i8* tracked = nullptr;
+		for (std::size_t i = 0; i < TRACKED_CAPABILITIES.size(); ++i) {
+			if (TRACKED_CAPABILITIES[i] == capability) {
+				tracked = &capabilities[i];
+				break;
+			}
+		}
+
+		if (changed(GLStateCall::CAPABILITY, !tracked || *tracked != state)) {
+			if (enabled) {
+				glEnable(capability);
+			}
+			else {
+				glDisable(capability);
+			}
+			if (tracked) {
+				*tracked = state;
+			}
+		}
+	}
+
+	void GLStateTracker::depth_func(GLenum func) {
+		if (changed(GLStateCall::DEPTH_FUNC, depth_function != func)) {
+			glDepthFunc(func);
+			depth_function = func;
+		}
+	}
+
+	void GLStateTracker::blend_func(GLenum source, GLenum destination) {
+		if (changed(GLStateCall::BLEND_FUNC, blend_source != source || blend_destination != destination)) {
+			glBlendFunc(source, destination);
+			blend_source = source;
+			blend_destination = destination;
+		}
+	}
+
+	void GLStateTracker::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+		const std::array<GLint, 4> rect{ x, y, width, height };
+		if (changed(GLStateCall::VIEWPORT, !viewport_known || viewport_rect != rect)) {
+			glViewport(x, y, width, height);
+			viewport_rect = rect;
+			viewport_known = true;
+		}
+	}
+
+	void GLStateTracker::program_deleted(GLuint deleted) {
+		// A program in use stays in use after glDeleteProgram, but its name may come back
+		// once another one replaces it, so it is safer not to know
+		if (deleted != 0 && program == deleted) {
+			program = UNKNOWN;
+		}
+	}
+
+	void GLStateTracker::vertex_array_deleted(GLuint vao) {
+		if (vao != 0 && vertex_array == vao) {
+			vertex_array = 0;
+		}
+	}
+
+	void GLStateTracker::framebuffer_deleted(GLuint framebuffer) {
+		if (framebuffer == 0) {
+			return;
+		}
+		if (draw_framebuffer == framebuffer) {
+			draw_framebuffer = 0;
+		}
+		if (read_framebuffer == framebuffer) {
+			read_framebuffer = 0;
+		}
+	}
+
+	void GLStateTracker::texture_deleted(GLuint texture) {
+		if (texture == 0) {
+			return;
+		}
+		for (GLuint& bound : textures) {
+			if (bound == texture) {
+				bound = 0;
+			}
+		}
+	}
+
+	void GLStateTracker::sampler_deleted(GLuint sampler) {
+		if (sampler == 0) {
+			return;
+		}
+		for (GLuint& bound : samplers) {
+			if (bound == sampler) {
+				bound = 0;
+			}
+		}
+	}
+
+	void GLStateTracker::invalidate() {
+		program = UNKNOWN;
+		vertex_array = UNKNOWN;
+		draw_framebuffer = UNKNOWN;
+		read_framebuffer = UNKNOWN;
+		textures.fill(UNKNOWN);
+		samplers.fill(UNKNOWN);
+		capabilities.fill(-1);
+		depth_function = UNKNOWN;
+		blend_source = UNKNOWN;
+		blend_destination = UNKNOWN;
+		viewport_known = false;
+	}
+
+	void GLStateTracker::begin_frame() {
+		frame_stats = stats;
+		stats = GLStateStats();
+	}
+
+} // end of namespace gam300
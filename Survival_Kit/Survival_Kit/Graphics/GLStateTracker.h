@@ -0,0 +1,143 @@
+/**
+ * @file GLStateTracker.h
+ * @brief Declaration of the OpenGL state tracker.
+ * @details Shadows the bindings and fixed-function state the renderer changes, so a call
+ *          that would set what is already set never reaches the driver.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __GL_STATE_TRACKER_H__
+#define __GL_STATE_TRACKER_H__
+
+#include <array>
+
+#include "../Graphics/Common.h"
+
+ // Acronym for easier access to the state tracker.
+#define GLS gam300::GLStateTracker::getInstance()
+
+namespace gam300 {
+
+	// Kinds of calls the tracker filters, for its counters
+	enum class GLStateCall : u8 {
+		PROGRAM = 0,
+		VERTEX_ARRAY,
+		FRAMEBUFFER,
+		TEXTURE,
+		SAMPLER,
+		CAPABILITY,         // glEnable and glDisable
+		DEPTH_FUNC,
+		BLEND_FUNC,
+		VIEWPORT,
+		COUNT
+	};
+
+	struct GLStateStats {
+		std::array<u32, static_cast<std::size_t>(GLStateCall::COUNT)> issued{};    // Calls that reached the driver
+		std::array<u32, static_cast<std::size_t>(GLStateCall::COUNT)> elided{};    // Calls skipped as no-ops
+
+		u32 get_issued(GLStateCall call) const { return issued[static_cast<std::size_t>(call)]; }
+		u32 get_elided(GLStateCall call) const { return elided[static_cast<std::size_t>(call)]; }
+		u32 total_issued() const;
+		u32 total_elided() const;
+	};
+
+	/**
+	 * @brief Shadow copy of the OpenGL state of the main context.
+	 * @details Every value starts unknown, so the first call always goes through. Code
+	 *          that changes tracked state with raw GL calls must put it back, as the
+	 *          ImGui backend does, or call invalidate(). Deleting a bound object unbinds
+	 *          it, so the wrappers report deletions to keep a reused name from being
+	 *          mistaken for the object that was bound.
+	 */
+	class GLStateTracker {
+	public:
+		// Texture units whose texture and sampler are tracked, higher units always go through
+		static constexpr u32 MAX_TRACKED_UNITS = 32;
+
+		/**
+		 * @brief Get the singleton instance of the tracker.
+		 */
+		static GLStateTracker& getInstance();
+
+		void use_program(GLuint program);
+		void bind_vertex_array(GLuint vao);
+
+		/**
+		 * @brief Bind a framebuffer, GL_FRAMEBUFFER sets both the draw and read targets.
+		 */
+		void bind_framebuffer(GLenum target, GLuint framebuffer);
+
+		void bind_texture(GLuint unit, GLuint texture);
+		void bind_sampler(GLuint unit, GLuint sampler);
+
+		/**
+		 * @brief glEnable or glDisable, only the capabilities the renderer toggles are tracked.
+		 */
+		void set_enabled(GLenum capability, bool enabled);
+
+		void depth_func(GLenum func);
+		void blend_func(GLenum source, GLenum destination);
+		void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// Objects about to be deleted, whatever they were bound to reverts to 0
+		void program_deleted(GLuint program);
+		void vertex_array_deleted(GLuint vao);
+		void framebuffer_deleted(GLuint framebuffer);
+		void texture_deleted(GLuint texture);
+		void sampler_deleted(GLuint sampler);
+
+		/**
+		 * @brief Forget every value, the next call of each kind goes through.
+		 */
+		void invalidate();
+
+		/**
+		 * @brief Close the counters of the frame that ended and start new ones.
+		 */
+		void begin_frame();
+
+		// Counters of the last full frame
+		const GLStateStats& get_frame_stats() const { return frame_stats; }
+
+	private:
+		GLStateTracker();
+
+		GLStateTracker(const GLStateTracker&) = delete;
+		GLStateTracker& operator=(const GLStateTracker&) = delete;
+
+		// Count a call, true if it has to be issued
+		bool changed(GLStateCall call, bool differs);
+
+		// Value of a binding or enum that is not known
+		static constexpr GLuint UNKNOWN = 0xFFFFFFFFu;
+
+		// Capabilities whose state is tracked
+		static constexpr std::array<GLenum, 7> TRACKED_CAPABILITIES{
+			GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST,
+			GL_DEPTH_CLAMP, GL_POLYGON_OFFSET_FILL
+		};
+
+		GLuint program = UNKNOWN;
+		GLuint vertex_array = UNKNOWN;
+		GLuint draw_framebuffer = UNKNOWN;
+		GLuint read_framebuffer = UNKNOWN;
+		std::array<GLuint, MAX_TRACKED_UNITS> textures{};
+		std::array<GLuint, MAX_TRACKED_UNITS> samplers{};
+		std::array<i8, TRACKED_CAPABILITIES.size()> capabilities{};  // -1 unknown, 0 disabled, 1 enabled
+		GLenum depth_function = UNKNOWN;
+		GLenum blend_source = UNKNOWN;
+		GLenum blend_destination = UNKNOWN;
+		std::array<GLint, 4> viewport_rect{};
+		bool viewport_known = false;
+
+		GLStateStats stats;             // Frame in progress
+		GLStateStats frame_stats;       // Last full frame
+	};
+
+} // end of namespace gam300
+#endif // __GL_STATE_TRACKER_H__
@@ -68,8 +68,16 @@ namespace gam300 {
         glm::vec3& getLightDiffuse() { return light_diffuse; }
         glm::vec3& getLightSpecular() { return light_specular; }
 
+        // Direction the light shines in when treated as directional, from its position
+        // towards the origin it orbits. Used for the shadows of the main light.
+        glm::vec3 getLightDirection() const
+        {
+            const float length = glm::length(pos);
+            return length > 0.0f ? -pos / length : glm::vec3(0.0f, -1.0f, 0.0f);
+        }
+
         // Handles cursor movement events to adjust the light's position.
-        void lightOnCursor(double xoffset, double yoffset, ShaderProgram* shader/*, int i = 0*/)
+        void lightOnCursor(double xoffset, double yoffset)
         {
             const float r = glm::sqrt(pos.x * pos.x +
                 pos.y * pos.y + pos.z * pos.z); // Calculate radial distance
@@ -88,13 +96,8 @@ namespace gam300 {
             pos.y = r * glm::sin(alpha);
             pos.z = r * glm::cos(alpha) * glm::cos(betta);
 
-            // Set uniform to shader after update light values
-            if (shader) {
-                shader->setUniform("light.position", pos);      // Position
-                //shader->setUniform("light.La", light_ambient);  // Ambient
-                //shader->setUniform("light.Ld", light_diffuse);  // Diffuse
-                //shader->setUniform("light.Ls", light_specular); // Specular
-            }
+            // The light block is uploaded by the GraphicsManager once per frame, and the
+            // new direction makes it draw the cached static shadow layers again
         }
     };
 
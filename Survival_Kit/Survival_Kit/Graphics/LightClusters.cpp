@@ -0,0 +1,404 @@
+/**
+ * @file LightClusters.cpp
+ * @brief Implementation of the light clusters of the clustered forward pass.
+ * @details Contains implementations for all member functions declared in LightClusters.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "LightClusters.h"
+#include "../Manager/JobManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <glm-0.9.9.8/glm/gtc/matrix_transform.hpp>
+
+namespace gam300 {
+
+	namespace {
+		// Slices per job, a slice of the default grid has 144 clusters
+		constexpr std::size_t SLICE_GRAIN = 2;
+
+		// Widening of the candidate search, so rounding never skips a cluster the exact test accepts
+		constexpr float CANDIDATE_MARGIN = 1e-3f;
+
+		// Grow an immutable buffer to hold at least count elements of size bytes
+		void reserve_buffer(VBO& buffer, std::size_t& capacity, std::size_t count, std::size_t size, std::size_t minimum) {
+			if (count <= capacity && capacity != 0) {
+				return;
+			}
+			capacity = std::max(capacity * 2, minimum);
+			while (capacity < count) {
+				capacity *= 2;
+			}
+			buffer.create();
+			buffer.storage(static_cast<GLsizeiptr>(size * capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		}
+	}
+
+	void LightClusters::configure(const LightClusterDesc& cluster_desc) {
+		desc = cluster_desc;
+		desc.tiles_x = std::max(desc.tiles_x, 1u);
+		desc.tiles_y = std::max(desc.tiles_y, 1u);
+		desc.slices = std::max(desc.slices, 1u);
+		bounds_dirty = true;
+	}
+
+	void LightClusters::set_projection(const glm::mat4& new_projection, float new_near, float new_far,
+		u32 viewport_width, u32 viewport_height) {
+
+		const glm::vec2 new_tile_size(static_cast<float>(viewport_width) / desc.tiles_x,
+			static_cast<float>(viewport_height) / desc.tiles_y);
+		if (!bounds_dirty && new_projection == projection && new_near == near_plane && new_far == far_plane &&
+			new_tile_size == tile_size) {
+			return;
+		}
+		projection = new_projection;
+		near_plane = std::max(new_near, 1e-4f);
+		far_plane = std::max(new_far, near_plane * 1.001f);
+		tile_size = new_tile_size;
+		bounds_dirty = false;
+
+		// Slice k spans near * (far / near)^(k / slices) to the start of slice k + 1
+		const float depth_ratio = std::log(far_plane / near_plane);
+		slice_scale_bias = glm::vec2(desc.slices / depth_ratio, -(desc.slices * std::log(near_plane)) / depth_ratio);
+
+		std::vector<float> slice_depths(desc.slices + 1);
+		for (u32 k = 0; k <= desc.slices; ++k) {
+			slice_depths[k] = near_plane * std::pow(far_plane / near_plane, static_cast<float>(k) / desc.slices);
+		}
+		slice_depths[desc.slices] = far_plane;
+
+		// A point at depth d on the NDC line n lies at d * (n + P[2][i]) / P[i][i], so the
+		// extent of a tile along x only depends on its column and slice, and along y on its row
+		auto axis_bounds = [&](u32 tile, u32 tiles, float depth_near, float depth_far, float scale, float shift) {
+			const float n0 = -1.0f + 2.0f * tile / tiles;
+			const float n1 = -1.0f + 2.0f * (tile + 1) / tiles;
+			const float a = depth_near * (n0 + shift) / scale;
+			const float b = depth_near * (n1 + shift) / scale;
+			const float c = depth_far * (n0 + shift) / scale;
+			const float d = depth_far * (n1 + shift) / scale;
+			return AxisBounds{ std::min({ a, b, c, d }), std::max({ a, b, c, d }) };
+		};
+
+		column_bounds.resize(static_cast<std::size_t>(desc.slices) * desc.tiles_x);
+		row_bounds.resize(static_cast<std::size_t>(desc.slices) * desc.tiles_y);
+		depth_bounds.resize(desc.slices);
+		for (u32 k = 0; k < desc.slices; ++k) {
+			const float depth_near = slice_depths[k];
+			const float depth_far = slice_depths[k + 1];
+			depth_bounds[k] = AxisBounds{ -depth_far, -depth_near };
+			for (u32 x = 0; x < desc.tiles_x; ++x) {
+				column_bounds[k * desc.tiles_x + x] = axis_bounds(x, desc.tiles_x, depth_near, depth_far, projection[0][0], projection[2][0]);
+			}
+			for (u32 y = 0; y < desc.tiles_y; ++y) {
+				row_bounds[k * desc.tiles_y + y] = axis_bounds(y, desc.tiles_y, depth_near, depth_far, projection[1][1], projection[2][1]);
+			}
+		}
+	}
+
+	void LightClusters::clear() {
+		lights.clear();
+		cull_lights.clear();
+	}
+
+	u32 LightClusters::add_point(const glm::vec3& position, float range, const glm::vec3& color) {
+		LightData light;
+		light.position_range = glm::vec4(position, range);
+		light.color = glm::vec4(color, 0.0f);
+		lights.push_back(light);
+
+		cull_lights.push_back(CullLight{ position, range, glm::vec3(0.0f, 0.0f, -1.0f), -1.0f, 0.0f, false, 0, 0 });
+		return static_cast<u32>(lights.size() - 1);
+	}
+
+	u32 LightClusters::add_spot(const glm::vec3& position, float range, const glm::vec3& color,
+		const glm::vec3& direction, float cos_inner, float cos_outer) {
+
+		cos_outer = std::clamp(cos_outer, 0.0f, 1.0f);
+		cos_inner = std::clamp(cos_inner, cos_outer, 1.0f);
+
+		LightData light;
+		light.position_range = glm::vec4(position, range);
+		light.color = glm::vec4(color, 0.0f);
+		light.direction = glm::vec4(direction, 0.0f);
+		light.spot = glm::vec4(cos_inner, cos_outer, 1.0f, 0.0f);
+		lights.push_back(light);
+
+		const float sin_outer = std::sqrt(std::max(1.0f - cos_outer * cos_outer, 0.0f));
+		cull_lights.push_back(CullLight{ position, range, direction, cos_outer, sin_outer, true, 0, 0 });
+		return static_cast<u32>(lights.size() - 1);
+	}
+
+	u32 LightClusters::slice_of(float depth) const {
+		const float slice = std::floor(std::log(std::max(depth, near_plane)) * slice_scale_bias.x + slice_scale_bias.y);
+		return static_cast<u32>(std::clamp(slice, 0.0f, static_cast<float>(desc.slices - 1)));
+	}
+
+	void LightClusters::get_bounds(u32 cluster, glm::vec3& out_min, glm::vec3& out_max) const {
+		const u32 x = cluster % desc.tiles_x;
+		const u32 y = (cluster / desc.tiles_x) % desc.tiles_y;
+		const u32 k = cluster / (desc.tiles_x * desc.tiles_y);
+		const AxisBounds& column = column_bounds[k * desc.tiles_x + x];
+		const AxisBounds& row = row_bounds[k * desc.tiles_y + y];
+		out_min = glm::vec3(column.min, row.min, depth_bounds[k].min);
+		out_max = glm::vec3(column.max, row.max, depth_bounds[k].max);
+	}
+
+	bool LightClusters::touches(const CullLight& light, const glm::vec3& min, const glm::vec3& max) {
+		// Range sphere against the box
+		const glm::vec3 closest = glm::clamp(light.position, min, max);
+		const glm::vec3 offset = closest - light.position;
+		if (glm::dot(offset, offset) > light.range * light.range) {
+			return false;
+		}
+		if (!light.spot) {
+			return true;
+		}
+
+		// Cone against the bounding sphere of the box: outside the cone's angle, past its
+		// range or behind its apex
+		const glm::vec3 center = 0.5f * (min + max);
+		const float radius = 0.5f * glm::length(max - min);
+		const glm::vec3 to_center = center - light.position;
+		const float along = glm::dot(to_center, light.direction);
+		const float across = std::sqrt(std::max(glm::dot(to_center, to_center) - along * along, 0.0f));
+		const float distance = light.cos_outer * across - light.sin_outer * along;
+		return !(distance > radius || along > radius + light.range || along < -radius);
+	}
+
+	void LightClusters::assign_slice(u32 slice) {
+		const u32 tiles = desc.tiles_x * desc.tiles_y;
+		std::vector<ClusterRange>& local_ranges = slice_ranges[slice];
+		std::vector<u32>& local_indices = slice_indices[slice];
+		std::vector<u32>& pairs = slice_scratch[slice];
+		local_ranges.assign(tiles, ClusterRange());
+		local_indices.clear();
+		pairs.clear();
+
+		const AxisBounds* columns = &column_bounds[static_cast<std::size_t>(slice) * desc.tiles_x];
+		const AxisBounds* rows = &row_bounds[static_cast<std::size_t>(slice) * desc.tiles_y];
+		const AxisBounds& depth = depth_bounds[slice];
+
+		// Tiles whose extent overlaps the range box of the light are only candidates, the
+		// exact test decides. Pairs come out in light order.
+		for (u32 light = 0; light < cull_lights.size(); ++light) {
+			const CullLight& cull = cull_lights[light];
+			if (slice < cull.first_slice || slice > cull.last_slice) {
+				continue;
+			}
+			const float reach = cull.range * (1.0f + CANDIDATE_MARGIN) + CANDIDATE_MARGIN;
+
+			for (u32 y = 0; y < desc.tiles_y; ++y) {
+				if (rows[y].max < cull.position.y - reach || rows[y].min > cull.position.y + reach) {
+					continue;
+				}
+				for (u32 x = 0; x < desc.tiles_x; ++x) {
+					if (columns[x].max < cull.position.x - reach || columns[x].min > cull.position.x + reach) {
+						continue;
+					}
+					const glm::vec3 min(columns[x].min, rows[y].min, depth.min);
+					const glm::vec3 max(columns[x].max, rows[y].max, depth.max);
+					if (touches(cull, min, max)) {
+						const u32 tile = x + y * desc.tiles_x;
+						pairs.push_back(tile);
+						pairs.push_back(light);
+						++local_ranges[tile].count;
+					}
+				}
+			}
+		}
+
+		// Counting sort by tile keeps the light order within each tile
+		u32 offset = 0;
+		for (ClusterRange& range : local_ranges) {
+			range.offset = offset;
+			offset += range.count;
+		}
+		local_indices.resize(offset);
+		std::vector<u32> cursor(tiles);
+		for (u32 tile = 0; tile < tiles; ++tile) {
+			cursor[tile] = local_ranges[tile].offset;
+		}
+		for (std::size_t i = 0; i < pairs.size(); i += 2) {
+			local_indices[cursor[pairs[i]]++] = pairs[i + 1];
+		}
+	}
+
+	void LightClusters::assign() {
+		const auto start_time = std::chrono::high_resolution_clock::now();
+
+		// Slices the range of each light covers, one more on each side against rounding
+		for (CullLight& cull : cull_lights) {
+			const float depth = -cull.position.z;
+			const u32 first = slice_of(depth - cull.range);
+			const u32 last = slice_of(depth + cull.range);
+			cull.first_slice = first > 0 ? first - 1 : 0;
+			cull.last_slice = std::min(last + 1, desc.slices - 1);
+		}
+
+		slice_ranges.resize(desc.slices);
+		slice_indices.resize(desc.slices);
+		slice_scratch.resize(desc.slices);
+		JM.parallelFor(desc.slices, SLICE_GRAIN, [this](std::size_t begin, std::size_t end) {
+			for (std::size_t slice = begin; slice < end; ++slice) {
+				assign_slice(static_cast<u32>(slice));
+			}
+		});
+
+		// Clusters are numbered slice by slice, so the slices are merged in order
+		const u32 tiles = desc.tiles_x * desc.tiles_y;
+		ranges.resize(cluster_count());
+		indices.clear();
+		stats.max_per_cluster = 0;
+		for (u32 slice = 0; slice < desc.slices; ++slice) {
+			const u32 base = static_cast<u32>(indices.size());
+			for (u32 tile = 0; tile < tiles; ++tile) {
+				const ClusterRange& local = slice_ranges[slice][tile];
+				ranges[slice * tiles + tile] = ClusterRange{ base + local.offset, local.count };
+				stats.max_per_cluster = std::max(stats.max_per_cluster, local.count);
+			}
+			indices.insert(indices.end(), slice_indices[slice].begin(), slice_indices[slice].end());
+		}
+
+		const auto end_time = std::chrono::high_resolution_clock::now();
+		stats.lights = light_count();
+		stats.clusters = cluster_count();
+		stats.references = static_cast<u32>(indices.size());
+		stats.microseconds = std::chrono::duration<double, std::micro>(end_time - start_time).count();
+	}
+
+	void LightClusters::assign_brute_force(std::vector<ClusterRange>& out_ranges, std::vector<u32>& out_indices) const {
+		out_ranges.assign(cluster_count(), ClusterRange());
+		out_indices.clear();
+		for (u32 cluster = 0; cluster < cluster_count(); ++cluster) {
+			glm::vec3 min, max;
+			get_bounds(cluster, min, max);
+			out_ranges[cluster].offset = static_cast<u32>(out_indices.size());
+			for (u32 light = 0; light < cull_lights.size(); ++light) {
+				if (touches(cull_lights[light], min, max)) {
+					out_indices.push_back(light);
+				}
+			}
+			out_ranges[cluster].count = static_cast<u32>(out_indices.size()) - out_ranges[cluster].offset;
+		}
+	}
+
+	bool LightClusters::validate(std::string& report) {
+		std::ostringstream log;
+		bool ok = true;
+		auto check = [&](bool condition, const std::string& what) {
+			log << (condition ? "  ok    " : "  FAIL  ") << what << "\n";
+			ok = ok && condition;
+		};
+
+		struct Case {
+			LightClusterDesc desc;
+			float fov;
+			u32 width, height;
+			float near_plane, far_plane;
+			u32 lights;
+		};
+		const Case cases[] = {
+			{ LightClusterDesc{}, 60.0f, 1280, 720, 0.1f, 100.0f, 256 },
+			{ LightClusterDesc{ 8, 8, 16 }, 90.0f, 1024, 1024, 0.5f, 50.0f, 512 },
+			{ LightClusterDesc{ 1, 1, 1 }, 45.0f, 640, 480, 0.1f, 10.0f, 64 },
+			{ LightClusterDesc{ 32, 18, 32 }, 75.0f, 1920, 1080, 0.05f, 500.0f, 1024 },
+		};
+
+		std::mt19937 rng(1234u);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		for (const Case& test : cases) {
+			LightClusters clusters;
+			clusters.configure(test.desc);
+			const float aspect = static_cast<float>(test.width) / test.height;
+			clusters.set_projection(glm::perspective(glm::radians(test.fov), aspect, test.near_plane, test.far_plane),
+				test.near_plane, test.far_plane, test.width, test.height);
+
+			// Lights scattered a little past the frustum, so some only reach it with their range
+			for (u32 i = 0; i < test.lights; ++i) {
+				const float depth = test.near_plane + unit(rng) * (test.far_plane - test.near_plane) * 1.1f - test.near_plane * 2.0f;
+				const float half_height = std::tan(glm::radians(test.fov) * 0.5f) * std::max(depth, test.near_plane);
+				const glm::vec3 position((unit(rng) * 2.4f - 1.2f) * half_height * aspect,
+					(unit(rng) * 2.4f - 1.2f) * half_height, -depth);
+				const float range = 0.05f + unit(rng) * test.far_plane * 0.1f;
+				if (i % 3 == 2) {
+					const glm::vec3 direction = glm::normalize(glm::vec3(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f) + glm::vec3(0.0f, 0.0f, 1e-3f));
+					const float outer = glm::radians(5.0f + unit(rng) * 80.0f);
+					clusters.add_spot(position, range, glm::vec3(1.0f), direction, std::cos(outer * 0.5f), std::cos(outer));
+				}
+				else {
+					clusters.add_point(position, range, glm::vec3(1.0f));
+				}
+			}
+
+			clusters.assign();
+			std::vector<ClusterRange> brute_ranges;
+			std::vector<u32> brute_indices;
+			clusters.assign_brute_force(brute_ranges, brute_indices);
+
+			std::ostringstream name;
+			name << test.desc.tiles_x << "x" << test.desc.tiles_y << "x" << test.desc.slices << " grid, "
+				<< test.lights << " lights (" << clusters.get_stats().references << " references)";
+			check(clusters.get_ranges() == brute_ranges, name.str() + ": ranges match the brute force");
+			check(clusters.get_indices() == brute_indices, name.str() + ": indices match the brute force");
+		}
+
+		// A light at the camera reaches the first slice of every tile
+		LightClusters clusters;
+		clusters.configure(LightClusterDesc{});
+		clusters.set_projection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f), 0.1f, 100.0f, 1280, 720);
+		clusters.add_point(glm::vec3(0.0f), 1.0f, glm::vec3(1.0f));
+		clusters.assign();
+		bool first_slice_lit = true;
+		const u32 tiles = clusters.get_desc().tiles_x * clusters.get_desc().tiles_y;
+		for (u32 tile = 0; tile < tiles; ++tile) {
+			first_slice_lit = first_slice_lit && clusters.get_ranges()[tile].count == 1;
+		}
+		check(first_slice_lit, "light at the camera is in every cluster of the first slice");
+		check(clusters.get_ranges()[clusters.cluster_count() - 1].count == 0, "light at the camera misses the last slice");
+
+		report = log.str();
+		return ok;
+	}
+
+	void LightClusters::upload() {
+		// Sized for at least one entry, so the blocks are backed even without lights
+		reserve_buffer(light_buffer, light_capacity, lights.size(), sizeof(LightData), 64);
+		reserve_buffer(range_buffer, range_capacity, ranges.size(), sizeof(ClusterRange), 1024);
+		reserve_buffer(index_buffer, index_capacity, indices.size(), sizeof(u32), 1024);
+
+		if (!lights.empty()) {
+			light_buffer.sub_data(0, static_cast<GLsizeiptr>(sizeof(LightData) * lights.size()), lights.data());
+		}
+		if (!ranges.empty()) {
+			range_buffer.sub_data(0, static_cast<GLsizeiptr>(sizeof(ClusterRange) * ranges.size()), ranges.data());
+		}
+		if (!indices.empty()) {
+			index_buffer.sub_data(0, static_cast<GLsizeiptr>(sizeof(u32) * indices.size()), indices.data());
+		}
+
+		light_buffer.bind_base(GL_SHADER_STORAGE_BUFFER, LIGHT_BUFFER_BINDING);
+		range_buffer.bind_base(GL_SHADER_STORAGE_BUFFER, CLUSTER_RANGE_BUFFER_BINDING);
+		index_buffer.bind_base(GL_SHADER_STORAGE_BUFFER, CLUSTER_INDEX_BUFFER_BINDING);
+	}
+
+	void LightClusters::destroy() {
+		light_buffer = VBO();
+		range_buffer = VBO();
+		index_buffer = VBO();
+		light_capacity = 0;
+		range_capacity = 0;
+		index_capacity = 0;
+		clear();
+		ranges.clear();
+		indices.clear();
+	}
+
+} // end of namespace gam300
@@ -0,0 +1,231 @@
+/**
+ * @file LightClusters.h
+ * @brief Declaration of the light clusters of the clustered forward pass.
+ * @details Slices the view frustum into a grid of clusters, assigns point and spot lights
+ *          to the clusters they reach on the CPU, and uploads the light lists so each
+ *          fragment only loops over the lights of its cluster.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __LIGHT_CLUSTERS_H__
+#define __LIGHT_CLUSTERS_H__
+
+#include <string>
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/GLResources.h"
+
+namespace gam300 {
+
+	// Shader storage binding points, must match cluster_lights.glsl
+	constexpr GLuint LIGHT_BUFFER_BINDING         = 1;
+	constexpr GLuint CLUSTER_RANGE_BUFFER_BINDING = 2;
+	constexpr GLuint CLUSTER_INDEX_BUFFER_BINDING = 3;
+
+	/**
+	 * @brief layout(std430, binding = 1) buffer Lights, one entry
+	 */
+	struct LightData {
+		glm::vec4 position_range{ 0.0f };               // View space position, range in w
+		glm::vec4 color{ 0.0f };                        // Color times intensity, w unused
+		glm::vec4 direction{ 0.0f, 0.0f, -1.0f, 0.0f }; // View space spot direction, w unused
+		glm::vec4 spot{ -1.0f, -1.0f, 0.0f, 0.0f };     // Cosines of the inner and outer angles, 1 in z for a spot
+	};
+
+	static_assert(sizeof(LightData) == 64, "LightData does not match the std430 layout");
+
+	/**
+	 * @brief Lights of one cluster, indices [offset, offset + count) of the index list
+	 */
+	struct ClusterRange {
+		u32 offset = 0;
+		u32 count = 0;
+
+		bool operator==(const ClusterRange& other) const { return offset == other.offset && count == other.count; }
+	};
+
+	struct LightClusterDesc {
+		u32 tiles_x = 16;           // Screen tiles across
+		u32 tiles_y = 9;            // Screen tiles down
+		u32 slices = 24;            // Depth slices, spaced exponentially from near to far
+	};
+
+	// Counters of the last assign() call
+	struct LightClusterStats {
+		u32 lights = 0;
+		u32 clusters = 0;
+		u32 references = 0;         // Entries of the index list
+		u32 max_per_cluster = 0;
+		double microseconds = 0.0;
+	};
+
+	/**
+	 * @brief Clustered light lists of one view.
+	 * @details Clusters are numbered x + y * tiles_x + slice * tiles_x * tiles_y, with y
+	 *          going up the screen like gl_FragCoord. A light is assigned to a cluster
+	 *          when its range sphere, and for a spot its cone, reaches the view space box
+	 *          of the cluster. Slices are assigned in parallel on the job system. The
+	 *          lists always match assign_brute_force(), which tests every light against
+	 *          every cluster, so the fast path can be checked against it.
+	 */
+	class LightClusters {
+	public:
+
+		/**
+		 * @brief Set the grid size, the bounds are rebuilt on the next set_projection.
+		 */
+		void configure(const LightClusterDesc& desc);
+
+		/**
+		 * @brief Rebuild the cluster bounds if the projection changed.
+		 * @param projection Perspective projection of the view.
+		 * @param near_plane Distance to the near plane, where the first slice starts.
+		 * @param far_plane Distance to the far plane, where the last slice ends.
+		 * @param viewport_width Pixels across, to map gl_FragCoord to tiles.
+		 * @param viewport_height Pixels down.
+		 */
+		void set_projection(const glm::mat4& projection, float near_plane, float far_plane,
+			u32 viewport_width, u32 viewport_height);
+
+		/**
+		 * @brief Remove every light, keeps the memory.
+		 */
+		void clear();
+
+		/**
+		 * @brief Add a point light.
+		 * @param position View space position.
+		 * @param color Color times intensity.
+		 * @return Index of the light in the light buffer.
+		 */
+		u32 add_point(const glm::vec3& position, float range, const glm::vec3& color);
+
+		/**
+		 * @brief Add a spot light.
+		 * @param direction View space direction the spot shines along, normalized.
+		 * @param cos_inner Cosine of the half angle of full intensity.
+		 * @param cos_outer Cosine of the half angle beyond which there is no light.
+		 */
+		u32 add_spot(const glm::vec3& position, float range, const glm::vec3& color,
+			const glm::vec3& direction, float cos_inner, float cos_outer);
+
+		/**
+		 * @brief Build the light list of every cluster.
+		 */
+		void assign();
+
+		/**
+		 * @brief Reference assignment, every light against every cluster.
+		 * @param out_ranges Receives one range per cluster.
+		 * @param out_indices Receives the light indices the ranges point into.
+		 */
+		void assign_brute_force(std::vector<ClusterRange>& out_ranges, std::vector<u32>& out_indices) const;
+
+		/**
+		 * @brief Compare assign() with assign_brute_force() on random lights, needs no GL context.
+		 * @details Runs several grids and projections with point and spot lights in and around
+		 *          the frustum. main runs it with --validate-light-clusters.
+		 * @param report Receives one line per check.
+		 * @return True if every check passed.
+		 */
+		static bool validate(std::string& report);
+
+		/**
+		 * @brief Upload the lights and the lists of the last assign() and bind the buffers.
+		 */
+		void upload();
+
+		/**
+		 * @brief Release the buffers.
+		 */
+		void destroy();
+
+		/**
+		 * @brief Cluster a view space depth falls into, clamped to the first and last slice.
+		 */
+		u32 slice_of(float depth) const;
+
+		/**
+		 * @brief View space box of a cluster.
+		 */
+		void get_bounds(u32 cluster, glm::vec3& out_min, glm::vec3& out_max) const;
+
+		u32 cluster_count() const { return desc.tiles_x * desc.tiles_y * desc.slices; }
+		u32 light_count() const { return static_cast<u32>(lights.size()); }
+		const LightClusterDesc& get_desc() const { return desc; }
+		const std::vector<ClusterRange>& get_ranges() const { return ranges; }
+		const std::vector<u32>& get_indices() const { return indices; }
+		const LightClusterStats& get_stats() const { return stats; }
+
+		// Depth slicing as the shader computes it, slice = log(depth) * x + y
+		glm::vec2 get_slice_scale_bias() const { return slice_scale_bias; }
+		float get_near() const { return near_plane; }
+		float get_far() const { return far_plane; }
+		glm::vec2 get_tile_size() const { return tile_size; }
+
+	private:
+		// What the assignment needs of a light, spot cone as cosine and sine of the outer angle
+		struct CullLight {
+			glm::vec3 position;
+			float range;
+			glm::vec3 direction;
+			float cos_outer;
+			float sin_outer;
+			bool spot;
+			u32 first_slice;        // Slices its range covers, first_slice > last_slice if none
+			u32 last_slice;
+		};
+
+		// Extent of a tile column or row along one axis within one slice
+		struct AxisBounds {
+			float min;
+			float max;
+		};
+
+		// Exact test shared by both assignments, so they always agree
+		static bool touches(const CullLight& light, const glm::vec3& min, const glm::vec3& max);
+
+		// Assign the lights of one slice into slice_pairs[slice]
+		void assign_slice(u32 slice);
+
+		LightClusterDesc desc;
+		glm::mat4 projection{ 0.0f };
+		float near_plane = 0.0f;
+		float far_plane = 0.0f;
+		glm::vec2 slice_scale_bias{ 0.0f };
+		glm::vec2 tile_size{ 0.0f };
+		bool bounds_dirty = true;
+
+		std::vector<AxisBounds> column_bounds;  // x extent, slice * tiles_x + x
+		std::vector<AxisBounds> row_bounds;     // y extent, slice * tiles_y + y
+		std::vector<AxisBounds> depth_bounds;   // z extent of each slice, negative in view space
+
+		std::vector<LightData> lights;
+		std::vector<CullLight> cull_lights;
+
+		// Light indices of each cluster of a slice, in light order, before they are merged
+		std::vector<std::vector<ClusterRange>> slice_ranges;
+		std::vector<std::vector<u32>> slice_indices;
+		std::vector<std::vector<u32>> slice_scratch;
+
+		std::vector<ClusterRange> ranges;
+		std::vector<u32> indices;
+		LightClusterStats stats;
+
+		// Storage is immutable, each buffer is recreated with room to spare when it grows
+		VBO light_buffer;
+		VBO range_buffer;
+		VBO index_buffer;
+		std::size_t light_capacity = 0;
+		std::size_t range_capacity = 0;
+		std::size_t index_capacity = 0;
+	};
+
+} // end of namespace gam300
+#endif // __LIGHT_CLUSTERS_H__
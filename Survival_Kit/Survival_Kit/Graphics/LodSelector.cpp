@@ -0,0 +1,74 @@
+/**
+ * @file LodSelector.cpp
+ * @brief Implementation of the per-object level of detail selection pass.
+ * @details Contains implementations for all member functions declared in LodSelector.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Graphics/LodSelector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gam300 {
+
+	void LodSelector::begin_frame(const glm::mat4& projection, float viewport_height) {
+		// P[1][1] is 1 / tan(fov / 2), NDC spans 2 units over the viewport height
+		pixels_per_unit = projection[1][1] * viewport_height * 0.5f;
+		stats = LodStats{};
+	}
+
+	float LodSelector::projected_diameter(const glm::vec4& sphere, const glm::vec3& camera_position) const {
+		const float distance = glm::length(glm::vec3(sphere) - camera_position);
+
+		// The camera is inside the sphere, it covers the screen
+		if (distance <= sphere.w) {
+			return std::numeric_limits<float>::max();
+		}
+		return 2.0f * sphere.w * pixels_per_unit / distance;
+	}
+
+	u32 LodSelector::select(u32 object, const PoolMesh& mesh, const glm::vec4& sphere, const glm::vec3& camera_position) {
+		if (object >= previous.size()) {
+			previous.resize(static_cast<std::size_t>(object) + 1, 0);
+		}
+
+		u32 lod = 0;
+		if (mesh.lod_count > 1) {
+			const float diameter = projected_diameter(sphere, camera_position);
+			const float budget = settings.max_pixel_error * std::exp2(settings.bias);
+			const u32 current = std::min<u32>(previous[object], mesh.lod_count - 1);
+
+			// Coarsest level under its budget, levels past the current one must clear the dead band
+			for (u32 candidate = mesh.lod_count - 1; candidate > 0; --candidate) {
+				float limit = budget;
+				if (candidate > current) {
+					limit *= 1.0f - settings.hysteresis;
+				}
+				else if (candidate == current) {
+					limit *= 1.0f + settings.hysteresis;
+				}
+
+				if (mesh.lods[candidate].error * diameter <= limit) {
+					lod = candidate;
+					break;
+				}
+			}
+		}
+		previous[object] = static_cast<u8>(lod);
+
+		++stats.objects[lod];
+		stats.indices += mesh.lods[lod].index_count;
+		stats.full_detail_indices += mesh.lods[0].index_count;
+		return lod;
+	}
+
+	void LodSelector::reset() {
+		previous.clear();
+	}
+}
@@ -0,0 +1,95 @@
+/**
+ * @file LodSelector.h
+ * @brief Declaration of the per-object level of detail selection pass.
+ * @details Picks the coarsest LOD of a pool mesh whose simplification error stays
+ *          under a pixel budget once the bounding sphere is projected on screen.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __LOD_SELECTOR_H__
+#define __LOD_SELECTOR_H__
+
+#include <array>
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/MeshPool.h"
+
+namespace gam300 {
+
+	/**
+	 * @brief Tuning of the LOD selection, shared by every object.
+	 */
+	struct LodSettings {
+		float max_pixel_error = 1.0f;   // Screen-space error allowed at a bias of 0
+		float bias = 0.0f;              // Each step doubles the allowed error, negative favours detail
+		float hysteresis = 0.25f;       // Dead band around the budget, as a fraction of it
+	};
+
+	// Counters of the last frame
+	struct LodStats {
+		std::array<std::size_t, MAX_MESH_LODS> objects{};  // Objects drawn at each LOD
+		std::size_t indices = 0;                           // Indices submitted
+		std::size_t full_detail_indices = 0;               // Indices if every object used LOD 0
+	};
+
+	/**
+	 * @brief Chooses a LOD per object from its projected size.
+	 * @details The error of a LOD is relative to the mesh extent, which is taken as the
+	 *          diameter of the bounding sphere, so its on screen error is the error
+	 *          times the projected diameter in pixels. The selector remembers the LOD
+	 *          each object used last: it only moves to a coarser LOD once that LOD is
+	 *          under the budget minus the hysteresis, and keeps the current one until it
+	 *          goes over the budget plus the hysteresis, so objects near a threshold do
+	 *          not pop back and forth.
+	 */
+	class LodSelector {
+	public:
+
+		/**
+		 * @brief Set the camera of the frame and reset the counters.
+		 * @param projection Projection matrix from Camera3D::getPerspective.
+		 * @param viewport_height Height of the render target in pixels.
+		 */
+		void begin_frame(const glm::mat4& projection, float viewport_height);
+
+		/**
+		 * @brief Choose the LOD of an object.
+		 * @param object Stable id of the object across frames, such as its entity id.
+		 * @param mesh Pool mesh the object draws.
+		 * @param sphere World-space bounding sphere, center in xyz and radius in w.
+		 * @param camera_position World-space position of the camera.
+		 * @return Index into mesh.lods.
+		 */
+		u32 select(u32 object, const PoolMesh& mesh, const glm::vec4& sphere, const glm::vec3& camera_position);
+
+		/**
+		 * @brief Diameter of a sphere on screen in pixels for the current frame.
+		 */
+		float projected_diameter(const glm::vec4& sphere, const glm::vec3& camera_position) const;
+
+		/**
+		 * @brief Forget the LOD every object used last.
+		 */
+		void reset();
+
+		LodSettings& get_settings() { return settings; }
+		const LodSettings& get_settings() const { return settings; }
+		const LodStats& get_stats() const { return stats; }
+
+	private:
+		LodSettings settings;
+		LodStats stats;
+
+		float pixels_per_unit = 1.0f;       // Pixels covered by one unit at distance one
+
+		std::vector<u8> previous;           // LOD of each object last time it was selected
+	};
+}
+
+#endif // !__LOD_SELECTOR_H__
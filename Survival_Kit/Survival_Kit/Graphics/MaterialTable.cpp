@@ -0,0 +1,217 @@
+/**
+ * @file MaterialTable.cpp
+ * @brief Implementation of the material table.
+ * @details Contains implementations for all member functions declared in MaterialTable.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "MaterialTable.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gam300 {
+
+	namespace {
+
+		// GL_ARB_bindless_texture is not part of the generated loader, its entry points are looked up here
+		typedef GLuint64(APIENTRYP PFNGETTEXTURESAMPLERHANDLEARBPROC)(GLuint texture, GLuint sampler);
+		typedef void (APIENTRYP PFNMAKETEXTUREHANDLERESIDENTARBPROC)(GLuint64 handle);
+		typedef void (APIENTRYP PFNMAKETEXTUREHANDLENONRESIDENTARBPROC)(GLuint64 handle);
+
+		PFNGETTEXTURESAMPLERHANDLEARBPROC get_texture_sampler_handle = nullptr;
+		PFNMAKETEXTUREHANDLERESIDENTARBPROC make_texture_handle_resident = nullptr;
+		PFNMAKETEXTUREHANDLENONRESIDENTARBPROC make_texture_handle_non_resident = nullptr;
+
+		bool has_extension(const char* name) {
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			for (GLint i = 0; i < count; ++i) {
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+				if (extension && std::strcmp(extension, name) == 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		GLuint64 handle_of(const MaterialData& material) {
+			return static_cast<GLuint64>(material.diffuse_handle.x) | (static_cast<GLuint64>(material.diffuse_handle.y) << 32);
+		}
+	}
+
+	MaterialTable::~MaterialTable() {
+		destroy();
+	}
+
+	bool MaterialTable::create(GLADloadproc load, SamplerCache& cache) {
+		destroy();
+
+		sampler_cache = &cache;
+		default_sampler = cache.get(SamplerDesc{});
+
+		bindless_supported = false;
+		if (load && has_extension("GL_ARB_bindless_texture")) {
+			get_texture_sampler_handle = reinterpret_cast<PFNGETTEXTURESAMPLERHANDLEARBPROC>(load("glGetTextureSamplerHandleARB"));
+			make_texture_handle_resident = reinterpret_cast<PFNMAKETEXTUREHANDLERESIDENTARBPROC>(load("glMakeTextureHandleResidentARB"));
+			make_texture_handle_non_resident = reinterpret_cast<PFNMAKETEXTUREHANDLENONRESIDENTARBPROC>(load("glMakeTextureHandleNonResidentARB"));
+			bindless_supported = get_texture_sampler_handle && make_texture_handle_resident && make_texture_handle_non_resident &&
+				default_sampler;
+		}
+
+		LM.writeLog("MaterialTable::create() - Bindless textures %s", bindless_supported ? "enabled" : "unavailable, other textures are bound per draw");
+		return bindless_supported;
+	}
+
+	void MaterialTable::destroy() {
+		for (u32 id = 0; id < materials.size(); ++id) {
+			release_handle(id);
+		}
+		materials.clear();
+		textures.clear();
+		samplers.clear();
+		handle_users.clear();
+		buffer = VBO();
+		capacity = 0;
+		dirty = false;
+		default_sampler.reset();
+		sampler_cache = nullptr;
+	}
+
+	u32 MaterialTable::add(const Material& material) {
+		const u32 id = size();
+		set(id, material);
+		return id;
+	}
+
+	void MaterialTable::set(u32 id, const Material& material) {
+		if (id >= materials.size()) {
+			materials.resize(id + 1);
+			textures.resize(id + 1, 0);
+			samplers.resize(id + 1, default_sampler);
+		}
+
+		// The getters of Material hand out references for the editor, so read from a copy
+		Material copy = material;
+		MaterialData& data = materials[id];
+		data.ambient = glm::vec4(copy.getMaterialAmbient(), 1.0f);
+		data.diffuse = glm::vec4(copy.getMaterialDiffuse(), 1.0f);
+		data.specular = glm::vec4(copy.getMaterialSpecular(), copy.getMaterialShininess());
+		dirty = true;
+	}
+
+	void MaterialTable::set_diffuse_atlas(u32 id, const AtlasRegion& region) {
+		if (id >= materials.size()) {
+			return;
+		}
+		release_handle(id);
+		textures[id] = 0;
+
+		MaterialData& data = materials[id];
+		data.flags = MATERIAL_DIFFUSE_ATLAS;
+		data.uv_rect = region.uv_rect;
+		data.diffuse_layer = region.layer;
+		dirty = true;
+	}
+
+	void MaterialTable::set_diffuse_texture(u32 id, GLuint texture) {
+		if (id >= materials.size() || (textures[id] == texture && !(materials[id].flags & MATERIAL_DIFFUSE_ATLAS))) {
+			return;
+		}
+		release_handle(id);
+		textures[id] = texture;
+
+		MaterialData& data = materials[id];
+		data.flags = 0;
+		data.diffuse_handle = glm::uvec2(0u);
+		data.uv_rect = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+		if (texture != 0 && bindless_supported && samplers[id]) {
+			// A handle fixes the sampler state, the same texture and sampler give the same handle
+			const GLuint64 handle = get_texture_sampler_handle(texture, static_cast<GLuint>(samplers[id]->handle()));
+			if (handle != 0) {
+				if (handle_users[handle]++ == 0) {
+					make_texture_handle_resident(handle);
+				}
+				data.diffuse_handle = glm::uvec2(static_cast<u32>(handle), static_cast<u32>(handle >> 32));
+				data.flags = MATERIAL_DIFFUSE_BINDLESS;
+			}
+		}
+		if (texture != 0 && data.flags == 0) {
+			data.flags = MATERIAL_DIFFUSE_BOUND;
+		}
+		dirty = true;
+	}
+
+	void MaterialTable::set_sampler(u32 id, const SamplerDesc& desc) {
+		if (id >= materials.size() || !sampler_cache) {
+			return;
+		}
+		SamplerRef sampler = sampler_cache->get(desc);
+		if (!sampler || sampler == samplers[id]) {
+			return;
+		}
+		samplers[id] = std::move(sampler);
+
+		// A bindless handle has to be made again with the new sampler
+		if (materials[id].flags & MATERIAL_DIFFUSE_BINDLESS) {
+			const GLuint texture = textures[id];
+			release_handle(id);
+			textures[id] = 0;
+			set_diffuse_texture(id, texture);
+		}
+	}
+
+	GLuint MaterialTable::get_bound_texture(u32 id) const {
+		return id < materials.size() && (materials[id].flags & MATERIAL_DIFFUSE_BOUND) ? textures[id] : 0;
+	}
+
+	GLuint MaterialTable::get_bound_sampler(u32 id) const {
+		return get_bound_texture(id) != 0 && samplers[id] ? static_cast<GLuint>(samplers[id]->handle()) : 0;
+	}
+
+	void MaterialTable::release_handle(u32 id) {
+		MaterialData& data = materials[id];
+		if (!(data.flags & MATERIAL_DIFFUSE_BINDLESS)) {
+			return;
+		}
+
+		// Materials sharing a texture share its handle. Deleting a texture already deleted
+		// its handles, which can then no longer be made non resident.
+		const GLuint64 handle = handle_of(data);
+		auto users = handle_users.find(handle);
+		if (users != handle_users.end() && --users->second == 0) {
+			handle_users.erase(users);
+			if (glIsTexture(textures[id])) {
+				make_texture_handle_non_resident(handle);
+			}
+		}
+		data.diffuse_handle = glm::uvec2(0u);
+		data.flags &= ~MATERIAL_DIFFUSE_BINDLESS;
+	}
+
+	void MaterialTable::update() {
+		if (dirty && !materials.empty()) {
+			// Storage is immutable, so grow by recreating the buffer with room to spare
+			if (materials.size() > capacity) {
+				capacity = std::max<std::size_t>(capacity * 2, 64);
+				while (capacity < materials.size()) {
+					capacity *= 2;
+				}
+				buffer.create();
+				buffer.storage(static_cast<GLsizeiptr>(sizeof(MaterialData) * capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+			}
+			buffer.sub_data(0, static_cast<GLsizeiptr>(sizeof(MaterialData) * materials.size()), materials.data());
+		}
+		dirty = false;
+
+		if (capacity != 0) {
+			buffer.bind_base(GL_SHADER_STORAGE_BUFFER, MATERIAL_BUFFER_BINDING);
+		}
+	}
+
+} // end of namespace gam300
@@ -0,0 +1,151 @@
+/**
+ * @file MaterialTable.h
+ * @brief Declaration of the material table.
+ * @details Keeps the properties and diffuse texture of every material in one shader
+ *          storage buffer, indexed per instance, so changing material or texture does
+ *          not have to break an instanced batch.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __MATERIAL_TABLE_H__
+#define __MATERIAL_TABLE_H__
+
+#include <unordered_map>
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/GLResources.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/SamplerCache.h"
+#include "../Graphics/TextureAtlas.h"
+
+namespace gam300 {
+
+	// Binding points, must match the binding qualifiers in the shaders
+	constexpr GLuint MATERIAL_BUFFER_BINDING = 0;    // Shader storage block
+	constexpr GLuint DIFFUSE_TEXTURE_UNIT    = 0;    // Texture of the draw, see DrawItem::texture
+	constexpr GLuint DIFFUSE_ATLAS_UNIT      = 1;
+
+	// Where the diffuse texture of a material comes from, must match material_block.glsl
+	enum MaterialFlags : u32 {
+		MATERIAL_DIFFUSE_ATLAS    = 1u << 0,     // Layer and rect of the atlas
+		MATERIAL_DIFFUSE_BOUND    = 1u << 1,     // Texture bound to DIFFUSE_TEXTURE_UNIT by the draw
+		MATERIAL_DIFFUSE_BINDLESS = 1u << 2      // Bindless handle
+	};
+
+	/**
+	 * @brief layout(std430, binding = 0) buffer Materials, one entry
+	 */
+	struct MaterialData {
+		glm::vec4 ambient{ 0.0f };
+		glm::vec4 diffuse{ 0.0f };
+		glm::vec4 specular{ 0.0f };                     // Shininess in w
+		glm::vec4 uv_rect{ 1.0f, 1.0f, 0.0f, 0.0f };    // Atlas region, scale in xy and offset in zw
+		glm::uvec2 diffuse_handle{ 0u };                // Bindless handle, low bits first
+		u32 diffuse_layer = 0;                          // Atlas layer
+		u32 flags = 0;
+	};
+
+	static_assert(sizeof(MaterialData) == 80, "MaterialData does not match the std430 layout");
+
+	/**
+	 * @brief Materials of the scene, uploaded as one shader storage buffer.
+	 * @details A diffuse texture is reached three ways. Textures in the texture atlas
+	 *          and, with GL_ARB_bindless_texture, any other texture are sampled through
+	 *          the buffer, so draws with different textures stay in one batch. Without
+	 *          bindless, other textures are bound per draw and break the batch as before.
+	 *          Each material samples its own texture through a sampler from the cache,
+	 *          so materials with the same sampling rules share one sampler object.
+	 */
+	class MaterialTable {
+	public:
+		MaterialTable() = default;
+		~MaterialTable();
+
+		MaterialTable(const MaterialTable&) = delete;
+		MaterialTable& operator=(const MaterialTable&) = delete;
+
+		/**
+		 * @brief Look up GL_ARB_bindless_texture and get the default sampler.
+		 * @param load Loader of GL entry points, the same glad was loaded with.
+		 * @param cache Samplers of the materials, must outlive the table.
+		 * @return true if bindless textures are used.
+		 */
+		bool create(GLADloadproc load, SamplerCache& cache);
+
+		void destroy();
+
+		/**
+		 * @brief Add a material without a texture.
+		 * @return Its index, what InstanceData::material refers to.
+		 */
+		u32 add(const Material& material);
+
+		/**
+		 * @brief Replace the colors of a material, adding materials up to it if needed.
+		 */
+		void set(u32 id, const Material& material);
+
+		/**
+		 * @brief Sample the diffuse texture from the atlas.
+		 */
+		void set_diffuse_atlas(u32 id, const AtlasRegion& region);
+
+		/**
+		 * @brief Sample the diffuse texture from a texture of its own, 0 for none.
+		 * @details Cheap to call every frame with the same texture. A texture that
+		 *          replaces a deleted one must be set before another texture is created.
+		 */
+		void set_diffuse_texture(u32 id, GLuint texture);
+
+		/**
+		 * @brief Sample the own diffuse texture of a material with other rules.
+		 * @details Materials start with the default SamplerDesc. The atlas keeps its own
+		 *          filtering and wraps in the shader.
+		 */
+		void set_sampler(u32 id, const SamplerDesc& desc);
+
+		/**
+		 * @brief Texture the draws of a material must bind, 0 if none has to be.
+		 */
+		GLuint get_bound_texture(u32 id) const;
+
+		/**
+		 * @brief Sampler to bind with get_bound_texture, 0 if no texture has to be bound.
+		 */
+		GLuint get_bound_sampler(u32 id) const;
+
+		/**
+		 * @brief Upload the changed materials and bind the buffer.
+		 */
+		void update();
+
+		bool bindless() const { return bindless_supported; }
+		u32 size() const { return static_cast<u32>(materials.size()); }
+		const MaterialData& get(u32 id) const { return materials[id]; }
+
+	private:
+		// Drop the bindless handle of a material, if the texture it came from still exists
+		void release_handle(u32 id);
+
+		std::vector<MaterialData> materials;
+		std::vector<GLuint> textures;                   // Own texture of each material, 0 for none
+		std::vector<SamplerRef> samplers;               // Sampling of each own texture
+		VBO buffer;
+		std::size_t capacity = 0;                       // Materials the buffer can hold
+		bool dirty = false;
+
+		SamplerCache* sampler_cache = nullptr;
+		SamplerRef default_sampler;
+
+		bool bindless_supported = false;
+		std::unordered_map<u64, u32> handle_users;      // Materials using each resident handle
+	};
+
+} // end of namespace gam300
+#endif // __MATERIAL_TABLE_H__
@@ -13,6 +13,30 @@
 #include "../Graphics/GLResources.h"
 
 namespace gam300 {
+
+	// Vertex attribute locations shared by every vertex layout and the shaders
+	constexpr GLuint POSITION_ATTRIB = 0;
+	constexpr GLuint NORMAL_ATTRIB   = 1;	// Octahedral encoded, two components
+	constexpr GLuint COLOR_ATTRIB    = 2;
+	constexpr GLuint TEXCOORD_ATTRIB = 3;
+
+	// Per-instance model matrix, one vec4 column per attribute location (4 to 7),
+	// followed by the position dequantization of the mesh and the material index
+	constexpr GLuint INSTANCE_MATRIX_ATTRIB          = 4;
+	constexpr GLuint INSTANCE_POSITION_OFFSET_ATTRIB = 8;
+	constexpr GLuint INSTANCE_POSITION_SCALE_ATTRIB  = 9;
+	constexpr GLuint INSTANCE_MATERIAL_ATTRIB        = 10;
+	constexpr GLuint INSTANCE_BUFFER_BINDING         = 2;
+
+	// Per-instance data read by the vertex shader, position = offset + vertex * scale
+	struct InstanceData {
+
+		glm::mat4 model{ 1.0f };
+		glm::vec4 position_offset{ 0.0f };
+		glm::vec4 position_scale{ 1.0f };
+		uint32_t material = 0;				// Index into the material table
+		uint32_t padding[3]{};
+	};
 	
 	// Helpful container to store per mesh data, extendable
 	struct MeshData {
@@ -24,6 +48,14 @@ namespace gam300 {
 		std::vector<uint32_t>  indices;
 	};
 
+	// Object-space bounding volumes of a mesh, both centered on the box center
+	struct MeshBounds {
+
+		glm::vec3 center{ 0.0f };
+		glm::vec3 extents{ 0.0f };	// Half size of the box
+		float     radius = 0.0f;	// Bounding sphere radius
+	};
+
 	struct MeshGL {
 
 		VAO vao{};
@@ -32,6 +64,12 @@ namespace gam300 {
 
 		GLsizei draw_count = 0;
 
+		MeshBounds bounds{};
+
+		// Position dequantization, the identity for unquantized layouts
+		glm::vec4 position_offset{ 0.0f };
+		glm::vec4 position_scale{ 1.0f };
+
 		GLenum  primitive_type = GL_TRIANGLES;
 		GLenum  index_type     = GL_UNSIGNED_INT;
 
@@ -0,0 +1,243 @@
+/**
+ * @file MeshPool.cpp
+ * @brief Implementation of the mesh pool and its range allocator.
+ * @details Contains implementations for all member functions declared in MeshPool.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Graphics/MeshPool.h"
+#include "../Graphics/Shape.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace gam300 {
+
+#pragma region RangeAllocator
+	RangeAllocator::RangeAllocator(u32 capacity) : total(capacity), available(capacity) {
+		if (capacity > 0) {
+			free_ranges.push_back({ 0, capacity });
+		}
+	}
+
+	std::optional<u32> RangeAllocator::allocate(u32 size, u32 alignment) {
+		if (size == 0 || alignment == 0) {
+			return std::nullopt;
+		}
+
+		for (std::size_t i = 0; i < free_ranges.size(); ++i) {
+			Range& range = free_ranges[i];
+			const u32 offset = (range.offset + alignment - 1) / alignment * alignment;
+			const u32 padding = offset - range.offset;
+			if (range.size < padding || range.size - padding < size) {
+				continue;
+			}
+
+			const u32 remaining = range.size - padding - size;
+			if (padding == 0) {
+				range.offset += size;
+				range.size = remaining;
+				if (range.size == 0) {
+					free_ranges.erase(free_ranges.begin() + static_cast<std::ptrdiff_t>(i));
+				}
+			}
+			else {
+				// The padding stays free in front, whatever is left goes after it
+				range.size = padding;
+				if (remaining > 0) {
+					free_ranges.insert(free_ranges.begin() + static_cast<std::ptrdiff_t>(i + 1), { offset + size, remaining });
+				}
+			}
+			available -= size;
+			return offset;
+		}
+		return std::nullopt;
+	}
+
+	void RangeAllocator::free(u32 offset, u32 size) {
+		if (size == 0) {
+			return;
+		}
+
+		auto next = std::lower_bound(free_ranges.begin(), free_ranges.end(), offset,
+			[](const Range& range, u32 value) { return range.offset < value; });
+		auto inserted = free_ranges.insert(next, { offset, size });
+		available += size;
+
+		// Merge with the following range, then with the previous one
+		auto after = inserted + 1;
+		if (after != free_ranges.end() && inserted->offset + inserted->size == after->offset) {
+			inserted->size += after->size;
+			free_ranges.erase(after);
+		}
+		if (inserted != free_ranges.begin()) {
+			auto before = inserted - 1;
+			if (before->offset + before->size == inserted->offset) {
+				before->size += inserted->size;
+				free_ranges.erase(inserted);
+			}
+		}
+	}
+#pragma endregion
+
+#pragma region MeshPool
+	void MeshPool::create(u32 max_vertices, u32 max_indices, VertexFormat vertex_format) {
+		const VertexLayout& layout = VertexLayout::get(vertex_format);
+		format = vertex_format;
+		stride = layout.stride;
+
+		meshes.clear();
+		vertex_allocator = RangeAllocator(max_vertices);
+		index_allocator = RangeAllocator(max_indices);
+
+		// Immutable storage, meshes are copied in with glNamedBufferSubData
+		vertex_buffer.create();
+		vertex_buffer.storage(static_cast<GLsizeiptr>(stride) * max_vertices, nullptr, GL_DYNAMIC_STORAGE_BIT);
+		index_buffer.create();
+		index_buffer.storage(static_cast<GLsizeiptr>(sizeof(u16)) * max_indices, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		// One VAO for every mesh of the pool, the instance buffer is bound by the render backend
+		vao.create();
+		vao.bind_vertex_buffer(0, vertex_buffer, 0, stride);
+		layout.apply(vao, 0);
+		apply_instance_layout(vao);
+
+		vao.bind_element_buffer(index_buffer);
+
+		LM.writeLog("MeshPool::create() - Pool created for %u vertices of %d bytes and %u 16-bit indices", max_vertices, stride, max_indices);
+	}
+
+	void MeshPool::destroy() {
+		meshes.clear();
+		vertex_allocator = RangeAllocator();
+		index_allocator = RangeAllocator();
+		vao = VAO();
+		vertex_buffer = VBO();
+		index_buffer = VBO();
+	}
+
+	bool MeshPool::place(const u8* vertices, u32 vertex_count, const u8* indices, u32 index_count, GLenum index_type, PoolMesh& entry) {
+		// 16-bit units, a 32-bit index takes two and must start on a 4-byte boundary
+		const u32 units_per_index = static_cast<u32>(index_size(index_type) / sizeof(u16));
+		const u32 index_units = index_count * units_per_index;
+
+		std::optional<u32> vertex_offset = vertex_allocator.allocate(vertex_count);
+		std::optional<u32> index_offset = vertex_offset ? index_allocator.allocate(index_units, units_per_index) : std::nullopt;
+		if (!vertex_offset || !index_offset) {
+			if (vertex_offset) {
+				vertex_allocator.free(*vertex_offset, vertex_count);
+			}
+			LM.writeLog("MeshPool::add() - Pool is full, cannot fit %u vertices and %u indices", vertex_count, index_count);
+			return false;
+		}
+
+		vertex_buffer.sub_data(static_cast<GLintptr>(stride) * *vertex_offset,
+			static_cast<GLsizeiptr>(stride) * vertex_count, vertices);
+		index_buffer.sub_data(static_cast<GLintptr>(sizeof(u16)) * *index_offset,
+			static_cast<GLsizeiptr>(sizeof(u16)) * index_units, indices);
+
+		entry.vertex_offset = *vertex_offset;
+		entry.vertex_count = vertex_count;
+		entry.index_offset = *index_offset / units_per_index;
+		entry.index_count = index_count;
+		entry.index_type = index_type;
+		return true;
+	}
+
+	std::optional<u32> MeshPool::add(const MeshData& mesh) {
+		const u32 vertex_count = static_cast<u32>(mesh.positions.size());
+		const u32 index_count = static_cast<u32>(mesh.indices.size());
+		if (vertex_count == 0 || index_count == 0) {
+			LM.writeLog("MeshPool::add() - Mesh has no vertices or indices");
+			return std::nullopt;
+		}
+
+		PackedMesh packed = pack_mesh(mesh, format);
+
+		PoolMesh entry;
+		if (!place(packed.vertices.data(), vertex_count, packed.indices.data(), index_count, packed.index_type, entry)) {
+			return std::nullopt;
+		}
+		entry.bounds = Shape::compute_bounds(mesh);
+		entry.position_offset = packed.position_offset;
+		entry.position_scale = packed.position_scale;
+		entry.lods[0] = { entry.index_offset, index_count, 0.0f };
+		entry.lod_count = 1;
+		entry.alive = true;
+		meshes.push_back(entry);
+
+		return static_cast<u32>(meshes.size() - 1);
+	}
+
+	std::optional<u32> MeshPool::add(const MeshBlob& blob) {
+		if (!blob.isLoaded()) {
+			LM.writeLog("MeshPool::add() - Mesh blob is not loaded");
+			return std::nullopt;
+		}
+
+		const MeshBlobHeader& header = blob.getHeader();
+		if (header.vertexFormat != static_cast<u32>(format) || header.vertexStride != static_cast<u32>(stride)) {
+			LM.writeLog("MeshPool::add() - Mesh blob vertex format %u does not match the pool format %u",
+				header.vertexFormat, static_cast<u32>(format));
+			return std::nullopt;
+		}
+		if (header.vertexCount == 0 || header.indexCount == 0 || header.lodCount == 0) {
+			LM.writeLog("MeshPool::add() - Mesh blob has no vertices, indices or LODs");
+			return std::nullopt;
+		}
+
+		const GLenum index_type = header.indexSize == sizeof(u16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+		PoolMesh entry;
+		if (!place(blob.getVertices(), header.vertexCount, blob.getIndices(), header.indexCount, index_type, entry)) {
+			return std::nullopt;
+		}
+		entry.bounds.center = glm::vec3(header.boundsCenter[0], header.boundsCenter[1], header.boundsCenter[2]);
+		entry.bounds.extents = glm::vec3(header.boundsExtents[0], header.boundsExtents[1], header.boundsExtents[2]);
+		entry.bounds.radius = header.boundsRadius;
+		entry.position_offset = glm::vec4(header.positionOffset[0], header.positionOffset[1], header.positionOffset[2], header.positionOffset[3]);
+		entry.position_scale = glm::vec4(header.positionScale[0], header.positionScale[1], header.positionScale[2], header.positionScale[3]);
+
+		// LOD ranges are relative to the blob index section, move them to the pool range
+		entry.lod_count = std::min(header.lodCount, MAX_MESH_LODS);
+		for (u32 i = 0; i < entry.lod_count; ++i) {
+			const MeshBlobLod& lod = blob.getLods()[i];
+			entry.lods[i] = { entry.index_offset + lod.firstIndex, lod.indexCount, lod.error };
+		}
+		entry.alive = true;
+		meshes.push_back(entry);
+
+		return static_cast<u32>(meshes.size() - 1);
+	}
+
+	void MeshPool::remove(u32 mesh_id) {
+		if (!valid(mesh_id)) {
+			return;
+		}
+
+		PoolMesh& entry = meshes[mesh_id];
+		vertex_allocator.free(entry.vertex_offset, entry.vertex_count);
+		const u32 units_per_index = static_cast<u32>(index_size(entry.index_type) / sizeof(u16));
+		index_allocator.free(entry.index_offset * units_per_index, entry.index_count * units_per_index);
+		entry.alive = false;
+	}
+
+	DrawElementsIndirectCommand MeshPool::make_command(u32 mesh_id, u32 instance_count, u32 base_instance, u32 lod) const {
+		const PoolMesh& entry = meshes[mesh_id];
+		const MeshLod& range = entry.lods[std::min(lod, entry.lod_count - 1)];
+
+		DrawElementsIndirectCommand command;
+		command.count = range.index_count;
+		command.instance_count = instance_count;
+		command.first_index = range.first_index;
+		command.base_vertex = static_cast<GLint>(entry.vertex_offset);
+		command.base_instance = base_instance;
+		return command;
+	}
+#pragma endregion
+}
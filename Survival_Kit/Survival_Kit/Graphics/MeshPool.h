@@ -0,0 +1,182 @@
+/**
+ * @file MeshPool.h
+ * @brief Declaration of the mesh pool that packs static meshes into shared buffers.
+ * @details Every mesh of a vertex format lives in one vertex buffer and one index
+ *          buffer behind one VAO, so different meshes can be drawn without rebinding
+ *          and a whole pass can go out as a single glMultiDrawElementsIndirect.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __MESH_POOL_H__
+#define __MESH_POOL_H__
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/GLResources.h"
+#include "../Graphics/MeshData.h"
+#include "../Graphics/VertexLayout.h"
+#include "../Resource/MeshBlob.h"
+
+namespace gam300 {
+
+	/**
+	 * @brief Free-list allocator over a range of elements.
+	 * @details First fit, freed ranges are merged with their neighbours.
+	 */
+	class RangeAllocator {
+	public:
+		explicit RangeAllocator(u32 capacity = 0);
+
+		/**
+		 * @brief Reserve size contiguous elements.
+		 * @param alignment The offset returned is a multiple of it, the skipped elements stay free.
+		 * @return Offset of the first element, nullopt if no free range is large enough.
+		 */
+		std::optional<u32> allocate(u32 size, u32 alignment = 1);
+
+		/**
+		 * @brief Give back a range returned by allocate.
+		 */
+		void free(u32 offset, u32 size);
+
+		u32 capacity() const { return total; }
+		u32 used() const { return total - available; }
+
+	private:
+		struct Range {
+			u32 offset;
+			u32 size;
+		};
+
+		std::vector<Range> free_ranges;     // Sorted by offset, never touching
+		u32 total = 0;
+		u32 available = 0;
+	};
+
+	constexpr u32 MAX_MESH_LODS = 8;	// Levels past this in a cooked mesh are dropped
+
+	/**
+	 * @brief Index range of one level of detail of a pool mesh.
+	 */
+	struct MeshLod {
+		u32   first_index = 0;     // In indices of the mesh index_type, like PoolMesh::index_offset
+		u32   index_count = 0;
+		float error = 0.0f;        // Simplification error relative to the mesh extent, 0 for LOD 0
+	};
+
+	/**
+	 * @brief Where a mesh lives inside the pool buffers.
+	 */
+	struct PoolMesh {
+		u32        vertex_offset = 0;      // First vertex, used as the base vertex
+		u32        vertex_count = 0;
+		u32        index_offset = 0;       // First index, in indices of index_type
+		u32        index_count = 0;        // Every LOD together
+		GLenum     index_type = GL_UNSIGNED_SHORT;
+		MeshBounds bounds{};
+		glm::vec4  position_offset{ 0.0f }; // Dequantization of the positions
+		glm::vec4  position_scale{ 1.0f };
+		std::array<MeshLod, MAX_MESH_LODS> lods{};  // Finest first, they share the vertices
+		u32        lod_count = 1;
+		bool       alive = false;
+	};
+
+	/**
+	 * @brief Matches the layout glMultiDrawElementsIndirect reads.
+	 */
+	struct DrawElementsIndirectCommand {
+		GLuint count = 0;
+		GLuint instance_count = 0;
+		GLuint first_index = 0;
+		GLint  base_vertex = 0;
+		GLuint base_instance = 0;
+	};
+
+	static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand must be tightly packed");
+
+	/**
+	 * @brief Pool of static meshes sharing one vertex format.
+	 * @details Vertices are interleaved in the pool layout, the same one
+	 *          Shape::upload_mesh_data sets up. Indices are relative to the mesh, the
+	 *          base vertex of the draw offsets them. Each mesh keeps 16-bit indices
+	 *          when it can, so the index buffer is allocated in 16-bit units and
+	 *          32-bit meshes take two aligned units per index.
+	 */
+	class MeshPool {
+	public:
+
+		MeshPool() = default;
+		MeshPool(const MeshPool&) = delete;
+		MeshPool& operator=(const MeshPool&) = delete;
+
+		/**
+		 * @brief Create the buffers and the shared VAO.
+		 * @param max_vertices Capacity of the vertex buffer.
+		 * @param max_indices Capacity of the index buffer, in 16-bit indices.
+		 * @param format Vertex layout of every mesh in the pool.
+		 */
+		void create(u32 max_vertices, u32 max_indices, VertexFormat format = VertexFormat::QUANTIZED);
+
+		/**
+		 * @brief Release the buffers and forget every mesh.
+		 */
+		void destroy();
+
+		/**
+		 * @brief Copy a mesh into the pool.
+		 * @return Id of the mesh, nullopt if the pool is full or the mesh is empty.
+		 */
+		std::optional<u32> add(const MeshData& mesh);
+
+		/**
+		 * @brief Copy a cooked mesh into the pool, with its LOD chain.
+		 * @details The blob is already packed, so its vertex format must be the one of the pool.
+		 * @return Id of the mesh, nullopt if the pool is full or the blob does not fit the pool.
+		 */
+		std::optional<u32> add(const MeshBlob& blob);
+
+		/**
+		 * @brief Free the space of a mesh, its id is not reused.
+		 */
+		void remove(u32 mesh_id);
+
+		bool valid(u32 mesh_id) const { return mesh_id < meshes.size() && meshes[mesh_id].alive; }
+		const PoolMesh& get(u32 mesh_id) const { return meshes[mesh_id]; }
+		std::size_t size() const { return meshes.size(); }
+
+		const VAO& vertex_array() const { return vao; }
+		VertexFormat vertex_format() const { return format; }
+
+		/**
+		 * @brief Indirect command drawing instance_count instances of a mesh.
+		 * @param lod Level of detail, clamped to the levels of the mesh.
+		 */
+		DrawElementsIndirectCommand make_command(u32 mesh_id, u32 instance_count, u32 base_instance, u32 lod = 0) const;
+
+	private:
+
+		// Allocate and upload packed vertices and indices, fills in the placement of entry
+		bool place(const u8* vertices, u32 vertex_count, const u8* indices, u32 index_count, GLenum index_type, PoolMesh& entry);
+
+		VBO vertex_buffer;
+		VBO index_buffer;
+		VAO vao;
+
+		RangeAllocator vertex_allocator;
+		RangeAllocator index_allocator;
+
+		VertexFormat format = VertexFormat::QUANTIZED;
+		GLsizei stride = 0;
+
+		std::vector<PoolMesh> meshes;
+	};
+}
+
+#endif // !__MESH_POOL_H__
@@ -0,0 +1,478 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of the render queue and its backends.
+ * @details Contains implementations for all member functions declared in RenderQueue.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Graphics/RenderQueue.h"
+#include "../Graphics/MeshData.h"
+#include "../Graphics/GLStateTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+namespace gam300 {
+
+#pragma region RenderQueue
+	u64 RenderQueue::make_key(RenderPass pass, u32 shader, u32 material, u32 mesh, u32 depth) {
+		const u64 pass_bits     = static_cast<u64>(pass) & ((1ull << PASS_BITS) - 1);
+		const u64 shader_bits   = static_cast<u64>(shader) & ((1ull << SHADER_BITS) - 1);
+		const u64 material_bits = static_cast<u64>(material) & ((1ull << MATERIAL_BITS) - 1);
+		const u64 mesh_bits     = static_cast<u64>(mesh) & ((1ull << MESH_BITS) - 1);
+		const u64 depth_bits    = static_cast<u64>(depth) & ((1ull << DEPTH_BITS) - 1);
+
+		if (pass == RenderPass::TRANSLUCENT) {
+			// Far to near first: inverted depth | shader | material | mesh
+			const u64 inverted_depth = ((1ull << DEPTH_BITS) - 1) - depth_bits;
+			return (pass_bits << PASS_SHIFT)
+				| (inverted_depth << (PASS_SHIFT - DEPTH_BITS))
+				| (shader_bits << (PASS_SHIFT - DEPTH_BITS - SHADER_BITS))
+				| (material_bits << MESH_BITS)
+				| mesh_bits;
+		}
+
+		return (pass_bits << PASS_SHIFT)
+			| (shader_bits << SHADER_SHIFT)
+			| (material_bits << MATERIAL_SHIFT)
+			| (mesh_bits << MESH_SHIFT)
+			| (depth_bits << DEPTH_SHIFT);
+	}
+
+	u32 RenderQueue::depth_bucket(float distance, float far_plane) {
+		if (!(distance > 0.0f) || far_plane <= 0.0f) {
+			return 0;
+		}
+		const float max_bucket = static_cast<float>((1u << DEPTH_BITS) - 1);
+		return static_cast<u32>(std::min(distance / far_plane, 1.0f) * max_bucket);
+	}
+
+	void RenderQueue::clear() {
+		items.clear();
+		instances.clear();
+		order.clear();
+	}
+
+	void RenderQueue::push(const DrawItem& item, const InstanceData& instance) {
+		items.push_back(item);
+		items.back().instance = static_cast<u32>(instances.size());
+		instances.push_back(instance);
+	}
+
+	void RenderQueue::sort() {
+		const std::size_t count = items.size();
+		keys.resize(count);
+		keys_scratch.resize(count);
+		order.resize(count);
+		order_scratch.resize(count);
+
+		for (std::size_t i = 0; i < count; ++i) {
+			keys[i] = items[i].key;
+			order[i] = static_cast<u32>(i);
+		}
+
+		// LSD radix sort, one byte per pass. Queues are mostly a handful of distinct
+		// shaders and materials, so many bytes are the same for every key.
+		for (u32 shift = 0; shift < 64; shift += 8) {
+			u32 histogram[256] = {};
+			for (std::size_t i = 0; i < count; ++i) {
+				++histogram[(keys[i] >> shift) & 0xFF];
+			}
+
+			// Nothing to reorder when every key has the same digit
+			if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count) {
+				continue;
+			}
+
+			u32 offset = 0;
+			for (u32& bucket : histogram) {
+				u32 bucket_size = bucket;
+				bucket = offset;
+				offset += bucket_size;
+			}
+
+			for (std::size_t i = 0; i < count; ++i) {
+				u32 slot = histogram[(keys[i] >> shift) & 0xFF]++;
+				keys_scratch[slot] = keys[i];
+				order_scratch[slot] = order[i];
+			}
+
+			keys.swap(keys_scratch);
+			order.swap(order_scratch);
+		}
+	}
+
+	void RenderQueue::submit(RenderBackend& backend) {
+		if (items.empty()) {
+			return;
+		}
+
+		// Instance data in submission order, so every run is one contiguous range
+		sorted_instances.resize(order.size());
+		for (std::size_t i = 0; i < order.size(); ++i) {
+			sorted_instances[i] = instances[items[order[i]].instance];
+		}
+		backend.upload_instances(sorted_instances.data(), sorted_instances.size());
+
+		// One indirect command per run of the same mesh, and one batch per run of the
+		// same state, which becomes one multi draw
+		batches.clear();
+		commands.clear();
+
+		auto same_state = [](const DrawItem& a, const DrawItem& b) {
+			return a.program == b.program && a.vao == b.vao && a.texture == b.texture && a.sampler == b.sampler &&
+				a.blend == b.blend && a.primitive_type == b.primitive_type && a.index_type == b.index_type;
+		};
+		auto same_mesh = [](const DrawItem& a, const DrawItem& b) {
+			return a.index_count == b.index_count && a.first_index == b.first_index && a.base_vertex == b.base_vertex;
+		};
+
+		std::size_t run_begin = 0;
+		while (run_begin < order.size()) {
+			const DrawItem& item = items[order[run_begin]];
+
+			std::size_t run_end = run_begin + 1;
+			while (run_end < order.size() && same_state(items[order[run_end]], item) && same_mesh(items[order[run_end]], item)) {
+				++run_end;
+			}
+
+			if (batches.empty() || !same_state(items[order[batches.back().first_item]], item)) {
+				batches.push_back({ run_begin, static_cast<u32>(commands.size()), 0 });
+			}
+
+			DrawElementsIndirectCommand command;
+			command.count = static_cast<GLuint>(item.index_count);
+			command.instance_count = static_cast<GLuint>(run_end - run_begin);
+			command.first_index = item.first_index;
+			command.base_vertex = item.base_vertex;
+			command.base_instance = static_cast<GLuint>(run_begin);
+			commands.push_back(command);
+			++batches.back().command_count;
+
+			run_begin = run_end;
+		}
+		backend.upload_commands(commands.data(), commands.size());
+
+		// State the backend is in, nothing is assumed before the first batch
+		bool first = true;
+		GLuint current_program = 0;
+		GLuint current_vao = 0;
+		GLuint current_texture = 0;
+		GLuint current_sampler = 0;
+		BlendMode current_blend = BlendMode::NONE;
+
+		for (const Batch& batch : batches) {
+			const DrawItem& item = items[order[batch.first_item]];
+
+			if (first || item.program != current_program) {
+				backend.use_program(item.program);
+				current_program = item.program;
+			}
+			if (first || item.vao != current_vao) {
+				backend.bind_vertex_array(item.vao);
+				current_vao = item.vao;
+			}
+			if (first || item.texture != current_texture) {
+				backend.bind_texture(0, item.texture);
+				current_texture = item.texture;
+			}
+			if (first || item.sampler != current_sampler) {
+				backend.bind_sampler(0, item.sampler);
+				current_sampler = item.sampler;
+			}
+			if (first || item.blend != current_blend) {
+				backend.set_blend(item.blend);
+				current_blend = item.blend;
+			}
+			first = false;
+
+			backend.multi_draw_indirect(item.primitive_type, item.index_type, batch.first_command, batch.command_count);
+		}
+
+		// A sampler overrides the state of every texture on its unit, including the UI's
+		if (current_sampler != 0) {
+			backend.bind_sampler(0, 0);
+		}
+	}
+
+	bool RenderQueue::validate(std::string& report) {
+		std::ostringstream log;
+		bool ok = true;
+		auto check = [&](bool condition, const std::string& what) {
+			log << (condition ? "  ok    " : "  FAIL  ") << what << "\n";
+			ok = ok && condition;
+		};
+
+		// A frame's worth of items over a few shaders, materials and meshes, some translucent.
+		// The state of each item follows from its key, and instance i remembers item i.
+		constexpr u32 ITEMS = 20000;
+		constexpr u32 SHADERS = 2, MATERIALS = 4, MESHES = 8;
+		std::mt19937 rng(5u);
+		std::uniform_int_distribution<u32> pick(0, 0xFFFFu);
+		std::uniform_real_distribution<float> distance(0.0f, 120.0f);
+
+		RenderQueue queue;
+		for (u32 i = 0; i < ITEMS; ++i) {
+			const u32 shader = pick(rng) % SHADERS;
+			const u32 material = pick(rng) % MATERIALS;
+			const u32 mesh = pick(rng) % MESHES;
+			const bool translucent = pick(rng) % 10 == 0;
+
+			DrawItem item;
+			item.key = make_key(translucent ? RenderPass::TRANSLUCENT : RenderPass::SOLID, shader, material, mesh,
+				depth_bucket(distance(rng), 100.0f));
+			item.program = 10 + shader;
+			item.vao = 20 + mesh % 2;
+			item.texture = material != 0 ? 30 + material : 0;
+			item.sampler = material % 2 != 0 ? 40 : 0;
+			item.blend = translucent ? BlendMode::ALPHA : BlendMode::NONE;
+			item.index_count = 36 * (mesh + 1);
+			item.first_index = 1000 * mesh;
+			item.base_vertex = static_cast<i32>(500 * mesh);
+
+			InstanceData instance;
+			instance.material = i;
+			queue.push(item, instance);
+		}
+
+		RecordingRenderBackend backend;
+		const auto start = std::chrono::steady_clock::now();
+		queue.sort();
+		const auto sorted = std::chrono::steady_clock::now();
+		queue.submit(backend);
+		const auto submitted = std::chrono::steady_clock::now();
+
+		// Sorting
+		const std::vector<u32>& order = queue.sorted_order();
+		std::vector<u32> expected(ITEMS);
+		std::iota(expected.begin(), expected.end(), 0u);
+		std::stable_sort(expected.begin(), expected.end(), [&queue](u32 a, u32 b) { return queue.items[a].key < queue.items[b].key; });
+		check(order == expected, "radix sort matches a stable sort of the keys");
+
+		bool solid_first = true;
+		bool back_to_front = true;
+		for (std::size_t i = 1; i < order.size(); ++i) {
+			const DrawItem& previous = queue.items[order[i - 1]];
+			const DrawItem& current = queue.items[order[i]];
+			solid_first = solid_first && !(previous.blend == BlendMode::ALPHA && current.blend == BlendMode::NONE);
+			if (previous.blend == BlendMode::ALPHA && current.blend == BlendMode::ALPHA) {
+				// Translucent keys hold the inverted depth, which must not go down
+				back_to_front = back_to_front && (previous.key >> (PASS_SHIFT - DEPTH_BITS)) <= (current.key >> (PASS_SHIFT - DEPTH_BITS));
+			}
+		}
+		check(solid_first, "solid items come before translucent ones");
+		check(back_to_front, "translucent items are ordered back to front");
+
+		// Submission: replay the recording and follow the state it leaves behind
+		GLuint program = 0, vao = 0, texture = 0, sampler = 0;
+		BlendMode blend = BlendMode::NONE;
+		bool state_set = false;
+		u32 redundant = 0;
+		u32 drawn = 0;
+		bool draw_order = true, draw_state = true, draw_mesh = true;
+		for (const RecordingRenderBackend::Command& command : backend.commands) {
+			switch (command.type) {
+			case RecordingRenderBackend::CommandType::USE_PROGRAM:
+				redundant += state_set && command.a == program ? 1 : 0;
+				program = command.a;
+				break;
+			case RecordingRenderBackend::CommandType::BIND_VERTEX_ARRAY:
+				redundant += state_set && command.a == vao ? 1 : 0;
+				vao = command.a;
+				break;
+			case RecordingRenderBackend::CommandType::BIND_TEXTURE:
+				redundant += state_set && command.b == texture ? 1 : 0;
+				texture = command.b;
+				break;
+			case RecordingRenderBackend::CommandType::BIND_SAMPLER:
+				redundant += state_set && command.b == sampler ? 1 : 0;
+				sampler = command.b;
+				break;
+			case RecordingRenderBackend::CommandType::SET_BLEND:
+				redundant += state_set && static_cast<BlendMode>(command.a) == blend ? 1 : 0;
+				blend = static_cast<BlendMode>(command.a);
+				break;
+			case RecordingRenderBackend::CommandType::MULTI_DRAW:
+				state_set = true;
+				for (u32 c = command.a; c < command.a + command.b && c < backend.draws.size(); ++c) {
+					const DrawElementsIndirectCommand& draw = backend.draws[c];
+					for (u32 instance = 0; instance < draw.instance_count; ++instance) {
+						const u32 slot = draw.base_instance + instance;
+						if (slot != drawn || slot >= order.size() || slot >= backend.instances.size()) {
+							draw_order = false;
+							continue;
+						}
+						++drawn;
+
+						const DrawItem& item = queue.items[order[slot]];
+						draw_order = draw_order && backend.instances[slot].material == order[slot];
+						draw_state = draw_state && item.program == program && item.vao == vao && item.texture == texture &&
+							item.sampler == sampler && item.blend == blend;
+						draw_mesh = draw_mesh && static_cast<GLsizei>(draw.count) == item.index_count &&
+							draw.first_index == item.first_index && draw.base_vertex == item.base_vertex;
+					}
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		check(draw_order && drawn == ITEMS, "every item is drawn once, in sorted order, with its own instance data");
+		check(draw_state, "every item is drawn with its program, VAO, texture, sampler and blend mode");
+		check(draw_mesh, "every item is drawn with its index range");
+		check(redundant == 0, "no state is set to the value it already has");
+		check(sampler == 0, "unit 0 is left without a sampler");
+
+		const std::size_t state_changes = backend.count(RecordingRenderBackend::CommandType::USE_PROGRAM)
+			+ backend.count(RecordingRenderBackend::CommandType::BIND_VERTEX_ARRAY)
+			+ backend.count(RecordingRenderBackend::CommandType::BIND_TEXTURE)
+			+ backend.count(RecordingRenderBackend::CommandType::BIND_SAMPLER)
+			+ backend.count(RecordingRenderBackend::CommandType::SET_BLEND);
+		log << "  " << ITEMS << " items: " << backend.draws.size() << " indirect commands in "
+			<< backend.count(RecordingRenderBackend::CommandType::MULTI_DRAW) << " multi draws, " << state_changes << " state changes\n";
+		log << "  sort " << std::chrono::duration<double, std::milli>(sorted - start).count() << " ms, submit "
+			<< std::chrono::duration<double, std::milli>(submitted - sorted).count() << " ms\n";
+
+		report = log.str();
+		return ok;
+	}
+#pragma endregion
+
+#pragma region GLRenderBackend
+	void GLRenderBackend::upload_instances(const InstanceData* instances, std::size_t count) {
+		if (count == 0) {
+			return;
+		}
+
+		// Storage is immutable, so grow by recreating the buffer with room to spare
+		if (count > instance_capacity) {
+			std::size_t capacity = std::max<std::size_t>(instance_capacity * 2, 1024);
+			while (capacity < count) {
+				capacity *= 2;
+			}
+			instance_buffer.create();
+			instance_buffer.storage(static_cast<GLsizeiptr>(sizeof(InstanceData) * capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+			instance_capacity = capacity;
+		}
+
+		instance_buffer.sub_data(0, static_cast<GLsizeiptr>(sizeof(InstanceData) * count), instances);
+	}
+
+	void GLRenderBackend::use_program(GLuint program) {
+		GLS.use_program(program);
+	}
+
+	void GLRenderBackend::bind_vertex_array(GLuint vao) {
+		// The instance buffer may have been recreated since this VAO last used it
+		glVertexArrayVertexBuffer(vao, INSTANCE_BUFFER_BINDING, instance_buffer.id(), 0, sizeof(InstanceData));
+		GLS.bind_vertex_array(vao);
+	}
+
+	void GLRenderBackend::bind_texture(GLuint unit, GLuint texture) {
+		GLS.bind_texture(unit, texture);
+	}
+
+	void GLRenderBackend::bind_sampler(GLuint unit, GLuint sampler) {
+		GLS.bind_sampler(unit, sampler);
+	}
+
+	void GLRenderBackend::set_blend(BlendMode blend) {
+		switch (blend) {
+		case BlendMode::NONE:
+			GLS.set_enabled(GL_BLEND, false);
+			break;
+		case BlendMode::ALPHA:
+			GLS.set_enabled(GL_BLEND, true);
+			GLS.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			break;
+		case BlendMode::ADDITIVE:
+			GLS.set_enabled(GL_BLEND, true);
+			GLS.blend_func(GL_ONE, GL_ONE);
+			break;
+		}
+	}
+
+	void GLRenderBackend::upload_commands(const DrawElementsIndirectCommand* commands, std::size_t count) {
+		if (count == 0) {
+			return;
+		}
+
+		if (count > command_capacity) {
+			std::size_t capacity = std::max<std::size_t>(command_capacity * 2, 256);
+			while (capacity < count) {
+				capacity *= 2;
+			}
+			command_buffer.create();
+			command_buffer.storage(static_cast<GLsizeiptr>(sizeof(DrawElementsIndirectCommand) * capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+			command_capacity = capacity;
+		}
+
+		command_buffer.sub_data(0, static_cast<GLsizeiptr>(sizeof(DrawElementsIndirectCommand) * count), commands);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer.id());
+	}
+
+	void GLRenderBackend::multi_draw_indirect(GLenum primitive_type, GLenum index_type, u32 first_command, u32 command_count) {
+		const GLintptr offset = static_cast<GLintptr>(sizeof(DrawElementsIndirectCommand)) * first_command;
+		glMultiDrawElementsIndirect(primitive_type, index_type, reinterpret_cast<const void*>(offset),
+			static_cast<GLsizei>(command_count), 0);
+	}
+
+	void GLRenderBackend::release() {
+		instance_buffer = VBO();
+		instance_capacity = 0;
+		command_buffer = VBO();
+		command_capacity = 0;
+	}
+#pragma endregion
+
+#pragma region RecordingRenderBackend
+	void RecordingRenderBackend::upload_instances(const InstanceData* uploaded, std::size_t count) {
+		instances.assign(uploaded, uploaded + count);
+		commands.push_back({ CommandType::UPLOAD_INSTANCES, static_cast<u32>(count) });
+	}
+
+	void RecordingRenderBackend::use_program(GLuint program) {
+		commands.push_back({ CommandType::USE_PROGRAM, program });
+	}
+
+	void RecordingRenderBackend::bind_vertex_array(GLuint vao) {
+		commands.push_back({ CommandType::BIND_VERTEX_ARRAY, vao });
+	}
+
+	void RecordingRenderBackend::bind_texture(GLuint unit, GLuint texture) {
+		commands.push_back({ CommandType::BIND_TEXTURE, unit, texture });
+	}
+
+	void RecordingRenderBackend::bind_sampler(GLuint unit, GLuint sampler) {
+		commands.push_back({ CommandType::BIND_SAMPLER, unit, sampler });
+	}
+
+	void RecordingRenderBackend::set_blend(BlendMode blend) {
+		commands.push_back({ CommandType::SET_BLEND, static_cast<u32>(blend) });
+	}
+
+	void RecordingRenderBackend::upload_commands(const DrawElementsIndirectCommand* indirect, std::size_t count) {
+		draws.assign(indirect, indirect + count);
+		commands.push_back({ CommandType::UPLOAD_COMMANDS, static_cast<u32>(count) });
+	}
+
+	void RecordingRenderBackend::multi_draw_indirect(GLenum primitive_type, GLenum index_type, u32 first_command, u32 command_count) {
+		(void)primitive_type;
+		(void)index_type;
+		commands.push_back({ CommandType::MULTI_DRAW, first_command, command_count });
+	}
+
+	std::size_t RecordingRenderBackend::count(CommandType type) const {
+		return static_cast<std::size_t>(std::count_if(commands.begin(), commands.end(),
+			[type](const Command& command) { return command.type == type; }));
+	}
+#pragma endregion
+}
@@ -0,0 +1,257 @@
+/**
+ * @file RenderQueue.h
+ * @brief Declaration of the render queue and the backends it submits to.
+ * @details Systems push draw items with a packed 64-bit sort key, the queue radix sorts
+ *          them once per frame and submits them in key order. Runs of the same mesh
+ *          become one instanced indirect command, runs of the same state become one
+ *          glMultiDrawElementsIndirect, and state that is already set is skipped.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __RENDER_QUEUE_H__
+#define __RENDER_QUEUE_H__
+
+#include <string>
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/GLResources.h"
+#include "../Graphics/MeshPool.h"
+
+namespace gam300 {
+
+	// Passes in submission order, stored in the top bits of the sort key
+	enum class RenderPass : u8 {
+		SOLID = 0,          // Opaque geometry
+		TRANSLUCENT,        // Alpha blended, drawn back to front
+		OVERLAY
+	};
+
+	enum class BlendMode : u8 {
+		NONE = 0,
+		ALPHA,
+		ADDITIVE
+	};
+
+	/**
+	 * @brief One mesh to draw, plus the state it needs.
+	 * @details Neighbouring items in sorted order that use the same state and mesh are
+	 *          drawn together as instances, which keeps their order. Meshes from a
+	 *          MeshPool share a VAO and only differ in their index range.
+	 */
+	struct DrawItem {
+		u64       key = 0;                          // See RenderQueue::make_key
+		GLuint    program = 0;
+		GLuint    vao = 0;
+		GLuint    texture = 0;                      // Bound to unit 0, 0 for none
+		GLuint    sampler = 0;                      // Bound to unit 0, 0 samples with the texture's own state
+		BlendMode blend = BlendMode::NONE;
+		GLenum    primitive_type = GL_TRIANGLES;
+		GLenum    index_type = GL_UNSIGNED_INT;
+		GLsizei   index_count = 0;
+		u32       first_index = 0;                  // Index range of the mesh in the bound index buffer
+		i32       base_vertex = 0;
+		u32       instance = 0;                     // Index of the instance data, set by push
+	};
+
+	/**
+	 * @brief Receives the commands of a sorted queue.
+	 * @details The queue only calls a state function when the state actually changes.
+	 */
+	class RenderBackend {
+	public:
+		virtual ~RenderBackend() = default;
+
+		// Model matrix and dequantization of every instance, in draw order
+		virtual void upload_instances(const InstanceData* instances, std::size_t count) = 0;
+
+		// Indirect commands of the whole queue, drawn in ranges by multi_draw_indirect
+		virtual void upload_commands(const DrawElementsIndirectCommand* commands, std::size_t count) = 0;
+
+		virtual void use_program(GLuint program) = 0;
+		virtual void bind_vertex_array(GLuint vao) = 0;
+		virtual void bind_texture(GLuint unit, GLuint texture) = 0;
+		virtual void bind_sampler(GLuint unit, GLuint sampler) = 0;
+		virtual void set_blend(BlendMode blend) = 0;
+
+		// Draw command_count uploaded commands starting at first_command
+		virtual void multi_draw_indirect(GLenum primitive_type, GLenum index_type, u32 first_command, u32 command_count) = 0;
+	};
+
+	/**
+	 * @brief Backend that issues OpenGL calls.
+	 */
+	class GLRenderBackend : public RenderBackend {
+	public:
+		void upload_instances(const InstanceData* instances, std::size_t count) override;
+		void use_program(GLuint program) override;
+		void bind_vertex_array(GLuint vao) override;
+		void bind_texture(GLuint unit, GLuint texture) override;
+		void bind_sampler(GLuint unit, GLuint sampler) override;
+		void set_blend(BlendMode blend) override;
+		void upload_commands(const DrawElementsIndirectCommand* commands, std::size_t count) override;
+		void multi_draw_indirect(GLenum primitive_type, GLenum index_type, u32 first_command, u32 command_count) override;
+
+		/**
+		 * @brief Release the instance and command buffers.
+		 */
+		void release();
+
+	private:
+		VBO instance_buffer;
+		std::size_t instance_capacity = 0;     // Instances the buffer can hold
+		VBO command_buffer;
+		std::size_t command_capacity = 0;      // Commands the buffer can hold
+	};
+
+	/**
+	 * @brief Backend that records commands instead of drawing.
+	 * @details Lets sorting and submission run and be checked without a GL context.
+	 */
+	class RecordingRenderBackend : public RenderBackend {
+	public:
+		enum class CommandType : u8 {
+			UPLOAD_INSTANCES,
+			USE_PROGRAM,
+			BIND_VERTEX_ARRAY,
+			BIND_TEXTURE,
+			BIND_SAMPLER,
+			SET_BLEND,
+			UPLOAD_COMMANDS,
+			MULTI_DRAW
+		};
+
+		struct Command {
+			CommandType type;
+			u32 a = 0;      // Program, VAO, texture unit, blend mode, upload count or first command
+			u32 b = 0;      // Texture, sampler, or command count of a multi draw
+		};
+
+		void upload_instances(const InstanceData* instances, std::size_t count) override;
+		void use_program(GLuint program) override;
+		void bind_vertex_array(GLuint vao) override;
+		void bind_texture(GLuint unit, GLuint texture) override;
+		void bind_sampler(GLuint unit, GLuint sampler) override;
+		void set_blend(BlendMode blend) override;
+		void upload_commands(const DrawElementsIndirectCommand* commands, std::size_t count) override;
+		void multi_draw_indirect(GLenum primitive_type, GLenum index_type, u32 first_command, u32 command_count) override;
+
+		void clear() { commands.clear(); instances.clear(); draws.clear(); }
+
+		// Number of recorded commands of one type
+		std::size_t count(CommandType type) const;
+
+		std::vector<Command> commands;
+		std::vector<InstanceData> instances;
+		std::vector<DrawElementsIndirectCommand> draws;
+	};
+
+	/**
+	 * @brief Per-frame list of draw items sorted by key.
+	 */
+	class RenderQueue {
+	public:
+		// Sort key layout, from the most significant bit down
+		static constexpr u32 PASS_BITS     = 4;
+		static constexpr u32 SHADER_BITS   = 12;
+		static constexpr u32 MATERIAL_BITS = 12;
+		static constexpr u32 MESH_BITS     = 16;
+		static constexpr u32 DEPTH_BITS    = 20;
+
+		static constexpr u32 DEPTH_SHIFT    = 0;
+		static constexpr u32 MESH_SHIFT     = DEPTH_SHIFT + DEPTH_BITS;
+		static constexpr u32 MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+		static constexpr u32 SHADER_SHIFT   = MATERIAL_SHIFT + MATERIAL_BITS;
+		static constexpr u32 PASS_SHIFT     = SHADER_SHIFT + SHADER_BITS;
+
+		static_assert(PASS_SHIFT + PASS_BITS == 64, "Sort key must fill 64 bits");
+
+		/**
+		 * @brief Pack a sort key.
+		 * @details Solid and overlay items sort by state first and front to back within
+		 *          the same mesh. Translucent items must blend back to front, so for that
+		 *          pass the inverted depth comes right after the pass and state only
+		 *          breaks ties.
+		 * @param depth Depth bucket from depth_bucket().
+		 */
+		static u64 make_key(RenderPass pass, u32 shader, u32 material, u32 mesh, u32 depth);
+
+		/**
+		 * @brief Quantize a view distance into a depth bucket.
+		 * @param distance Distance from the camera.
+		 * @param far_plane Distance mapped to the last bucket, farther is clamped.
+		 */
+		static u32 depth_bucket(float distance, float far_plane);
+
+		/**
+		 * @brief Remove every item, keeps the memory.
+		 */
+		void clear();
+
+		/**
+		 * @brief Add an item to draw.
+		 * @param item The item, its key must be set.
+		 * @param instance Model matrix and position dequantization of the item.
+		 */
+		void push(const DrawItem& item, const InstanceData& instance);
+
+		/**
+		 * @brief Radix sort the items by key.
+		 * @details Stable, so items with the same key keep their push order. Byte
+		 *          passes where every key has the same digit are skipped.
+		 */
+		void sort();
+
+		/**
+		 * @brief Submit the sorted items as one multi draw per run of the same state.
+		 * @details Call sort() first. Unit 0 is left without a sampler.
+		 */
+		void submit(RenderBackend& backend);
+
+		std::size_t size() const { return items.size(); }
+		bool empty() const { return items.empty(); }
+
+		// Sorted order of the items, valid after sort()
+		const std::vector<u32>& sorted_order() const { return order; }
+		const std::vector<DrawItem>& get_items() const { return items; }
+
+		/**
+		 * @brief Sort and submit a random queue into a RecordingRenderBackend and check it.
+		 * @details Checks the order against a stable sort of the keys, the pass and depth
+		 *          order the keys encode, that replaying the recording draws every item once
+		 *          in sorted order with its own state, and that no state is set twice. Needs
+		 *          no GL context, main runs it with --validate-render-queue.
+		 * @param report Receives one line per check and the sort and submit timings.
+		 * @return True if every check passed.
+		 */
+		static bool validate(std::string& report);
+
+	private:
+		std::vector<DrawItem>  items;
+		std::vector<InstanceData> instances;        // Indexed by DrawItem::instance
+
+		// Radix sort buffers
+		std::vector<u64> keys;
+		std::vector<u64> keys_scratch;
+		std::vector<u32> order;
+		std::vector<u32> order_scratch;
+
+		std::vector<InstanceData> sorted_instances; // Instances in submission order
+		std::vector<DrawElementsIndirectCommand> commands;
+
+		// Commands [first_command, first_command + command_count) share the state of first_item
+		struct Batch {
+			std::size_t first_item;
+			u32 first_command;
+			u32 command_count;
+		};
+		std::vector<Batch> batches;
+	};
+}
+
+#endif // !__RENDER_QUEUE_H__
@@ -0,0 +1,150 @@
+/**
+ * @file RenderTargetPool.cpp
+ * @brief Implementation of the pool of transient render targets.
+ * @details Contains implementations for all member functions declared in RenderTargetPool.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "RenderTargetPool.h"
+#include "GLStateTracker.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+
+namespace gam300 {
+
+	RenderTargetPool::~RenderTargetPool() {
+		clear();
+	}
+
+	GLuint RenderTargetPool::acquire(const RenderTargetDesc& desc) {
+		if (desc.width == 0 || desc.height == 0 || desc.samples == 0) {
+			LM.writeLog("RenderTargetPool::acquire() - Cannot create a %ux%u target with %u samples",
+				desc.width, desc.height, desc.samples);
+			return 0;
+		}
+
+		// The free match used most recently, so a pass acquiring the same desc every frame
+		// keeps getting the same texture and its framebuffer does not have to change
+		Target* found = nullptr;
+		for (Target& target : targets) {
+			if (!target.in_use && target.desc == desc && (!found || target.last_used > found->last_used)) {
+				found = &target;
+			}
+		}
+		if (found) {
+			found->in_use = true;
+			found->last_used = frame;
+			++stats.in_use;
+			++stats.reuses;
+			return found->texture;
+		}
+
+		Target target;
+		target.desc = desc;
+		const GLsizei width = static_cast<GLsizei>(desc.width);
+		const GLsizei height = static_cast<GLsizei>(desc.height);
+		if (desc.samples > 1) {
+			glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &target.texture);
+			glTextureStorage2DMultisample(target.texture, static_cast<GLsizei>(desc.samples), desc.format, width, height, GL_TRUE);
+		}
+		else {
+			glCreateTextures(GL_TEXTURE_2D, 1, &target.texture);
+			glTextureStorage2D(target.texture, 1, desc.format, width, height);
+		}
+		if (glGetError() != GL_NO_ERROR) {
+			LM.writeLog("RenderTargetPool::acquire() - Failed to allocate a %ux%u target of format 0x%x",
+				desc.width, desc.height, desc.format);
+			glDeleteTextures(1, &target.texture);
+			return 0;
+		}
+
+		if (desc.samples == 1) {
+			glTextureParameteri(target.texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTextureParameteri(target.texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(target.texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(target.texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+
+		target.in_use = true;
+		target.last_used = frame;
+		targets.push_back(target);
+		++stats.targets;
+		++stats.in_use;
+		++stats.allocations;
+		stats.bytes += size_in_bytes(desc);
+		return target.texture;
+	}
+
+	void RenderTargetPool::release(GLuint texture) {
+		auto found = std::find_if(targets.begin(), targets.end(), [texture](const Target& target) {
+			return target.texture == texture;
+		});
+		if (found == targets.end() || !found->in_use) {
+			LM.writeLog("RenderTargetPool::release() - Texture %u was not acquired from the pool", texture);
+			return;
+		}
+		found->in_use = false;
+		--stats.in_use;
+	}
+
+	void RenderTargetPool::begin_frame() {
+		++frame;
+		for (auto it = targets.begin(); it != targets.end();) {
+			if (!it->in_use && frame - it->last_used > max_idle_frames) {
+				destroy(*it);
+				++stats.evictions;
+				it = targets.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+
+	void RenderTargetPool::clear() {
+		for (Target& target : targets) {
+			destroy(target);
+		}
+		targets.clear();
+		stats.in_use = 0;
+	}
+
+	void RenderTargetPool::destroy(Target& target) {
+		GLS.texture_deleted(target.texture);
+		glDeleteTextures(1, &target.texture);
+		target.texture = 0;
+		--stats.targets;
+		stats.bytes -= size_in_bytes(target.desc);
+	}
+
+	u64 RenderTargetPool::size_in_bytes(const RenderTargetDesc& desc) {
+		return static_cast<u64>(desc.width) * desc.height * desc.samples * bytes_per_texel(desc.format);
+	}
+
+	u32 RenderTargetPool::bytes_per_texel(GLenum format) {
+		switch (format) {
+		case GL_R8:
+			return 1;
+		case GL_RG8:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:
+			return 2;
+		case GL_RGBA16F:
+		case GL_RG32F:
+		case GL_DEPTH32F_STENCIL8:
+			return 8;
+		case GL_RGBA32F:
+			return 16;
+		default:
+			// RGBA8, R32F, R11F_G11F_B10F and the 24 and 32 bit depth formats, which
+			// drivers pad to 4 bytes
+			return 4;
+		}
+	}
+
+} // end of namespace gam300
@@ -0,0 +1,116 @@
+/**
+ * @file RenderTargetPool.h
+ * @brief Declaration of the pool of transient render targets.
+ * @details Hands out textures to render into by size, format and sample count, and keeps
+ *          them across frames so passes do not allocate every frame.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __RENDER_TARGET_POOL_H__
+#define __RENDER_TARGET_POOL_H__
+
+#include <vector>
+
+#include "../Graphics/Common.h"
+
+namespace gam300 {
+
+	struct RenderTargetDesc {
+		u32 width = 0;
+		u32 height = 0;
+		GLenum format = GL_RGBA8;       // Sized internal format
+		u32 samples = 1;                // Above 1 allocates a multisample texture
+
+		bool operator==(const RenderTargetDesc& other) const {
+			return width == other.width && height == other.height && format == other.format && samples == other.samples;
+		}
+		bool operator!=(const RenderTargetDesc& other) const { return !(*this == other); }
+	};
+
+	struct RenderTargetPoolStats {
+		u32 targets = 0;                // Textures the pool owns
+		u32 in_use = 0;                 // Acquired and not released yet
+		u32 allocations = 0;            // Textures created since the pool was created
+		u32 reuses = 0;                 // Acquires served by an existing texture
+		u32 evictions = 0;              // Textures deleted after sitting idle
+		u64 bytes = 0;                  // Estimated memory of the owned textures
+	};
+
+	/**
+	 * @brief Textures for passes to render into, reused across frames.
+	 * @details A texture is acquired for as long as a pass or its readers need it and then
+	 *          released back to the pool, where the next acquire with the same desc takes
+	 *          it again. Storage is immutable, so a new size or format always gets another
+	 *          texture. The ones left behind, for example at the old size after the
+	 *          viewport is resized, are deleted once they sit idle for a few frames.
+	 */
+	class RenderTargetPool {
+	public:
+		static constexpr u32 DEFAULT_IDLE_FRAMES = 3;
+
+		RenderTargetPool() = default;
+		~RenderTargetPool();
+
+		RenderTargetPool(const RenderTargetPool&) = delete;
+		RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+		/**
+		 * @brief Take a free texture matching the desc, or create one.
+		 * @details The texture is clamped and unfiltered, a sampler object can filter it.
+		 * @return The texture, 0 if the desc is empty or the storage could not be allocated.
+		 */
+		GLuint acquire(const RenderTargetDesc& desc);
+
+		/**
+		 * @brief Give a texture back, its contents are kept until someone acquires it.
+		 */
+		void release(GLuint texture);
+
+		/**
+		 * @brief Start a frame, deletes the free textures that went unused for too long.
+		 */
+		void begin_frame();
+
+		/**
+		 * @brief Delete every texture, including those still acquired.
+		 */
+		void clear();
+
+		// Frames a free texture survives without being acquired
+		void set_max_idle_frames(u32 frames) { max_idle_frames = frames; }
+
+		const RenderTargetPoolStats& get_stats() const { return stats; }
+
+		/**
+		 * @brief Estimated memory of a texture with the desc.
+		 */
+		static u64 size_in_bytes(const RenderTargetDesc& desc);
+
+		/**
+		 * @brief Estimated bytes per texel of a sized internal format, 4 for unknown ones.
+		 */
+		static u32 bytes_per_texel(GLenum format);
+
+	private:
+		struct Target {
+			RenderTargetDesc desc;
+			GLuint texture = 0;
+			bool in_use = false;
+			u64 last_used = 0;          // Frame it was last acquired in
+		};
+
+		// Delete the texture of a target, does not remove it from the list
+		void destroy(Target& target);
+
+		std::vector<Target> targets;
+		u64 frame = 0;
+		u32 max_idle_frames = DEFAULT_IDLE_FRAMES;
+		RenderTargetPoolStats stats;
+	};
+
+} // end of namespace gam300
+#endif // __RENDER_TARGET_POOL_H__
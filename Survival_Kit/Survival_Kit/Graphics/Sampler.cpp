@@ -1,4 +1,14 @@
 #include "../Graphics/Sampler.h"
+#include "../Graphics/GLStateTracker.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Core in GL 4.6 with the same values as GL_EXT_texture_filter_anisotropic, the loader targets 4.5
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
 
 namespace gam300 {
 
@@ -31,16 +41,29 @@ namespace gam300 {
 	}
 
 	void set_gl_anisotropy(GLuint s, u32 requested) {
-#ifdef GL_TEXTURE_MAX_ANISOTROPY_EXT
-		if (reqeusted > 1) {
-			GLfloat maxSupported = 1.0f;
-			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxSupported);
-			const GLfloat val = std::min(static_cast<GLfloat>(requested), maxSupported);
-			glSamplerParameterf(s, GL_TEXTURE_MAX_ANISOTROPY_EXT, val);
+		const u32 supported = Sampler::max_anisotropy();
+		if (requested > 1 && supported > 1) {
+			glSamplerParameterf(s, GL_TEXTURE_MAX_ANISOTROPY, static_cast<GLfloat>(std::min(requested, supported)));
+		}
 	}
-#else
-		(void)s, (void)requested;
-#endif
+
+	uint32_t Sampler::max_anisotropy() {
+		// Asked once, every desktop driver has the extension but the 4.5 core does not
+		static const u32 supported = [] {
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			for (GLint i = 0; i < count; ++i) {
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+				if (extension && (std::strcmp(extension, "GL_ARB_texture_filter_anisotropic") == 0 ||
+					std::strcmp(extension, "GL_EXT_texture_filter_anisotropic") == 0)) {
+					GLfloat max_supported = 1.0f;
+					glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &max_supported);
+					return static_cast<u32>(std::max(max_supported, 1.0f));
+				}
+			}
+			return 1u;
+		}();
+		return supported;
 	}
 
 	std::optional<Sampler> Sampler::create(const SamplerDesc& d) {
@@ -72,6 +95,7 @@ namespace gam300 {
 	void Sampler::destroy_gpu_sampler(uint64_t handle) {
 		if (handle == kInvalid) return;
 		const GLuint s = static_cast<GLuint>(handle);
+		GLS.sampler_deleted(s);
 		glDeleteSamplers(1, &s);
 	}
 }
\ No newline at end of file
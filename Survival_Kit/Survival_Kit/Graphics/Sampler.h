@@ -53,6 +53,9 @@ namespace gam300 {
         uint64_t handle() const noexcept { return m_handle; }
         bool     valid()  const noexcept { return m_handle != kInvalid; }
 
+        // Largest max_anisotropy that has an effect, 1 without anisotropic filtering
+        static uint32_t max_anisotropy();
+
     private:
         explicit Sampler(uint64_t h) noexcept : m_handle(h) {}
 
@@ -0,0 +1,79 @@
+/**
+ * @file SamplerCache.cpp
+ * @brief Implementation of the sampler cache.
+ * @details Contains implementations for all member functions declared in SamplerCache.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "SamplerCache.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+
+namespace gam300 {
+
+	u64 SamplerCache::make_key(const SamplerDesc& desc) {
+		const u32 anisotropy = std::clamp(desc.max_anisotropy, 1u, Sampler::max_anisotropy());
+
+		// Two bits per enum, the anisotropy above them
+		u64 key = static_cast<u64>(desc.wrap_u);
+		key |= static_cast<u64>(desc.wrap_v) << 2;
+		key |= static_cast<u64>(desc.wrap_w) << 4;
+		key |= static_cast<u64>(desc.min_filter) << 6;
+		key |= static_cast<u64>(desc.mag_filter) << 8;
+		key |= static_cast<u64>(desc.mip_filter) << 10;
+		key |= static_cast<u64>(anisotropy) << 12;
+		return key;
+	}
+
+	SamplerRef SamplerCache::get(const SamplerDesc& desc) {
+		const u64 key = make_key(desc);
+
+		auto found = samplers.find(key);
+		if (found != samplers.end()) {
+			if (SamplerRef sampler = found->second.lock()) {
+				++stats.hits;
+				return sampler;
+			}
+		}
+
+		std::optional<Sampler> created = Sampler::create(desc);
+		if (!created) {
+			LM.writeLog("SamplerCache::get() - Failed to create a sampler object");
+			return nullptr;
+		}
+		SamplerRef sampler = std::make_shared<const Sampler>(std::move(*created));
+		samplers[key] = sampler;
+		++stats.misses;
+
+		// Released samplers leave expired entries behind, cleared now and then
+		if (++misses_since_sweep >= 64) {
+			sweep();
+		}
+		return sampler;
+	}
+
+	void SamplerCache::clear() {
+		samplers.clear();
+		misses_since_sweep = 0;
+	}
+
+	SamplerCacheStats SamplerCache::get_stats() const {
+		SamplerCacheStats current = stats;
+		current.samplers = static_cast<u32>(std::count_if(samplers.begin(), samplers.end(),
+			[](const auto& entry) { return !entry.second.expired(); }));
+		return current;
+	}
+
+	void SamplerCache::sweep() {
+		for (auto it = samplers.begin(); it != samplers.end();) {
+			it = it->second.expired() ? samplers.erase(it) : std::next(it);
+		}
+		misses_since_sweep = 0;
+	}
+
+} // end of namespace gam300
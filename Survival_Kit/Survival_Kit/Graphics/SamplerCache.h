@@ -0,0 +1,78 @@
+/**
+ * @file SamplerCache.h
+ * @brief Declaration of the sampler cache.
+ * @details Hands out one shared GL sampler object per distinct SamplerDesc, so materials
+ *          with the same sampling rules share a sampler instead of each creating one.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __SAMPLER_CACHE_H__
+#define __SAMPLER_CACHE_H__
+
+#include <memory>
+#include <unordered_map>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/Sampler.h"
+
+namespace gam300 {
+
+	// Shared sampler, the GL object is deleted when the last reference is dropped
+	using SamplerRef = std::shared_ptr<const Sampler>;
+
+	struct SamplerCacheStats {
+		u32 samplers = 0;       // Live sampler objects
+		u64 hits = 0;           // Requests served by an existing sampler
+		u64 misses = 0;         // Requests that created a sampler
+	};
+
+	/**
+	 * @brief Sampler objects keyed by their description.
+	 * @details The cache only holds weak references, so it never keeps a sampler alive
+	 *          on its own. Descriptions that sample the same way, like anisotropy beyond
+	 *          what the driver supports, map to the same sampler.
+	 */
+	class SamplerCache {
+	public:
+		SamplerCache() = default;
+
+		SamplerCache(const SamplerCache&) = delete;
+		SamplerCache& operator=(const SamplerCache&) = delete;
+
+		/**
+		 * @brief Sampler for a description, created on first use.
+		 * @return The sampler, nullptr if it could not be created.
+		 */
+		SamplerRef get(const SamplerDesc& desc);
+
+		/**
+		 * @brief Forget every sampler, references already handed out stay valid.
+		 */
+		void clear();
+
+		/**
+		 * @brief Pack a description into the key of its sampler.
+		 * @details Anisotropy is clamped to what the driver supports first.
+		 */
+		static u64 make_key(const SamplerDesc& desc);
+
+		/**
+		 * @brief Counters since creation, with the samplers still referenced.
+		 */
+		SamplerCacheStats get_stats() const;
+
+	private:
+		// Drop entries whose sampler was released
+		void sweep();
+
+		std::unordered_map<u64, std::weak_ptr<const Sampler>> samplers;
+		u32 misses_since_sweep = 0;
+		SamplerCacheStats stats;
+	};
+
+} // end of namespace gam300
+#endif // __SAMPLER_CACHE_H__
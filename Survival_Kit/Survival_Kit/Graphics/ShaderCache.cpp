@@ -0,0 +1,151 @@
+/**
+ * @file ShaderCache.cpp
+ * @brief Implementation of the program binary cache.
+ * @details Contains implementations for all member functions declared in ShaderCache.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "ShaderCache.h"
+#include "../Utility/AssetPath.h"
+#include "../Manager/LogManager.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+
+namespace gam300 {
+
+    namespace {
+        constexpr u32 PROGRAM_BINARY_MAGIC = 0x42504B53;   // "SKPB"
+        constexpr u32 PROGRAM_BINARY_VERSION = 1;
+
+        // Start of every cache file, the binary follows
+        struct ProgramBinaryHeader {
+            u32 magic = PROGRAM_BINARY_MAGIC;
+            u32 version = PROGRAM_BINARY_VERSION;
+            u64 key = 0;            // Guards against a renamed or mixed up file
+            u32 format = 0;         // Format returned by glGetProgramBinary
+            u32 length = 0;         // Bytes of binary after the header
+        };
+
+        constexpr u64 FNV_OFFSET = 14695981039346656037ull;
+        constexpr u64 FNV_PRIME = 1099511628211ull;
+
+        u64 hashBytes(u64 hash, const void* data, std::size_t size) {
+            const u8* bytes = static_cast<const u8*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * FNV_PRIME;
+            }
+            return hash;
+        }
+
+        // Strings are hashed with their length so "ab" + "c" and "a" + "bc" differ
+        u64 hashString(u64 hash, std::string_view text) {
+            const u64 length = text.size();
+            hash = hashBytes(hash, &length, sizeof(length));
+            return hashBytes(hash, text.data(), text.size());
+        }
+
+        std::string_view glString(GLenum name) {
+            const GLubyte* text = glGetString(name);
+            return text ? std::string_view(reinterpret_cast<const char*>(text)) : std::string_view();
+        }
+    }
+
+    ShaderCacheStats ShaderCache::stats;
+
+    u64 ShaderCache::computeKey(const std::vector<std::pair<GLenum, std::string>>& sources, std::string_view defines) {
+        u64 hash = FNV_OFFSET;
+        hash = hashString(hash, glString(GL_VENDOR));
+        hash = hashString(hash, glString(GL_RENDERER));
+        hash = hashString(hash, glString(GL_VERSION));
+        hash = hashString(hash, defines);
+        for (const auto& source : sources) {
+            hash = hashBytes(hash, &source.first, sizeof(source.first));
+            hash = hashString(hash, source.second);
+        }
+        return hash;
+    }
+
+    bool ShaderCache::isSupported() {
+        GLint format_count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        return format_count > 0;
+    }
+
+    std::string ShaderCache::getFilePath(u64 key) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016" PRIx64 ".bin", key);
+        return getShaderCachePath() + "/" + name;
+    }
+
+    bool ShaderCache::load(u64 key, GLuint program) {
+        std::ifstream file(getFilePath(key), std::ios::binary);
+        ProgramBinaryHeader header;
+        if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION ||
+            header.key != key || header.length == 0) {
+            ++stats.misses;
+            return false;
+        }
+
+        std::vector<char> binary(header.length);
+        if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+            ++stats.misses;
+            return false;
+        }
+
+        // The driver decides if the binary still fits, it only tells through the link status
+        glProgramBinary(program, static_cast<GLenum>(header.format), binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint status = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status == GL_FALSE) {
+            LM.writeLog("ShaderCache::load() - Driver rejected binary %016" PRIx64 " (format 0x%X), recompiling", key, header.format);
+            ++stats.rejected;
+            ++stats.misses;
+            return false;
+        }
+
+        ++stats.hits;
+        return true;
+    }
+
+    bool ShaderCache::store(u64 key, GLuint program) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            LM.writeLog("ShaderCache::store() - Program %u has no retrievable binary", program);
+            return false;
+        }
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0) {
+            LM.writeLog("ShaderCache::store() - Failed to get the binary of program %u", program);
+            return false;
+        }
+
+        ProgramBinaryHeader header;
+        header.key = key;
+        header.format = static_cast<u32>(format);
+        header.length = static_cast<u32>(written);
+
+        const std::string path = getFilePath(key);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(binary.data(), written)) {
+            LM.writeLog("ShaderCache::store() - Failed to write %s", path.c_str());
+            return false;
+        }
+
+        ++stats.stored;
+        return true;
+    }
+
+} // end of namespace gam300
@@ -0,0 +1,83 @@
+/**
+ * @file ShaderCache.h
+ * @brief Declaration of the program binary cache.
+ * @details Linked programs are saved with glGetProgramBinary under Cache/Shaders and
+ *          loaded back with glProgramBinary, skipping compile and link on later runs.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __SHADER_CACHE_H__
+#define __SHADER_CACHE_H__
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../Graphics/Common.h"
+
+namespace gam300 {
+
+    // Counters since start up
+    struct ShaderCacheStats {
+        u32 hits = 0;       // Programs loaded from a binary
+        u32 misses = 0;     // Programs compiled from source
+        u32 rejected = 0;   // Binaries the driver refused, counted as misses too
+        u32 stored = 0;     // Binaries written
+    };
+
+    /**
+     * @brief Stores linked program binaries, one file per key.
+     * @details The key hashes every stage source, the defines and the vendor, renderer
+     *          and version strings of the driver, so editing a shader or updating the
+     *          driver simply misses. A driver can still refuse a binary it wrote
+     *          (format removed, different GPU), load then fails and the caller
+     *          compiles from source, which overwrites the stale file.
+     */
+    class ShaderCache {
+    public:
+
+        /**
+         * @brief Hash the sources of a program (FNV-1a, 64 bits).
+         * @param sources Stage type and source code of every shader.
+         * @param defines Text prepended to every stage, empty for none.
+         * @return The key, needs a current context for the driver strings.
+         */
+        static u64 computeKey(const std::vector<std::pair<GLenum, std::string>>& sources, std::string_view defines);
+
+        /**
+         * @brief Check if the driver supports at least one binary format.
+         */
+        static bool isSupported();
+
+        /**
+         * @brief Load a cached binary into a program.
+         * @return True if the program is linked from the binary, false on a miss or if
+         *         the driver refused the binary, the program must then be compiled.
+         */
+        static bool load(u64 key, GLuint program);
+
+        /**
+         * @brief Save the binary of a linked program.
+         * @details The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+         * @return True if the file was written.
+         */
+        static bool store(u64 key, GLuint program);
+
+        /**
+         * @brief File a key is stored in.
+         */
+        static std::string getFilePath(u64 key);
+
+        static const ShaderCacheStats& getStats() { return stats; }
+
+    private:
+        static ShaderCacheStats stats;
+    };
+
+} // end of namespace gam300
+#endif // __SHADER_CACHE_H__
@@ -10,44 +10,76 @@
  */
 
 #include "ShaderProgram.h"
+#include "GLStateTracker.h"
+
+#include <algorithm>
 
 namespace gam300 {
 
     // Create and compile shader files to shader program
-    GLboolean ShaderProgram::compileShader(std::vector<std::pair<GLenum, std::string>> shader_files) {
-        // Read each shader file details such as shader type and file path
+    GLboolean ShaderProgram::compileShader(std::vector<std::pair<GLenum, std::string>> shader_files, std::string_view defines) {
+        // Read every shader file first, the binary cache key covers all of them
+        std::vector<std::pair<GLenum, std::string>> sources;
+        std::vector<std::vector<std::string>> stage_files;
+        source_files.clear();
         for (auto& file : shader_files) {
-            // Check if file's state is good for reading
+            // Check if file's state is good for reading, includes are expanded on the way
             std::string shader_source;
-            if (!readShaderFile(file.second, shader_source)) {
+            std::vector<std::string> files;
+            const bool expanded = expandShaderFile(file.second, defines, files, shader_source);
+
+            // Kept even when a file is missing, so fixing it is seen as a change of this program
+            for (const std::string& included : files) {
+                if (std::find(source_files.begin(), source_files.end(), included) == source_files.end()) {
+                    source_files.push_back(included);
+                }
+            }
+            if (!expanded) {
                 LM.writeLog("ShaderProgram::compileShader: File %s has error.", file.second.c_str());
                 return GL_FALSE;
             }
             LM.writeLog("ShaderProgram::compileShader: File %s is good for reading.", file.second.c_str());
 
-            // Create shader program
-            if (program_handle <= 0) {
-                program_handle = glCreateProgram();
-                if (program_handle == 0) {
-                    LM.writeLog("ShaderProgram::compileShader: Cannot create program handle");
-                    return GL_FALSE;
-                }
-                LM.writeLog("ShaderProgram::compileShader: Program handle %u created", program_handle);
+            sources.emplace_back(file.first, std::move(shader_source));
+            stage_files.push_back(std::move(files));
+        }
+
+        // Create shader program
+        if (program_handle <= 0) {
+            program_handle = glCreateProgram();
+            if (program_handle == 0) {
+                LM.writeLog("ShaderProgram::compileShader: Cannot create program handle");
+                return GL_FALSE;
             }
+            LM.writeLog("ShaderProgram::compileShader: Program handle %u created", program_handle);
+        }
+
+        // A binary linked on an earlier run skips compiling and linking altogether
+        const bool use_cache = ShaderCache::isSupported();
+        const u64 cache_key = use_cache ? ShaderCache::computeKey(sources, defines) : 0;
+        if (link_status == GL_FALSE && use_cache && ShaderCache::load(cache_key, program_handle)) {
+            link_status = GL_TRUE;
+            LM.writeLog("ShaderProgram::compileShader: Program %u loaded from the binary cache.", program_handle);
+
+            reflectUniforms();
+        }
+
+        for (std::size_t i = 0; link_status == GL_FALSE && i < sources.size(); ++i) {
+            const std::string& file_path = shader_files[i].second;
 
             // Create shader object and load shader code with it
             GLuint shader_obj = 0;
-            if (file.first == GL_VERTEX_SHADER) {
+            if (sources[i].first == GL_VERTEX_SHADER) {
                 shader_obj = glCreateShader(GL_VERTEX_SHADER);
             }
-            else if (file.first == GL_FRAGMENT_SHADER) {
+            else if (sources[i].first == GL_FRAGMENT_SHADER) {
                 shader_obj = glCreateShader(GL_FRAGMENT_SHADER);
             }
             else {
                 LM.writeLog("ShaderProgram::compileShader: Invalid shader type.");
                 return GL_FALSE;
             }
-            const GLchar* shader_code[] = { shader_source.c_str() };
+            const GLchar* shader_code[] = { sources[i].second.c_str() };
             glShaderSource(shader_obj, 1, shader_code, NULL);
 
             // Compile and check if successful
@@ -55,27 +87,52 @@ namespace gam300 {
             GLint compile_status;
             glGetShaderiv(shader_obj, GL_COMPILE_STATUS, &compile_status);
             if (compile_status == GL_FALSE) {
-                LM.writeLog("ShaderProgram::compileShader: Shader from file %s compilation fail.", file.second.c_str());
-
+                LM.writeLog("ShaderProgram::compileShader: Shader from file %s compilation fail.", file_path.c_str());
+
+                // Errors read "file(line)", file being the index of the list below
+                GLint log_length = 0;
+                glGetShaderiv(shader_obj, GL_INFO_LOG_LENGTH, &log_length);
+                std::string info_log(static_cast<std::size_t>(std::max(log_length, 1)), '\0');
+                glGetShaderInfoLog(shader_obj, log_length, nullptr, info_log.data());
+                LM.writeLog("ShaderProgram::compileShader: %s", info_log.c_str());
+                for (std::size_t index = 0; index < stage_files[i].size(); ++index) {
+                    LM.writeLog("ShaderProgram::compileShader:   file %zu is %s", index, stage_files[i][index].c_str());
+                }
+                glDeleteShader(shader_obj);
                 return GL_FALSE;
             }
             else {
                 glAttachShader(program_handle, shader_obj);
-                LM.writeLog("ShaderProgram::compileShader: Shader from file %s compilation successful.", file.second.c_str());
+                glDeleteShader(shader_obj);     // Only flagged, it goes away with the program
+                LM.writeLog("ShaderProgram::compileShader: Shader from file %s compilation successful.", file_path.c_str());
             }
         }
 
         // Check if compiled shaders in shader program is linked
         if (link_status == GL_FALSE) {
+            if (use_cache) {
+                glProgramParameteri(program_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
             glLinkProgram(program_handle);
             GLint status;
             glGetProgramiv(program_handle, GL_LINK_STATUS, &status); 
             if (status == GL_FALSE) {
-                LM.writeLog("ShaderProgram::compileShader: Compiled shaders failed to link.");
+                GLint log_length = 0;
+                glGetProgramiv(program_handle, GL_INFO_LOG_LENGTH, &log_length);
+                std::string info_log(static_cast<std::size_t>(std::max(log_length, 1)), '\0');
+                glGetProgramInfoLog(program_handle, log_length, nullptr, info_log.data());
+                LM.writeLog("ShaderProgram::compileShader: Compiled shaders failed to link. %s", info_log.c_str());
                 return GL_FALSE;
             }
             link_status = GL_TRUE;
             LM.writeLog("ShaderProgram::compileShader: Compiled shaders are linked successfully.");
+
+            // Next start up loads this instead, a stale file for the same key is overwritten
+            if (use_cache && ShaderCache::store(cache_key, program_handle)) {
+                LM.writeLog("ShaderProgram::compileShader: Program %u saved to the binary cache.", program_handle);
+            }
+
+            reflectUniforms();
         }
 
         // Check if the program created can be executed in current OpenGL state
@@ -91,6 +148,89 @@ namespace gam300 {
 
     }
 
+    // Read a shader file and paste the files it includes in place
+    bool ShaderProgram::expandShaderFile(const std::filesystem::path& file_path, std::string_view defines,
+        std::vector<std::string>& files, std::string& out) {
+        // Listed before reading, so creating a missing include counts as a change of the program
+        const std::string file_index = std::to_string(files.size());
+        files.push_back(normalizeShaderPath(file_path));
+
+        std::string shader_source;
+        if (!readShaderFile(file_path.string(), shader_source)) {
+            return false;
+        }
+
+        const std::size_t file_start = out.size();
+
+        std::istringstream lines(shader_source);
+        std::string line;
+        int line_number = 0;
+        while (std::getline(lines, line)) {
+            ++line_number;
+            const std::size_t first = line.find_first_not_of(" \t");
+
+            if (first != std::string::npos && line.compare(first, 8, "#include") == 0) {
+                const std::size_t open = line.find_first_of("\"<", first + 8);
+                const std::size_t close = open == std::string::npos ? std::string::npos : line.find_first_of("\">", open + 1);
+                if (close == std::string::npos) {
+                    LM.writeLog("ShaderProgram::expandShaderFile: Malformed #include in %s line %d.", file_path.string().c_str(), line_number);
+                    return false;
+                }
+
+                // Each file is pasted once per stage, which also stops include cycles
+                const std::filesystem::path include_path = file_path.parent_path() / line.substr(open + 1, close - open - 1);
+                if (std::find(files.begin(), files.end(), normalizeShaderPath(include_path)) == files.end()) {
+                    out += "#line 1 " + std::to_string(files.size()) + "\n";
+                    if (!expandShaderFile(include_path, {}, files, out)) {
+                        LM.writeLog("ShaderProgram::expandShaderFile: Included from %s line %d.", file_path.string().c_str(), line_number);
+                        return false;
+                    }
+                }
+                out += "#line " + std::to_string(line_number + 1) + " " + file_index + "\n";
+                continue;
+            }
+
+            out += line;
+            out += '\n';
+
+            // Defines must come after #version, which has to stay the first directive
+            if (!defines.empty() && first != std::string::npos && line.compare(first, 8, "#version") == 0) {
+                out += defines;
+                out += "#line " + std::to_string(line_number + 1) + " " + file_index + "\n";
+                defines = {};
+            }
+        }
+
+        if (!defines.empty()) {
+            out.insert(file_start, std::string(defines) + "#line 1 " + file_index + "\n");
+        }
+        return true;
+    }
+
+    // Absolute path with forward slashes
+    std::string ShaderProgram::normalizeShaderPath(const std::filesystem::path& file_path) {
+        std::error_code error;
+        std::filesystem::path normalized = std::filesystem::weakly_canonical(file_path, error);
+        if (error) {
+            normalized = std::filesystem::absolute(file_path, error).lexically_normal();
+        }
+        return normalized.generic_string();
+    }
+
+    // Delete the program and forget what was reflected from it
+    void ShaderProgram::destroy() {
+        if (program_handle > 0) {
+            GLS.program_deleted(program_handle);
+            glDeleteProgram(program_handle);
+        }
+        program_handle = 0;
+        link_status = GL_FALSE;
+        uniform_locations.clear();
+        uniform_blocks.clear();
+        colliding_locations.clear();
+        colliding_blocks.clear();
+    }
+
     // Read shader from the given filepath
     bool ShaderProgram::readShaderFile(const std::string& file_path, std::string& shader_source) {
         // Check if file's state is good for reading
@@ -113,12 +253,12 @@ namespace gam300 {
     // Use program with given program handle
     void ShaderProgram::programUse() {
         if (program_handle > 0) {
-            glUseProgram(program_handle);
+            GLS.use_program(program_handle);
         }
     }
 
     // Free current program
-    void ShaderProgram::programFree() { glUseProgram(0); }
+    void ShaderProgram::programFree() { GLS.use_program(0); }
 
     // Getter for shader program handle
     GLuint ShaderProgram::getShaderProgramHandle() const { return program_handle; }
@@ -126,160 +266,245 @@ namespace gam300 {
     // Getter for shader program link status
     GLuint ShaderProgram::getShaderProgramLinkStatus() const { return link_status; }
 
-    // Set uniform for type vec2 (float x, y)
-    void ShaderProgram::setUniform(const std::string& name, float x, float y) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform2f(location, x, y);
+    // Find every active uniform and uniform block of the linked program
+    void ShaderProgram::reflectUniforms() {
+        uniform_locations.clear();
+        uniform_blocks.clear();
+        colliding_locations.clear();
+        colliding_blocks.clear();
+
+        // Add a name to a table, names whose hash is taken by a different name move to the
+        // string keyed table so neither overwrites the other
+        auto add_entry = [this](auto& table, auto& colliding, auto& names, auto marker,
+            const std::string& entry_name, auto value) {
+            const u32 hash = hashName(entry_name);
+            auto [name_it, inserted] = names.try_emplace(hash, entry_name);
+            if (inserted || name_it->second == entry_name) {
+                if (table[hash] != marker) {
+                    table[hash] = value;
+                    return;
+                }
+            }
+            else if (table[hash] != marker) {
+                LM.writeLog("ShaderProgram::reflectUniforms: \"%s\" and \"%s\" share the hash %08x, looked up by name",
+                    name_it->second.c_str(), entry_name.c_str(), hash);
+                colliding[name_it->second] = table[hash];
+                table[hash] = marker;
+            }
+            else {
+                LM.writeLog("ShaderProgram::reflectUniforms: \"%s\" shares the hash %08x too, looked up by name",
+                    entry_name.c_str(), hash);
+            }
+            colliding[entry_name] = value;
+        };
+        std::unordered_map<u32, std::string> location_names;
+        std::unordered_map<u32, std::string> block_names;
+
+        GLint uniform_count = 0;
+        GLint max_name_length = 0;
+        glGetProgramiv(program_handle, GL_ACTIVE_UNIFORMS, &uniform_count);
+        glGetProgramiv(program_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+        std::string name(static_cast<std::size_t>(std::max(max_name_length, 1)), '\0');
+        for (GLint i = 0; i < uniform_count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program_handle, static_cast<GLuint>(i), max_name_length, &length, &size, &type, name.data());
+            std::string uniform_name(name.data(), static_cast<std::size_t>(length));
+
+            // Members of uniform blocks have no location
+            GLint location = glGetUniformLocation(program_handle, uniform_name.c_str());
+            if (location < 0) {
+                continue;
+            }
+            add_entry(uniform_locations, colliding_locations, location_names, COLLIDING_LOCATION, uniform_name, location);
+
+            // Arrays are reported as "name[0]", also accept "name" and every "name[i]"
+            std::size_t bracket = uniform_name.find("[0]");
+            if (size > 1 || bracket != std::string::npos) {
+                std::string base_name = uniform_name.substr(0, bracket);
+                add_entry(uniform_locations, colliding_locations, location_names, COLLIDING_LOCATION, base_name, location);
+                for (GLint element = 1; element < size; ++element) {
+                    std::string element_name = base_name + "[" + std::to_string(element) + "]";
+                    GLint element_location = glGetUniformLocation(program_handle, element_name.c_str());
+                    if (element_location >= 0) {
+                        add_entry(uniform_locations, colliding_locations, location_names, COLLIDING_LOCATION, element_name, element_location);
+                    }
+                }
+            }
         }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): vec2 (float x, y) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
+
+        GLint block_count = 0;
+        glGetProgramiv(program_handle, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+        for (GLint i = 0; i < block_count; ++i) {
+            GLint length = 0;
+            glGetActiveUniformBlockiv(program_handle, static_cast<GLuint>(i), GL_UNIFORM_BLOCK_NAME_LENGTH, &length);
+            std::string block_name(static_cast<std::size_t>(std::max(length, 1)), '\0');
+            GLsizei written = 0;
+            glGetActiveUniformBlockName(program_handle, static_cast<GLuint>(i), length, &written, block_name.data());
+            block_name.resize(static_cast<std::size_t>(written));
+            add_entry(uniform_blocks, colliding_blocks, block_names, COLLIDING_BLOCK, block_name, static_cast<GLuint>(i));
         }
+
+        LM.writeLog("ShaderProgram::reflectUniforms: Program %u has %zu uniform locations and %zu uniform blocks.",
+            program_handle, uniform_locations.size(), uniform_blocks.size());
     }
 
-    // Set uniform for type vec3 (float x, y, z)
-    void ShaderProgram::setUniform(const std::string& name, float x, float y, float z) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform3f(location, x, y, z);
+    // Location of a uniform, looked up in the table built at link time
+    UniformLocation ShaderProgram::getUniformLocation(std::string_view name) const {
+        auto it = uniform_locations.find(hashName(name));
+        if (it == uniform_locations.end()) {
+            return UniformLocation{};
         }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): vec3 (float x, y, z) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
+        if (it->second == COLLIDING_LOCATION) {
+            auto named = colliding_locations.find(std::string(name));
+            return named != colliding_locations.end() ? UniformLocation{ named->second } : UniformLocation{};
         }
+        return UniformLocation{ it->second };
     }
 
-    // Set uniform for type vec4 (float x, y, z, w)
-    void ShaderProgram::setUniform(const std::string& name, float x, float y, float z, float w) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform4f(location, x, y, z, w);
+    // Index of a uniform block, looked up in the table built at link time
+    GLuint ShaderProgram::getUniformBlockIndex(std::string_view name) const {
+        auto it = uniform_blocks.find(hashName(name));
+        if (it == uniform_blocks.end()) {
+            return GL_INVALID_INDEX;
         }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): vec4 (float x, y, z, w) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
+        if (it->second == COLLIDING_BLOCK) {
+            auto named = colliding_blocks.find(std::string(name));
+            return named != colliding_blocks.end() ? named->second : GL_INVALID_INDEX;
         }
+        return it->second;
     }
 
-    // Set uniform for type vec2 (glm::vec2)
-    void ShaderProgram::setUniform(const std::string& name, glm::vec2 v, GLsizei cnt) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform2fv(location, cnt, glm::value_ptr(v));
+    // Point a uniform block at a uniform buffer binding
+    bool ShaderProgram::bindUniformBlock(std::string_view name, GLuint binding) {
+        GLuint index = getUniformBlockIndex(name);
+        if (index == GL_INVALID_INDEX) {
+            return false;
         }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): vec2 (glm::vec2) uniform variable doesn't exist.");
+        glUniformBlockBinding(program_handle, index, binding);
+        return true;
+    }
+
+    // Location of a uniform that the caller expects to exist
+    GLint ShaderProgram::requireLocation(const std::string& name, const char* type_name) const {
+        UniformLocation location = getUniformLocation(name);
+        if (!location.valid()) {
+            LM.writeLog("ShaderProgram::setUniform(): %s uniform variable doesn't exist.", type_name);
             std::exit(EXIT_FAILURE);
         }
+        return location.value;
+    }
+
+    // Set uniform for float by location
+    void ShaderProgram::setUniform(UniformLocation location, float val) {
+        if (location.valid()) glProgramUniform1f(program_handle, location.value, val);
+    }
+
+    // Set uniform for integer by location
+    void ShaderProgram::setUniform(UniformLocation location, int val) {
+        if (location.valid()) glProgramUniform1i(program_handle, location.value, val);
+    }
+
+    // Set uniform for unsigned integer by location
+    void ShaderProgram::setUniform(UniformLocation location, GLuint val) {
+        if (location.valid()) glProgramUniform1ui(program_handle, location.value, val);
+    }
+
+    // Set uniform for boolean by location
+    void ShaderProgram::setUniform(UniformLocation location, GLboolean val) {
+        if (location.valid()) glProgramUniform1i(program_handle, location.value, val);
+    }
+
+    // Set uniform for type vec2 (glm::vec2) by location
+    void ShaderProgram::setUniform(UniformLocation location, glm::vec2 v, GLsizei cnt) {
+        if (location.valid()) glProgramUniform2fv(program_handle, location.value, cnt, glm::value_ptr(v));
+    }
+
+    // Set uniform for type vec3 (glm::vec3) by location
+    void ShaderProgram::setUniform(UniformLocation location, glm::vec3 v, GLsizei cnt) {
+        if (location.valid()) glProgramUniform3fv(program_handle, location.value, cnt, glm::value_ptr(v));
+    }
+
+    // Set uniform for type vec4 (glm::vec4) by location
+    void ShaderProgram::setUniform(UniformLocation location, glm::vec4 v, GLsizei cnt) {
+        if (location.valid()) glProgramUniform4fv(program_handle, location.value, cnt, glm::value_ptr(v));
+    }
+
+    // Set uniform for type mat3 (glm::mat3) by location
+    void ShaderProgram::setUniform(UniformLocation location, const glm::mat3& mat, GLsizei cnt) {
+        if (location.valid()) glProgramUniformMatrix3fv(program_handle, location.value, cnt, GL_FALSE, glm::value_ptr(mat));
+    }
+
+    // Set uniform for type mat4 (glm::mat4) by location
+    void ShaderProgram::setUniform(UniformLocation location, const glm::mat4& mat, GLsizei cnt) {
+        if (location.valid()) glProgramUniformMatrix4fv(program_handle, location.value, cnt, GL_FALSE, glm::value_ptr(mat));
+    }
+
+    // Set uniform for type vec2 (float x, y)
+    void ShaderProgram::setUniform(const std::string& name, float x, float y) {
+        glUniform2f(requireLocation(name, "vec2 (float x, y)"), x, y);
+    }
+
+    // Set uniform for type vec3 (float x, y, z)
+    void ShaderProgram::setUniform(const std::string& name, float x, float y, float z) {
+        glUniform3f(requireLocation(name, "vec3 (float x, y, z)"), x, y, z);
+    }
+
+    // Set uniform for type vec4 (float x, y, z, w)
+    void ShaderProgram::setUniform(const std::string& name, float x, float y, float z, float w) {
+        glUniform4f(requireLocation(name, "vec4 (float x, y, z, w)"), x, y, z, w);
+    }
+
+    // Set uniform for type vec2 (glm::vec2)
+    void ShaderProgram::setUniform(const std::string& name, glm::vec2 v, GLsizei cnt) {
+        glUniform2fv(requireLocation(name, "vec2 (glm::vec2)"), cnt, glm::value_ptr(v));
     }
 
     // Set uniform for type vec3 (glm::vec3)
     void ShaderProgram::setUniform(const std::string& name, glm::vec3 v, GLsizei cnt) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform3fv(location, cnt, glm::value_ptr(v));
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): vec3 (glm::vec3) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform3fv(requireLocation(name, "vec3 (glm::vec3)"), cnt, glm::value_ptr(v));
     }
 
     // Set uniform for type vec4 (glm::vec4)
     void ShaderProgram::setUniform(const std::string& name, glm::vec4 v, GLsizei cnt) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform4fv(location, cnt, glm::value_ptr(v));
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): vec4 (glm::vec4) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform4fv(requireLocation(name, "vec4 (glm::vec4)"), cnt, glm::value_ptr(v));
     }
 
     // Set uniform for type mat3 (glm::mat3)
     void ShaderProgram::setUniform(const std::string& name, glm::mat3 mat, GLsizei cnt) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniformMatrix3fv(location, cnt, GL_FALSE, glm::value_ptr(mat));
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): mat3 (glm::mat3) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniformMatrix3fv(requireLocation(name, "mat3 (glm::mat3)"), cnt, GL_FALSE, glm::value_ptr(mat));
     }
 
     // Set uniform for type mat4 (glm::mat4)
     void ShaderProgram::setUniform(const std::string& name, glm::mat4 mat, GLsizei cnt) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniformMatrix4fv(location, cnt, GL_FALSE, glm::value_ptr(mat));
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): mat4 (glm::mat4) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniformMatrix4fv(requireLocation(name, "mat4 (glm::mat4)"), cnt, GL_FALSE, glm::value_ptr(mat));
     }
 
     // Set uniform for float
     void ShaderProgram::setUniform(const std::string& name, float val) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform1f(location, val);
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): float uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform1f(requireLocation(name, "float"), val);
     }
 
     // Set uniform for integer
     void ShaderProgram::setUniform(const std::string& name, int val) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform1i(location, val);
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): integer uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform1i(requireLocation(name, "integer"), val);
     }
 
     // Set uniform for unsigned integer
     void ShaderProgram::setUniform(const std::string& name, GLuint val) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform1ui(location, val);
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): unsigned integer uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform1ui(requireLocation(name, "unsigned integer"), val);
     }
 
     // P.S. -> Set variable name as such: "uIndices[0]" instead of "uIndices"
     void ShaderProgram::setUniform(const std::string& name, const GLuint* val, GLsizei cnt) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform1uiv(location, cnt, val);
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): unsigned integer (array) uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform1uiv(requireLocation(name, "unsigned integer (array)"), cnt, val);
     }
 
     // Set uniform for boolean
     void ShaderProgram::setUniform(const std::string& name, GLboolean val) {
-        GLint location = glGetUniformLocation(program_handle, name.c_str());
-        if (location >= 0) {
-            glUniform1i(location, val);
-        }
-        else {
-            LM.writeLog("ShaderProgram::setUniform(): boolean uniform variable doesn't exist.");
-            std::exit(EXIT_FAILURE);
-        }
+        glUniform1i(requireLocation(name, "boolean"), val);
     }
 
 
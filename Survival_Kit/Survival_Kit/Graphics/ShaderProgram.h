@@ -15,15 +15,30 @@
 // Includes
 #include <vector>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
+#include <unordered_map>
+#include <filesystem>
 #include "../Utility/Constant.h"
+#include "../Graphics/Common.h"
+#include "../Graphics/ShaderCache.h"
 
 // For logging information
 #include "../Manager/LogManager.h"
 
 namespace gam300 {
 
+    /**
+     * @brief Location of a uniform, resolved once with ShaderProgram::getUniformLocation.
+     * @details Setting an invalid location does nothing, like OpenGL does for location -1.
+     */
+    struct UniformLocation {
+        GLint value = -1;
+
+        bool valid() const { return value >= 0; }
+    };
+
     class ShaderProgram {
 
     private:
@@ -31,16 +46,71 @@ namespace gam300 {
         GLuint program_handle = 0;
         GLboolean link_status = GL_FALSE; 
 
+        // Active uniforms and uniform blocks found at link time, keyed by hashName
+        std::unordered_map<u32, GLint> uniform_locations;
+        std::unordered_map<u32, GLuint> uniform_blocks;
+
+        // Names sharing a hash with another name of the program are looked up by string, their
+        // hash maps to the marker below instead of a location or block index
+        static constexpr GLint COLLIDING_LOCATION = -2;
+        static constexpr GLuint COLLIDING_BLOCK = GL_INVALID_INDEX - 1;
+        std::unordered_map<std::string, GLint> colliding_locations;
+        std::unordered_map<std::string, GLuint> colliding_blocks;
+
+        // Every file the last compile read, the stage files and what they include (normalized)
+        std::vector<std::string> source_files;
+
+        // Append a shader file to out with its #include directives expanded. files holds the
+        // files of the stage so far, its index is the GLSL source string number of #line.
+        bool expandShaderFile(const std::filesystem::path& file_path, std::string_view defines,
+            std::vector<std::string>& files, std::string& out);
+
+        // Fill the tables above from the linked program
+        void reflectUniforms();
+
+        // Location of a uniform that must exist, exits like the name setters always have
+        GLint requireLocation(const std::string& name, const char* type_name) const;
+
     public:
 
+        /**
+         * @brief Hash of a uniform or block name (FNV-1a), used as the lookup key.
+         */
+        static constexpr u32 hashName(std::string_view name) {
+            u32 hash = 2166136261u;
+            for (char c : name) {
+                hash = (hash ^ static_cast<u8>(c)) * 16777619u;
+            }
+            return hash;
+        }
+
         /**
         * @brief Compile the shaders, link the shader objects to create an executable,
                  and ensure the program can work in the current OpenGL state.
+                 A binary from the ShaderCache is used instead when the sources match.
+                 #include "file" lines are replaced by the file, resolved from the including
+                 file and pasted once per stage, and #line directives keep the line
+                 numbers of compile errors pointing at the right file.
         * @param shader_files The data which contains the shader type and its filepath.
-        * @param shader The shader program that will be created, compiled, and link.
+        * @param defines Lines inserted right after #version in every stage, such as "#define FOO 1\n".
         * @return True if shader program compile and link successfully, false otherwise.
         */
-        GLboolean compileShader(std::vector<std::pair<GLenum, std::string>> shader_files);
+        GLboolean compileShader(std::vector<std::pair<GLenum, std::string>> shader_files, std::string_view defines = {});
+
+        /**
+         * @brief Delete the program, the object can be compiled again afterwards.
+         */
+        void destroy();
+
+        /**
+         * @brief Files read by the last compile, normalized with normalizeShaderPath.
+         */
+        const std::vector<std::string>& getSourceFiles() const { return source_files; }
+
+        /**
+         * @brief Absolute path with forward slashes, so paths from different places compare equal.
+         */
+        static std::string normalizeShaderPath(const std::filesystem::path& file_path);
 
         // Reading shader files
         bool readShaderFile(const std::string& file_path, std::string& shader_source);
@@ -73,6 +143,37 @@ namespace gam300 {
 
         // Bind object's VAO handle
 
+        /**
+         * @brief Look up a uniform in the table built at link time, no driver call.
+         * @return The location, invalid if the program has no such active uniform.
+         */
+        UniformLocation getUniformLocation(std::string_view name) const;
+
+        /**
+         * @brief Look up a uniform block in the table built at link time.
+         * @return The block index, GL_INVALID_INDEX if the program has no such block.
+         */
+        GLuint getUniformBlockIndex(std::string_view name) const;
+
+        /**
+         * @brief Point a uniform block at a uniform buffer binding.
+         * @return True if the program has the block.
+         */
+        bool bindUniformBlock(std::string_view name, GLuint binding);
+
+        /************** Functions for setting uniforms by location **************/
+        // These write straight into the program, so it does not need to be in use
+
+        void setUniform(UniformLocation location, float val);
+        void setUniform(UniformLocation location, int val);
+        void setUniform(UniformLocation location, GLuint val);
+        void setUniform(UniformLocation location, GLboolean val);
+        void setUniform(UniformLocation location, glm::vec2 v, GLsizei cnt = 1);
+        void setUniform(UniformLocation location, glm::vec3 v, GLsizei cnt = 1);
+        void setUniform(UniformLocation location, glm::vec4 v, GLsizei cnt = 1);
+        void setUniform(UniformLocation location, const glm::mat3& mat, GLsizei cnt = 1);
+        void setUniform(UniformLocation location, const glm::mat4& mat, GLsizei cnt = 1);
+
         /******************** Functions for setting uniforms ********************/
 
         // Set uniform for type vec2 (float x, y)
@@ -0,0 +1,142 @@
+/**
+ * @file ShaderVariants.cpp
+ * @brief Implementation of a shader and its #define permutations.
+ * @details Contains implementations for all member functions declared in ShaderVariants.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "ShaderVariants.h"
+
+#include <algorithm>
+
+namespace gam300 {
+
+    ShaderVariants::ShaderVariants(std::vector<std::pair<GLenum, std::string>> shader_files, std::vector<std::string> options)
+        : files(std::move(shader_files)), options(std::move(options)) {
+        if (this->options.size() > 32) {
+            LM.writeLog("ShaderVariants::ShaderVariants: %zu options, only the first 32 are used.", this->options.size());
+            this->options.resize(32);
+        }
+    }
+
+    u32 ShaderVariants::getOptionMask(std::string_view option) const {
+        for (std::size_t i = 0; i < options.size(); ++i) {
+            if (options[i] == option) {
+                return 1u << i;
+            }
+        }
+        return 0;
+    }
+
+    void ShaderVariants::bindUniformBlock(std::string name, GLuint binding) {
+        for (auto& variant : variants) {
+            variant.second.bindUniformBlock(name, binding);
+        }
+        block_bindings.emplace_back(std::move(name), binding);
+    }
+
+    bool ShaderVariants::compileVariant(u32 mask, ShaderProgram& program) const {
+        std::string defines;
+        for (std::size_t i = 0; i < options.size(); ++i) {
+            if (mask & (1u << i)) {
+                defines += "#define " + options[i] + " 1\n";
+            }
+        }
+
+        if (!program.compileShader(files, defines)) {
+            program.destroy();
+            return false;
+        }
+
+        for (const auto& block : block_bindings) {
+            program.bindUniformBlock(block.first, block.second);
+        }
+        return true;
+    }
+
+    ShaderProgram& ShaderVariants::getVariant(u32 mask) {
+        auto it = variants.find(mask);
+        if (it != variants.end()) {
+            return it->second;
+        }
+
+        if (failed.count(mask) == 0) {
+            ShaderProgram program;
+            if (compileVariant(mask, program)) {
+                LM.writeLog("ShaderVariants::getVariant: Variant 0x%X of %s compiled on first use.", mask, files.front().second.c_str());
+                failed_sources.erase(mask);
+                return variants.emplace(mask, std::move(program)).first->second;
+            }
+            LM.writeLog("ShaderVariants::getVariant: Variant 0x%X of %s failed to compile, using variant 0.", mask, files.front().second.c_str());
+            failed.insert(mask);
+            failed_sources[mask] = program.getSourceFiles();
+        }
+
+        // Variant 0 stands in, an empty program if even that one fails
+        return mask != 0 ? getVariant(0) : variants[0];
+    }
+
+    bool ShaderVariants::isValid() {
+        return get().getShaderProgramLinkStatus() == GL_TRUE;
+    }
+
+    bool ShaderVariants::dependsOn(const std::string& file_path) const {
+        for (const auto& variant : variants) {
+            const std::vector<std::string>& sources = variant.second.getSourceFiles();
+            if (std::find(sources.begin(), sources.end(), file_path) != sources.end()) {
+                return true;
+            }
+        }
+
+        // A failed compile leaves no program, but it still knows the files it read
+        for (const auto& failed_variant : failed_sources) {
+            const std::vector<std::string>& sources = failed_variant.second;
+            if (std::find(sources.begin(), sources.end(), file_path) != sources.end()) {
+                return true;
+            }
+        }
+
+        // The stage files themselves, in case a compile never got to read them
+        for (const auto& file : files) {
+            if (ShaderProgram::normalizeShaderPath(file.second) == file_path) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    u32 ShaderVariants::reload() {
+        // Failed variants get another try on their next use
+        failed.clear();
+
+        u32 reloaded = 0;
+        for (auto& variant : variants) {
+            ShaderProgram program;
+            if (!compileVariant(variant.first, program)) {
+                LM.writeLog("ShaderVariants::reload: Variant 0x%X of %s failed to compile, keeping the previous program.",
+                    variant.first, files.front().second.c_str());
+                failed_sources[variant.first] = program.getSourceFiles();
+                continue;
+            }
+            failed_sources.erase(variant.first);
+            variant.second.destroy();
+            variant.second = std::move(program);
+            ++reloaded;
+        }
+        return reloaded;
+    }
+
+    void ShaderVariants::destroy() {
+        for (auto& variant : variants) {
+            variant.second.destroy();
+        }
+        variants.clear();
+        failed.clear();
+        failed_sources.clear();
+    }
+
+} // end of namespace gam300
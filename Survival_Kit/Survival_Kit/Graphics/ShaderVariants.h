@@ -0,0 +1,108 @@
+/**
+ * @file ShaderVariants.h
+ * @brief Declaration of a shader and its #define permutations.
+ * @details One set of stage files compiled once per combination of options, each
+ *          combination on first use, and recompiled when a file it reads changes.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __SHADER_VARIANTS_H__
+#define __SHADER_VARIANTS_H__
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../Graphics/ShaderProgram.h"
+
+namespace gam300 {
+
+    /**
+     * @brief Permutations of one shader, selected by a bitmask of options.
+     * @details Option i is compiled in as "#define <name> 1" when bit i of the mask is
+     *          set, so the shader strips what it does not need with #ifdef instead of
+     *          branching at run time. Variant 0 has no option and is the fallback of a
+     *          variant that fails to compile.
+     */
+    class ShaderVariants {
+    public:
+
+        /**
+         * @param shader_files Stage type and file of every shader.
+         * @param options Names of the options, at most 32.
+         */
+        ShaderVariants(std::vector<std::pair<GLenum, std::string>> shader_files, std::vector<std::string> options = {});
+
+        /**
+         * @brief Bit of an option.
+         * @return 0 if the shader has no such option.
+         */
+        u32 getOptionMask(std::string_view option) const;
+
+        /**
+         * @brief Point a uniform block at a binding in every variant, now and after each compile.
+         */
+        void bindUniformBlock(std::string name, GLuint binding);
+
+        /**
+         * @brief Program of a combination of options, compiled on first use.
+         * @return The variant, or variant 0 if it does not compile.
+         */
+        ShaderProgram& getVariant(u32 mask);
+
+        /**
+         * @brief Program without options.
+         */
+        ShaderProgram& get() { return getVariant(0); }
+
+        /**
+         * @brief Check if variant 0 compiled.
+         */
+        bool isValid();
+
+        /**
+         * @brief Check if a compiled variant, or the last failed compile of a variant, read a file.
+         * @param file_path Path normalized with ShaderProgram::normalizeShaderPath.
+         */
+        bool dependsOn(const std::string& file_path) const;
+
+        /**
+         * @brief Recompile every compiled variant from the files on disk.
+         * @details A variant that no longer compiles keeps its previous program, so a
+         *          typo while editing never leaves the scene without a shader.
+         * @return Number of variants replaced.
+         */
+        u32 reload();
+
+        /**
+         * @brief Delete every program.
+         */
+        void destroy();
+
+        std::size_t getVariantCount() const { return variants.size(); }
+
+    private:
+
+        // Compile the variant of a mask into program
+        bool compileVariant(u32 mask, ShaderProgram& program) const;
+
+        std::vector<std::pair<GLenum, std::string>> files;
+        std::vector<std::string> options;
+        std::vector<std::pair<std::string, GLuint>> block_bindings;
+
+        std::unordered_map<u32, ShaderProgram> variants;
+        std::unordered_set<u32> failed;     // Not retried until the files change
+
+        // Files the last failed compile of a variant read, includes too, so fixing any of them reloads it
+        std::unordered_map<u32, std::vector<std::string>> failed_sources;
+    };
+
+} // end of namespace gam300
+#endif // __SHADER_VARIANTS_H__
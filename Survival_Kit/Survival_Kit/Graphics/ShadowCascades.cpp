@@ -0,0 +1,269 @@
+/**
+ * @file ShadowCascades.cpp
+ * @brief Implementation of the cascaded shadow maps.
+ * @details Contains implementations for all member functions declared in ShadowCascades.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "ShadowCascades.h"
+#include "GLStateTracker.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm-0.9.9.8/glm/gtc/matrix_transform.hpp>
+
+namespace gam300 {
+
+	ShadowCascades::~ShadowCascades() {
+		destroy();
+	}
+
+	bool ShadowCascades::create(const ShadowCascadeDesc& cascade_desc) {
+		destroy();
+
+		desc = cascade_desc;
+		desc.cascades = std::clamp(desc.cascades, 1u, MAX_SHADOW_CASCADES);
+		if (desc.resolution == 0) {
+			LM.writeLog("ShadowCascades::create() - The resolution must not be 0");
+			return false;
+		}
+
+		const GLsizei size = static_cast<GLsizei>(desc.resolution);
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &shadow_map);
+		glTextureStorage3D(shadow_map, 1, GL_DEPTH_COMPONENT32F, size, size, static_cast<GLsizei>(desc.cascades));
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &static_map);
+		glTextureStorage3D(static_map, 1, GL_DEPTH_COMPONENT32F, size, size, static_cast<GLsizei>(desc.cascades));
+		framebuffer = FrameBuffer::create();
+		if (glGetError() != GL_NO_ERROR || !framebuffer) {
+			LM.writeLog("ShadowCascades::create() - Failed to allocate %u cascades of %u texels", desc.cascades, desc.resolution);
+			destroy();
+			return false;
+		}
+
+		// Linear filtering of a comparison gives 2x2 PCF for free
+		glTextureParameteri(shadow_map, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(shadow_map, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(shadow_map, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(shadow_map, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(shadow_map, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTextureParameteri(shadow_map, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+		// Depth only, nothing is written to or read from a color buffer
+		const GLenum none = GL_NONE;
+		framebuffer->set_draw_buffers({ &none, 1 });
+		framebuffer->set_read_buffer(GL_NONE);
+
+		// The first update() fits every cascade
+		light_direction = glm::vec3(0.0f);
+		for (Cascade& cascade : cascades) {
+			cascade = Cascade();
+		}
+		return true;
+	}
+
+	void ShadowCascades::destroy() {
+		for (GLuint* texture : { &shadow_map, &static_map }) {
+			if (*texture != 0) {
+				GLS.texture_deleted(*texture);
+				glDeleteTextures(1, texture);
+				*texture = 0;
+			}
+		}
+		framebuffer.reset();
+		stats = ShadowCascadeStats();
+	}
+
+	void ShadowCascades::update(const glm::mat4& view, const glm::mat4& projection, float near_plane, float far_plane,
+		const glm::vec3& direction) {
+		stats = ShadowCascadeStats();
+		if (!valid()) {
+			return;
+		}
+
+		// The light space basis only depends on the direction, so it stays put as the view moves
+		if (direction != light_direction) {
+			light_direction = direction;
+			const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+			light_rotation = glm::lookAt(glm::vec3(0.0f), direction, up);
+			for (Cascade& cascade : cascades) {
+				cascade.fitted = false;
+			}
+		}
+
+		// Squared distance from the view axis of a frustum corner, per unit of depth
+		const float tan_x = 1.0f / projection[0][0];
+		const float tan_y = 1.0f / projection[1][1];
+		const float corner = tan_x * tan_x + tan_y * tan_y;
+
+		const glm::mat4 inverse_view = glm::inverse(view);
+		const float shadow_far = std::max(std::min(far_plane, desc.max_distance), near_plane);
+		float split_near = near_plane;
+		for (u32 i = 0; i < desc.cascades; ++i) {
+			const float t = static_cast<float>(i + 1) / static_cast<float>(desc.cascades);
+			const float split_log = near_plane * std::pow(shadow_far / near_plane, t);
+			const float split_uniform = near_plane + (shadow_far - near_plane) * t;
+			const float split_far = desc.split_lambda * split_log + (1.0f - desc.split_lambda) * split_uniform;
+
+			// Smallest sphere around the corners of the slice, centered on the view axis.
+			// Only the projection decides its radius, so turning the view keeps it.
+			float depth = 0.5f * (split_near + split_far) * (1.0f + corner);
+			float radius = 0.0f;
+			if (depth >= split_far) {
+				depth = split_far;
+				radius = split_far * std::sqrt(corner);
+			}
+			else {
+				radius = std::sqrt((depth - split_near) * (depth - split_near) + split_near * split_near * corner);
+			}
+			const glm::vec3 center = glm::vec3(light_rotation * inverse_view * glm::vec4(0.0f, 0.0f, -depth, 1.0f));
+
+			// Rounded up, so rounding in the projection cannot resize it from frame to frame
+			const float fitted_radius = std::ceil(radius * (1.0f + desc.margin) * 16.0f) / 16.0f;
+
+			Cascade& cascade = cascades[i];
+			cascade.split = split_far;
+			split_near = split_far;
+			if (cascade.fitted && cascade.radius == fitted_radius &&
+				glm::distance(center, cascade.center) + radius <= cascade.radius) {
+				continue;
+			}
+
+			// Whole texels in light space, so the texel grid does not slide over the world.
+			// The radius is a whole number of texels, so the edges land on the grid too.
+			const float texel = 2.0f * fitted_radius / static_cast<float>(desc.resolution);
+			cascade.center = glm::vec3(std::floor(center.x / texel) * texel, std::floor(center.y / texel) * texel, center.z);
+			cascade.radius = fitted_radius;
+
+			// The light looks down -z, nearer casters are clamped onto the near plane
+			const glm::mat4 light_projection = glm::ortho(
+				cascade.center.x - fitted_radius, cascade.center.x + fitted_radius,
+				cascade.center.y - fitted_radius, cascade.center.y + fitted_radius,
+				-cascade.center.z - fitted_radius, -cascade.center.z + fitted_radius);
+			cascade.view_projection = light_projection * light_rotation;
+			cascade.fitted = true;
+			cascade.static_valid = false;
+			cascade.composite_clean = false;
+			++stats.refits;
+		}
+	}
+
+	void ShadowCascades::set_static_revision(u64 revision) {
+		if (revision != static_revision) {
+			static_revision = revision;
+			invalidate();
+		}
+	}
+
+	void ShadowCascades::invalidate() {
+		for (Cascade& cascade : cascades) {
+			cascade.static_valid = false;
+			cascade.composite_clean = false;
+		}
+	}
+
+	std::array<glm::vec4, 6> ShadowCascades::get_caster_planes(u32 cascade) const {
+		// Rows of the view-projection matrix, as in Camera3D::getFrustumPlanes
+		const glm::mat4& m = cascades[cascade].view_projection;
+		const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+		const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+		const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+		const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+		std::array<glm::vec4, 6> planes = {
+			row3 + row0, row3 - row0,   // Left, right
+			row3 + row1, row3 - row1,   // Bottom, top
+			row3 + row2, row3 - row2    // Near, far
+		};
+		for (glm::vec4& plane : planes) {
+			plane /= glm::length(glm::vec3(plane));
+		}
+
+		// Every point is in front of a plane with no normal and a positive distance
+		planes[4] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		return planes;
+	}
+
+	void ShadowCascades::bind_layer(GLuint texture, u32 layer) const {
+		framebuffer->attach_depth_layer(texture, static_cast<GLint>(layer));
+		framebuffer->bind();
+		GLS.viewport(0, 0, static_cast<GLsizei>(desc.resolution), static_cast<GLsizei>(desc.resolution));
+	}
+
+	void ShadowCascades::begin_static(u32 cascade) {
+		bind_layer(static_map, cascade);
+		framebuffer->clear_depth(1.0f);
+	}
+
+	void ShadowCascades::end_static(u32 cascade) {
+		cascades[cascade].static_valid = true;
+		cascades[cascade].composite_clean = false;
+		++stats.static_renders;
+	}
+
+	bool ShadowCascades::composite(u32 cascade, bool has_dynamic) {
+		Cascade& current = cascades[cascade];
+		if (!current.composite_clean) {
+			const GLsizei size = static_cast<GLsizei>(desc.resolution);
+			const GLint layer = static_cast<GLint>(cascade);
+			glCopyImageSubData(static_map, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+				shadow_map, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, size, size, 1);
+			current.composite_clean = true;
+			++stats.copies;
+		}
+		if (!has_dynamic) {
+			return false;
+		}
+
+		// The dynamic casters make it differ from the static layer until the next copy
+		bind_layer(shadow_map, cascade);
+		current.composite_clean = false;
+		return true;
+	}
+
+	void ShadowCascades::begin_casters() const {
+		GLS.set_enabled(GL_DEPTH_TEST, true);
+		GLS.depth_func(GL_LESS);
+		GLS.set_enabled(GL_DEPTH_CLAMP, true);
+		GLS.set_enabled(GL_POLYGON_OFFSET_FILL, true);
+		glPolygonOffset(1.5f, 2.0f);
+	}
+
+	void ShadowCascades::end_casters() const {
+		GLS.set_enabled(GL_DEPTH_CLAMP, false);
+		GLS.set_enabled(GL_POLYGON_OFFSET_FILL, false);
+	}
+
+	void ShadowCascades::fill_block(const glm::mat4& view, ShadowBlock& out) const {
+		out = ShadowBlock();
+		if (!valid()) {
+			return;
+		}
+
+		// Clip space [-1, 1] to texture coordinates and depth in [0, 1]
+		const glm::mat4 bias = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.5f)), glm::vec3(0.5f));
+		const glm::mat4 inverse_view = glm::inverse(view);
+		for (u32 i = 0; i < MAX_SHADOW_CASCADES; ++i) {
+			if (i < desc.cascades) {
+				out.view_to_shadow[i] = bias * cascades[i].view_projection * inverse_view;
+				out.split[i] = cascades[i].split;
+				out.texel_size[i] = 2.0f * cascades[i].radius / static_cast<float>(desc.resolution);
+			}
+			else {
+				out.view_to_shadow[i] = glm::mat4(1.0f);
+			}
+		}
+		out.params = glm::vec4(static_cast<float>(desc.cascades), desc.normal_offset,
+			1.0f / static_cast<float>(desc.resolution), 0.0f);
+	}
+
+	void ShadowCascades::count_casters(u32 static_casters, u32 dynamic_casters) {
+		stats.static_casters += static_casters;
+		stats.dynamic_casters += dynamic_casters;
+	}
+
+} // end of namespace gam300
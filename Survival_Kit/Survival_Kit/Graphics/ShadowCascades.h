@@ -0,0 +1,193 @@
+/**
+ * @file ShadowCascades.h
+ * @brief Declaration of the cascaded shadow maps of the main directional light.
+ * @details Splits the view into depth ranges, fits a stable orthographic shadow map to
+ *          each, and keeps the depth of static casters in a cached layer so only the
+ *          dynamic casters are drawn every frame.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __SHADOW_CASCADES_H__
+#define __SHADOW_CASCADES_H__
+
+#include <array>
+#include <optional>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/Framebuffer.h"
+#include "../Graphics/UniformBlocks.h"
+
+namespace gam300 {
+
+	constexpr GLuint SHADOW_MAP_UNIT = 2;           // Must match shadow_cascades.glsl
+
+	struct ShadowCascadeDesc {
+		u32 cascades = 4;               // At most MAX_SHADOW_CASCADES
+		u32 resolution = 1024;          // Texels across each cascade
+		float max_distance = 60.0f;     // Shadows end here, or at the far plane if it is nearer
+		float split_lambda = 0.75f;     // 1 spaces the splits logarithmically, 0 evenly
+		float margin = 0.15f;           // Extra radius of a cascade, the view can move this far before it is refitted
+		float normal_offset = 1.5f;     // Receivers are pushed along their normal by this many texels
+	};
+
+	// Counters of the last update() and the drawing that followed it
+	struct ShadowCascadeStats {
+		u32 refits = 0;                 // Cascades moved to follow the view
+		u32 static_renders = 0;         // Cascades whose static layer was drawn again
+		u32 copies = 0;                 // Static layers copied under the dynamic casters
+		u32 static_casters = 0;
+		u32 dynamic_casters = 0;
+	};
+
+	/**
+	 * @brief Cascaded shadow maps with a cached static layer per cascade.
+	 * @details Each cascade bounds its slice of the view frustum with a sphere, whose
+	 *          radius only depends on the projection, so the shadow map does not change
+	 *          size as the view turns. Its center is snapped to whole texels in light
+	 *          space, so moving the view does not make shadow edges crawl, and it is
+	 *          only moved once the slice leaves the margin around it.
+	 *
+	 *          Static casters are drawn into a static layer that stays valid until its
+	 *          cascade moves, the light turns or the static casters change. Every frame
+	 *          the static layer is copied into the layer the shaders sample and the
+	 *          dynamic casters are drawn over it, and even the copy is skipped while
+	 *          the sampled layer still matches the static one.
+	 */
+	class ShadowCascades {
+	public:
+		ShadowCascades() = default;
+		~ShadowCascades();
+
+		ShadowCascades(const ShadowCascades&) = delete;
+		ShadowCascades& operator=(const ShadowCascades&) = delete;
+
+		/**
+		 * @brief Allocate the shadow map and static layer arrays.
+		 * @return false if the storage or framebuffer could not be created.
+		 */
+		bool create(const ShadowCascadeDesc& desc);
+
+		/**
+		 * @brief Release the textures and framebuffer.
+		 */
+		void destroy();
+
+		bool valid() const { return shadow_map != 0; }
+
+		/**
+		 * @brief Fit the cascades to the view and find the static layers that are stale.
+		 * @param view View matrix of the camera.
+		 * @param projection Symmetric perspective projection of the camera.
+		 * @param near_plane Distance to the near plane of the camera.
+		 * @param far_plane Distance to the far plane of the camera.
+		 * @param direction Direction the light travels in, normalized. Any change
+		 *        invalidates every static layer.
+		 */
+		void update(const glm::mat4& view, const glm::mat4& projection, float near_plane, float far_plane,
+			const glm::vec3& direction);
+
+		/**
+		 * @brief Set a hash of every static caster, a change invalidates every static layer.
+		 */
+		void set_static_revision(u64 revision);
+
+		/**
+		 * @brief Draw every static layer again on the next frame.
+		 */
+		void invalidate();
+
+		u32 cascade_count() const { return desc.cascades; }
+
+		// True until the static layer of the cascade is drawn with its current fit
+		bool needs_static(u32 cascade) const { return !cascades[cascade].static_valid; }
+
+		// World to clip space of the light for a cascade
+		const glm::mat4& get_view_projection(u32 cascade) const { return cascades[cascade].view_projection; }
+
+		// View depth where a cascade ends
+		float get_split(u32 cascade) const { return cascades[cascade].split; }
+
+		/**
+		 * @brief Planes for culling the casters of a cascade, see FrustumCuller::cull.
+		 * @details The plane facing the light keeps everything, casters between the light
+		 *          and the cascade are flattened onto its near plane by depth clamping.
+		 */
+		std::array<glm::vec4, 6> get_caster_planes(u32 cascade) const;
+
+		/**
+		 * @brief Bind the static layer of a cascade for drawing, cleared to the far plane.
+		 * @details The caster state of begin_casters() must be set.
+		 */
+		void begin_static(u32 cascade);
+
+		/**
+		 * @brief Mark the static layer of a cascade as drawn.
+		 */
+		void end_static(u32 cascade);
+
+		/**
+		 * @brief Bring the sampled layer of a cascade up to date with its static layer.
+		 * @param has_dynamic Whether dynamic casters are drawn over it this frame.
+		 * @return true if the layer is bound and the dynamic casters should be drawn now.
+		 */
+		bool composite(u32 cascade, bool has_dynamic);
+
+		/**
+		 * @brief Set the depth-only state casters are drawn with.
+		 */
+		void begin_casters() const;
+
+		/**
+		 * @brief Put back the state begin_casters() changed, except the viewport and framebuffer.
+		 */
+		void end_casters() const;
+
+		/**
+		 * @brief Fill the uniform block the receivers sample the shadow map with.
+		 * @param view View matrix of the camera, receivers pass view space positions.
+		 */
+		void fill_block(const glm::mat4& view, ShadowBlock& out) const;
+
+		// Depth array sampled by the receivers, one layer per cascade
+		GLuint get_shadow_map() const { return shadow_map; }
+
+		const ShadowCascadeDesc& get_desc() const { return desc; }
+		const ShadowCascadeStats& get_stats() const { return stats; }
+
+		// Lets the GraphicsManager count the casters it drew
+		void count_casters(u32 static_casters, u32 dynamic_casters);
+
+	private:
+		struct Cascade {
+			glm::mat4 view_projection{ 1.0f };
+			glm::vec3 center{ 0.0f };       // Light space, snapped to whole texels
+			float radius = 0.0f;
+			float split = 0.0f;
+			bool fitted = false;
+			bool static_valid = false;      // Static layer drawn with the current fit
+			bool composite_clean = false;   // Sampled layer holds exactly the static layer
+		};
+
+		// Point the framebuffer at a layer of an array and bind it with a square viewport
+		void bind_layer(GLuint texture, u32 layer) const;
+
+		ShadowCascadeDesc desc;
+		std::array<Cascade, MAX_SHADOW_CASCADES> cascades;
+		glm::mat4 light_rotation{ 1.0f };   // World to light space, without translation
+		glm::vec3 light_direction{ 0.0f };
+		u64 static_revision = 0;
+
+		GLuint shadow_map = 0;              // Sampled, static layer plus dynamic casters
+		GLuint static_map = 0;              // Static casters only
+		std::optional<FrameBuffer> framebuffer;
+
+		ShadowCascadeStats stats;
+	};
+
+} // end of namespace gam300
+#endif // __SHADOW_CASCADES_H__
@@ -2,6 +2,8 @@
 #include "../Manager/GraphicsManager.h"
 #include "../Utility/MathUtils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 namespace gam300 {
@@ -206,56 +208,65 @@ namespace gam300 {
 			return m;
 		}
 
-		MeshGL upload_mesh_data(MeshData& mesh) {
+		MeshBounds compute_bounds(const MeshData& mesh) {
 
-			MeshGL mgl;
+			MeshBounds bounds;
+			if (mesh.positions.empty()) return bounds;
 
-			const size_t N = mesh.positions.size();
-			if (N == 0 || mesh.indices.empty()) throw std::runtime_error("Corrupt mesh, check mesh position and index values!");
+			glm::vec3 min_corner = mesh.positions[0];
+			glm::vec3 max_corner = mesh.positions[0];
+			for (const glm::vec3& position : mesh.positions) {
+				min_corner = glm::min(min_corner, position);
+				max_corner = glm::max(max_corner, position);
+			}
 
-			mgl.vbo.create();
+			bounds.center = (min_corner + max_corner) * 0.5f;
+			bounds.extents = (max_corner - min_corner) * 0.5f;
+
+			// Sphere around the same center, tighter than the box corners for round meshes
+			float radius_squared = 0.0f;
+			for (const glm::vec3& position : mesh.positions) {
+				glm::vec3 offset = position - bounds.center;
+				radius_squared = std::max(radius_squared, glm::dot(offset, offset));
+			}
+			bounds.radius = std::sqrt(radius_squared);
 
-			// Calculate how much size we need to allocate for vbo
-			// Calculate values for ease of packing
-			GLsizeiptr position_data_offset = 0;
-			GLsizeiptr position_attribute_size = sizeof(glm::vec3);
-			GLsizeiptr position_data_size = position_attribute_size * static_cast<GLsizeiptr>(mesh.positions.size());
+			return bounds;
+		}
 
-			GLsizeiptr color_data_offset = position_data_size;
-			GLsizeiptr color_attribute_size = sizeof(glm::vec3);
-			GLsizeiptr color_data_size = color_attribute_size * static_cast<GLsizeiptr>(mesh.colors.size());
+		MeshGL upload_mesh_data(MeshData& mesh, VertexFormat format) {
 
-			GLsizeiptr buffer_size = position_data_size + color_data_size;
+			MeshGL mgl;
 
-			// Wrapper for named buffer storage
-			mgl.vbo.storage(buffer_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+			const size_t N = mesh.positions.size();
+			if (N == 0 || mesh.indices.empty()) throw std::runtime_error("Corrupt mesh, check mesh position and index values!");
 
-			// Load data into sub buffer		
-			mgl.vbo.sub_data(position_data_offset, position_data_size, mesh.positions.data());
-			mgl.vbo.sub_data(color_data_offset, color_data_size, mesh.colors.data());
+			// Interleave every attribute into one buffer, quantized unless asked otherwise
+			const VertexLayout& layout = VertexLayout::get(format);
+			PackedMesh packed = pack_mesh(mesh, format);
 
-			// Set up the VAO
-			mgl.vao.create();
+			mgl.vbo.create();
+			mgl.vbo.storage(static_cast<GLsizeiptr>(packed.vertices.size()), packed.vertices.data(), GL_DYNAMIC_STORAGE_BIT);
 
-			// Bind the vertex array for the position
-			mgl.vao.enable_attrib(0);
-			mgl.vao.bind_vertex_buffer(0, mgl.vbo, position_data_offset, position_attribute_size);
-			mgl.vao.attrib_format(0, 3, GL_FLOAT, false, 0);
-			mgl.vao.attrib_binding(0, 0);
+			// Set up the VAO, all vertex attributes read binding 0
+			mgl.vao.create();
+			mgl.vao.bind_vertex_buffer(0, mgl.vbo, 0, layout.stride);
+			layout.apply(mgl.vao, 0);
 
-			// Bind the vertex array for the colors
-			mgl.vao.enable_attrib(1);
-			mgl.vao.bind_vertex_buffer(1, mgl.vbo, color_data_offset, color_attribute_size);
-			mgl.vao.attrib_format(1, 3, GL_FLOAT, false, 0);
-			mgl.vao.attrib_binding(1, 1);
+			// Model matrix and dequantization read once per instance, the buffer is bound by the render backend
+			apply_instance_layout(mgl.vao);
 
-			// Create an element buffer object to transfer topology
+			// Create an element buffer object to transfer topology, 16-bit when the vertex count allows
 			mgl.ebo.create();
-			mgl.ebo.storage(sizeof(uint32_t) * mesh.indices.size(), reinterpret_cast<GLvoid*>(mesh.indices.data()), GL_DYNAMIC_STORAGE_BIT);
+			mgl.ebo.storage(static_cast<GLsizeiptr>(packed.indices.size()), packed.indices.data(), GL_DYNAMIC_STORAGE_BIT);
 			mgl.vao.bind_element_buffer(mgl.ebo);
 
-			mgl.draw_count = mesh.indices.size();
+			mgl.draw_count = static_cast<GLsizei>(packed.index_count);
 			mgl.primitive_type = GL_TRIANGLES;
+			mgl.index_type = packed.index_type;
+			mgl.bounds = compute_bounds(mesh);
+			mgl.position_offset = packed.position_offset;
+			mgl.position_scale = packed.position_scale;
 
 			return mgl;
 		}
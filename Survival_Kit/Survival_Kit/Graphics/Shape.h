@@ -3,6 +3,7 @@
 #ifndef __SHAPE_H__
 #define __SHAPE_H__
 #include "../Graphics/MeshData.h"
+#include "../Graphics/VertexLayout.h"
 
 namespace gam300 {
 
@@ -12,7 +13,11 @@ namespace gam300 {
 		MeshData make_plane();
 		MeshData make_sphere();
 	
-		MeshGL   upload_mesh_data(MeshData& mesh);
+		// Box and sphere around the mesh positions, also filled in by upload_mesh_data
+		MeshBounds compute_bounds(const MeshData& mesh);
+
+		// Interleaved vertices in the given layout, normals and texture coordinates included
+		MeshGL   upload_mesh_data(MeshData& mesh, VertexFormat format = VertexFormat::QUANTIZED);
 	}
 }
 
@@ -2,12 +2,13 @@
 #ifndef __SHARED_GRAPHICS_H__
 #define __SHARED_GRAPHICS_H__
 #include "../Graphics/Common.h"
+#include "../Graphics/GLStateTracker.h"
 
 namespace gam300 {
 	namespace gfx {
 		inline void bind_texture_and_sampler(GLuint unit, u64 texHandle, u64 sampleHandle) {
-			glBindTextureUnit(unit, static_cast<GLuint>(texHandle));
-			glBindSampler(unit, static_cast<GLuint>(sampleHandle));
+			GLS.bind_texture(unit, static_cast<GLuint>(texHandle));
+			GLS.bind_sampler(unit, static_cast<GLuint>(sampleHandle));
 		}
 	}
 }
@@ -1,26 +1,26 @@
 #include "../Graphics/Texture.h"
 #include "../Graphics/stb_image.h"
 #include "../Graphics/Common.h"
+#include "../Graphics/GLStateTracker.h"
 #include "../Manager/LogManager.h"
 
 namespace gam300 {
 
-	std::optional<std::vector<uint8_t>> Texture::load_pixels_rgba8(const std::filesystem::path& path,
-																   bool flip_vertical,
-																   int& out_w, 
-																   int& out_h, 
-																   int& out_channels) {
-
-		stbi_set_flip_vertically_on_load(flip_vertical ? 1 : 0);
-		int channels = 0;
-		unsigned char* data = stbi_load(path.string().c_str(), &out_w, &out_h, &out_channels, 4); 
-		if (!data) return std::nullopt; 
-
-		size_t size = static_cast<size_t>(out_w) * static_cast<size_t>(out_h) * 4; 
-		std::vector<uint8_t> pixels(size);
-		std::memcpy(pixels.data(), data, size);
-		stbi_image_free(data);
-		return pixels;
+	// EXT_texture_compression_s3tc and EXT_texture_sRGB, not part of the core profile header
+	static constexpr GLenum COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+	static constexpr GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+	static constexpr GLenum COMPRESSED_SRGB_ALPHA_S3TC_DXT1 = 0x8C4D;
+	static constexpr GLenum COMPRESSED_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F;
+
+	static GLenum internal_format_of(TextureBlockFormat format, bool srgb) {
+		switch (format) {
+		case TextureBlockFormat::BC1: return srgb ? COMPRESSED_SRGB_ALPHA_S3TC_DXT1 : COMPRESSED_RGBA_S3TC_DXT1;
+		case TextureBlockFormat::BC3: return srgb ? COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : COMPRESSED_RGBA_S3TC_DXT5;
+		case TextureBlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+		case TextureBlockFormat::BC7: return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		case TextureBlockFormat::RGBA8:
+		default: return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+		}
 	}
 
 	static inline uint32_t calc_mip_count(uint32_t w, uint32_t h) {
@@ -48,7 +48,7 @@ namespace gam300 {
 		const u32 mips = gen_mips ? calc_mip_count(w, h) : 1;
 		glTextureStorage2D(tex, mips, internalFmt, w, h);
 
-		glTextureSubImage2D(tex, 0, 0, 0, w, h, GL_RGBA8, GL_UNSIGNED_BYTE, pixels);
+		glTextureSubImage2D(tex, 0, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
 		if (gen_mips && mips > 1) {
 			glGenerateTextureMipmap(tex);
@@ -62,32 +62,95 @@ namespace gam300 {
 		if (handle == 0) return;
 
 		GLuint tex = static_cast<GLuint>(handle);
+		GLS.texture_deleted(tex);
 		glDeleteTextures(1, &tex);
 	}
 
-    std::optional<Texture> Texture::load_from_file(const std::filesystem::path& path,
-												   const TextureDesc& desc) {
+	std::optional<Texture> Texture::from_pixels_rgba8(const uint8_t* pixels, uint32_t w, uint32_t h,
+													  const TextureDesc& desc) {
 
-		int w = 0, h = 0, c;
-		auto pixels = load_pixels_rgba8(path, desc.flip_verticals, w, h, c);
-		if (!pixels) {
-			LM.writeLog("Failed to load texture from: %s", path.string().c_str());
+		u32 mip_levels = 0;
+		const u64 handle = create_gpu_texture_rgba8(pixels, w, h, desc.srgb, desc.generate_mips, mip_levels);
+
+		if (handle == 0) {
+			LM.writeLog("Failed to generate texture handle");
 			return std::nullopt;
 		}
 
-		u32 mip_levels = 0;
-		const u64 handle = create_gpu_texture_rgba8(pixels->data(), 
-												    static_cast<u32>(w), 
-													static_cast<u32>(h), 
-													desc.srgb, 
-													desc.generate_mips,
-													mip_levels);
+		return Texture{ handle, w, h, mip_levels, desc.srgb };
+	}
 
-		if (handle == 0) {
+	std::optional<Texture> Texture::from_blob_levels(TextureBlockFormat format, bool srgb,
+													 const TextureBlobLevel* levels, uint32_t level_count,
+													 const uint8_t* data) {
+
+		if (level_count == 0) return std::nullopt;
+
+		GLuint tex = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &tex);
+		const GLenum internalFmt = internal_format_of(format, srgb);
+		glTextureStorage2D(tex, level_count, internalFmt, levels[0].width, levels[0].height);
+
+		for (uint32_t i = 0; i < level_count; ++i) {
+			const TextureBlobLevel& level = levels[i];
+			if (format == TextureBlockFormat::RGBA8) {
+				glTextureSubImage2D(tex, i, 0, 0, level.width, level.height, GL_RGBA, GL_UNSIGNED_BYTE, data + level.offset);
+			}
+			else {
+				glCompressedTextureSubImage2D(tex, i, 0, 0, level.width, level.height, internalFmt, level.size, data + level.offset);
+			}
+		}
+
+		if (tex == 0) {
 			LM.writeLog("Failed to generate texture handle");
 			return std::nullopt;
 		}
 
-		return Texture{ handle, static_cast<u32>(w), static_cast<u32>(h), mip_levels, desc.srgb };
+		return Texture{ static_cast<u64>(tex), levels[0].width, levels[0].height, level_count, srgb };
+	}
+
+	std::optional<Texture> Texture::copy_levels(uint32_t first_level) const {
+		if (!valid() || first_level >= m_mip_levels) return std::nullopt;
+
+		const GLuint source = static_cast<GLuint>(m_handle);
+		GLint internalFmt = 0;
+		glGetTextureLevelParameteriv(source, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFmt);
+
+		const u32 levels = m_mip_levels - first_level;
+		const u32 w = std::max(1u, m_width >> first_level);
+		const u32 h = std::max(1u, m_height >> first_level);
+
+		GLuint tex = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &tex);
+		glTextureStorage2D(tex, levels, static_cast<GLenum>(internalFmt), w, h);
+		for (u32 i = 0; i < levels; ++i) {
+			glCopyImageSubData(source, GL_TEXTURE_2D, first_level + i, 0, 0, 0,
+							   tex, GL_TEXTURE_2D, i, 0, 0, 0,
+							   std::max(1u, w >> i), std::max(1u, h >> i), 1);
+		}
+
+		if (tex == 0) {
+			LM.writeLog("Failed to generate texture handle");
+			return std::nullopt;
+		}
+
+		return Texture{ static_cast<u64>(tex), w, h, levels, m_srgb };
+	}
+
+	std::optional<Texture> Texture::load_from_file(const std::filesystem::path& path,
+												   const TextureDesc& desc) {
+
+		// Upload straight from the stb buffer, no second copy of the pixels
+		stbi_set_flip_vertically_on_load_thread(desc.flip_verticals ? 1 : 0);
+		int w = 0, h = 0, c = 0;
+		unsigned char* pixels = stbi_load(path.string().c_str(), &w, &h, &c, 4);
+		if (!pixels) {
+			LM.writeLog("Failed to load texture from: %s", path.string().c_str());
+			return std::nullopt;
+		}
+
+		auto texture = from_pixels_rgba8(pixels, static_cast<u32>(w), static_cast<u32>(h), desc);
+		stbi_image_free(pixels);
+		return texture;
 	}
 }
\ No newline at end of file
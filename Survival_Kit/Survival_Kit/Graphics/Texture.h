@@ -8,6 +8,8 @@
 #include <filesystem>
 #include <string>
 
+#include "../Resource/TextureBlob.h"
+
 namespace gam300 {
 
 	// Load time options (texture data)
@@ -27,6 +29,20 @@ namespace gam300 {
 		static std::optional<Texture> load_from_file(const std::filesystem::path& path,
 													 const TextureDesc& desc);
 
+		// Factory for pixels decoded elsewhere, tightly packed RGBA8 rows
+		// pixels is an offset into the buffer when a GL_PIXEL_UNPACK_BUFFER is bound
+		static std::optional<Texture> from_pixels_rgba8(const uint8_t* pixels, uint32_t w, uint32_t h,
+														const TextureDesc& desc);
+
+		// Factory for cooked levels, uploaded as stored without decoding
+		// Level offsets are relative to data, which is an offset into the buffer when a GL_PIXEL_UNPACK_BUFFER is bound
+		static std::optional<Texture> from_blob_levels(TextureBlockFormat format, bool srgb,
+													   const TextureBlobLevel* levels, uint32_t level_count,
+													   const uint8_t* data);
+
+		// New texture holding levels first_level and smaller of this one, copied on the GPU
+		std::optional<Texture> copy_levels(uint32_t first_level) const;
+
 		Texture(Texture&& other) noexcept { move_from(other); }
 		Texture& operator=(Texture&& other) noexcept {
 			if (this != &other) { destroy(); move_from(other); }
@@ -49,10 +65,6 @@ namespace gam300 {
 			: m_handle(handle), m_width(w), m_height(h), m_mip_levels(mip_levels), m_srgb(srgb) { }
 
 		// GL hooks
-		static std::optional<std::vector<uint8_t>> load_pixels_rgba8(const std::filesystem::path& path,
-																	 bool flip_vertical,
-																	 int& out_w, int& out_h, int& out_channels);
-
 		static uint64_t create_gpu_texture_rgba8(const uint8_t* pixels, uint32_t w, uint32_t h,
 												 bool srgb, bool gen_mips, uint32_t& out_mip_levels);
 
@@ -0,0 +1,150 @@
+/**
+ * @file TextureAtlas.cpp
+ * @brief Implementation of the texture atlas.
+ * @details Contains implementations for all member functions declared in TextureAtlas.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "TextureAtlas.h"
+#include "GLStateTracker.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Dear ImGui compiles the packer static in its own translation unit, so this one does too
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../IMGUI/imstb_rectpack.h"
+
+namespace gam300 {
+
+	struct TextureAtlas::Layer {
+		stbrp_context context;
+		std::vector<stbrp_node> nodes;
+	};
+
+	TextureAtlas::TextureAtlas() = default;
+
+	TextureAtlas::~TextureAtlas() {
+		destroy();
+	}
+
+	bool TextureAtlas::create(const TextureAtlasDesc& atlas_desc) {
+		destroy();
+
+		// The smallest level still has to hold a gutter texel on each side of a texture
+		desc = atlas_desc;
+		desc.mip_levels = std::clamp(desc.mip_levels, 1u, 16u);
+		if (desc.size < 4 * gutter() || desc.layers == 0) {
+			LM.writeLog("TextureAtlas::create() - A %u texel layer cannot hold %u levels", desc.size, desc.mip_levels);
+			return false;
+		}
+
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &texture);
+		glTextureStorage3D(texture, static_cast<GLsizei>(desc.mip_levels), desc.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8,
+			static_cast<GLsizei>(desc.size), static_cast<GLsizei>(desc.size), static_cast<GLsizei>(desc.layers));
+		if (glGetError() != GL_NO_ERROR) {
+			LM.writeLog("TextureAtlas::create() - Failed to allocate %u layers of %u texels", desc.layers, desc.size);
+			glDeleteTextures(1, &texture);
+			texture = 0;
+			return false;
+		}
+
+		// Texture coordinates wrap in the shader, the array itself never wraps
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, desc.mip_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(texture, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(desc.mip_levels - 1));
+		return true;
+	}
+
+	void TextureAtlas::destroy() {
+		if (texture != 0) {
+			GLS.texture_deleted(texture);
+			glDeleteTextures(1, &texture);
+			texture = 0;
+		}
+		layers.clear();
+		used_area = 0;
+		dirty = false;
+		stats = TextureAtlasStats();
+	}
+
+	std::optional<AtlasRegion> TextureAtlas::add(const u8* pixels, u32 width, u32 height) {
+		const u32 pad = gutter();
+		if (!texture || !pixels || width == 0 || height == 0 || width + 2 * pad > desc.size || height + 2 * pad > desc.size) {
+			return std::nullopt;
+		}
+
+		// Rounded up to the alignment, so every rectangle the skyline packer places starts on it
+		const u32 rect_width = (width + 2 * pad + pad - 1) / pad * pad;
+		const u32 rect_height = (height + 2 * pad + pad - 1) / pad * pad;
+
+		stbrp_rect rect{};
+		u32 layer = 0;
+		for (;; ++layer) {
+			if (layer == layers.size()) {
+				if (layer == desc.layers) {
+					LM.writeLog("TextureAtlas::add() - Every layer is full, %ux%u does not fit", width, height);
+					return std::nullopt;
+				}
+				auto fresh = std::make_unique<Layer>();
+				fresh->nodes.resize(desc.size);
+				stbrp_init_target(&fresh->context, static_cast<int>(desc.size), static_cast<int>(desc.size),
+					fresh->nodes.data(), static_cast<int>(fresh->nodes.size()));
+				layers.push_back(std::move(fresh));
+			}
+
+			rect.w = static_cast<stbrp_coord>(rect_width);
+			rect.h = static_cast<stbrp_coord>(rect_height);
+			if (stbrp_pack_rects(&layers[layer]->context, &rect, 1) && rect.was_packed) {
+				break;
+			}
+		}
+
+		// Texture with its edges repeated into the gutter
+		const u32 padded_width = width + 2 * pad;
+		const u32 padded_height = height + 2 * pad;
+		padded.resize(static_cast<std::size_t>(padded_width) * padded_height * 4);
+		for (u32 y = 0; y < padded_height; ++y) {
+			const u32 source_y = std::min(y > pad ? y - pad : 0, height - 1);
+			const u8* source_row = pixels + static_cast<std::size_t>(source_y) * width * 4;
+			u8* row = padded.data() + static_cast<std::size_t>(y) * padded_width * 4;
+			for (u32 x = 0; x < padded_width; ++x) {
+				const u32 source_x = std::min(x > pad ? x - pad : 0, width - 1);
+				std::memcpy(row + x * 4, source_row + source_x * 4, 4);
+			}
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage3D(texture, 0, rect.x, rect.y, static_cast<GLint>(layer),
+			static_cast<GLsizei>(padded_width), static_cast<GLsizei>(padded_height), 1, GL_RGBA, GL_UNSIGNED_BYTE, padded.data());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		used_area += static_cast<u64>(rect_width) * rect_height;
+		dirty = true;
+		++stats.textures;
+		stats.layers_used = static_cast<u32>(layers.size());
+		stats.fill = static_cast<float>(static_cast<double>(used_area) / (static_cast<double>(desc.size) * desc.size * layers.size()));
+
+		const float size = static_cast<float>(desc.size);
+		AtlasRegion region;
+		region.layer = layer;
+		region.uv_rect = glm::vec4(width / size, height / size, (rect.x + pad) / size, (rect.y + pad) / size);
+		return region;
+	}
+
+	void TextureAtlas::update() {
+		if (dirty && texture && desc.mip_levels > 1) {
+			glGenerateTextureMipmap(texture);
+		}
+		dirty = false;
+	}
+
+} // end of namespace gam300
@@ -0,0 +1,104 @@
+/**
+ * @file TextureAtlas.h
+ * @brief Declaration of the texture atlas.
+ * @details Packs small textures of one format into the layers of a 2D texture array, so
+ *          draws sampling different textures can still share one batch.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __TEXTURE_ATLAS_H__
+#define __TEXTURE_ATLAS_H__
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+
+namespace gam300 {
+
+	/**
+	 * @brief Where a texture ended up in the atlas.
+	 * @details A texture coordinate in [0, 1] maps to offset + uv * scale in the layer.
+	 */
+	struct AtlasRegion {
+		u32 layer = 0;
+		glm::vec4 uv_rect{ 1.0f, 1.0f, 0.0f, 0.0f };   // Scale in xy, offset in zw
+	};
+
+	struct TextureAtlasDesc {
+		u32 size = 1024;            // Width and height of a layer
+		u32 layers = 8;             // Layers of the array, storage is allocated up front
+		u32 mip_levels = 4;         // Textures are padded so levels this deep do not bleed
+		bool srgb = true;           // Every texture of an atlas shares this format
+	};
+
+	struct TextureAtlasStats {
+		u32 textures = 0;
+		u32 layers_used = 0;
+		float fill = 0.0f;          // Share of the used layers covered by textures and padding
+	};
+
+	/**
+	 * @brief RGBA8 textures packed into the layers of one texture array.
+	 * @details Each texture is surrounded by a gutter that repeats its edge texels, as wide
+	 *          as one texel of the smallest level, and starts on a multiple of it, so
+	 *          filtering at any level never reads a neighbour. The packer cannot free
+	 *          space, textures stay until the atlas is destroyed.
+	 */
+	class TextureAtlas {
+	public:
+		TextureAtlas();
+		~TextureAtlas();
+
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		/**
+		 * @brief Allocate the texture array.
+		 * @return false if the storage could not be created.
+		 */
+		bool create(const TextureAtlasDesc& desc);
+
+		void destroy();
+
+		/**
+		 * @brief Copy a texture into the first layer with room.
+		 * @param pixels Tightly packed RGBA8, rows in the order they are sampled.
+		 * @return Its region, nothing if it is too large or every layer is full.
+		 */
+		std::optional<AtlasRegion> add(const u8* pixels, u32 width, u32 height);
+
+		/**
+		 * @brief Rebuild the mip levels if textures were added since the last call.
+		 */
+		void update();
+
+		GLuint handle() const { return texture; }
+		bool valid() const { return texture != 0; }
+		const TextureAtlasDesc& get_desc() const { return desc; }
+		const TextureAtlasStats& get_stats() const { return stats; }
+
+	private:
+		// Skyline packer state of one layer, the context points into itself so it never moves
+		struct Layer;
+
+		// Texels a gutter is wide, and the alignment of every rectangle
+		u32 gutter() const { return 1u << (desc.mip_levels - 1); }
+
+		TextureAtlasDesc desc;
+		GLuint texture = 0;
+		std::vector<std::unique_ptr<Layer>> layers;
+		std::vector<u8> padded;                 // Staging of the texture with its gutter
+		u64 used_area = 0;
+		bool dirty = false;
+		TextureAtlasStats stats;
+	};
+
+} // end of namespace gam300
+#endif // __TEXTURE_ATLAS_H__
@@ -0,0 +1,284 @@
+/**
+ * @file TextureStreamer.cpp
+ * @brief Implementation of the texture streamer.
+ * @details Contains implementations for all member functions declared in TextureStreamer.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "TextureStreamer.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gam300 {
+
+	void TextureStreamer::init(TextureUploader& texture_uploader) {
+		uploader = &texture_uploader;
+	}
+
+	void TextureStreamer::destroy() {
+		entries.clear();
+		free_slots.clear();
+		resident_bytes = 0;
+		pending_bytes = 0;
+		stats = TextureStreamStats();
+	}
+
+	TextureStreamer::Entry* TextureStreamer::find(TextureStreamID id) {
+		return id != INVALID_TEXTURE_STREAM && id <= entries.size() && entries[id - 1].used ? &entries[id - 1] : nullptr;
+	}
+
+	const TextureStreamer::Entry* TextureStreamer::find(TextureStreamID id) const {
+		return id != INVALID_TEXTURE_STREAM && id <= entries.size() && entries[id - 1].used ? &entries[id - 1] : nullptr;
+	}
+
+	u64 TextureStreamer::bytes_from(const Entry& entry, u32 level) {
+		u64 bytes = 0;
+		for (u32 i = level; i < entry.levels.size(); ++i) {
+			bytes += entry.levels[i].size;
+		}
+		return bytes;
+	}
+
+	TextureStreamID TextureStreamer::add(const std::string& path, u8 priority) {
+		u32 slot = 0;
+		if (!free_slots.empty()) {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+		else {
+			slot = static_cast<u32>(entries.size());
+			entries.emplace_back();
+		}
+
+		Entry& entry = entries[slot];
+		entry = Entry();
+		entry.used = true;
+		entry.path = path;
+		entry.priority = priority;
+		entry.last_used = frame;
+
+		// The mip tail is the first level that fits in tail_size
+		TextureBlobHeader header;
+		if (readTextureBlobInfo(path, header, entry.levels)) {
+			entry.streamable = true;
+			entry.tail_level = static_cast<u32>(entry.levels.size()) - 1;
+			for (u32 i = 0; i < entry.levels.size(); ++i) {
+				if (entry.levels[i].width <= settings.tail_size && entry.levels[i].height <= settings.tail_size) {
+					entry.tail_level = i;
+					break;
+				}
+			}
+		}
+		else {
+			LM.writeLog("TextureStreamer::add() - %s is not a cooked texture, loading it whole", path.c_str());
+			entry.levels.clear();
+		}
+
+		entry.pending = uploader->request(path, TextureDesc{}, entry.tail_level);
+		entry.pending_level = entry.tail_level;
+		entry.pending_growth = bytes_from(entry, entry.tail_level);
+		pending_bytes += entry.pending_growth;
+		return slot + 1;
+	}
+
+	void TextureStreamer::remove(TextureStreamID id) {
+		Entry* entry = find(id);
+		if (!entry) {
+			return;
+		}
+
+		// A pending upload is dropped by the uploader once nobody holds it
+		resident_bytes -= entry->resident_bytes;
+		pending_bytes -= entry->pending_growth;
+		*entry = Entry();
+		free_slots.push_back(id - 1);
+	}
+
+	void TextureStreamer::note_usage(TextureStreamID id, float screen_pixels) {
+		if (Entry* entry = find(id)) {
+			entry->frame_pixels = std::max(entry->frame_pixels, screen_pixels);
+			entry->last_used = frame;
+		}
+	}
+
+	void TextureStreamer::set_priority(TextureStreamID id, u8 priority) {
+		if (Entry* entry = find(id)) {
+			entry->priority = priority;
+		}
+	}
+
+	u32 TextureStreamer::get_handle(TextureStreamID id) const {
+		const Entry* entry = find(id);
+		return entry && entry->texture ? static_cast<u32>(entry->texture->handle()) : 0;
+	}
+
+	u32 TextureStreamer::get_resident_level(TextureStreamID id) const {
+		const Entry* entry = find(id);
+		return entry ? entry->resident_level : 0;
+	}
+
+	u32 TextureStreamer::wanted_level(const Entry& entry) const {
+		if (entry.frame_pixels <= 0.0f) {
+			return entry.tail_level;
+		}
+
+		// One texel per pixel across the object, each level halves the texels
+		const float texels = static_cast<float>(std::max(entry.levels[0].width, entry.levels[0].height));
+		const float level = std::log2(texels / std::max(entry.frame_pixels, 1.0f)) + settings.bias;
+		return std::min(entry.tail_level, static_cast<u32>(std::max(0.0f, std::floor(level))));
+	}
+
+	bool TextureStreamer::demote(Entry& entry, u32 level) {
+		if (!entry.texture || level <= entry.resident_level) {
+			return false;
+		}
+
+		std::optional<Texture> smaller = entry.texture->copy_levels(level - entry.resident_level);
+		if (!smaller) {
+			return false;
+		}
+
+		const u64 bytes = bytes_from(entry, level);
+		resident_bytes -= entry.resident_bytes - bytes;
+		entry.resident_bytes = bytes;
+		entry.resident_level = level;
+		entry.texture = std::move(smaller);
+		++stats.evictions;
+		return true;
+	}
+
+	bool TextureStreamer::make_room(u64 bytes, const Entry* keep, bool used_too) {
+		// Lowest priority first, least recently used first within a priority
+		std::vector<Entry*> victims;
+		for (Entry& entry : entries) {
+			if (!entry.used || &entry == keep || !entry.streamable || !entry.texture || entry.resident_level >= entry.tail_level) {
+				continue;
+			}
+			const bool recent = frame - entry.last_used < settings.grace_frames;
+			if (recent && !used_too) {
+				continue;
+			}
+			victims.push_back(&entry);
+		}
+		std::sort(victims.begin(), victims.end(), [](const Entry* a, const Entry* b) {
+			return a->priority != b->priority ? a->priority < b->priority : a->last_used < b->last_used;
+		});
+
+		// Unused textures go straight to their tail, textures in use give up one level at a time
+		u64 freed = 0;
+		for (Entry* victim : victims) {
+			while (freed < bytes && victim->resident_level < victim->tail_level) {
+				const u64 before = victim->resident_bytes;
+				const u32 level = used_too ? victim->resident_level + 1 : victim->tail_level;
+				if (!demote(*victim, level)) {
+					break;
+				}
+				freed += before - victim->resident_bytes;
+			}
+			if (freed >= bytes) {
+				return true;
+			}
+		}
+		return freed >= bytes;
+	}
+
+	void TextureStreamer::update() {
+		stats.promotions = 0;
+		stats.evictions = 0;
+
+		// Swap in the textures whose levels arrived
+		for (Entry& entry : entries) {
+			if (!entry.used || !entry.pending) {
+				continue;
+			}
+			const TextureUploadState state = entry.pending->state.load(std::memory_order_acquire);
+			if (state != TextureUploadState::Uploaded && state != TextureUploadState::Failed) {
+				continue;
+			}
+
+			pending_bytes -= entry.pending_growth;
+			entry.pending_growth = 0;
+			if (state == TextureUploadState::Uploaded) {
+				// A texture loaded whole is RGBA8 with a full mip chain
+				const u64 bytes = entry.streamable ? bytes_from(entry, entry.pending_level) : entry.pending->staged_size * 4 / 3;
+				resident_bytes += bytes;
+				resident_bytes -= entry.resident_bytes;
+				entry.resident_bytes = bytes;
+				entry.resident_level = entry.pending_level;
+				entry.texture = std::move(entry.pending->texture);
+			}
+			else {
+				LM.writeLog("TextureStreamer::update() - Failed to stream level %u of %s", entry.pending_level, entry.path.c_str());
+			}
+			entry.pending.reset();
+		}
+
+		// Promote what the screen asks for, biggest priority and biggest gap first
+		struct Promotion {
+			Entry* entry;
+			u32 level;
+		};
+		std::vector<Promotion> promotions;
+		u64 wanted_bytes = 0;
+		for (Entry& entry : entries) {
+			if (!entry.used) {
+				continue;
+			}
+			if (!entry.streamable) {
+				wanted_bytes += entry.resident_bytes;
+				continue;
+			}
+			const u32 level = wanted_level(entry);
+			wanted_bytes += bytes_from(entry, level);
+			if (level < entry.resident_level && !entry.pending && entry.texture) {
+				promotions.push_back({ &entry, level });
+			}
+		}
+		std::sort(promotions.begin(), promotions.end(), [](const Promotion& a, const Promotion& b) {
+			if (a.entry->priority != b.entry->priority) return a.entry->priority > b.entry->priority;
+			return a.entry->resident_level - a.level > b.entry->resident_level - b.level;
+		});
+
+		for (const Promotion& promotion : promotions) {
+			if (stats.promotions >= settings.max_requests_per_frame) {
+				break;
+			}
+			Entry& entry = *promotion.entry;
+			const u64 growth = bytes_from(entry, promotion.level) - entry.resident_bytes;
+
+			// Room comes from idle textures only, a visible texture never pushes out another
+			const u64 projected = resident_bytes + pending_bytes + growth;
+			if (projected > settings.budget_bytes && !make_room(projected - settings.budget_bytes, &entry, false)) {
+				continue;
+			}
+
+			entry.pending = uploader->request(entry.path, TextureDesc{}, promotion.level);
+			entry.pending_level = promotion.level;
+			entry.pending_growth = growth;
+			pending_bytes += growth;
+			++stats.promotions;
+		}
+
+		// A lowered budget is met by taking levels from textures in use as well
+		if (resident_bytes > settings.budget_bytes && !make_room(resident_bytes - settings.budget_bytes, nullptr, false)) {
+			make_room(resident_bytes - settings.budget_bytes, nullptr, true);
+		}
+
+		stats.textures = static_cast<u32>(entries.size() - free_slots.size());
+		stats.resident_bytes = resident_bytes;
+		stats.wanted_bytes = wanted_bytes;
+		stats.pending_uploads = 0;
+		for (Entry& entry : entries) {
+			stats.pending_uploads += entry.used && entry.pending ? 1u : 0u;
+			entry.frame_pixels = 0.0f;
+		}
+		++frame;
+	}
+
+} // end of namespace gam300
@@ -0,0 +1,163 @@
+/**
+ * @file TextureStreamer.h
+ * @brief Declaration of the texture streamer.
+ * @details Keeps only the mip levels of cooked textures that the screen needs resident,
+ *          within a VRAM budget.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __TEXTURE_STREAMER_H__
+#define __TEXTURE_STREAMER_H__
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/Texture.h"
+#include "../Graphics/TextureUploader.h"
+
+namespace gam300 {
+
+	// Handle of a streamed texture, 0 is never a valid one
+	using TextureStreamID = u32;
+	constexpr TextureStreamID INVALID_TEXTURE_STREAM = 0;
+
+	/**
+	 * @brief Tuning of the streamer, shared by every texture.
+	 */
+	struct TextureStreamSettings {
+		u64 budget_bytes = 256ull << 20;    // VRAM the streamed textures may use together
+		u32 tail_size = 64;                 // Levels this small and smaller are always resident
+		float bias = 0.0f;                  // Mip levels added to what the screen asks for, positive saves memory
+		u32 max_requests_per_frame = 4;     // Promotions started per update
+		u32 grace_frames = 120;             // Textures used this recently are evicted last
+	};
+
+	// Counters of the last update
+	struct TextureStreamStats {
+		u32 textures = 0;
+		u64 resident_bytes = 0;
+		u64 wanted_bytes = 0;               // Resident if every texture had the levels it asks for
+		u32 pending_uploads = 0;
+		u32 promotions = 0;                 // Requests started this frame
+		u32 evictions = 0;                  // Textures dropped to fewer levels this frame
+
+		float resident_mb() const { return static_cast<float>(resident_bytes) / (1024.0f * 1024.0f); }
+	};
+
+	/**
+	 * @brief Streams the mip levels of cooked textures in and out by screen-space usage.
+	 * @details A texture starts with its mip tail only. Every frame the renderer reports
+	 *          how many pixels each texture covers; the streamer derives the largest level
+	 *          worth having, reads the missing levels through the TextureUploader and swaps
+	 *          in a texture holding them. Over the budget, textures are dropped to fewer
+	 *          levels, copying the levels they keep on the GPU: first those unused for
+	 *          grace_frames, then the rest, lowest priority first and least recently used
+	 *          first within a priority.
+	 */
+	class TextureStreamer {
+	public:
+
+		/**
+		 * @param uploader Reads and uploads the levels, must outlive the streamer.
+		 */
+		void init(TextureUploader& uploader);
+
+		/**
+		 * @brief Drop every texture.
+		 */
+		void destroy();
+
+		/**
+		 * @brief Start streaming a texture, its mip tail is requested right away.
+		 * @details A file that is not a cooked blob cannot be streamed and is loaded whole.
+		 * @param priority Higher is evicted later.
+		 */
+		TextureStreamID add(const std::string& path, u8 priority = 0);
+
+		/**
+		 * @brief Stop streaming a texture and free it.
+		 */
+		void remove(TextureStreamID id);
+
+		/**
+		 * @brief Report that a texture covers about screen_pixels across this frame.
+		 * @details Called for every visible object using the texture, the largest wins.
+		 */
+		void note_usage(TextureStreamID id, float screen_pixels);
+
+		void set_priority(TextureStreamID id, u8 priority);
+
+		/**
+		 * @brief GL texture of the levels resident now, 0 until the mip tail arrives.
+		 */
+		u32 get_handle(TextureStreamID id) const;
+
+		/**
+		 * @brief Largest resident level, 0 for full detail.
+		 */
+		u32 get_resident_level(TextureStreamID id) const;
+
+		/**
+		 * @brief Take in finished uploads, then promote and evict, once per frame after culling.
+		 */
+		void update();
+
+		TextureStreamSettings& get_settings() { return settings; }
+		const TextureStreamStats& get_stats() const { return stats; }
+
+	private:
+		struct Entry {
+			bool used = false;                              // Slot holds a texture
+			std::string path;
+			u8 priority = 0;
+			bool streamable = false;                        // Cooked blob with a level index
+			std::vector<TextureBlobLevel> levels;           // Level index of the blob
+
+			std::optional<Texture> texture;
+			u32 resident_level = 0;                         // Level 0 of texture is this level of the blob
+			u32 tail_level = 0;                             // Never evicted below this
+			u64 resident_bytes = 0;
+
+			std::shared_ptr<TextureUpload> pending;
+			u32 pending_level = 0;
+			u64 pending_growth = 0;                         // Counted in pending_bytes until it lands
+
+			float frame_pixels = 0.0f;                      // Largest usage reported this frame
+			u64 last_used = 0;                              // Frame of the last usage
+		};
+
+		Entry* find(TextureStreamID id);
+		const Entry* find(TextureStreamID id) const;
+
+		// Bytes of a blob from a level down to its smallest
+		static u64 bytes_from(const Entry& entry, u32 level);
+
+		// Largest level the usage of this frame calls for
+		u32 wanted_level(const Entry& entry) const;
+
+		// Free at least bytes by dropping levels of other textures, false if it could not
+		bool make_room(u64 bytes, const Entry* keep, bool used_too);
+
+		// Drop a texture to a smaller level, keeping the levels below on the GPU
+		bool demote(Entry& entry, u32 level);
+
+		TextureUploader* uploader = nullptr;
+		std::vector<Entry> entries;                         // Index + 1 is the id
+		std::vector<u32> free_slots;
+
+		TextureStreamSettings settings;
+		TextureStreamStats stats;
+		u64 frame = 0;
+		u64 resident_bytes = 0;
+		u64 pending_bytes = 0;                              // Growth once the pending uploads land
+	};
+
+} // end of namespace gam300
+#endif // __TEXTURE_STREAMER_H__
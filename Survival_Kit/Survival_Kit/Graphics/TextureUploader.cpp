@@ -0,0 +1,423 @@
+/**
+ * @file TextureUploader.cpp
+ * @brief Implementation of the background texture loader.
+ * @details Contains implementations for all member functions declared in TextureUploader.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "TextureUploader.h"
+#include "../Graphics/stb_image.h"
+#include "../Manager/JobManager.h"
+#include "../Manager/LogManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace gam300 {
+
+    namespace {
+        constexpr u64 RING_ALIGNMENT = 256;                 // Keeps every image on its own cache lines
+        constexpr GLuint64 FENCE_WAIT_NS = 1000000000ull;   // Waiting only happens in flush and destroy
+
+        u64 align_up(u64 value, u64 alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    bool TextureUploader::create(u64 ring_size) {
+        destroy();
+
+        // Written by workers, read by the GPU, never read back or remapped
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        ring.create();
+        ring.storage(static_cast<GLsizeiptr>(ring_size), nullptr, flags);
+        mapped = static_cast<u8*>(glMapNamedBufferRange(ring.id(), 0, static_cast<GLsizeiptr>(ring_size), flags));
+        if (!mapped) {
+            LM.writeLog("TextureUploader::create() - Failed to map a %llu byte unpack ring", static_cast<unsigned long long>(ring_size));
+            ring = VBO();
+            return false;
+        }
+
+        capacity = ring_size;
+        head = 0;
+        stats = TextureUploadStats();
+        return true;
+    }
+
+    void TextureUploader::destroy() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stopping = true;
+            idle_cv.wait(lock, [this] { return decoding == 0; });
+        }
+
+        retire(true);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& upload : decoded) {
+            upload->state.store(TextureUploadState::Failed, std::memory_order_release);
+        }
+        for (auto& upload : waiting_for_space) {
+            upload->state.store(TextureUploadState::Failed, std::memory_order_release);
+        }
+        decoded.clear();
+        waiting_for_space.clear();
+        regions.clear();
+        head = 0;
+
+        // Deleting the buffer also unmaps it
+        ring = VBO();
+        mapped = nullptr;
+        capacity = 0;
+        stopping = false;
+    }
+
+    std::shared_ptr<TextureUpload> TextureUploader::request(std::string path, const TextureDesc& desc, u32 first_level) {
+        auto upload = std::make_shared<TextureUpload>();
+        upload->path = std::move(path);
+        upload->desc = desc;
+        upload->first_level = first_level;
+        ++stats.requested;
+        submit(upload);
+        return upload;
+    }
+
+    void TextureUploader::submit(std::shared_ptr<TextureUpload> upload) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++decoding;
+        }
+        JM.submit([this, upload = std::move(upload)] { decode(upload); });
+    }
+
+    void TextureUploader::decode(const std::shared_ptr<TextureUpload>& upload) {
+        // Every way out of here hands the request on and lets destroy know
+        auto finish = [this, &upload](TextureUploadState state) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (state == TextureUploadState::Decoded) {
+                decoded.push_back(upload);
+            }
+            else if (state == TextureUploadState::Failed) {
+                ++decode_failures;
+            }
+            upload->state.store(state, std::memory_order_release);
+            --decoding;
+            idle_cv.notify_all();
+        };
+
+        // The owner already let go, or the uploader is going away
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping || upload.use_count() == 1) {
+                upload->state.store(TextureUploadState::Failed, std::memory_order_release);
+                --decoding;
+                idle_cv.notify_all();
+                return;
+            }
+        }
+
+        // Only headers are read here, so ring space is reserved before the pixels exist
+        TextureBlobHeader header;
+        u64 data_offset = 0;
+        if (readTextureBlobInfo(upload->path, header, upload->levels)) {
+            upload->cooked = true;
+            upload->format = static_cast<TextureBlockFormat>(header.format);
+            upload->desc.srgb = (header.flags & TEXTURE_BLOB_SRGB) != 0;
+            upload->first_level = std::min(upload->first_level, header.levelCount - 1);
+            upload->levels.erase(upload->levels.begin(), upload->levels.begin() + upload->first_level);
+            upload->width = upload->levels.front().width;
+            upload->height = upload->levels.front().height;
+
+            // The levels kept are one range of the file
+            u64 end = 0;
+            data_offset = header.totalSize;
+            for (const TextureBlobLevel& level : upload->levels) {
+                data_offset = std::min<u64>(data_offset, level.offset);
+                end = std::max<u64>(end, static_cast<u64>(level.offset) + level.size);
+            }
+            upload->staged_size = end - data_offset;
+            for (TextureBlobLevel& level : upload->levels) {
+                level.offset -= static_cast<u32>(data_offset);
+            }
+        }
+        else {
+            int w = 0, h = 0, channels = 0;
+            if (!stbi_info(upload->path.c_str(), &w, &h, &channels) || w <= 0 || h <= 0) {
+                LM.writeLog("TextureUploader::decode() - Failed to read image header of %s", upload->path.c_str());
+                finish(TextureUploadState::Failed);
+                return;
+            }
+            upload->cooked = false;
+            upload->format = TextureBlockFormat::RGBA8;
+            upload->width = static_cast<u32>(w);
+            upload->height = static_cast<u32>(h);
+            upload->staged_size = static_cast<u64>(w) * static_cast<u64>(h) * 4;
+        }
+
+        const u64 size = upload->staged_size;
+        upload->ring_size = 0;
+        if (size <= capacity) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!allocate(size, upload->ring_offset)) {
+                // Retried by update once the GPU gives some of the ring back
+                waiting_for_space.push_back(upload);
+                ++decode_deferrals;
+                --decoding;
+                idle_cv.notify_all();
+                return;
+            }
+            upload->ring_size = size;
+        }
+
+        u8* destination = nullptr;
+        if (upload->ring_size != 0) {
+            destination = mapped + upload->ring_offset;
+        }
+        else {
+            LM.writeLog("TextureUploader::decode() - %s is larger than the unpack ring, staging it in memory", upload->path.c_str());
+            upload->fallback.resize(static_cast<std::size_t>(size));
+            destination = upload->fallback.data();
+        }
+
+        const bool loaded = upload->cooked ? read_blob(*upload, destination, data_offset) : decode_image(*upload, destination);
+        if (!loaded) {
+            if (upload->ring_size != 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                release(upload->ring_offset);
+                upload->ring_size = 0;
+            }
+            upload->fallback = std::vector<u8>();
+            finish(TextureUploadState::Failed);
+            return;
+        }
+
+        finish(TextureUploadState::Decoded);
+    }
+
+    bool TextureUploader::read_blob(TextureUpload& upload, u8* destination, u64 data_offset) {
+        // Every level in one read, straight into the staging memory
+        std::ifstream file(upload.path, std::ios::binary);
+        if (!file.seekg(static_cast<std::streamoff>(data_offset), std::ios::beg) ||
+            !file.read(reinterpret_cast<char*>(destination), static_cast<std::streamsize>(upload.staged_size))) {
+            LM.writeLog("TextureUploader::read_blob() - Failed to read the levels of %s", upload.path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool TextureUploader::decode_image(TextureUpload& upload, u8* destination) {
+        // stb always allocates its own output, the flip is folded into the one copy out of it
+        stbi_set_flip_vertically_on_load_thread(0);
+        int w = 0, h = 0, channels = 0;
+        unsigned char* pixels = stbi_load(upload.path.c_str(), &w, &h, &channels, 4);
+        if (!pixels || static_cast<u32>(w) != upload.width || static_cast<u32>(h) != upload.height) {
+            LM.writeLog("TextureUploader::decode_image() - Failed to decode %s: %s", upload.path.c_str(),
+                pixels ? "size changed while loading" : stbi_failure_reason());
+            stbi_image_free(pixels);
+            return false;
+        }
+
+        const std::size_t row_size = static_cast<std::size_t>(w) * 4;
+        for (int y = 0; y < h; ++y) {
+            const int source_row = upload.desc.flip_verticals ? h - 1 - y : y;
+            std::memcpy(destination + row_size * y, pixels + row_size * source_row, row_size);
+        }
+        stbi_image_free(pixels);
+        return true;
+    }
+
+    bool TextureUploader::allocate(u64 size, u64& offset) {
+        size = align_up(size, RING_ALIGNMENT);
+        if (size > capacity) {
+            return false;
+        }
+
+        if (regions.empty()) {
+            head = 0;
+            offset = 0;
+        }
+        else {
+            // Used space is [tail, head), wrapping around the end of the ring
+            const u64 tail = regions.front().offset;
+            if (head > tail) {
+                if (capacity - head >= size) {
+                    offset = head;
+                }
+                else if (tail >= size) {
+                    offset = 0;
+                }
+                else {
+                    return false;
+                }
+            }
+            else if (head < tail && tail - head >= size) {
+                offset = head;
+            }
+            else {
+                // head == tail with regions in use means the ring is full
+                return false;
+            }
+        }
+
+        regions.push_back({ offset, size, false });
+        head = offset + size;
+        return true;
+    }
+
+    void TextureUploader::release(u64 offset) {
+        for (RingRegion& region : regions) {
+            if (region.offset == offset && !region.released) {
+                region.released = true;
+                break;
+            }
+        }
+
+        // Regions free up out of order, space only comes back from the oldest one on
+        while (!regions.empty() && regions.front().released) {
+            regions.pop_front();
+        }
+        if (regions.empty()) {
+            head = 0;
+        }
+    }
+
+    bool TextureUploader::retire(bool wait) {
+        bool released = false;
+        while (!in_flight.empty()) {
+            InFlight& batch = in_flight.front();
+            const GLenum result = glClientWaitSync(batch.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? FENCE_WAIT_NS : 0);
+            if (result == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            if (result == GL_WAIT_FAILED) {
+                LM.writeLog("TextureUploader::retire() - Waiting on an upload fence failed");
+            }
+
+            glDeleteSync(batch.fence);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (u64 offset : batch.offsets) {
+                    release(offset);
+                }
+            }
+            in_flight.pop_front();
+            released = true;
+        }
+        return released;
+    }
+
+    void TextureUploader::update(u64 budget_bytes) {
+        const auto start = std::chrono::steady_clock::now();
+
+        bool space_freed = retire(false);
+
+        // Take as many decoded images as the budget allows, always at least one
+        std::vector<std::shared_ptr<TextureUpload>> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            u64 total = 0;
+            std::size_t taken = 0;
+            for (; taken < decoded.size(); ++taken) {
+                const u64 size = decoded[taken]->staged_size;
+                if (taken > 0 && total + size > budget_bytes) {
+                    break;
+                }
+                total += size;
+            }
+            ready.assign(decoded.begin(), decoded.begin() + taken);
+            decoded.erase(decoded.begin(), decoded.begin() + taken);
+        }
+
+        InFlight batch{};
+        for (auto& upload : ready) {
+            // Nobody wants the texture anymore, the GPU never saw this ring space
+            if (upload.use_count() == 1) {
+                if (upload->ring_size != 0) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    release(upload->ring_offset);
+                    space_freed = true;
+                }
+                upload->state.store(TextureUploadState::Failed, std::memory_order_release);
+                continue;
+            }
+
+            // With the ring bound, the pixel pointer is an offset into it
+            const u8* data = upload->fallback.data();
+            if (upload->ring_size != 0) {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ring.id());
+                data = reinterpret_cast<const u8*>(static_cast<std::uintptr_t>(upload->ring_offset));
+                batch.offsets.push_back(upload->ring_offset);
+            }
+
+            std::optional<Texture> texture = upload->cooked
+                ? Texture::from_blob_levels(upload->format, upload->desc.srgb, upload->levels.data(), static_cast<u32>(upload->levels.size()), data)
+                : Texture::from_pixels_rgba8(data, upload->width, upload->height, upload->desc);
+
+            if (upload->ring_size != 0) {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            upload->fallback = std::vector<u8>();
+
+            if (!texture) {
+                LM.writeLog("TextureUploader::update() - Failed to create the texture of %s", upload->path.c_str());
+                upload->state.store(TextureUploadState::Failed, std::memory_order_release);
+                ++stats.failed;
+                continue;
+            }
+
+            upload->texture = std::move(texture);
+            upload->state.store(TextureUploadState::Uploaded, std::memory_order_release);
+            ++stats.uploaded;
+            stats.bytes_uploaded += upload->staged_size;
+        }
+
+        // One fence covers every copy out of the ring this frame
+        if (!batch.offsets.empty()) {
+            batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            in_flight.push_back(std::move(batch));
+        }
+
+        std::vector<std::shared_ptr<TextureUpload>> retry;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (space_freed || regions.empty()) {
+                retry.swap(waiting_for_space);
+            }
+            stats.failed += decode_failures;
+            stats.deferred += decode_deferrals;
+            decode_failures = 0;
+            decode_deferrals = 0;
+            stats.pending = decoding + static_cast<u32>(decoded.size() + waiting_for_space.size() + retry.size());
+        }
+        for (auto& upload : retry) {
+            submit(std::move(upload));
+        }
+
+        stats.last_update_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void TextureUploader::flush() {
+        for (;;) {
+            update(~0ull);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (decoding == 0 && decoded.empty() && waiting_for_space.empty()) {
+                break;
+            }
+            if (decoded.empty() && decoding == 0) {
+                // Only deferred requests are left, they need ring space back from the GPU
+                lock.unlock();
+                retire(true);
+                continue;
+            }
+            idle_cv.wait(lock, [this] { return decoding == 0 || !decoded.empty(); });
+        }
+    }
+
+} // end of namespace gam300
@@ -0,0 +1,174 @@
+/**
+ * @file TextureUploader.h
+ * @brief Declaration of the background texture loader.
+ * @details Cooked texture blobs are read, and other image files decoded, on JobManager
+ *          workers into a persistently mapped ring of pixel unpack memory. The render
+ *          thread only copies from that ring into textures and fences the copies.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __TEXTURE_UPLOADER_H__
+#define __TEXTURE_UPLOADER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/GLResources.h"
+#include "../Graphics/Texture.h"
+
+namespace gam300 {
+
+    enum class TextureUploadState : u8 {
+        Decoding,   // Waiting for or running on a worker
+        Decoded,    // Pixels are staged, waiting for the render thread
+        Uploaded,   // texture is valid
+        Failed      // File missing or not an image
+    };
+
+    /**
+     * @brief One texture on its way from a file to the GPU.
+     * @details Shared between the owner of the texture and the uploader, the uploader
+     *          drops a request whose owner let go of it before it was uploaded.
+     */
+    struct TextureUpload {
+        std::string path;
+        TextureDesc desc;
+        u32 width = 0;                              // Known once decoding starts
+        u32 height = 0;
+
+        std::atomic<TextureUploadState> state{ TextureUploadState::Decoding };
+        std::optional<Texture> texture;             // Set on the render thread, read it once state is Uploaded
+
+        // Cooked blobs are read as stored, images are decoded to RGBA8
+        bool cooked = false;
+        TextureBlockFormat format = TextureBlockFormat::RGBA8;
+        u32 first_level = 0;                        // Largest level of the blob that is loaded
+        std::vector<TextureBlobLevel> levels;       // Loaded levels, offsets relative to the staged data
+
+        // Staging, owned by the uploader
+        u64 staged_size = 0;
+        u64 ring_offset = 0;
+        u64 ring_size = 0;                          // 0 when the pixels are in fallback instead
+        std::vector<u8> fallback;                   // Image larger than the whole ring
+
+        bool is_ready() const { return state.load(std::memory_order_acquire) == TextureUploadState::Uploaded; }
+        u32 gl_handle() const { return is_ready() ? static_cast<u32>(texture->handle()) : 0; }
+    };
+
+    struct TextureUploadStats {
+        u32 requested = 0;
+        u32 uploaded = 0;
+        u32 failed = 0;
+        u32 deferred = 0;                           // Decodes postponed because the ring was full
+        u32 pending = 0;                            // Requests not uploaded yet
+        u64 bytes_uploaded = 0;
+        float last_update_ms = 0.f;                 // Render thread time of the last update
+    };
+
+    class TextureUploader {
+    public:
+        static constexpr u64 DEFAULT_RING_SIZE = 128ull << 20;         // Two 4K RGBA8 images in flight
+        static constexpr u64 DEFAULT_FRAME_BUDGET = 64ull << 20;       // Bytes copied into textures per update
+
+        TextureUploader() = default;
+        TextureUploader(const TextureUploader&) = delete;
+        TextureUploader& operator=(const TextureUploader&) = delete;
+        ~TextureUploader() = default;
+
+        /**
+         * @brief Create and map the ring, needs a GL 4.4 context.
+         * @return false if the ring could not be mapped.
+         */
+        bool create(u64 ring_size = DEFAULT_RING_SIZE);
+
+        /**
+         * @brief Wait for the running decodes, then release the ring and every fence.
+         * @details Requests that are not uploaded yet are marked Failed.
+         */
+        void destroy();
+
+        /**
+         * @brief Start loading a texture blob or an image file, returns right away.
+         * @details The file is read on a worker, call update every frame to finish it.
+         *          A blob keeps the format, levels and color space it was cooked with,
+         *          desc only applies to images decoded here.
+         * @param first_level Blobs only, levels larger than this one are left out. The
+         *          rest is one contiguous read since blobs store levels smallest first.
+         */
+        std::shared_ptr<TextureUpload> request(std::string path, const TextureDesc& desc, u32 first_level = 0);
+
+        /**
+         * @brief Create the textures of decoded requests and recycle ring space the GPU is done with.
+         * @details Render thread only, once per frame. At least one texture is created per
+         *          call, more while the total stays under budget_bytes.
+         */
+        void update(u64 budget_bytes = DEFAULT_FRAME_BUDGET);
+
+        /**
+         * @brief Block until every request is uploaded or failed, for loading screens and tests.
+         */
+        void flush();
+
+        // Counters as of the last update
+        const TextureUploadStats& get_stats() const { return stats; }
+        bool valid() const { return mapped != nullptr; }
+
+    private:
+        // A part of the ring handed to one request, in allocation order
+        struct RingRegion {
+            u64 offset;
+            u64 size;
+            bool released;
+        };
+
+        // Ring space covered by a fence
+        struct InFlight {
+            GLsync fence;
+            std::vector<u64> offsets;
+        };
+
+        // Worker side of a request
+        void decode(const std::shared_ptr<TextureUpload>& upload);
+        bool read_blob(TextureUpload& upload, u8* destination, u64 data_offset);
+        bool decode_image(TextureUpload& upload, u8* destination);
+        void submit(std::shared_ptr<TextureUpload> upload);
+
+        // Ring allocation, under mutex
+        bool allocate(u64 size, u64& offset);
+        void release(u64 offset);
+
+        // Release the ring space of every signalled fence, oldest first, returns true if any was released
+        bool retire(bool wait);
+
+        VBO ring;                                   // Persistent, coherent, write only mapping
+        u8* mapped = nullptr;
+        u64 capacity = 0;
+
+        std::mutex mutex;                           // Guards everything below
+        std::condition_variable idle_cv;            // Signalled when a decode ends
+        std::deque<RingRegion> regions;
+        u64 head = 0;                               // Next free byte of the ring
+        std::vector<std::shared_ptr<TextureUpload>> decoded;
+        std::vector<std::shared_ptr<TextureUpload>> waiting_for_space;
+        u32 decoding = 0;                           // Jobs queued or running
+        u32 decode_failures = 0;                    // Copied into stats by update
+        u32 decode_deferrals = 0;
+        bool stopping = false;
+
+        std::deque<InFlight> in_flight;             // Render thread only
+        TextureUploadStats stats;
+    };
+
+} // end of namespace gam300
+#endif // __TEXTURE_UPLOADER_H__
@@ -0,0 +1,77 @@
+/**
+ * @file UniformBlocks.h
+ * @brief CPU side layouts of the uniform blocks shared by every shader program.
+ * @details Each struct matches a std140 block in the shaders, and is uploaded to a
+ *          uniform buffer once per frame instead of being set on every program.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __UNIFORM_BLOCKS_H__
+#define __UNIFORM_BLOCKS_H__
+
+#include <glm-0.9.9.8/glm/glm.hpp>
+#include "../Graphics/Common.h"
+
+namespace gam300 {
+
+    // Uniform buffer binding points, must match the binding qualifiers in the shaders
+    constexpr GLuint CAMERA_BLOCK_BINDING = 0;
+    constexpr GLuint LIGHT_BLOCK_BINDING  = 1;
+    constexpr GLuint CLUSTER_BLOCK_BINDING = 2;
+    constexpr GLuint SHADOW_BLOCK_BINDING = 3;
+
+    constexpr u32 MAX_SHADOW_CASCADES = 4;          // Array size of the Shadows block
+
+    /**
+     * @brief layout(std140, binding = 0) uniform Camera
+     */
+    struct CameraBlock {
+        glm::mat4 V;                // View transform matrix
+        glm::mat4 P;                // Projection transform matrix
+        glm::mat4 VP;               // P * V
+        glm::vec4 camera_position;  // World space, w unused
+    };
+
+    /**
+     * @brief layout(std140, binding = 1) uniform LightBlock
+     * @details vec3 members are padded to vec4 as std140 requires, w is unused.
+     */
+    struct LightBlock {
+        glm::vec4 position;         // Position of the light source in the world space
+        glm::vec4 La;               // Ambient light intensity
+        glm::vec4 Ld;               // Diffuse light intensity
+        glm::vec4 Ls;               // Specular light intensity
+    };
+
+    /**
+     * @brief layout(std140, binding = 2) uniform Clusters
+     * @details How a fragment finds its cluster, see LightClusters.
+     */
+    struct ClusterBlock {
+        glm::uvec4 grid;            // Tiles across, tiles down, depth slices and light count
+        glm::vec4 depth;            // Near, far, then slice = log(depth) * z + w
+        glm::vec4 tile_size;        // Pixels per tile in xy, zw unused
+    };
+
+    /**
+     * @brief layout(std140, binding = 3) uniform Shadows
+     * @details How a fragment finds its texel in the shadow map, see ShadowCascades.
+     */
+    struct ShadowBlock {
+        glm::mat4 view_to_shadow[MAX_SHADOW_CASCADES]; // View space to shadow map texture space and depth
+        glm::vec4 split;            // View depth where each cascade ends
+        glm::vec4 texel_size;       // World size of a shadow map texel in each cascade
+        glm::vec4 params;           // Cascade count (0 disables shadows), normal offset in texels, 1 / resolution
+    };
+
+    static_assert(sizeof(CameraBlock) == 208, "CameraBlock does not match the std140 layout");
+    static_assert(sizeof(LightBlock) == 64, "LightBlock does not match the std140 layout");
+    static_assert(sizeof(ClusterBlock) == 48, "ClusterBlock does not match the std140 layout");
+    static_assert(sizeof(ShadowBlock) == 304, "ShadowBlock does not match the std140 layout");
+}
+
+#endif // !__UNIFORM_BLOCKS_H__
@@ -0,0 +1,218 @@
+/**
+ * @file VertexLayout.cpp
+ * @brief Implementation of the vertex layouts and mesh packing.
+ * @details Contains implementations for all functions declared in VertexLayout.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Graphics/VertexLayout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <glm-0.9.9.8/glm/gtc/packing.hpp>
+
+namespace gam300 {
+
+	namespace {
+
+		// Byte offsets of the QUANTIZED vertex, 2 bytes of padding keep the normal 4-byte aligned
+		constexpr GLuint QUANTIZED_POSITION_OFFSET = 0;
+		constexpr GLuint QUANTIZED_NORMAL_OFFSET   = 8;
+		constexpr GLuint QUANTIZED_TEXCOORD_OFFSET = 12;
+		constexpr GLuint QUANTIZED_COLOR_OFFSET    = 16;
+		constexpr GLsizei QUANTIZED_STRIDE         = 20;
+
+		constexpr GLuint FLOAT_POSITION_OFFSET = 0;
+		constexpr GLuint FLOAT_NORMAL_OFFSET   = 12;
+		constexpr GLuint FLOAT_COLOR_OFFSET    = 20;
+		constexpr GLuint FLOAT_TEXCOORD_OFFSET = 32;
+		constexpr GLsizei FLOAT_STRIDE         = 40;
+
+		const glm::vec3 DEFAULT_NORMAL{ 0.0f, 1.0f, 0.0f };
+		const glm::vec3 DEFAULT_COLOR{ 0.5f };
+		const glm::vec2 DEFAULT_TEXCOORD{ 0.0f };
+
+		u16 quantize_unorm16(float value) {
+			return static_cast<u16>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+		}
+
+		i16 quantize_snorm16(float value) {
+			return static_cast<i16>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+		}
+
+		u8 quantize_unorm8(float value) {
+			return static_cast<u8>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+		}
+
+		template <typename T>
+		void write(u8* destination, const T& value) {
+			std::memcpy(destination, &value, sizeof(T));
+		}
+
+		VertexLayout make_layout(VertexFormat format) {
+			VertexLayout layout;
+			layout.format = format;
+
+			if (format == VertexFormat::QUANTIZED) {
+				layout.stride = QUANTIZED_STRIDE;
+				layout.attributes = {
+					{ POSITION_ATTRIB, 3, GL_UNSIGNED_SHORT, true, QUANTIZED_POSITION_OFFSET },
+					{ NORMAL_ATTRIB,   2, GL_SHORT,          true, QUANTIZED_NORMAL_OFFSET },
+					{ TEXCOORD_ATTRIB, 2, GL_HALF_FLOAT,     false, QUANTIZED_TEXCOORD_OFFSET },
+					{ COLOR_ATTRIB,    4, GL_UNSIGNED_BYTE,  true, QUANTIZED_COLOR_OFFSET }
+				};
+			}
+			else {
+				layout.stride = FLOAT_STRIDE;
+				layout.attributes = {
+					{ POSITION_ATTRIB, 3, GL_FLOAT, false, FLOAT_POSITION_OFFSET },
+					{ NORMAL_ATTRIB,   2, GL_FLOAT, false, FLOAT_NORMAL_OFFSET },
+					{ COLOR_ATTRIB,    3, GL_FLOAT, false, FLOAT_COLOR_OFFSET },
+					{ TEXCOORD_ATTRIB, 2, GL_FLOAT, false, FLOAT_TEXCOORD_OFFSET }
+				};
+			}
+			return layout;
+		}
+	}
+
+#pragma region VertexLayout
+	const VertexLayout& VertexLayout::get(VertexFormat format) {
+		static const VertexLayout float_layout = make_layout(VertexFormat::FLOAT);
+		static const VertexLayout quantized_layout = make_layout(VertexFormat::QUANTIZED);
+		return format == VertexFormat::QUANTIZED ? quantized_layout : float_layout;
+	}
+
+	void VertexLayout::apply(const VAO& vao, GLuint binding) const {
+		for (const VertexAttribute& attribute : attributes) {
+			vao.enable_attrib(attribute.location);
+			vao.attrib_format(attribute.location, attribute.components, attribute.type, attribute.normalized, attribute.offset);
+			vao.attrib_binding(attribute.location, binding);
+		}
+	}
+
+	void apply_instance_layout(const VAO& vao) {
+		// Model matrix, one vec4 column per location
+		for (GLuint column = 0; column < 4; ++column) {
+			vao.enable_attrib(INSTANCE_MATRIX_ATTRIB + column);
+			vao.attrib_format(INSTANCE_MATRIX_ATTRIB + column, 4, GL_FLOAT, false,
+				static_cast<GLuint>(offsetof(InstanceData, model) + sizeof(glm::vec4) * column));
+			vao.attrib_binding(INSTANCE_MATRIX_ATTRIB + column, INSTANCE_BUFFER_BINDING);
+		}
+
+		vao.enable_attrib(INSTANCE_POSITION_OFFSET_ATTRIB);
+		vao.attrib_format(INSTANCE_POSITION_OFFSET_ATTRIB, 4, GL_FLOAT, false, offsetof(InstanceData, position_offset));
+		vao.attrib_binding(INSTANCE_POSITION_OFFSET_ATTRIB, INSTANCE_BUFFER_BINDING);
+
+		vao.enable_attrib(INSTANCE_POSITION_SCALE_ATTRIB);
+		vao.attrib_format(INSTANCE_POSITION_SCALE_ATTRIB, 4, GL_FLOAT, false, offsetof(InstanceData, position_scale));
+		vao.attrib_binding(INSTANCE_POSITION_SCALE_ATTRIB, INSTANCE_BUFFER_BINDING);
+
+		vao.enable_attrib(INSTANCE_MATERIAL_ATTRIB);
+		vao.attrib_iformat(INSTANCE_MATERIAL_ATTRIB, 1, GL_UNSIGNED_INT, offsetof(InstanceData, material));
+		vao.attrib_binding(INSTANCE_MATERIAL_ATTRIB, INSTANCE_BUFFER_BINDING);
+
+		vao.binding_divisor(INSTANCE_BUFFER_BINDING, 1);
+	}
+#pragma endregion
+
+#pragma region Packing
+	glm::vec2 encode_octahedral(const glm::vec3& normal) {
+		const float length = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+		if (length <= 0.0f) {
+			return glm::vec2(0.0f, 1.0f);
+		}
+
+		glm::vec2 encoded = glm::vec2(normal.x, normal.y) / length;
+		if (normal.z < 0.0f) {
+			// Fold the lower hemisphere over the diagonals
+			const glm::vec2 folded(1.0f - std::fabs(encoded.y), 1.0f - std::fabs(encoded.x));
+			encoded.x = encoded.x >= 0.0f ? folded.x : -folded.x;
+			encoded.y = encoded.y >= 0.0f ? folded.y : -folded.y;
+		}
+		return encoded;
+	}
+
+	glm::vec3 decode_octahedral(const glm::vec2& encoded) {
+		glm::vec3 normal(encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y));
+		const float fold = std::max(-normal.z, 0.0f);
+		normal.x += normal.x >= 0.0f ? -fold : fold;
+		normal.y += normal.y >= 0.0f ? -fold : fold;
+		return glm::normalize(normal);
+	}
+
+	PackedMesh pack_mesh(const MeshData& mesh, VertexFormat format) {
+		const VertexLayout& layout = VertexLayout::get(format);
+
+		PackedMesh packed;
+		packed.vertex_count = static_cast<u32>(mesh.positions.size());
+		packed.index_count = static_cast<u32>(mesh.indices.size());
+		packed.vertices.resize(static_cast<std::size_t>(packed.vertex_count) * layout.stride);
+
+		// Positions are stored in [0, 1] over the mesh box, flat axes keep a scale of 0
+		glm::vec3 min_corner(0.0f), max_corner(0.0f);
+		if (format == VertexFormat::QUANTIZED && !mesh.positions.empty()) {
+			min_corner = max_corner = mesh.positions[0];
+			for (const glm::vec3& position : mesh.positions) {
+				min_corner = glm::min(min_corner, position);
+				max_corner = glm::max(max_corner, position);
+			}
+			packed.position_offset = glm::vec4(min_corner, 0.0f);
+			packed.position_scale = glm::vec4(max_corner - min_corner, 0.0f);
+		}
+		const glm::vec3 size = max_corner - min_corner;
+		const glm::vec3 inverse_size(size.x > 0.0f ? 1.0f / size.x : 0.0f,
+			size.y > 0.0f ? 1.0f / size.y : 0.0f,
+			size.z > 0.0f ? 1.0f / size.z : 0.0f);
+
+		for (u32 i = 0; i < packed.vertex_count; ++i) {
+			u8* vertex = packed.vertices.data() + static_cast<std::size_t>(i) * layout.stride;
+
+			const glm::vec3& position = mesh.positions[i];
+			const glm::vec3 normal = i < mesh.normals.size() ? mesh.normals[i] : DEFAULT_NORMAL;
+			const glm::vec3 color = i < mesh.colors.size() ? mesh.colors[i] : DEFAULT_COLOR;
+			const glm::vec2 texcoord = i < mesh.texcoords.size() ? mesh.texcoords[i] : DEFAULT_TEXCOORD;
+			const glm::vec2 octahedral = encode_octahedral(normal);
+
+			if (format == VertexFormat::QUANTIZED) {
+				const glm::vec3 unit = (position - min_corner) * inverse_size;
+				const u16 quantized_position[4] = { quantize_unorm16(unit.x), quantize_unorm16(unit.y), quantize_unorm16(unit.z), 0 };
+				const i16 quantized_normal[2] = { quantize_snorm16(octahedral.x), quantize_snorm16(octahedral.y) };
+				const u16 half_texcoord[2] = { glm::packHalf1x16(texcoord.x), glm::packHalf1x16(texcoord.y) };
+				const u8 quantized_color[4] = { quantize_unorm8(color.r), quantize_unorm8(color.g), quantize_unorm8(color.b), 255 };
+
+				write(vertex + QUANTIZED_POSITION_OFFSET, quantized_position);
+				write(vertex + QUANTIZED_NORMAL_OFFSET, quantized_normal);
+				write(vertex + QUANTIZED_TEXCOORD_OFFSET, half_texcoord);
+				write(vertex + QUANTIZED_COLOR_OFFSET, quantized_color);
+			}
+			else {
+				write(vertex + FLOAT_POSITION_OFFSET, position);
+				write(vertex + FLOAT_NORMAL_OFFSET, octahedral);
+				write(vertex + FLOAT_COLOR_OFFSET, color);
+				write(vertex + FLOAT_TEXCOORD_OFFSET, texcoord);
+			}
+		}
+
+		// 0xFFFF is left out so primitive restart can be turned on later
+		packed.index_type = packed.vertex_count <= 0xFFFF ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		packed.indices.resize(static_cast<std::size_t>(packed.index_count) * index_size(packed.index_type));
+		if (packed.index_type == GL_UNSIGNED_SHORT) {
+			u16* indices = reinterpret_cast<u16*>(packed.indices.data());
+			for (u32 i = 0; i < packed.index_count; ++i) {
+				indices[i] = static_cast<u16>(mesh.indices[i]);
+			}
+		}
+		else if (packed.index_count > 0) {
+			std::memcpy(packed.indices.data(), mesh.indices.data(), packed.indices.size());
+		}
+
+		return packed;
+	}
+#pragma endregion
+}
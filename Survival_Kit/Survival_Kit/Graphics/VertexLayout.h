@@ -0,0 +1,109 @@
+/**
+ * @file VertexLayout.h
+ * @brief Declaration of the vertex layouts and the packing of MeshData into them.
+ * @details A layout describes one interleaved vertex, and can set up a VAO for it.
+ *          pack_mesh turns a MeshData into vertex and index bytes for a layout, so
+ *          positions, normals, colors and texture coordinates all reach the shader.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __VERTEX_LAYOUT_H__
+#define __VERTEX_LAYOUT_H__
+
+#include <vector>
+#include <glm-0.9.9.8/glm/glm.hpp>
+
+#include "../Graphics/Common.h"
+#include "../Graphics/GLResources.h"
+#include "../Graphics/MeshData.h"
+
+namespace gam300 {
+
+	enum class VertexFormat : u8 {
+		FLOAT = 0,      // 40 bytes: float3 position, float2 octahedral normal, float3 color, float2 uv
+		QUANTIZED       // 20 bytes: unorm16 position, snorm16 octahedral normal, unorm8 color, half uv
+	};
+
+	/**
+	 * @brief One attribute of an interleaved vertex.
+	 */
+	struct VertexAttribute {
+		GLuint location = 0;
+		GLint  components = 0;
+		GLenum type = GL_FLOAT;
+		bool   normalized = false;
+		GLuint offset = 0;
+	};
+
+	/**
+	 * @brief Description of an interleaved vertex.
+	 * @details Both formats feed the same shader inputs. Normals are always octahedral
+	 *          encoded in two components, and positions are scaled by the per-instance
+	 *          dequantization, which is the identity for FLOAT.
+	 */
+	struct VertexLayout {
+		VertexFormat format = VertexFormat::FLOAT;
+		std::vector<VertexAttribute> attributes;
+		GLsizei stride = 0;
+
+		/**
+		 * @brief Layout of a vertex format.
+		 */
+		static const VertexLayout& get(VertexFormat format);
+
+		/**
+		 * @brief Set up the vertex attributes of a VAO to read this layout from one binding.
+		 */
+		void apply(const VAO& vao, GLuint binding) const;
+	};
+
+	/**
+	 * @brief Mesh data packed for a layout.
+	 */
+	struct PackedMesh {
+		std::vector<u8> vertices;          // vertex_count * stride bytes
+		std::vector<u8> indices;           // index_count * index size bytes
+		u32             vertex_count = 0;
+		u32             index_count = 0;
+		GLenum          index_type = GL_UNSIGNED_INT;
+		glm::vec4       position_offset{ 0.0f };
+		glm::vec4       position_scale{ 1.0f };
+	};
+
+	/**
+	 * @brief Pack a mesh into interleaved vertices.
+	 * @details QUANTIZED stores positions relative to the mesh bounds, which the shader
+	 *          undoes with position_offset and position_scale. Indices are 16-bit when
+	 *          every vertex can be addressed, 32-bit otherwise. Missing normals, colors
+	 *          or texture coordinates are filled with defaults.
+	 */
+	PackedMesh pack_mesh(const MeshData& mesh, VertexFormat format);
+
+	/**
+	 * @brief Size in bytes of one index of an index type.
+	 */
+	constexpr GLsizei index_size(GLenum index_type) {
+		return index_type == GL_UNSIGNED_SHORT ? 2 : 4;
+	}
+
+	/**
+	 * @brief Octahedral encoding of a unit vector, each component in [-1, 1].
+	 */
+	glm::vec2 encode_octahedral(const glm::vec3& normal);
+
+	/**
+	 * @brief Inverse of encode_octahedral.
+	 */
+	glm::vec3 decode_octahedral(const glm::vec2& encoded);
+
+	/**
+	 * @brief Set up the per-instance attributes of a VAO to read InstanceData from INSTANCE_BUFFER_BINDING.
+	 */
+	void apply_instance_layout(const VAO& vao);
+}
+
+#endif // !__VERTEX_LAYOUT_H__
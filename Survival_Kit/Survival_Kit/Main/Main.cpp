@@ -10,8 +10,92 @@
  */
 #include "Main.h"
 #include "../Manager/SerialisationManager.h"
+#include "../Pipeline/Importers/MeshImporter.h"
+#include "../Pipeline/TextureCompressor.h"
+#include "../Graphics/LightClusters.h"
+#include "../Graphics/FrameGraph.h"
+#include "../Graphics/FrustumCuller.h"
+#include "../Graphics/RenderQueue.h"
+#include "../Manager/JobManager.h"
+#include "../System/PhysicsSystem.h"
+#include "../Utility/SpatialHashGrid.h"
+
+#include <filesystem>
+#include <string>
+
+int main(int argc, char** argv) {
+    // Headless check of the mesh cooker, exits before any window or manager starts
+    if (argc > 1 && std::string(argv[1]) == "--validate-mesh-cook") {
+        std::string report;
+        const bool passed = gam300::MeshImporter::Validate((std::filesystem::temp_directory_path() / "Survival_Kit_MeshCook").string(), report);
+        std::cout << report << (passed ? "Mesh cook validation passed" : "Mesh cook validation FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless check of the clustered light assignment, on the job system like in a frame
+    if (argc > 1 && std::string(argv[1]) == "--validate-light-clusters") {
+        JM.startUp();
+        std::string report;
+        const bool passed = gam300::LightClusters::validate(report);
+        JM.shutDown();
+        std::cout << report << (passed ? "Light cluster validation passed" : "Light cluster validation FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless check of frame graph compilation, which makes no GL calls
+    if (argc > 1 && std::string(argv[1]) == "--validate-frame-graph") {
+        std::string report;
+        const bool passed = gam300::FrameGraph::validate(report);
+        std::cout << report << (passed ? "Frame graph validation passed" : "Frame graph validation FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless batch raycast benchmark, the job system stays down so it runs on one core
+    if (argc > 1 && std::string(argv[1]) == "--bench-raycast") {
+        std::string report;
+        const bool passed = gam300::PhysicsSystem::benchmarkRaycast(report);
+        std::cout << report << (passed ? "Raycast benchmark passed" : "Raycast benchmark FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless spatial grid benchmark, builds run on the job system like in a frame
+    if (argc > 1 && std::string(argv[1]) == "--bench-spatial-grid") {
+        JM.startUp();
+        std::string report;
+        const bool passed = gam300::SpatialHashGrid::benchmark(report);
+        JM.shutDown();
+        std::cout << report << (passed ? "Spatial grid benchmark passed" : "Spatial grid benchmark FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless check of render queue sorting and submission, against the recording backend
+    if (argc > 1 && std::string(argv[1]) == "--validate-render-queue") {
+        std::string report;
+        const bool passed = gam300::RenderQueue::validate(report);
+        std::cout << report << (passed ? "Render queue validation passed" : "Render queue validation FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless frustum culling benchmark, on the job system like in a frame
+    if (argc > 1 && std::string(argv[1]) == "--bench-frustum-cull") {
+        JM.startUp();
+        std::string report;
+        const bool passed = gam300::FrustumCuller::benchmark(report);
+        JM.shutDown();
+        std::cout << report << (passed ? "Frustum cull benchmark passed" : "Frustum cull benchmark FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    // Headless PSNR check of the texture cooker, compression runs on the job system like in a cook
+    if (argc > 1 && std::string(argv[1]) == "--validate-texture-cook") {
+        JM.startUp();
+        std::string report;
+        const bool passed = gam300::TextureCompressor::Validate(report);
+        JM.shutDown();
+        std::cout << report << (passed ? "Texture cook validation passed" : "Texture cook validation FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
 
-int main(void) {
     //// Initialize GameManager
     //if (GM.startUp()) {
     //    // Failed to start GameManager
@@ -124,11 +208,15 @@ int main(void) {
     AM.setConfig(cfg);
     AM.startUp();
 
+    // Shaders reload when a file they read is edited, picked up by the scans in the main loop
+    AM.addChangeListener([](const std::vector<gam300::ScanChange>& changes) { GFXM.onAssetsChanged(changes); });
+
     AM.scanAndProcess();
 
     std::cout << "\nFinal database count: " << AM.db().Count() << std::endl;
 
-    AM.shutDown();
+    // Rescan the asset folders about once a second
+    auto last_asset_scan = std::chrono::steady_clock::now();
 
     // ---------------------------------------------------------------------------------------
 
@@ -207,6 +295,13 @@ int main(void) {
         app.UpdateScripts();
         app.CheckAndReloadScripts();
 
+        // Scans and imports run on a worker, only reloading what changed happens here
+        AM.dispatchAsyncScan();
+        if (std::chrono::steady_clock::now() - last_asset_scan >= std::chrono::seconds(1)) {
+            last_asset_scan = std::chrono::steady_clock::now();
+            AM.scanAndProcessAsync();
+        }
+
     }
 
 
@@ -214,6 +309,9 @@ int main(void) {
     // Cleanup
     LM.writeLog("Cleaning up resources");
 
+    // Persists the asset database and scan snapshot
+    AM.shutDown();
+
     // Shut down InputManager
     IM.shutDown();
     
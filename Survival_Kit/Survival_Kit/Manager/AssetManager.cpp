@@ -1,4 +1,5 @@
 #include "AssetManager.h"
+#include "JobManager.h"
 #include <filesystem>
 
 #include <iostream>
@@ -122,6 +123,12 @@ namespace gam300 {
 	}
 
 	void AssetManager::shutDown() {
+		// A background scan still writes the DB and the snapshot
+		{
+			std::unique_lock<std::mutex> lock(m_scanMutex);
+			m_scanDone.wait(lock, [this]() { return !m_scanRunning; });
+		}
+
 		// Save DB
 		if (!m_cfg.databaseFile.empty())
 			m_db.Save(m_cfg.databaseFile);
@@ -195,9 +202,58 @@ namespace gam300 {
 		}
 	}
 
+	void AssetManager::addChangeListener(ChangeListener listener) {
+		m_listeners.push_back(std::move(listener));
+	}
+
 	void AssetManager::scanAndProcess() {
+		const std::vector<ScanChange> changes = scanAndImport();
+
+		// Let runtime systems pick up the new files
+		for (const auto& listener : m_listeners)
+			listener(changes);
+	}
+
+	void AssetManager::scanAndProcessAsync() {
+		{
+			std::lock_guard<std::mutex> lock(m_scanMutex);
+			if (m_scanRunning)
+				return;
+			m_scanRunning = true;
+		}
+
+		// Importing cooks textures and meshes, which would stall the frame on the main thread
+		JM.submit([this]() {
+			std::vector<ScanChange> changes = scanAndImport();
+
+			std::lock_guard<std::mutex> lock(m_scanMutex);
+			m_scanChanges.insert(m_scanChanges.end(), changes.begin(), changes.end());
+			m_scanRunning = false;
+			m_scanDone.notify_all();
+		});
+	}
+
+	void AssetManager::dispatchAsyncScan() {
+		std::vector<ScanChange> changes;
+		{
+			std::lock_guard<std::mutex> lock(m_scanMutex);
+			if (m_scanChanges.empty())
+				return;
+			changes.swap(m_scanChanges);
+		}
+
+		for (const auto& listener : m_listeners)
+			listener(changes);
+	}
+
+	std::vector<ScanChange> AssetManager::scanAndImport() {
+		// Nothing to import or persist when nothing changed, which keeps frequent scans cheap
+		std::vector<ScanChange> changes = m_scanner.Scan();
+		if (changes.empty())
+			return changes;
+
 		// Iterate changes from the scanner and act on them
-		for (const auto& c : m_scanner.Scan()) {
+		for (const auto& c : changes) {
 			switch (c.kind) {
 			case ::gam300::ScanChange::Kind::Added:
 			case ::gam300::ScanChange::Kind::Modified:
@@ -215,6 +271,8 @@ namespace gam300 {
 		// Persist after a pass (cheap for small DBs; adjust cadence if needed)
 		if (!m_cfg.databaseFile.empty())
 			m_db.Save(m_cfg.databaseFile);
+
+		return changes;
 	}
 
 
@@ -6,6 +6,9 @@
 #include <vector>
 #include <ctime>
 #include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
 
 // Manager base + logging
 #include "Manager.h"
@@ -110,6 +113,16 @@ namespace gam300 {
 		/** Scan source roots, import changes, update DB, optionally emit .desc */
 		void scanAndProcess();
 
+		/** Same as scanAndProcess() on a JobManager worker, does nothing while the last one runs */
+		void scanAndProcessAsync();
+
+		/** Tell the listeners about a finished scanAndProcessAsync() on this thread, call once a frame */
+		void dispatchAsyncScan();
+
+		/** Called after each scan that found changes, with the changes (e.g. shader hot reload) */
+		using ChangeListener = std::function<void(const std::vector<ScanChange>&)>;
+		void addChangeListener(ChangeListener listener);
+
 
 		// --------------- Accessors ---------------
 		AssetDatabase& db() { return m_db; }
@@ -122,6 +135,9 @@ namespace gam300 {
 		void validateExistingDescriptors();
 	private:
 
+		/** Scan, import and save the DB, returns the changes for the listeners */
+		std::vector<ScanChange> scanAndImport();
+
 		void handleAddedOrModified(const std::string& src);
 		void handleRemoved(const std::string& src);
 		static const char* typeName(AssetType t);
@@ -133,6 +149,13 @@ namespace gam300 {
 		AssetImporterRegistry m_importers;
 		AssetDatabase m_db;
 		AssetDescriptorGenerator m_descGen;
+		std::vector<ChangeListener> m_listeners; //!< Told about every non-empty scan
+
+		// Background scan, the listeners may touch GL so they only run on the main thread
+		std::mutex m_scanMutex;
+		std::condition_variable m_scanDone;
+		bool m_scanRunning = false;
+		std::vector<ScanChange> m_scanChanges; //!< Changes of the finished scan, not dispatched yet
 	};
 
 }	//end of namespace gam300
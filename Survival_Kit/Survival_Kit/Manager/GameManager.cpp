@@ -17,12 +17,18 @@
 #include "SerialisationManager.h"
 #include "PrefabManager.h"
 #include "GraphicsManager.h"
+#include "JobManager.h"
 #include "../Component/Transform3D.h"
 #include "../Component/AudioComponent.h"
 #include "../Utility/Clock.h"
 #include "../Utility/AssetPath.h"
 #include "../System/MovementSystem.h"
+#include "../System/PhysicsSystem.h"
+#include "../System/SpatialGridSystem.h"
 #include "../Component/RigidBody.h"
+#include "../Component/Collider.h"
+#include "../Component/MeshRenderer.h"
+#include "../Component/LightComponent.h"
 
 namespace gam300 {
 
@@ -63,9 +69,20 @@ namespace gam300 {
 
         logManager.writeLog("GameManager::startUp() - InputManager started successfully");
 
+        // Start the JobManager
+        if (JM.startUp()) {
+            logManager.writeLog("GameManager::startUp() - Failed to start JobManager");
+            IM.shutDown();
+            logManager.shutDown();
+            return -1;
+        }
+
+        logManager.writeLog("GameManager::startUp() - JobManager started successfully");
+
         // Start the ECSManager
         if (EM.startUp()) {
             logManager.writeLog("GameManager::startUp() - Failed to start ECSManager");
+            JM.shutDown();
             IM.shutDown();
             logManager.shutDown();
             return -1;
@@ -77,6 +94,7 @@ namespace gam300 {
         if (SEM.startUp()) {
             logManager.writeLog("GameManager::startUp() - Failed to start SerialisationManager");
             EM.shutDown();
+            JM.shutDown();
             IM.shutDown();
             logManager.shutDown();
             return -1;
@@ -88,6 +106,7 @@ namespace gam300 {
         if (PM.startUp()) {
             logManager.writeLog("GameManager::startUp() - Failed to start PrefabManager");
             EM.shutDown();
+            JM.shutDown();
             IM.shutDown();
             logManager.shutDown();
             return -1;
@@ -99,6 +118,7 @@ namespace gam300 {
         if (GFXM.startUp()) {
             logManager.writeLog("GameManager::startUp() - Failed to start GraphicsManager");
             EM.shutDown();
+            JM.shutDown();
             IM.shutDown();
             SEM.shutDown();
             logManager.shutDown();
@@ -115,6 +135,12 @@ namespace gam300 {
         logManager.writeLog("GameManager::startUp() - GraphicsManager started successfully");
 		CM.register_component<AudioComponent>();
 		logManager.writeLog("GameManager::startUp() - AudioComponent component registered successfully");
+        CM.register_component<Collider>();
+        logManager.writeLog("GameManager::startUp() - Collider component registered successfully");
+        CM.register_component<MeshRenderer>();
+        logManager.writeLog("GameManager::startUp() - MeshRenderer component registered successfully");
+        CM.register_component<LightComponent>();
+        logManager.writeLog("GameManager::startUp() - LightComponent component registered successfully");
 
         // Load the scene
         const std::string scenePath = getAssetFilePath("Scene/Game.scn");
@@ -124,6 +150,12 @@ namespace gam300 {
         // Register the Movement component with the ComponetManager
         SM.register_system<MovementSystem>();
 
+        // Register the Physics system, runs after the Movement system
+        SM.register_system<PhysicsSystem>();
+
+        // Register the Spatial Grid system, rebuilt after physics has moved everything
+        SM.register_system<SpatialGridSystem>();
+
         //// Create a test entity with Transform3D component for demonstration
         //Entity& testEntity = EM.createEntity("TestEntity");
         //Vector3D position(0.0f, 0.0f, 0.0f);
@@ -181,6 +213,7 @@ namespace gam300 {
 		PM.shutDown();
         SEM.shutDown();
         EM.shutDown();
+        JM.shutDown();
         IM.shutDown();
         logManager.shutDown();
 
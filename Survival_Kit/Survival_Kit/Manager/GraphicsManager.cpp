@@ -11,13 +11,48 @@
 
 #include "GraphicsManager.h"
 
+#include <algorithm>
 #include <glm-0.9.9.8/glm/glm.hpp>
 #include <glm-0.9.9.8/glm/gtc/quaternion.hpp>
 #include <glm-0.9.9.8/glm/gtx/quaternion.hpp>
+#include <glm-0.9.9.8/glm/gtc/type_ptr.hpp>
 #include "../Component/Transform3D.h"
+#include "../Component/MeshRenderer.h"
+#include "../Component/LightComponent.h"
+#include "../Component/RigidBody.h"
+#include "../Pipeline/Importers/MeshImporter.h"
 
 namespace gam300 {
 
+    namespace {
+        constexpr u32 MESH_POOL_VERTICES = 1u << 20;    // Shared vertex buffer capacity (20 MB quantized)
+        constexpr u32 MESH_POOL_INDICES  = 1u << 23;    // Shared index buffer capacity in 16-bit indices (16 MB)
+
+        constexpr const char* NO_SPECULAR_OPTION = "NO_SPECULAR";   // Object shader without the specular term
+        constexpr const char* BINDLESS_OPTION = "BINDLESS";         // Object shader sampling bindless handles
+
+        constexpr int VIEWPORT_WIDTH  = 640;            // Size of the scene textures until the imgui viewport has one
+        constexpr int VIEWPORT_HEIGHT = 480;
+
+        constexpr GLenum SCENE_COLOR_FORMAT = GL_RGBA8;
+        constexpr GLenum SCENE_DEPTH_FORMAT = GL_DEPTH_COMPONENT24;
+
+        constexpr std::size_t SHADOW_DEPTH_SHADER = 1;  // Index in shadersStorage, loaded after the object shader
+        constexpr GLint LIGHT_VIEW_PROJECTION_LOCATION = 0; // Explicit uniform location in shadow_depth.vert
+
+        // FNV-1a, folds every static caster into the revision of the shadow cache
+        constexpr u64 FNV_OFFSET = 14695981039346656037ull;
+        constexpr u64 FNV_PRIME = 1099511628211ull;
+
+        u64 hashBytes(u64 hash, const void* data, std::size_t size) {
+            const u8* bytes = static_cast<const u8*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * FNV_PRIME;
+            }
+            return hash;
+        }
+    }
+
     // Initialize singleton instance
     GraphicsManager::GraphicsManager() {
         setType("GraphicsManager");
@@ -73,7 +108,7 @@ namespace gam300 {
         };
 
         // Load shader files
-        if (!loadShaderPrograms(shader_files)) {
+        if (!loadShaderPrograms(shader_files, { NO_SPECULAR_OPTION, BINDLESS_OPTION })) {
             LM.writeLog("GraphicsManager::startUp(): Failed to load shader programs");
             std::cerr << "GraphicsManager::startUp(): Failed to load shader programs" << std::endl;
             return -1;
@@ -81,6 +116,40 @@ namespace gam300 {
             LM.writeLog("GraphicsManager::startUp(): Succesfully added shader programs.");
         }
 
+        // Depth only program for the shadow casters, it has no permutations
+        std::string vertex_shadow_path{ "..\\Survival_Kit\\Assets\\Shaders\\shadow_depth.vert" };
+        std::string fragment_shadow_path{ "..\\Survival_Kit\\Assets\\Shaders\\shadow_depth.frag" };
+        if (!loadShaderPrograms({ std::make_pair(vertex_shadow_path, fragment_shadow_path) })) {
+            LM.writeLog("GraphicsManager::startUp(): Failed to load the shadow depth program");
+            return -1;
+        }
+
+        // Staging ring for textures decoded on workers, without it they are staged in memory
+        if (!texture_uploader.create()) {
+            LM.writeLog("GraphicsManager::startUp() - Texture uploads will not use a pixel unpack ring");
+        }
+        texture_streamer.init(texture_uploader);
+
+        // Material 0 has the colors the object shader used before materials were read per instance
+        material_table.create((GLADloadproc)glfwGetProcAddress, sampler_cache);
+        material_table.add(Material(100.0f, glm::vec3(0.3f, 0.5f, 0.9f), glm::vec3(0.3f, 0.5f, 0.9f), glm::vec3(0.8f, 0.8f, 0.8f)));
+
+        // Uniform buffers for the blocks shared by every program, bound once per frame
+        camera_ubo.create();
+        camera_ubo.storage(sizeof(CameraBlock), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        light_ubo.create();
+        light_ubo.storage(sizeof(LightBlock), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        cluster_ubo.create();
+        cluster_ubo.storage(sizeof(ClusterBlock), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        light_clusters.configure(LightClusterDesc{});
+        shadow_ubo.create();
+        shadow_ubo.storage(sizeof(ShadowBlock), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+        // Without shadow maps the block tells the shaders there are no cascades
+        if (!shadow_cascades.create(ShadowCascadeDesc{})) {
+            LM.writeLog("GraphicsManager::startUp() - The main light will not cast shadows");
+        }
+
         // Set camera as orbiting
         main_camera = Camera3D(ORBITING, glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.f, 0.f, 0.0f), 45.0f, 0.5f, 100.0f);
 
@@ -107,38 +176,25 @@ namespace gam300 {
             imgui_fbo = std::move(temp_fbo);
         }
 
-        // Set up the framebuffer and game scene texture for imgui viewport
-        glBindFramebuffer(GL_FRAMEBUFFER, imgui_fbo->handle());
-        
-        // Creating texture object for imgui
-        int windowWidth = 640;
-        int windowHeight = 480;
-        //int windowWidth = IMGUIM.getWindowWidthHeight().x;
-        //int windowHeight = IMGUIM.getWindowWidthHeight().y;
-        glGenTextures(1, &imguiTex);
-        glBindTexture(GL_TEXTURE_2D, imguiTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, windowWidth , windowHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        // Attaching texture object for imgui to framebuffer 
-        imgui_fbo->attach_color(GL_COLOR_ATTACHMENT0, imguiTex);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        MeshData cubeData = Shape::make_cube();
-        MeshData planeData = Shape::make_plane();
-        MeshData sphereData = Shape::make_sphere();
-
-        MeshGL   cubeGL = Shape::upload_mesh_data(cubeData);
-        MeshGL   planeGL = Shape::upload_mesh_data(planeData);
-        MeshGL   sphereGL = Shape::upload_mesh_data(sphereData);
-
-        meshStorage.push_back(std::move(cubeGL));
-        meshStorage.push_back(std::move(planeGL));
-        meshStorage.push_back(std::move(sphereGL));
+        // The game scene texture and its depth buffer are attached by update(), at the size
+        // the imgui viewport shows them
+
+        // Every static mesh shares the buffers and VAO of the pool, ids 0, 1 and 2
+        meshStorage.create(MESH_POOL_VERTICES, MESH_POOL_INDICES);
+
+        // Built-in shapes go through the same cooking as imported meshes, so they get LOD chains too
+        MeshImporter mesh_cooker;
+        mesh_cooker.GetSettings().vertexFormat = meshStorage.vertex_format();
+        for (MeshData shape : { Shape::make_cube(), Shape::make_plane(), Shape::make_sphere() }) {
+            MeshBlobData cooked = mesh_cooker.Cook(std::move(shape));
+            MeshBlob blob;
+            std::optional<u32> mesh_id = blob.assign(serializeMeshBlob(cooked)) ? meshStorage.add(blob) : std::nullopt;
+            if (!mesh_id) {
+                LM.writeLog("GraphicsManager::startUp() - Failed to add a built-in mesh to the mesh pool");
+                return -1;
+            }
+            LM.writeLog("GraphicsManager::startUp() - Mesh %u has %u LODs", *mesh_id, meshStorage.get(*mesh_id).lod_count);
+        }
 
 
         // Log startup
@@ -152,6 +208,31 @@ namespace gam300 {
         LM.writeLog("GraphicsManager::shutDown() - Shutting down Graphics Manager");
 
         // Reset/Clear anything if needed
+        frame_graph.clear();
+        imgui_fbo.reset();
+        render_targets.clear();
+        imguiTex = 0;
+        sceneDepth = 0;
+        render_queue.clear();
+        shadow_queue.clear();
+        render_backend.release();
+        meshStorage.destroy();
+        texture_streamer.destroy();
+        material_textures.clear();
+        material_table.destroy();
+        texture_atlas.destroy();
+        sampler_cache.clear();
+        texture_uploader.destroy();
+        for (ShaderVariants& shader : shadersStorage) {
+            shader.destroy();
+        }
+        shadersStorage.clear();
+        camera_ubo = VBO();
+        light_ubo = VBO();
+        cluster_ubo = VBO();
+        shadow_ubo = VBO();
+        light_clusters.destroy();
+        shadow_cascades.destroy();
 
         //// Clear stored states
         //m_key_states.clear();
@@ -174,6 +255,31 @@ namespace gam300 {
         -
         */
 
+        // Calls issued and skipped by the state tracker are counted per frame
+        GLS.begin_frame();
+
+        // Render at the size the imgui viewport shows the scene. Last frame's color target goes
+        // back to the pool first, so while the size holds the same texture comes back and the
+        // framebuffer keeps its attachment. ImGui has already drawn last frame's texture.
+        // The depth buffer only lives during the frame, it is a transient of the frame graph.
+        const Vector2D viewport_size = IMGUIM.getViewportSize();
+        const int viewport_width = viewport_size.x >= 1.0f ? static_cast<int>(viewport_size.x) : VIEWPORT_WIDTH;
+        const int viewport_height = viewport_size.y >= 1.0f ? static_cast<int>(viewport_size.y) : VIEWPORT_HEIGHT;
+        const float aspect = static_cast<float>(viewport_width) / static_cast<float>(viewport_height);
+
+        render_targets.begin_frame();
+        if (imguiTex != 0) {
+            render_targets.release(imguiTex);
+        }
+        const GLuint scene_color = render_targets.acquire({ static_cast<u32>(viewport_width), static_cast<u32>(viewport_height), SCENE_COLOR_FORMAT });
+        if (scene_color != imguiTex) {
+            imgui_fbo->attach_color(GL_COLOR_ATTACHMENT0, scene_color);
+        }
+        imguiTex = scene_color;
+
+        // Finish the textures that were decoded since the last frame
+        texture_uploader.update();
+
         // Temporary input for cursor to move camera
         if (IM.isKeyPressed(GLFW_KEY_LEFT_SHIFT)) {
 
@@ -188,7 +294,7 @@ namespace gam300 {
 
                     main_camera.cameraOnCursor(mouseDeltaX * extraSensitivity,
                         mouseDeltaY * extraSensitivity,
-                        &shadersStorage[0]);
+                        &shadersStorage[0].get());
                 }
             }
         }
@@ -219,37 +325,71 @@ namespace gam300 {
 
         // Handle diagonal movement (multiple keys pressed)
         if (keyPressed) {
-            main_camera.cameraOnCursor(keyDeltaX, keyDeltaY, &shadersStorage[0]);
+            main_camera.cameraOnCursor(keyDeltaX, keyDeltaY, &shadersStorage[0].get());
         }
 
-        // Set up shader program
-        shadersStorage[0].programUse();
-
-        // Temporary transformations for camera
-        //shadersStorage[0].setUniform("M", transform.getTransformationMatrix()); // Model transform
-        shadersStorage[0].setUniform("V", main_camera.getLookAt()); // View transform
-        shadersStorage[0].setUniform("P", main_camera.getPerspective()); // Perspective transform
-
-        // Set uniform to shader after update light values
-        shadersStorage[0].setUniform("light.position", main_light.getLightPos());  // Position
-        shadersStorage[0].setUniform("light.La", main_light.getLightAmbient());        // Ambient
-        shadersStorage[0].setUniform("light.Ld", main_light.getLightDiffuse());        // Diffuse
-        shadersStorage[0].setUniform("light.Ls", main_light.getLightSpecular());        // Specular
-
         //Temporary input for light cursor
         if (IM.isKeyPressed(GLFW_KEY_L)) {
             //std::cout << IM.getMouseDeltaX() << std::endl;
-            main_light.lightOnCursor(IM.getMouseDeltaX(), IM.getMouseDeltaY(), &shadersStorage[0]);
+            main_light.lightOnCursor(IM.getMouseDeltaX(), IM.getMouseDeltaY());
         }
 
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS); // Default comparison
+        // Upload the camera and light once, every program reads them from the same buffers
+        CameraBlock camera_block;
+        camera_block.V = main_camera.getLookAt();                                    // View transform
+        camera_block.P = main_camera.getPerspective(aspect);                         // Perspective transform
+        camera_block.VP = camera_block.P * camera_block.V;
+        camera_block.camera_position = glm::vec4(main_camera.getCamPos(), 1.0f);
+        camera_ubo.sub_data(0, sizeof(CameraBlock), &camera_block);
+
+        LightBlock light_block;
+        light_block.position = glm::vec4(main_light.getLightPos(), 1.0f);           // Position
+        light_block.La = glm::vec4(main_light.getLightAmbient(), 0.0f);             // Ambient
+        light_block.Ld = glm::vec4(main_light.getLightDiffuse(), 0.0f);             // Diffuse
+        light_block.Ls = glm::vec4(main_light.getLightSpecular(), 0.0f);            // Specular
+        light_ubo.sub_data(0, sizeof(LightBlock), &light_block);
+
+        // Local lights in view space, each fragment only shades the ones of its cluster
+        light_clusters.set_projection(camera_block.P, main_camera.getCamNear(), main_camera.getCamFar(),
+            static_cast<u32>(viewport_width), static_cast<u32>(viewport_height));
+        light_clusters.clear();
+        for (const auto light_ID : EM.getEntitiesWithComponent<LightComponent>()) {
+            const LightComponent* light = EM.getComponent<LightComponent>(light_ID);
+            const Transform3D* transform = EM.getComponent<Transform3D>(light_ID);
+            if (!transform || !light->isEnabled() || light->getRange() <= 0.0f) {
+                continue;
+            }
 
-        // Bind framebuffer object for IMGUI viewport
-        glBindFramebuffer(GL_FRAMEBUFFER, imgui_fbo->handle());
+            const glm::mat4 model = transform->getTransformationMatrix();
+            const glm::vec3 position = glm::vec3(camera_block.V * model[3]);
+            const glm::vec3 color = light->getColor() * light->getIntensity();
+            if (light->getType() == LightType::SPOT) {
+                const glm::vec3 direction = glm::normalize(glm::mat3(camera_block.V) * glm::mat3(model) * light->getDirection());
+                light_clusters.add_spot(position, light->getRange(), color, direction,
+                    std::cos(glm::radians(light->getInnerAngle())), std::cos(glm::radians(light->getOuterAngle())));
+            }
+            else {
+                light_clusters.add_point(position, light->getRange(), color);
+            }
+        }
+        light_clusters.assign();
+        light_clusters.upload();
 
-        // Clear the color and depth buffer
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // temporary comment for the imgui
+        ClusterBlock cluster_block;
+        const LightClusterDesc& cluster_desc = light_clusters.get_desc();
+        cluster_block.grid = glm::uvec4(cluster_desc.tiles_x, cluster_desc.tiles_y, cluster_desc.slices, light_clusters.light_count());
+        cluster_block.depth = glm::vec4(light_clusters.get_near(), light_clusters.get_far(), light_clusters.get_slice_scale_bias());
+        cluster_block.tile_size = glm::vec4(light_clusters.get_tile_size(), 0.0f, 0.0f);
+        cluster_ubo.sub_data(0, sizeof(ClusterBlock), &cluster_block);
+
+        camera_ubo.bind_base(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING);
+        light_ubo.bind_base(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING);
+        cluster_ubo.bind_base(GL_UNIFORM_BUFFER, CLUSTER_BLOCK_BINDING);
+
+        // Materials and the atlas are shared by every draw of the frame
+        material_table.update();
+        texture_atlas.update();
+        GLS.bind_texture(DIFFUSE_ATLAS_UNIT, texture_atlas.handle());
 
         // Enable choosing of mesh
         if (IM.isKeyPressed(GLFW_KEY_1)) {
@@ -262,60 +402,328 @@ namespace gam300 {
             selected_mesh = 2;
         }
 
-        const MeshGL& mesh = meshStorage[selected_mesh];
+        // Collect everything that could be drawn, entities without a MeshRenderer draw the selected mesh
+        frustum_culler.clear();
+        candidates.clear();
+        candidate_instances.clear();
+        u32 dynamic_candidates = 0;
+        u64 static_revision = FNV_OFFSET;
 
-        // KENNY TESTING: ACCESSING ENTITIES AND UPDATING THEIR TRANSFORMS PER FRAME     
         const auto transform_entities_IDs = EM.getEntitiesWithComponent<Transform3D>();
         for (const auto transform_ID : transform_entities_IDs) {
+            u32 mesh_id = static_cast<u32>(selected_mesh);
+            u32 material_id = 0;
 
-            // Get entity's transform component using ID
-            if (EM.hasComponent<Transform3D>(transform_ID)) { // Extra check just in case 
-                Transform3D* transform = EM.getComponent<Transform3D>(transform_ID);
-                shadersStorage[0].setUniform("M", transform->getTransformationMatrix()); // Model transform
+            if (EM.hasComponent<MeshRenderer>(transform_ID)) {
+                MeshRenderer* renderer = EM.getComponent<MeshRenderer>(transform_ID);
+                if (!renderer->isVisible() || !meshStorage.valid(renderer->getMeshID())) {
+                    continue;
+                }
+                mesh_id = renderer->getMeshID();
+                material_id = renderer->getMaterialID();
             }
 
-            // Bind selected mesh
-            mesh.vao.bind();
+            const Transform3D* transform = EM.getComponent<Transform3D>(transform_ID);
+            const PoolMesh& mesh = meshStorage.get(mesh_id);
+
+            InstanceData instance;
+            instance.model = transform->getTransformationMatrix();
+            instance.position_offset = mesh.position_offset;
+            instance.position_scale = mesh.position_scale;
+            instance.material = material_id < material_table.size() ? material_id : 0;
+
+            // Bodies that physics moves are drawn into the shadow maps every frame, everything
+            // else is static and its shadow is cached until the revision changes
+            const RigidBody* body = EM.getComponent<RigidBody>(transform_ID);
+            const bool dynamic = body && !body->isStatic();
+            if (dynamic) {
+                ++dynamic_candidates;
+            }
+            else {
+                static_revision = hashBytes(static_revision, &transform_ID, sizeof(transform_ID));
+                static_revision = hashBytes(static_revision, &mesh_id, sizeof(mesh_id));
+                static_revision = hashBytes(static_revision, glm::value_ptr(instance.model), sizeof(instance.model));
+            }
 
-            // Draw the actual object
-            glDrawElements(mesh.primitive_type, mesh.draw_count, mesh.index_type, NULL);
+            candidates.push_back({ transform_ID, mesh_id, instance.material, dynamic });
+            candidate_instances.push_back(instance);
+            frustum_culler.add(instance.model, mesh.bounds);
+        }
 
-            // Unbind mesh
-            glBindVertexArray(0);
+        // Passes of the frame, ordered by what they read and write. The scene color outlives
+        // the frame for ImGui and the shadow map keeps its static layers, so both are imported.
+        frame_graph.clear();
+        const FrameGraphResource scene_target = frame_graph.import_texture("SceneColor", imguiTex);
+        FrameGraphResource shadow_target = INVALID_FRAME_GRAPH_RESOURCE;
+        if (shadow_cascades.valid()) {
+            shadow_target = frame_graph.import_texture("ShadowMap", shadow_cascades.get_shadow_map());
+            frame_graph.add_pass("Shadows",
+                [&](FrameGraphBuilder& builder) {
+                    builder.write(shadow_target);
+                },
+                [&](const FrameGraph&) {
+                    shadow_cascades.set_static_revision(static_revision);
+                    renderShadows(camera_block.V, camera_block.P, dynamic_candidates);
+                });
+        }
 
+        FrameGraphResource depth_target = INVALID_FRAME_GRAPH_RESOURCE;
+        frame_graph.add_pass("Scene",
+            [&](FrameGraphBuilder& builder) {
+                if (shadow_target != INVALID_FRAME_GRAPH_RESOURCE) {
+                    builder.read(shadow_target);
+                }
+                depth_target = builder.create("SceneDepth", { static_cast<u32>(viewport_width), static_cast<u32>(viewport_height), SCENE_DEPTH_FORMAT });
+                builder.write(scene_target);
+            },
+            [&](const FrameGraph& graph) {
+                renderScene(camera_block, graph.get_texture(depth_target), viewport_width, viewport_height, aspect);
+            });
+
+        if (frame_graph.compile()) {
+            frame_graph.execute(render_targets);
         }
 
-        shadersStorage[0].programFree();
+        // Request the levels this frame asked for and evict over the budget, then point the
+        // materials at the textures holding the levels now resident
+        texture_streamer.update();
+        for (u32 material = 0; material < material_textures.size(); ++material) {
+            if (!material_textures[material].empty()) {
+                material_table.set_diffuse_texture(material, texture_streamer.get_handle(material_textures[material].front()));
+            }
+        }
 
-        // Unbind framebuffer object
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // The program and VAO stay bound, the tracker skips binding them again next frame.
+        // ImGui draws to the window, so the framebuffer does go back to it.
+        FrameBuffer::unbind();
     }
 
-    bool GraphicsManager::loadShaderPrograms(std::vector<std::pair<std::string, std::string>> shaders) {
+    void GraphicsManager::renderScene(const CameraBlock& camera_block, GLuint depth_texture, int viewport_width, int viewport_height,
+        float aspect) {
+        ShadowBlock shadow_block;
+        shadow_cascades.fill_block(camera_block.V, shadow_block);
+        shadow_ubo.sub_data(0, sizeof(ShadowBlock), &shadow_block);
+        shadow_ubo.bind_base(GL_UNIFORM_BUFFER, SHADOW_BLOCK_BINDING);
+        GLS.bind_texture(SHADOW_MAP_UNIT, shadow_cascades.get_shadow_map());
+
+        // Only reaches the driver when something else changed it since the last frame
+        GLS.set_enabled(GL_DEPTH_TEST, true);
+        GLS.depth_func(GL_LESS); // Default comparison
+
+        // The pool hands back the same depth texture while the size holds, so it is only
+        // attached again after a resize
+        if (depth_texture != sceneDepth) {
+            imgui_fbo->attach_depth(depth_texture, true);
+            sceneDepth = depth_texture;
+        }
+
+        // Bind framebuffer object for IMGUI viewport, the shadow pass left its own viewport
+        imgui_fbo->bind();
+        GLS.viewport(0, 0, viewport_width, viewport_height);
+
+        // Clear the color and depth buffer
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // temporary comment for the imgui
+
+        // Only what is inside the view frustum reaches the render queue. Culled after the
+        // cascades, so the counters are those of the view.
+        frustum_culler.cull(main_camera.getFrustumPlanes(aspect), visible_objects);
+
+        // Each visible entity draws the LOD its projected size calls for. LODs are separate
+        // index ranges of the mesh, so the mesh field of the key holds the LOD as well and
+        // entities sharing a mesh and LOD still batch into one instanced command.
+        const glm::vec3 camera_position = main_camera.getCamPos();
+        const float far_plane = main_camera.getCamFar();
+        lod_selector.begin_frame(camera_block.P, static_cast<float>(viewport_height));
+
+        // Without a specular light the object shader variant that leaves the term out is used
+        ShaderVariants& object_shader = shadersStorage[0];
+        const bool specular = glm::any(glm::greaterThan(main_light.getLightSpecular(), glm::vec3(0.0f)));
+        u32 object_variant = specular ? 0 : object_shader.getOptionMask(NO_SPECULAR_OPTION);
+        if (material_table.bindless()) {
+            object_variant |= object_shader.getOptionMask(BINDLESS_OPTION);
+        }
+        const GLuint object_program = object_shader.getVariant(object_variant).getShaderProgramHandle();
+
+        render_queue.clear();
+        for (u32 object : visible_objects) {
+            const DrawCandidate& candidate = candidates[object];
+            const PoolMesh& mesh = meshStorage.get(candidate.mesh_id);
+            const glm::vec4 sphere = frustum_culler.get_sphere(object);
+            const u32 lod = lod_selector.select(candidate.entity, mesh, sphere, camera_position);
+            const float distance = glm::length(glm::vec3(sphere) - camera_position);
+
+            // Material the instance is drawn with, unknown material IDs were clamped to 0
+            const u32 material = candidate_instances[object].material;
+
+            // The textures of the material are needed at about the size the object covers
+            if (material < material_textures.size() && !material_textures[material].empty()) {
+                const float pixels = lod_selector.projected_diameter(sphere, camera_position);
+                for (TextureStreamID texture : material_textures[material]) {
+                    texture_streamer.note_usage(texture, pixels);
+                }
+            }
+
+            // The instance carries its material, so only a texture bound for the draw has to
+            // split instances of the same mesh. Every other material sorts as material 0.
+            const GLuint texture = material_table.get_bound_texture(material);
+
+            DrawItem item;
+            item.key = RenderQueue::make_key(RenderPass::SOLID, 0, texture != 0 ? material : 0,
+                candidate.mesh_id * MAX_MESH_LODS + lod, RenderQueue::depth_bucket(distance, far_plane));
+            item.program = object_program;
+            item.texture = texture;
+            item.sampler = material_table.get_bound_sampler(material);
+            item.vao = meshStorage.vertex_array().id();
+            item.index_type = mesh.index_type;
+            item.index_count = static_cast<GLsizei>(mesh.lods[lod].index_count);
+            item.first_index = mesh.lods[lod].first_index;
+            item.base_vertex = static_cast<i32>(mesh.vertex_offset);
+
+            render_queue.push(item, candidate_instances[object]);
+        }
+
+        // Sort by pass, shader, material, mesh then depth, and draw each run of the same mesh once
+        render_queue.sort();
+        render_queue.submit(render_backend);
+    }
+
+    void GraphicsManager::renderShadows(const glm::mat4& view, const glm::mat4& projection, u32 dynamic_candidates) {
+        shadow_cascades.update(view, projection, main_camera.getCamNear(), main_camera.getCamFar(), main_light.getLightDirection());
+
+        const GLuint shadow_program = shadersStorage[SHADOW_DEPTH_SHADER].get().getShaderProgramHandle();
+
+        // Queue the casters of one kind. Texels grow with each cascade, so the meshes drawn
+        // into it can be as coarse as its index in their LOD chain.
+        auto queue_casters = [&](u32 cascade, bool dynamic) {
+            shadow_queue.clear();
+            for (u32 object : shadow_casters) {
+                const DrawCandidate& candidate = candidates[object];
+                if (candidate.dynamic != dynamic) {
+                    continue;
+                }
+
+                const PoolMesh& mesh = meshStorage.get(candidate.mesh_id);
+                const u32 lod = std::min(cascade, mesh.lod_count - 1);
+
+                DrawItem item;
+                item.key = RenderQueue::make_key(RenderPass::SOLID, 0, 0, candidate.mesh_id * MAX_MESH_LODS + lod, 0);
+                item.program = shadow_program;
+                item.vao = meshStorage.vertex_array().id();
+                item.index_type = mesh.index_type;
+                item.index_count = static_cast<GLsizei>(mesh.lods[lod].index_count);
+                item.first_index = mesh.lods[lod].first_index;
+                item.base_vertex = static_cast<i32>(mesh.vertex_offset);
+                shadow_queue.push(item, candidate_instances[object]);
+            }
+            shadow_queue.sort();
+            return static_cast<u32>(shadow_queue.size());
+        };
+
+        shadow_cascades.begin_casters();
+        for (u32 cascade = 0; cascade < shadow_cascades.cascade_count(); ++cascade) {
+            const bool draw_static = shadow_cascades.needs_static(cascade);
+
+            // A cascade with a valid static layer and no dynamic casters only needs its copy
+            shadow_casters.clear();
+            if (draw_static || dynamic_candidates > 0) {
+                frustum_culler.cull(shadow_cascades.get_caster_planes(cascade), shadow_casters);
+                glProgramUniformMatrix4fv(shadow_program, LIGHT_VIEW_PROJECTION_LOCATION, 1, GL_FALSE,
+                    glm::value_ptr(shadow_cascades.get_view_projection(cascade)));
+            }
+
+            u32 static_count = 0;
+            if (draw_static) {
+                static_count = queue_casters(cascade, false);
+                shadow_cascades.begin_static(cascade);
+                shadow_queue.submit(render_backend);
+                shadow_cascades.end_static(cascade);
+            }
+
+            const u32 dynamic_count = queue_casters(cascade, true);
+            if (shadow_cascades.composite(cascade, dynamic_count > 0)) {
+                shadow_queue.submit(render_backend);
+            }
+            shadow_cascades.count_casters(static_count, dynamic_count);
+        }
+        shadow_cascades.end_casters();
+    }
+
+    void GraphicsManager::setMaterialTextures(u32 material_id, std::vector<TextureStreamID> textures) {
+        if (material_id >= material_textures.size()) {
+            material_textures.resize(material_id + 1);
+        }
+        material_textures[material_id] = std::move(textures);
+    }
+
+    bool GraphicsManager::addAtlasTexture(u32 material_id, const u8* pixels, u32 width, u32 height) {
+        if (material_id >= material_table.size()) {
+            LM.writeLog("GraphicsManager::addAtlasTexture() - Material %u does not exist", material_id);
+            return false;
+        }
+        if (!texture_atlas.valid() && !texture_atlas.create(TextureAtlasDesc{})) {
+            return false;
+        }
+
+        std::optional<AtlasRegion> region = texture_atlas.add(pixels, width, height);
+        if (!region) {
+            return false;
+        }
+        material_table.set_diffuse_atlas(material_id, *region);
+        return true;
+    }
+
+    bool GraphicsManager::loadShaderPrograms(std::vector<std::pair<std::string, std::string>> shaders, std::vector<std::string> options) {
         for (auto const& file : shaders) { 
             // Create the shader files vector with types 
             std::vector<std::pair<GLenum, std::string>> shader_files; 
             shader_files.emplace_back(std::make_pair(GL_VERTEX_SHADER, file.first)); 
             shader_files.emplace_back(std::make_pair(GL_FRAGMENT_SHADER, file.second)); 
 
-            // Create new shader program
-            ShaderProgram shader_program; 
+            // Create new shader program, permutations other than the default one compile on first use
+            ShaderVariants shader_program(shader_files, options);
+
+            // Shaders declare the binding too, this covers any that leave it out
+            shader_program.bindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+            shader_program.bindUniformBlock("LightBlock", LIGHT_BLOCK_BINDING);
 
             // Use Graphics_Manager to compile the shader
-            if (!shader_program.compileShader(shader_files)) {
+            if (!shader_program.isValid()) {
                 LM.writeLog("GraphicsManager::loadShaderPrograms(): Shader program failed to compile.");
                 return false;
             }
 
             // Insert shader program into vector
-            shadersStorage.emplace_back(shader_program);
+            LM.writeLog("GraphicsManager::loadShaderPrograms(): Shader program handle is %u.", shader_program.get().getShaderProgramHandle());
+            shadersStorage.emplace_back(std::move(shader_program));
             std::size_t shader_idx = shadersStorage.size() - 1;
 
-            LM.writeLog("GraphicsManager::loadShaderPrograms(): Shader program handle is %u.", shader_program.getShaderProgramHandle());
             LM.writeLog("GraphicsManager::loadShaderPrograms(): Shader program %zu created, compiled and added successfully.", shader_idx);
         }
+
+        const ShaderCacheStats& cache_stats = ShaderCache::getStats();
+        LM.writeLog("GraphicsManager::loadShaderPrograms(): Program binary cache %u hits, %u misses (%u rejected by the driver), %u stored.",
+            cache_stats.hits, cache_stats.misses, cache_stats.rejected, cache_stats.stored);
         return true;
     }
 
+    void GraphicsManager::onAssetsChanged(const std::vector<ScanChange>& changes) {
+        for (std::size_t shader_idx = 0; shader_idx < shadersStorage.size(); ++shader_idx) {
+            ShaderVariants& shader = shadersStorage[shader_idx];
+
+            // A stage file or anything it includes, removed files are left to fail on the next edit
+            const bool affected = std::any_of(changes.begin(), changes.end(), [&shader](const ScanChange& change) {
+                return change.kind != ScanChange::Kind::Removed &&
+                    shader.dependsOn(ShaderProgram::normalizeShaderPath(change.sourcePath));
+            });
+            if (!affected) {
+                continue;
+            }
+
+            const u32 reloaded = shader.reload();
+            LM.writeLog("GraphicsManager::onAssetsChanged(): Shader program %zu reloaded, %u of %zu variants replaced.",
+                shader_idx, reloaded, shader.getVariantCount());
+        }
+    }
+
 
 } // end of namespace gam300
\ No newline at end of file
@@ -27,10 +27,29 @@
 // To support graphical operations
 #include "../Utility/Constant.h"
 #include "../Graphics/ShaderProgram.h"
+#include "../Graphics/ShaderVariants.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/Light.h"
 #include "../Graphics/Shape.h"
 #include "../Graphics/Framebuffer.h" 
+#include "../Graphics/GLStateTracker.h"
+#include "../Graphics/UniformBlocks.h"
+#include "../Graphics/RenderQueue.h"
+#include "../Graphics/FrustumCuller.h"
+#include "../Graphics/MeshPool.h"
+#include "../Graphics/LodSelector.h"
+#include "../Graphics/TextureUploader.h"
+#include "../Graphics/TextureStreamer.h"
+#include "../Graphics/TextureAtlas.h"
+#include "../Graphics/SamplerCache.h"
+#include "../Graphics/MaterialTable.h"
+#include "../Graphics/LightClusters.h"
+#include "../Graphics/ShadowCascades.h"
+#include "../Graphics/RenderTargetPool.h"
+#include "../Graphics/FrameGraph.h"
+
+// For the asset changes that trigger shader hot reload
+#include "../Pipeline/AssetScanner.h"
 
 // For IMGUI operations
 #include "ImguiManager.h"
@@ -62,9 +81,9 @@ namespace gam300 {
     private:
         GraphicsManager();                      // Private since a singleton.
 
-        // Storage for shader programs (Will port to asset manager eventually)
-        std::vector<ShaderProgram> shadersStorage;
-        std::vector<MeshGL>        meshStorage;
+        // Storage for shader programs and their permutations (Will port to asset manager eventually)
+        std::vector<ShaderVariants> shadersStorage;
+        MeshPool                   meshStorage;     // Static meshes, ids are MeshRenderer mesh ids
         
         // Main camera
         Camera3D main_camera;
@@ -72,13 +91,77 @@ namespace gam300 {
         // Main light
         Light main_light;
 
-        // Framebuffer object and texture for IMGUI
+        // Uniform buffers for the per-frame camera, light, cluster and shadow blocks
+        VBO camera_ubo;
+        VBO light_ubo;
+        VBO cluster_ubo;
+        VBO shadow_ubo;
+
+        // Lights of every LightComponent, assigned to clusters of the view frustum
+        LightClusters light_clusters;
+
+        // Shadow maps of the main light, static casters are cached per cascade
+        ShadowCascades shadow_cascades;
+        RenderQueue shadow_queue;
+        std::vector<u32> shadow_casters;            // Culler objects inside the cascade being drawn
+
+        // Framebuffer object and texture for IMGUI, the color texture is a render target
+        // acquired again every frame at the size of the imgui viewport. The depth texture
+        // is a transient of the frame graph, sceneDepth is the one currently attached.
         GLuint imguiTex{ 0 };
+        GLuint sceneDepth{ 0 };
         std::optional<FrameBuffer> imgui_fbo; 
 
+        // Textures passes render into, reused across frames and reallocated on resize
+        RenderTargetPool render_targets;
+
+        // Passes of the current frame, rebuilt every update
+        FrameGraph frame_graph;
+
         // Mesh selection
         int selected_mesh{ 0 };
 
+        // Draw items of the frame, sorted by key and submitted as instanced draws
+        RenderQueue render_queue;
+        GLRenderBackend render_backend;
+
+        // Frustum culling before anything reaches the render queue
+        struct DrawCandidate {
+            EntityID entity;
+            u32      mesh_id;
+            u32      material_id;                   // Clamped like InstanceData::material
+            bool     dynamic;                       // Moved by physics, never cached in the static shadow layers
+        };
+        FrustumCuller frustum_culler;
+        std::vector<DrawCandidate> candidates;      // Indexed like the culler objects
+        std::vector<InstanceData> candidate_instances;
+        std::vector<u32> visible_objects;
+
+        // Level of detail of each visible entity
+        LodSelector lod_selector;
+
+        // Draw the casters of every cascade, the static ones only into stale static layers
+        void renderShadows(const glm::mat4& view, const glm::mat4& projection, u32 dynamic_candidates);
+
+        // Draw the visible candidates into the imgui framebuffer with the given depth texture
+        void renderScene(const CameraBlock& camera_block, GLuint depth_texture, int viewport_width, int viewport_height,
+            float aspect);
+
+        // Textures decoded on workers, uploaded at the start of each frame
+        TextureUploader texture_uploader;
+
+        // Mip residency of cooked textures, driven by how large their materials are on screen
+        TextureStreamer texture_streamer;
+        std::vector<std::vector<TextureStreamID>> material_textures;    // Indexed by material ID
+
+        // One sampler object per distinct SamplerDesc, shared by the materials using it
+        SamplerCache sampler_cache;
+
+        // Materials read per instance from one buffer, with their diffuse textures in the
+        // atlas or behind bindless handles so draws of different textures share a batch
+        MaterialTable material_table;
+        TextureAtlas texture_atlas;                 // Created by the first addAtlasTexture
+
     public:
         /**
          * @brief Get the singleton instance of the GraphicsManager.
@@ -103,9 +186,64 @@ namespace gam300 {
         void update();
 
         // To load all shader program at start up (the pair of 2 strings are the vertex and fragment shaders' filepath)
-        bool loadShaderPrograms(std::vector<std::pair<std::string, std::string>> shaders);
+        // Options are the #define permutations every program can be compiled with, each variant is compiled on first use
+        bool loadShaderPrograms(std::vector<std::pair<std::string, std::string>> shaders, std::vector<std::string> options = {});
+
+        /**
+         * @brief Reload the shader programs that read a changed file, for AssetManager change listeners.
+         * @param changes Changes of the last asset scan.
+         */
+        void onAssetsChanged(const std::vector<ScanChange>& changes);
 
         GLuint getImguiTex() { return imguiTex; }
+
+        // Culling counters of the last frame
+        const CullStats& getCullStats() const { return frustum_culler.get_stats(); }
+
+        // LOD counters of the last frame, and the settings shared by every entity (bias, pixel error, hysteresis)
+        const LodStats& getLodStats() const { return lod_selector.get_stats(); }
+        LodSettings& getLodSettings() { return lod_selector.get_settings(); }
+
+        // Asynchronous texture loads, used by the texture resource loader
+        TextureUploader& getTextureUploader() { return texture_uploader; }
+
+        // Streamed textures, used by the texture resource loader, and their counters of the last frame
+        TextureStreamer& getTextureStreamer() { return texture_streamer; }
+        const TextureStreamStats& getTextureStreamStats() const { return texture_streamer.get_stats(); }
+
+        /**
+         * @brief Set the streamed textures a material samples, so drawing it keeps their levels resident.
+         * @details The first texture is the diffuse texture of the material.
+         */
+        void setMaterialTextures(u32 material_id, std::vector<TextureStreamID> textures);
+
+        // Properties of every material, material 0 is used by entities without one
+        MaterialTable& getMaterialTable() { return material_table; }
+        const TextureAtlasStats& getTextureAtlasStats() const { return texture_atlas.get_stats(); }
+        SamplerCache& getSamplerCache() { return sampler_cache; }
+        const LightClusterStats& getLightClusterStats() const { return light_clusters.get_stats(); }
+        const ShadowCascadeStats& getShadowStats() const { return shadow_cascades.get_stats(); }
+
+        /**
+         * @brief Draw the static shadow casters again, for changes the revision hash cannot see.
+         */
+        void invalidateStaticShadows() { shadow_cascades.invalidate(); }
+
+        // Render targets owned by the pool and how they were served
+        const RenderTargetPoolStats& getRenderTargetStats() const { return render_targets.get_stats(); }
+
+        // Passes culled and transient memory saved by aliasing in the last frame
+        const FrameGraphStats& getFrameGraphStats() const { return frame_graph.get_stats(); }
+
+        // GL calls issued and skipped as no-ops by the state tracker during the last frame
+        const GLStateStats& getGLStateStats() const { return GLS.get_frame_stats(); }
+
+        /**
+         * @brief Pack a small texture into the atlas and make it the diffuse texture of a material.
+         * @param pixels Tightly packed RGBA8.
+         * @return false if it does not fit, the material keeps its texture.
+         */
+        bool addAtlasTexture(u32 material_id, const u8* pixels, u32 width, u32 height);
         //GLuint getImguiFbo() { return imguiFbo; }
 
     };
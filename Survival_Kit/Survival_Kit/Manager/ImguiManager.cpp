@@ -17,6 +17,9 @@
 #include "../Utility/AssetPath.h"
 #include "../Component/Transform3D.h"
 #include "../Component/RigidBody.h"
+#include "../Component/Collider.h"
+#include "../Component/MeshRenderer.h"
+#include "../Component/LightComponent.h"
 
 
 namespace gam300 {
@@ -394,6 +397,15 @@ namespace gam300 {
                     //displayComponentMenu<RigidBody>(selectedEntity.get_id(), "RigidBody");
 
                 }
+                if (ImguiEcsRef.hasComponent<Collider>(selectedEntity.get_id())) {
+                    displayComponentMenu<Collider>(selectedEntity.get_id(), "Collider");
+                }
+                if (ImguiEcsRef.hasComponent<MeshRenderer>(selectedEntity.get_id())) {
+                    displayComponentMenu<MeshRenderer>(selectedEntity.get_id(), "MeshRenderer");
+                }
+                if (ImguiEcsRef.hasComponent<LightComponent>(selectedEntity.get_id())) {
+                    displayComponentMenu<LightComponent>(selectedEntity.get_id(), "LightComponent");
+                }
                 
                
                 ImGui::Separator();
@@ -430,6 +442,21 @@ namespace gam300 {
                             ImguiEcsRef.addComponent<RigidBody>(selectedEntity.get_id());
                         }
                     }
+                    if (ImGui::MenuItem("Collider")) {
+                        if (!ImguiEcsRef.hasComponent<Collider>(selectedEntity.get_id())) {
+                            ImguiEcsRef.addComponent<Collider>(selectedEntity.get_id());
+                        }
+                    }
+                    if (ImGui::MenuItem("MeshRenderer")) {
+                        if (!ImguiEcsRef.hasComponent<MeshRenderer>(selectedEntity.get_id())) {
+                            ImguiEcsRef.addComponent<MeshRenderer>(selectedEntity.get_id());
+                        }
+                    }
+                    if (ImGui::MenuItem("LightComponent")) {
+                        if (!ImguiEcsRef.hasComponent<LightComponent>(selectedEntity.get_id())) {
+                            ImguiEcsRef.addComponent<LightComponent>(selectedEntity.get_id());
+                        }
+                    }
                    
                     ImGui::EndPopup();
                 }
@@ -503,7 +530,7 @@ namespace gam300 {
 
         if (texture) {
             ImGui::Image((ImTextureID)(intptr_t)GFXM.getImguiTex(),
-                ImVec2((static_cast<int>(getWindowWidthHeight().x) / 2), (static_cast<int>(getWindowWidthHeight().y) / 2)),
+                ImVec2(getViewportSize().x, getViewportSize().y),
                 ImVec2(0, 1), ImVec2(1, 0));
         }
 
@@ -609,9 +636,142 @@ namespace gam300 {
                         ImGui::EndCombo();
                     }
 
+                    // Opt in to swept collision for fast bodies like projectiles
+                    bool continuousCollision = rigidBody->getContinuousCollision();
+                    if (ImGui::Checkbox("Continuous Collision", &continuousCollision)) {
+                        rigidBody->setContinuousCollision(continuousCollision);
+                    }
+
                //}
             }
         }
+        else if constexpr (std::is_same_v<componentType, Collider>) {
+            if (Collider* collider = ImguiEcsRef.getComponent<Collider>(selectedEntityID)) {
+                const char* shapeNames[] = { "BOX", "SPHERE" };
+                const ColliderShape shapes[] = { ColliderShape::BOX, ColliderShape::SPHERE };
+                int currentShapeIndex = collider->getShape() == ColliderShape::SPHERE ? 1 : 0;
+
+                // Dropdown for the shape, only its own size is shown below
+                if (ImGui::BeginCombo("Shape", shapeNames[currentShapeIndex])) {
+                    for (int i = 0; i < 2; i++) {
+                        bool isSelected = (currentShapeIndex == i);
+                        if (ImGui::Selectable(shapeNames[i], isSelected)) {
+                            collider->setShape(shapes[i]);
+                        }
+                        if (isSelected)
+                            ImGui::SetItemDefaultFocus();
+                    }
+                    ImGui::EndCombo();
+                }
+
+                if (collider->getShape() == ColliderShape::BOX) {
+                    Vector3D half = collider->getHalfExtents();
+                    float halfExtents[3] = { half.x, half.y, half.z };
+                    if (ImGui::DragFloat3("Half Extents", halfExtents, 0.05f, 0.0f, 1000.0f)) {
+                        collider->setHalfExtents(Vector3D(halfExtents[0], halfExtents[1], halfExtents[2]));
+                    }
+                }
+                else {
+                    float radius = collider->getRadius();
+                    if (ImGui::DragFloat("Radius", &radius, 0.05f, 0.0f, 1000.0f)) {
+                        collider->setRadius(radius);
+                    }
+                }
+
+                Vector3D off = collider->getOffset();
+                float offset[3] = { off.x, off.y, off.z };
+                if (ImGui::DragFloat3("Offset", offset, 0.05f)) {
+                    collider->setOffset(Vector3D(offset[0], offset[1], offset[2]));
+                }
+
+                float restitution = collider->getRestitution();
+                if (ImGui::SliderFloat("Restitution", &restitution, 0.0f, 1.0f)) {
+                    collider->setRestitution(restitution);
+                }
+
+                // Layer is what this collider is, mask is what it collides with
+                uint32_t layer = collider->getLayer();
+                if (ImGui::InputScalar("Layer", ImGuiDataType_U32, &layer, nullptr, nullptr, "%08X",
+                    ImGuiInputTextFlags_CharsHexadecimal)) {
+                    collider->setLayer(layer);
+                }
+
+                uint32_t mask = collider->getMask();
+                if (ImGui::InputScalar("Mask", ImGuiDataType_U32, &mask, nullptr, nullptr, "%08X",
+                    ImGuiInputTextFlags_CharsHexadecimal)) {
+                    collider->setMask(mask);
+                }
+
+                bool isTrigger = collider->isTrigger();
+                if (ImGui::Checkbox("Is Trigger", &isTrigger)) {
+                    collider->setTrigger(isTrigger);
+                }
+            }
+        }
+        else if constexpr (std::is_same_v<componentType, MeshRenderer>) {
+            if (MeshRenderer* renderer = ImguiEcsRef.getComponent<MeshRenderer>(selectedEntityID)) {
+                // Entities with an unknown mesh are skipped, unknown materials fall back to material 0
+                uint32_t meshID = renderer->getMeshID();
+                if (ImGui::InputScalar("Mesh ID", ImGuiDataType_U32, &meshID)) {
+                    renderer->setMeshID(meshID);
+                }
+
+                uint32_t materialID = renderer->getMaterialID();
+                if (ImGui::InputScalar("Material ID", ImGuiDataType_U32, &materialID)) {
+                    renderer->setMaterialID(materialID);
+                }
+
+                bool visible = renderer->isVisible();
+                if (ImGui::Checkbox("Visible", &visible)) {
+                    renderer->setVisible(visible);
+                }
+            }
+        }
+        else if constexpr (std::is_same_v<componentType, LightComponent>) {
+            if (LightComponent* light = ImguiEcsRef.getComponent<LightComponent>(selectedEntityID)) {
+                const char* typeNames[] = { "POINT", "SPOT" };
+                int currentTypeIndex = static_cast<int>(light->getType());
+                if (ImGui::Combo("Type", &currentTypeIndex, typeNames, 2)) {
+                    light->setType(static_cast<LightType>(currentTypeIndex));
+                }
+
+                bool enabled = light->isEnabled();
+                if (ImGui::Checkbox("Enabled", &enabled)) {
+                    light->setEnabled(enabled);
+                }
+
+                glm::vec3 color = light->getColor();
+                if (ImGui::ColorEdit3("Color", &color.x)) {
+                    light->setColor(color);
+                }
+
+                float intensity = light->getIntensity();
+                if (ImGui::DragFloat("Intensity", &intensity, 0.05f, 0.0f, 1000.0f)) {
+                    light->setIntensity(intensity);
+                }
+
+                float range = light->getRange();
+                if (ImGui::DragFloat("Range", &range, 0.1f, 0.0f, 1000.0f)) {
+                    light->setRange(range);
+                }
+
+                // The cone only matters for a spot light
+                if (light->getType() == LightType::SPOT) {
+                    glm::vec3 direction = light->getDirection();
+                    if (ImGui::DragFloat3("Direction", &direction.x, 0.05f, -1.0f, 1.0f)) {
+                        light->setDirection(direction);
+                    }
+
+                    float innerAngle = light->getInnerAngle();
+                    float outerAngle = light->getOuterAngle();
+                    bool anglesChanged = ImGui::SliderFloat("Inner Angle", &innerAngle, 0.0f, 89.0f);
+                    anglesChanged |= ImGui::SliderFloat("Outer Angle", &outerAngle, 0.0f, 89.0f);
+                    if (anglesChanged) {
+                        light->setSpotAngles(innerAngle, outerAngle);
+                    }
+                }
+            }
+        }
 
     }
 
@@ -105,6 +105,9 @@ namespace gam300
 		// to retuen the width and height for imguiTex and imguiFbo
 		Vector2D getWindowWidthHeight() { return Vector2D(width, height); }
 
+		// size the scene texture is shown at in the viewport window, the GraphicsManager renders at this size
+		Vector2D getViewportSize() { return Vector2D(static_cast<float>(width / 2), static_cast<float>(height / 2)); }
+
 		// template to add the remove component menu right beside collapsing menu
 		template<typename componentType>
 		void displayComponentMenu(EntityID entityID, const char* componentName);
@@ -0,0 +1,183 @@
+/**
+ * @file JobManager.cpp
+ * @brief Implementation of the Job Manager for the game engine.
+ * @details Contains implementations for all member functions declared in JobManager.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "JobManager.h"
+#include "LogManager.h"
+#include <algorithm>
+
+namespace gam300 {
+
+    // Initialize singleton instance
+    JobManager::JobManager() : m_stop(false) {
+        setType("JobManager");
+    }
+
+    // Get the singleton instance
+    JobManager& JobManager::getInstance() {
+        static JobManager instance;
+        return instance;
+    }
+
+    // Start up the JobManager
+    int JobManager::startUp() {
+        // Call parent's startUp() first
+        if (Manager::startUp())
+            return -1;
+
+        // Leave one hardware thread for the caller, which also runs chunks
+        unsigned int hw_threads = std::thread::hardware_concurrency();
+        std::size_t worker_count = hw_threads > 1 ? hw_threads - 1 : 0;
+
+        m_stop = false;
+        m_workers.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; ++i) {
+            m_workers.emplace_back(&JobManager::workerLoop, this);
+        }
+
+        LM.writeLog("JobManager::startUp() - Job Manager started with %zu worker threads", worker_count);
+        return 0;
+    }
+
+    // Shut down the JobManager
+    void JobManager::shutDown() {
+        LM.writeLog("JobManager::shutDown() - Shutting down Job Manager");
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_work_cv.notify_all();
+
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+        m_batches.clear();
+
+        // Call parent's shutDown()
+        Manager::shutDown();
+    }
+
+    // Worker thread entry point
+    void JobManager::workerLoop() {
+        for (;;) {
+            std::shared_ptr<JobBatch> batch;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_work_cv.wait(lock, [this] { return m_stop || !m_batches.empty(); });
+                if (m_stop && m_batches.empty()) {
+                    return;
+                }
+                batch = m_batches.front();
+            }
+
+            // Nothing left to claim, retire the batch so the next one is picked up
+            if (!runChunks(*batch)) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = std::find(m_batches.begin(), m_batches.end(), batch);
+                if (it != m_batches.end()) {
+                    m_batches.erase(it);
+                }
+            }
+        }
+    }
+
+    // Claim and run chunks of a batch until none are left
+    bool JobManager::runChunks(JobBatch& batch) {
+        bool ran = false;
+        for (;;) {
+            std::size_t begin = batch.next.fetch_add(batch.grain);
+            if (begin >= batch.count) {
+                break;
+            }
+            std::size_t end = std::min(begin + batch.grain, batch.count);
+            batch.func(begin, end);
+            ran = true;
+
+            // Last chunk done, wake the thread waiting in parallelFor
+            if (batch.done.fetch_add(end - begin) + (end - begin) == batch.count) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done_cv.notify_all();
+            }
+        }
+        return ran;
+    }
+
+    // Run func over [0, count) in chunks of at most grain items
+    void JobManager::parallelFor(std::size_t count, std::size_t grain, const JobRangeFunc& func) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+
+        // Not worth waking anyone up, but keep the same chunk boundaries
+        if (m_workers.empty() || count <= grain) {
+            for (std::size_t begin = 0; begin < count; begin += grain) {
+                func(begin, std::min(begin + grain, count));
+            }
+            return;
+        }
+
+        auto batch = std::make_shared<JobBatch>();
+        batch->func = func;
+        batch->count = count;
+        batch->grain = grain;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_batches.push_back(batch);
+        }
+        m_work_cv.notify_all();
+
+        // Help out instead of idling
+        runChunks(*batch);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = std::find(m_batches.begin(), m_batches.end(), batch);
+        if (it != m_batches.end()) {
+            m_batches.erase(it);
+        }
+        m_done_cv.wait(lock, [&batch] { return batch->done.load() == batch->count; });
+    }
+
+    // Run a job on a worker thread without waiting for it
+    void JobManager::submit(std::function<void()> job) {
+        if (m_workers.empty()) {
+            job();
+            return;
+        }
+
+        // A single chunk batch that nobody waits on, the worker that claims it retires it
+        auto batch = std::make_shared<JobBatch>();
+        batch->func = [job = std::move(job)](std::size_t, std::size_t) { job(); };
+        batch->count = 1;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_batches.push_back(batch);
+        }
+        m_work_cv.notify_one();
+    }
+
+    // Number of chunks parallelFor will split count items into
+    std::size_t JobManager::chunkCount(std::size_t count, std::size_t grain) {
+        grain = std::max<std::size_t>(grain, 1);
+        return (count + grain - 1) / grain;
+    }
+
+    // Get the number of worker threads
+    std::size_t JobManager::getWorkerCount() const {
+        return m_workers.size();
+    }
+
+} // end of namespace gam300
@@ -0,0 +1,126 @@
+/**
+ * @file JobManager.h
+ * @brief Declaration of the Job Manager for the game engine.
+ * @details Owns a pool of worker threads and splits data-parallel work across them.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __JOB_MANAGER_H__
+#define __JOB_MANAGER_H__
+
+#include "Manager.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Two-letter acronym for easier access to manager.
+#define JM gam300::JobManager::getInstance()
+
+namespace gam300 {
+
+    /**
+     * @brief Range callback used by parallelFor.
+     * @details Receives a half open range [begin, end) of item indices to process.
+     */
+    using JobRangeFunc = std::function<void(std::size_t begin, std::size_t end)>;
+
+    class JobManager : public Manager {
+    private:
+        JobManager();                       // Private since a singleton.
+        JobManager(JobManager const&);      // Don't allow copy.
+        void operator=(JobManager const&);  // Don't allow assignment.
+
+        /**
+         * @brief One parallelFor call, shared between the caller and all workers.
+         * @details Chunks are claimed through an atomic cursor so a batch finishes as
+         *          soon as every chunk has been executed, whoever executed it.
+         */
+        struct JobBatch {
+            JobRangeFunc func;
+            std::size_t count = 0;
+            std::size_t grain = 1;
+            std::atomic<std::size_t> next{ 0 };
+            std::atomic<std::size_t> done{ 0 };
+        };
+
+        std::vector<std::thread> m_workers;                 // Worker threads
+        std::deque<std::shared_ptr<JobBatch>> m_batches;    // Batches that still have unclaimed chunks
+        std::mutex m_mutex;                                 // Guards m_batches and m_stop
+        std::condition_variable m_work_cv;                  // Signalled when a batch is queued
+        std::condition_variable m_done_cv;                  // Signalled when a batch completes
+        bool m_stop;                                        // True while shutting down
+
+        // Worker thread entry point
+        void workerLoop();
+
+        // Claim and run chunks of a batch until none are left, returns true if any chunk ran
+        bool runChunks(JobBatch& batch);
+
+    public:
+        /**
+         * @brief Get the singleton instance of the JobManager.
+         * @return Reference to the singleton instance.
+         */
+        static JobManager& getInstance();
+
+        /**
+         * @brief Start up the JobManager and spawn the worker threads.
+         * @details One worker per hardware thread, minus the calling thread.
+         * @return 0 if successful, else -1.
+         */
+        int startUp() override;
+
+        /**
+         * @brief Shut down the JobManager and join all worker threads.
+         */
+        void shutDown() override;
+
+        /**
+         * @brief Run func over [0, count) in chunks of at most grain items.
+         * @details Blocks until every chunk has run. The calling thread helps execute
+         *          chunks, so nested calls from inside a job cannot deadlock. Chunk
+         *          boundaries only depend on count and grain, never on the number of
+         *          threads, so callers that write per-chunk output get the same result
+         *          on any machine. Runs inline when the manager is not started.
+         * @param count Number of items to process.
+         * @param grain Maximum number of items per chunk (clamped to at least 1).
+         * @param func Callback receiving a [begin, end) range.
+         */
+        void parallelFor(std::size_t count, std::size_t grain, const JobRangeFunc& func);
+
+        /**
+         * @brief Run a job on a worker thread without waiting for it.
+         * @details For long jobs like decoding a file that should finish in the
+         *          background while frames go on. The job reports back on its own, nothing
+         *          tracks it after it is queued. Runs inline when the manager is not started.
+         * @param job Callback to run once.
+         */
+        void submit(std::function<void()> job);
+
+        /**
+         * @brief Number of chunks parallelFor will split count items into.
+         * @param count Number of items.
+         * @param grain Maximum number of items per chunk.
+         * @return Chunk count, useful for sizing per-chunk output arrays.
+         */
+        static std::size_t chunkCount(std::size_t count, std::size_t grain);
+
+        /**
+         * @brief Get the number of worker threads (not counting the caller).
+         * @return Number of worker threads.
+         */
+        std::size_t getWorkerCount() const;
+    };
+
+} // end of namespace gam300
+#endif // __JOB_MANAGER_H__
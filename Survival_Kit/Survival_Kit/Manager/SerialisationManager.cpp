@@ -21,6 +21,9 @@
 #include "ECSManager.h"
 #include "../Component/Transform3D.h"
 #include "../Component/RigidBody.h"
+#include "../Component/Collider.h"
+#include "../Component/MeshRenderer.h"
+#include "../Component/LightComponent.h"
 #include "../Component/AudioComponent.h"
 #include <fstream>
 #include <sstream>
@@ -161,6 +164,262 @@ namespace gam300 {
     }
 
 
+    // ColliderSerializer implementation
+    std::string ColliderSerializer::serialize(Component* component) {
+        Collider* collider = static_cast<Collider*>(component);
+        if (!collider) {
+            return "{}";
+        }
+
+        std::stringstream ss;
+        ss << "{\n";
+        ss << "          \"shape\": \"" << Collider::shapeToString(collider->getShape()) << "\",\n";
+
+        const Vector3D& offset = collider->getOffset();
+        ss << "          \"offset\": [\n";
+        ss << "            " << offset.x << ",\n";
+        ss << "            " << offset.y << ",\n";
+        ss << "            " << offset.z << "\n";
+        ss << "          ],\n";
+
+        const Vector3D& halfExtents = collider->getHalfExtents();
+        ss << "          \"halfExtents\": [\n";
+        ss << "            " << halfExtents.x << ",\n";
+        ss << "            " << halfExtents.y << ",\n";
+        ss << "            " << halfExtents.z << "\n";
+        ss << "          ],\n";
+
+        ss << "          \"radius\": " << collider->getRadius() << ",\n";
+        ss << "          \"restitution\": " << collider->getRestitution() << ",\n";
+        ss << "          \"layer\": " << collider->getLayer() << ",\n";
+        ss << "          \"mask\": " << collider->getMask() << ",\n";
+        ss << "          \"isTrigger\": " << (collider->isTrigger() ? "true" : "false") << "\n";
+        ss << "        }";
+
+        return ss.str();
+    }
+
+    // ColliderDeserializer implementation
+    Component* ColliderSerializer::deserialize(EntityID entityId, const std::string& jsonData) {
+        ColliderShape shape = ColliderShape::BOX;
+        std::string shapeData = SerialisationManager::extractQuotedValue(jsonData, "shape");
+        if (!shapeData.empty()) {
+            shape = Collider::stringToShape(shapeData);
+        }
+
+        Vector3D offset = Vector3D::ZERO;
+        std::string offsetData = SerialisationManager::extractObjectValue(jsonData, "offset");
+        if (!offsetData.empty()) {
+            std::vector<float> offsetArray = SerialisationManager::parseFloatArray(offsetData);
+            if (offsetArray.size() >= 3) {
+                offset = Vector3D(offsetArray[0], offsetArray[1], offsetArray[2]);
+            }
+        }
+
+        Vector3D halfExtents(0.5f, 0.5f, 0.5f);
+        std::string halfExtentsData = SerialisationManager::extractObjectValue(jsonData, "halfExtents");
+        if (!halfExtentsData.empty()) {
+            std::vector<float> halfExtentsArray = SerialisationManager::parseFloatArray(halfExtentsData);
+            if (halfExtentsArray.size() >= 3) {
+                halfExtents = Vector3D(halfExtentsArray[0], halfExtentsArray[1], halfExtentsArray[2]);
+            }
+        }
+
+        float radius = 0.5f;
+        std::string radiusData = SerialisationManager::extractNumberValue(jsonData, "radius");
+        if (!radiusData.empty()) {
+            try {
+                radius = std::stof(radiusData);
+            }
+            catch (const std::exception&) {
+                LM.writeLog("ColliderSerializer::deserialize() - Fail to parse radius");
+            }
+        }
+
+        float restitution = 0.2f;
+        std::string restitutionData = SerialisationManager::extractNumberValue(jsonData, "restitution");
+        if (!restitutionData.empty()) {
+            try {
+                restitution = std::stof(restitutionData);
+            }
+            catch (const std::exception&) {
+                LM.writeLog("ColliderSerializer::deserialize() - Fail to parse restitution");
+            }
+        }
+
+        // Layer and mask are bit sets, read them as unsigned so the top bit survives
+        uint32_t layer = 1u;
+        std::string layerData = SerialisationManager::extractNumberValue(jsonData, "layer");
+        if (!layerData.empty()) {
+            try {
+                layer = static_cast<uint32_t>(std::stoul(layerData));
+            }
+            catch (const std::exception&) {
+                LM.writeLog("ColliderSerializer::deserialize() - Fail to parse layer");
+            }
+        }
+
+        uint32_t mask = 0xFFFFFFFFu;
+        std::string maskData = SerialisationManager::extractNumberValue(jsonData, "mask");
+        if (!maskData.empty()) {
+            try {
+                mask = static_cast<uint32_t>(std::stoul(maskData));
+            }
+            catch (const std::exception&) {
+                LM.writeLog("ColliderSerializer::deserialize() - Fail to parse mask");
+            }
+        }
+
+        bool isTrigger = false;
+        std::string isTriggerData = SerialisationManager::extractNumberValue(jsonData, "isTrigger");
+        if (!isTriggerData.empty()) {
+            isTrigger = (isTriggerData == "true");
+        }
+
+        return EM.addComponent<Collider>(entityId, shape, halfExtents, radius, offset, restitution,
+            layer, mask, isTrigger);
+    }
+
+    // MeshRendererSerializer implementation
+    std::string MeshRendererSerializer::serialize(Component* component) {
+        MeshRenderer* renderer = static_cast<MeshRenderer*>(component);
+        if (!renderer) {
+            return "{}";
+        }
+
+        std::stringstream ss;
+        ss << "{\n";
+        ss << "          \"meshID\": " << renderer->getMeshID() << ",\n";
+        ss << "          \"materialID\": " << renderer->getMaterialID() << ",\n";
+        ss << "          \"visible\": " << (renderer->isVisible() ? "true" : "false") << "\n";
+        ss << "        }";
+
+        return ss.str();
+    }
+
+    // MeshRendererDeserializer implementation
+    Component* MeshRendererSerializer::deserialize(EntityID entityId, const std::string& jsonData) {
+        uint32_t meshID = 0;
+        std::string meshIDData = SerialisationManager::extractNumberValue(jsonData, "meshID");
+        if (!meshIDData.empty()) {
+            try {
+                meshID = static_cast<uint32_t>(std::stoul(meshIDData));
+            }
+            catch (const std::exception&) {
+                LM.writeLog("MeshRendererSerializer::deserialize() - Fail to parse meshID");
+            }
+        }
+
+        uint32_t materialID = 0;
+        std::string materialIDData = SerialisationManager::extractNumberValue(jsonData, "materialID");
+        if (!materialIDData.empty()) {
+            try {
+                materialID = static_cast<uint32_t>(std::stoul(materialIDData));
+            }
+            catch (const std::exception&) {
+                LM.writeLog("MeshRendererSerializer::deserialize() - Fail to parse materialID");
+            }
+        }
+
+        bool visible = true;
+        std::string visibleData = SerialisationManager::extractNumberValue(jsonData, "visible");
+        if (!visibleData.empty()) {
+            visible = (visibleData == "true");
+        }
+
+        return EM.addComponent<MeshRenderer>(entityId, meshID, materialID, visible);
+    }
+
+    // LightComponentSerializer implementation
+    std::string LightComponentSerializer::serialize(Component* component) {
+        LightComponent* light = static_cast<LightComponent*>(component);
+        if (!light) {
+            return "{}";
+        }
+
+        std::stringstream ss;
+        ss << "{\n";
+        ss << "          \"type\": \"" << (light->getType() == LightType::SPOT ? "SPOT" : "POINT") << "\",\n";
+
+        const glm::vec3& color = light->getColor();
+        ss << "          \"color\": [\n";
+        ss << "            " << color.x << ",\n";
+        ss << "            " << color.y << ",\n";
+        ss << "            " << color.z << "\n";
+        ss << "          ],\n";
+
+        ss << "          \"intensity\": " << light->getIntensity() << ",\n";
+        ss << "          \"range\": " << light->getRange() << ",\n";
+
+        const glm::vec3& direction = light->getDirection();
+        ss << "          \"direction\": [\n";
+        ss << "            " << direction.x << ",\n";
+        ss << "            " << direction.y << ",\n";
+        ss << "            " << direction.z << "\n";
+        ss << "          ],\n";
+
+        ss << "          \"innerAngle\": " << light->getInnerAngle() << ",\n";
+        ss << "          \"outerAngle\": " << light->getOuterAngle() << ",\n";
+        ss << "          \"enabled\": " << (light->isEnabled() ? "true" : "false") << "\n";
+        ss << "        }";
+
+        return ss.str();
+    }
+
+    // LightComponentDeserializer implementation
+    Component* LightComponentSerializer::deserialize(EntityID entityId, const std::string& jsonData) {
+        LightType type = LightType::POINT;
+        if (SerialisationManager::extractQuotedValue(jsonData, "type") == "SPOT") {
+            type = LightType::SPOT;
+        }
+
+        glm::vec3 color(1.0f);
+        std::string colorData = SerialisationManager::extractObjectValue(jsonData, "color");
+        if (!colorData.empty()) {
+            std::vector<float> colorArray = SerialisationManager::parseFloatArray(colorData);
+            if (colorArray.size() >= 3) {
+                color = glm::vec3(colorArray[0], colorArray[1], colorArray[2]);
+            }
+        }
+
+        // Reads one float field, keeping the default when it is missing or malformed
+        auto readFloat = [&jsonData](const char* fieldName, float defaultValue) {
+            std::string data = SerialisationManager::extractNumberValue(jsonData, fieldName);
+            if (data.empty()) {
+                return defaultValue;
+            }
+            try {
+                return std::stof(data);
+            }
+            catch (const std::exception&) {
+                LM.writeLog("LightComponentSerializer::deserialize() - Fail to parse %s", fieldName);
+                return defaultValue;
+            }
+        };
+
+        const float intensity = readFloat("intensity", 1.0f);
+        const float range = readFloat("range", 10.0f);
+        const float innerAngle = readFloat("innerAngle", 20.0f);
+        const float outerAngle = readFloat("outerAngle", 30.0f);
+
+        LightComponent* light = EM.addComponent<LightComponent>(entityId, type, color, intensity, range);
+        if (!light) {
+            return nullptr;
+        }
+
+        std::string directionData = SerialisationManager::extractObjectValue(jsonData, "direction");
+        if (!directionData.empty()) {
+            std::vector<float> directionArray = SerialisationManager::parseFloatArray(directionData);
+            if (directionArray.size() >= 3) {
+                light->setDirection(glm::vec3(directionArray[0], directionArray[1], directionArray[2]));
+            }
+        }
+        light->setSpotAngles(innerAngle, outerAngle);
+        light->setEnabled(SerialisationManager::extractNumberValue(jsonData, "enabled") != "false");
+
+        return light;
+    }
+
 	//AudioComponentSerializer implementation
     std::string AudioComponentSerializer::serialize(Component* component) {
 		AudioComponent* audio = static_cast<AudioComponent*>(component);
@@ -329,6 +588,39 @@ namespace gam300 {
                 LM.writeLog("RigidBody created for entity %d", entityId);
             }
             });
+
+        // Register component serializers for Collider
+        registerComponentSerializer("Collider", std::make_shared<ColliderSerializer>());
+
+        registerComponentCreator("Collider", [this](EntityID entityId, const std::string& componentData) {
+            auto serializer = m_component_serializers["Collider"];
+            if (serializer) {
+                serializer->deserialize(entityId, componentData);
+                LM.writeLog("Collider created for entity %d", entityId);
+            }
+            });
+
+        // Register component serializers for MeshRenderer
+        registerComponentSerializer("MeshRenderer", std::make_shared<MeshRendererSerializer>());
+
+        registerComponentCreator("MeshRenderer", [this](EntityID entityId, const std::string& componentData) {
+            auto serializer = m_component_serializers["MeshRenderer"];
+            if (serializer) {
+                serializer->deserialize(entityId, componentData);
+                LM.writeLog("MeshRenderer created for entity %d", entityId);
+            }
+            });
+
+        // Register component serializers for LightComponent
+        registerComponentSerializer("LightComponent", std::make_shared<LightComponentSerializer>());
+
+        registerComponentCreator("LightComponent", [this](EntityID entityId, const std::string& componentData) {
+            auto serializer = m_component_serializers["LightComponent"];
+            if (serializer) {
+                serializer->deserialize(entityId, componentData);
+                LM.writeLog("LightComponent created for entity %d", entityId);
+            }
+            });
     
 
         registerComponentCreator("AudioComponent", [this](EntityID entityId, const std::string& componentData) {
@@ -669,6 +961,36 @@ namespace gam300 {
                 }
             }
 
+            // Check for Collider component
+            if (auto serializer = m_component_serializers.find("Collider");
+                serializer != m_component_serializers.end()) {
+                if (Collider* collider = EM.getComponent<Collider>(entity.get_id())) {
+                    componentStrings.push_back(getIndent(4) + "\"Collider\": " +
+                        serializer->second->serialize(collider));
+                    hasComponents = true;
+                }
+            }
+
+            // Check for MeshRenderer component
+            if (auto serializer = m_component_serializers.find("MeshRenderer");
+                serializer != m_component_serializers.end()) {
+                if (MeshRenderer* renderer = EM.getComponent<MeshRenderer>(entity.get_id())) {
+                    componentStrings.push_back(getIndent(4) + "\"MeshRenderer\": " +
+                        serializer->second->serialize(renderer));
+                    hasComponents = true;
+                }
+            }
+
+            // Check for LightComponent component
+            if (auto serializer = m_component_serializers.find("LightComponent");
+                serializer != m_component_serializers.end()) {
+                if (LightComponent* light = EM.getComponent<LightComponent>(entity.get_id())) {
+                    componentStrings.push_back(getIndent(4) + "\"LightComponent\": " +
+                        serializer->second->serialize(light));
+                    hasComponents = true;
+                }
+            }
+
             // TODO: Add more component types here as needed
 
             // Write all components with proper comma separation
@@ -0,0 +1,61 @@
+/**
+ * @file AABB.h
+ * @brief Axis-aligned bounding box used by the physics world.
+ * @details Small value type shared by colliders, the broadphase and scene queries.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __AABB_H__
+#define __AABB_H__
+
+#include <algorithm>
+#include <cfloat>
+#include "../Utility/Vector3D.h"
+
+namespace gam300 {
+
+    /**
+     * @brief Axis-aligned bounding box in world space.
+     */
+    struct AABB {
+        Vector3D min{ FLT_MAX, FLT_MAX, FLT_MAX };
+        Vector3D max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        AABB() = default;
+        AABB(const Vector3D& min_corner, const Vector3D& max_corner) : min(min_corner), max(max_corner) {}
+
+        /**
+         * @brief Build a box from its center and half extents.
+         */
+        static AABB fromCenterExtents(const Vector3D& center, const Vector3D& half_extents) {
+            return AABB(center - half_extents, center + half_extents);
+        }
+
+        /**
+         * @brief Grow this box to contain another box.
+         */
+        void merge(const AABB& other) {
+            min = Vector3D(std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z));
+            max = Vector3D(std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z));
+        }
+
+        /**
+         * @brief Check if two boxes overlap (touching counts as overlapping).
+         */
+        bool overlaps(const AABB& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        Vector3D center() const { return (min + max) * 0.5f; }
+        Vector3D extents() const { return (max - min) * 0.5f; }
+    };
+
+} // namespace gam300
+
+#endif // __AABB_H__
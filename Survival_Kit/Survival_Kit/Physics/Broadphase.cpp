@@ -0,0 +1,296 @@
+/**
+ * @file Broadphase.cpp
+ * @brief Implementation of the physics broadphase.
+ * @details Contains implementations for all member functions declared in Broadphase.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Physics/Broadphase.h"
+#include "../Manager/JobManager.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace gam300 {
+
+    namespace {
+        // Items per job for the parallel passes
+        constexpr std::size_t REFIT_GRAIN = 64;
+        constexpr std::size_t PAIR_GRAIN = 32;
+
+        float centroidAxis(const AABB& box, int axis) {
+            switch (axis) {
+            case 0:  return box.min.x + box.max.x;
+            case 1:  return box.min.y + box.max.y;
+            default: return box.min.z + box.max.z;
+            }
+        }
+    }
+
+    void Broadphase::build() {
+        m_nodes.clear();
+        m_levels.clear();
+
+        if (m_proxies.empty()) {
+            return;
+        }
+
+        std::vector<uint32_t> indices(m_proxies.size());
+        std::iota(indices.begin(), indices.end(), 0u);
+
+        m_nodes.reserve(m_proxies.size() / 2 + 1);
+        buildNode(indices.data(), indices.size(), 0);
+
+        refit();
+    }
+
+    int32_t Broadphase::buildNode(uint32_t* indices, std::size_t count, std::size_t depth) {
+        const int32_t node_index = static_cast<int32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        if (m_levels.size() <= depth) {
+            m_levels.resize(depth + 1);
+        }
+        m_levels[depth].push_back(static_cast<uint32_t>(node_index));
+
+        // Split into up to four child ranges
+        std::size_t starts[4] = { 0, 0, 0, 0 };
+        std::size_t sizes[4] = { 0, 0, 0, 0 };
+        int range_count = 0;
+
+        if (count <= 4) {
+            for (std::size_t i = 0; i < count; ++i) {
+                starts[range_count] = i;
+                sizes[range_count] = 1;
+                ++range_count;
+            }
+        }
+        else {
+            std::size_t mid = splitRange(indices, count);
+            std::size_t halves_start[2] = { 0, mid };
+            std::size_t halves_size[2] = { mid, count - mid };
+
+            for (int h = 0; h < 2; ++h) {
+                if (halves_size[h] == 1) {
+                    starts[range_count] = halves_start[h];
+                    sizes[range_count] = 1;
+                    ++range_count;
+                    continue;
+                }
+                std::size_t quarter = splitRange(indices + halves_start[h], halves_size[h]);
+                starts[range_count] = halves_start[h];
+                sizes[range_count] = quarter;
+                ++range_count;
+                starts[range_count] = halves_start[h] + quarter;
+                sizes[range_count] = halves_size[h] - quarter;
+                ++range_count;
+            }
+        }
+
+        int32_t children[4] = { EMPTY_SLOT, EMPTY_SLOT, EMPTY_SLOT, EMPTY_SLOT };
+        for (int slot = 0; slot < range_count; ++slot) {
+            if (sizes[slot] == 1) {
+                children[slot] = makeLeaf(indices[starts[slot]]);
+            }
+            else {
+                children[slot] = buildNode(indices + starts[slot], sizes[slot], depth + 1);
+            }
+        }
+
+        // m_nodes may have grown during recursion, so index again
+        Node& node = m_nodes[node_index];
+        for (int slot = 0; slot < 4; ++slot) {
+            node.child[slot] = children[slot];
+            node.min_x[slot] = node.min_y[slot] = node.min_z[slot] = FLT_MAX;
+            node.max_x[slot] = node.max_y[slot] = node.max_z[slot] = -FLT_MAX;
+        }
+
+        return node_index;
+    }
+
+    std::size_t Broadphase::splitRange(uint32_t* indices, std::size_t count) const {
+        AABB centroids;
+        for (std::size_t i = 0; i < count; ++i) {
+            Vector3D c = m_proxies[indices[i]].bounds.center();
+            centroids.merge(AABB(c, c));
+        }
+
+        Vector3D extent = centroids.max - centroids.min;
+        int axis = 0;
+        if (extent.y > extent.x && extent.y >= extent.z) axis = 1;
+        else if (extent.z > extent.x && extent.z > extent.y) axis = 2;
+
+        // Ties are broken by proxy index so the split never depends on input order quirks
+        std::size_t mid = count / 2;
+        std::nth_element(indices, indices + mid, indices + count,
+            [this, axis](uint32_t lhs, uint32_t rhs) {
+                float a = centroidAxis(m_proxies[lhs].bounds, axis);
+                float b = centroidAxis(m_proxies[rhs].bounds, axis);
+                return a < b || (a == b && lhs < rhs);
+            });
+        return mid;
+    }
+
+    AABB Broadphase::slotBounds(const Node& node, int slot) const {
+        int32_t child = node.child[slot];
+        if (isLeaf(child)) {
+            return m_proxies[leafProxy(child)].bounds;
+        }
+
+        AABB box;
+        if (child == EMPTY_SLOT) {
+            return box;
+        }
+
+        const Node& sub = m_nodes[child];
+        for (int i = 0; i < 4; ++i) {
+            if (sub.child[i] == EMPTY_SLOT) continue;
+            box.merge(AABB(Vector3D(sub.min_x[i], sub.min_y[i], sub.min_z[i]),
+                           Vector3D(sub.max_x[i], sub.max_y[i], sub.max_z[i])));
+        }
+        return box;
+    }
+
+    void Broadphase::refit() {
+        // Deepest level first so child nodes are final before their parents read them
+        for (std::size_t level = m_levels.size(); level-- > 0;) {
+            const std::vector<uint32_t>& nodes = m_levels[level];
+
+            JM.parallelFor(nodes.size(), REFIT_GRAIN, [this, &nodes](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    Node& node = m_nodes[nodes[i]];
+                    for (int slot = 0; slot < 4; ++slot) {
+                        if (node.child[slot] == EMPTY_SLOT) continue;
+                        AABB box = slotBounds(node, slot);
+                        node.min_x[slot] = box.min.x; node.min_y[slot] = box.min.y; node.min_z[slot] = box.min.z;
+                        node.max_x[slot] = box.max.x; node.max_y[slot] = box.max.y; node.max_z[slot] = box.max.z;
+                    }
+                }
+            });
+        }
+    }
+
+    template<typename Visitor>
+    void Broadphase::traverse(const AABB& box, Visitor&& visit) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        const __m128 qmin_x = _mm_set1_ps(box.min.x);
+        const __m128 qmin_y = _mm_set1_ps(box.min.y);
+        const __m128 qmin_z = _mm_set1_ps(box.min.z);
+        const __m128 qmax_x = _mm_set1_ps(box.max.x);
+        const __m128 qmax_y = _mm_set1_ps(box.max.y);
+        const __m128 qmax_z = _mm_set1_ps(box.max.z);
+
+        int32_t stack[TRAVERSAL_STACK_SIZE];
+        std::vector<int32_t> overflow;  // Nodes pushed while the stack is full, popped first
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0 || !overflow.empty()) {
+            int32_t index;
+            if (!overflow.empty()) {
+                index = overflow.back();
+                overflow.pop_back();
+            }
+            else {
+                index = stack[--top];
+            }
+            const Node& node = m_nodes[index];
+
+            // Test the query against all four children at once
+            __m128 hit = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.min_x), qmax_x), _mm_cmpge_ps(_mm_load_ps(node.max_x), qmin_x));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.min_y), qmax_y), _mm_cmpge_ps(_mm_load_ps(node.max_y), qmin_y)));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.min_z), qmax_z), _mm_cmpge_ps(_mm_load_ps(node.max_z), qmin_z)));
+            int mask = _mm_movemask_ps(hit);
+
+            for (int slot = 0; slot < 4; ++slot) {
+                if (!(mask & (1 << slot))) continue;
+                int32_t child = node.child[slot];
+                if (child == EMPTY_SLOT) continue;
+
+                if (isLeaf(child)) {
+                    visit(leafProxy(child));
+                }
+                else if (top < TRAVERSAL_STACK_SIZE) {
+                    stack[top++] = child;
+                }
+                else {
+                    overflow.push_back(child);
+                }
+            }
+        }
+    }
+
+    void Broadphase::findPairs(std::vector<BroadphasePair>& out_pairs) const {
+        out_pairs.clear();
+
+        const std::size_t count = m_proxies.size();
+        if (count < 2 || m_nodes.empty()) {
+            return;
+        }
+
+        // One output list per chunk, chunk boundaries do not depend on the thread count
+        std::vector<std::vector<BroadphasePair>> chunk_pairs(JobManager::chunkCount(count, PAIR_GRAIN));
+
+        JM.parallelFor(count, PAIR_GRAIN, [this, &chunk_pairs](std::size_t begin, std::size_t end) {
+            std::vector<BroadphasePair>& local = chunk_pairs[begin / PAIR_GRAIN];
+            std::vector<uint32_t> hits;
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const BroadphaseProxy& proxy = m_proxies[i];
+                if (proxy.is_static) continue;
+
+                hits.clear();
+                traverse(proxy.bounds, [&hits](uint32_t other) { hits.push_back(other); });
+                std::sort(hits.begin(), hits.end());
+
+                const uint32_t self = static_cast<uint32_t>(i);
+                for (uint32_t other : hits) {
+                    if (other == self) continue;
+
+                    // Moving pairs are found from both sides, keep the one from the lower index
+                    if (!m_proxies[other].is_static && other < self) continue;
+
+                    if (!layersInteract(proxy.layer, proxy.mask, m_proxies[other].layer, m_proxies[other].mask)) continue;
+
+                    local.push_back({ self, other });
+                }
+            }
+        });
+
+        std::size_t total = 0;
+        for (const auto& local : chunk_pairs) {
+            total += local.size();
+        }
+        out_pairs.reserve(total);
+        for (const auto& local : chunk_pairs) {
+            out_pairs.insert(out_pairs.end(), local.begin(), local.end());
+        }
+    }
+
+    AABB Broadphase::getBounds() const {
+        AABB box;
+        if (m_nodes.empty()) {
+            return box;
+        }
+
+        const Node& root = m_nodes[0];
+        for (int slot = 0; slot < 4; ++slot) {
+            if (root.child[slot] == EMPTY_SLOT) continue;
+            box.merge(AABB(Vector3D(root.min_x[slot], root.min_y[slot], root.min_z[slot]),
+                           Vector3D(root.max_x[slot], root.max_y[slot], root.max_z[slot])));
+        }
+        return box;
+    }
+
+    void Broadphase::queryOverlaps(const AABB& box, std::vector<uint32_t>& out_proxies) const {
+        traverse(box, [&out_proxies](uint32_t proxy) { out_proxies.push_back(proxy); });
+    }
+
+} // namespace gam300
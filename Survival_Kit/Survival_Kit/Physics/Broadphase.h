@@ -0,0 +1,287 @@
+/**
+ * @file Broadphase.h
+ * @brief Declaration of the physics broadphase.
+ * @details A 4-wide bounding volume hierarchy over collider bounds, used to find
+ *          candidate collision pairs before any narrowphase work is done.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __BROADPHASE_H__
+#define __BROADPHASE_H__
+
+#include <xmmintrin.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../Physics/AABB.h"
+#include "../Utility/ECS_Variables.h"
+
+namespace gam300 {
+
+    /**
+     * @brief One collider registered with the broadphase.
+     */
+    struct BroadphaseProxy {
+        AABB bounds;                            // World-space bounds, refreshed every step
+        EntityID entity = INVALID_ENTITY_ID;    // Owning entity
+        uint32_t body = 0;                      // Index of the body in the physics step
+        uint32_t layer = 1u;                    // Layer bits of the collider
+        uint32_t mask = 0xFFFFFFFFu;            // Layers the collider interacts with
+        bool is_static = false;                 // Static proxies never query, and never pair with each other
+    };
+
+    /**
+     * @brief Check if two collision filters accept each other.
+     * @details Both sides have to accept, so either collider can opt out of a pair.
+     */
+    inline bool layersInteract(uint32_t layer_a, uint32_t mask_a, uint32_t layer_b, uint32_t mask_b) {
+        return (layer_a & mask_b) != 0 && (layer_b & mask_a) != 0;
+    }
+
+    /**
+     * @brief Candidate pair produced by the broadphase.
+     * @details a is always the non-static proxy that found the pair.
+     */
+    struct BroadphasePair {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    class Broadphase {
+    public:
+
+        /**
+         * @brief Access the proxy list.
+         * @details Update bounds in place, then call refit(). Adding or removing
+         *          proxies requires a build().
+         */
+        std::vector<BroadphaseProxy>& getProxies() { return m_proxies; }
+        const std::vector<BroadphaseProxy>& getProxies() const { return m_proxies; }
+
+        /**
+         * @brief Rebuild the tree from scratch over the current proxies.
+         */
+        void build();
+
+        /**
+         * @brief Refresh node bounds from the current proxy bounds.
+         * @details Keeps the tree topology. Runs one depth level at a time, deepest
+         *          first, with the nodes of a level processed on the job system.
+         */
+        void refit();
+
+        /**
+         * @brief Find every overlapping proxy pair.
+         * @details Queries run on the job system. Pairs whose layers and masks do not
+         *          accept each other are dropped here, before any narrowphase work. The
+         *          output order depends only on the proxy order, not on the number of threads.
+         * @param out_pairs Receives the pairs, cleared first.
+         */
+        void findPairs(std::vector<BroadphasePair>& out_pairs) const;
+
+        /**
+         * @brief Collect every proxy whose bounds overlap a box.
+         * @param box Query bounds in world space.
+         * @param out_proxies Receives the proxy indices (appended).
+         */
+        void queryOverlaps(const AABB& box, std::vector<uint32_t>& out_proxies) const;
+
+        /**
+         * @brief Walk every proxy whose bounds a ray (or swept sphere) passes through.
+         * @details Each node tests the ray against its four children with one set of SSE
+         *          slab tests, and nearer children are visited first. The visitor is
+         *          called as visit(proxy_index, max_t) and returns the new max_t, so a
+         *          closest-hit query returns its hit distance to prune farther nodes and
+         *          an all-hits query returns max_t unchanged.
+         * @param origin Ray origin.
+         * @param direction Ray direction, normalized.
+         * @param max_distance Length of the ray.
+         * @param radius Radius of the swept sphere, 0 for a plain ray.
+         * @param visit Callback for each candidate proxy.
+         */
+        template<typename Visitor>
+        void castRay(const Vector3D& origin, const Vector3D& direction, float max_distance, float radius, Visitor&& visit) const;
+
+        /**
+         * @brief Bounds of every proxy in the tree, as of the last build or refit.
+         */
+        AABB getBounds() const;
+
+        /**
+         * @brief Number of tree nodes, for debugging and stats.
+         */
+        std::size_t getNodeCount() const { return m_nodes.size(); }
+
+    private:
+
+        // Child slot encoding: >= 0 is a node, EMPTY_SLOT is unused, anything else is ~proxy
+        static constexpr int32_t EMPTY_SLOT = INT32_MIN;
+        static bool isLeaf(int32_t child) { return child < 0 && child != EMPTY_SLOT; }
+        static uint32_t leafProxy(int32_t child) { return static_cast<uint32_t>(~child); }
+        static int32_t makeLeaf(uint32_t proxy) { return ~static_cast<int32_t>(proxy); }
+
+        // Deep enough for any tree built by median splits, traversals spill into a vector past it
+        static constexpr int TRAVERSAL_STACK_SIZE = 256;
+
+        // Ray direction components smaller than this are treated as parallel to the axis
+        static constexpr float RAY_PARALLEL_EPSILON = 1e-8f;
+
+        /**
+         * @brief Clip the ray interval of four children against the slabs of one axis.
+         * @details A parallel ray is either inside a slab for its whole length or never,
+         *          lanes whose origin is outside get an empty interval.
+         */
+        static void clipSlab(const float* min, const float* max, __m128 inflate, __m128 origin, __m128 inv_dir,
+            bool parallel, __m128& t_enter, __m128& t_exit) {
+            const __m128 lo = _mm_sub_ps(_mm_load_ps(min), inflate);
+            const __m128 hi = _mm_add_ps(_mm_load_ps(max), inflate);
+            if (parallel) {
+                const __m128 outside = _mm_or_ps(_mm_cmplt_ps(origin, lo), _mm_cmpgt_ps(origin, hi));
+                t_enter = _mm_or_ps(_mm_andnot_ps(outside, t_enter), _mm_and_ps(outside, _mm_set1_ps(INFINITY)));
+                return;
+            }
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(lo, origin), inv_dir);
+            const __m128 t2 = _mm_mul_ps(_mm_sub_ps(hi, origin), inv_dir);
+            t_enter = _mm_max_ps(t_enter, _mm_min_ps(t1, t2));
+            t_exit = _mm_min_ps(t_exit, _mm_max_ps(t1, t2));
+        }
+
+        /**
+         * @brief Node with four child bounds stored as structure of arrays.
+         * @details Lets one SSE compare test a query against all four children.
+         */
+        struct alignas(16) Node {
+            float min_x[4], min_y[4], min_z[4];
+            float max_x[4], max_y[4], max_z[4];
+            int32_t child[4];
+        };
+
+        // Recursive top-down build, returns the new node index
+        int32_t buildNode(uint32_t* indices, std::size_t count, std::size_t depth);
+
+        // Median split along the widest centroid axis, returns the split position
+        std::size_t splitRange(uint32_t* indices, std::size_t count) const;
+
+        // Bounds of everything below a child slot
+        AABB slotBounds(const Node& node, int slot) const;
+
+        // Traverse the tree, calling visit(proxy_index) for each overlapping proxy
+        template<typename Visitor>
+        void traverse(const AABB& box, Visitor&& visit) const;
+
+        std::vector<BroadphaseProxy> m_proxies;
+        std::vector<Node> m_nodes;                      // Root is node 0
+        std::vector<std::vector<uint32_t>> m_levels;    // Node indices by depth, for refit
+    };
+
+    template<typename Visitor>
+    void Broadphase::castRay(const Vector3D& origin, const Vector3D& direction, float max_distance, float radius, Visitor&& visit) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        const __m128 origin_x = _mm_set1_ps(origin.x);
+        const __m128 origin_y = _mm_set1_ps(origin.y);
+        const __m128 origin_z = _mm_set1_ps(origin.z);
+        const __m128 inv_dir_x = _mm_set1_ps(1.0f / direction.x);
+        const __m128 inv_dir_y = _mm_set1_ps(1.0f / direction.y);
+        const __m128 inv_dir_z = _mm_set1_ps(1.0f / direction.z);
+
+        // On an axis the ray runs parallel to, an origin on a slab plane would compute
+        // 0 * inf = NaN and miss boxes it touches, so those axes only check the origin
+        const bool parallel_x = std::fabs(direction.x) < RAY_PARALLEL_EPSILON;
+        const bool parallel_y = std::fabs(direction.y) < RAY_PARALLEL_EPSILON;
+        const bool parallel_z = std::fabs(direction.z) < RAY_PARALLEL_EPSILON;
+
+        const __m128 inflate = _mm_set1_ps(radius);
+        const __m128 zero = _mm_setzero_ps();
+
+        struct Entry {
+            int32_t node;
+            float t;        // Distance where the ray enters the node
+        };
+        Entry stack[TRAVERSAL_STACK_SIZE];
+        std::vector<Entry> overflow;    // Entries pushed while the stack is full, popped first
+        int top = 0;
+
+        float max_t = max_distance;
+        int32_t node_index = 0;
+
+        for (;;) {
+            const Node& node = m_nodes[node_index];
+
+            // Slab test against all four children, bounds grown by the sphere radius
+            __m128 t_enter = zero;
+            __m128 t_exit = _mm_set1_ps(max_t);
+            clipSlab(node.min_x, node.max_x, inflate, origin_x, inv_dir_x, parallel_x, t_enter, t_exit);
+            clipSlab(node.min_y, node.max_y, inflate, origin_y, inv_dir_y, parallel_y, t_enter, t_exit);
+            clipSlab(node.min_z, node.max_z, inflate, origin_z, inv_dir_z, parallel_z, t_enter, t_exit);
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(t_enter, t_exit));
+
+            alignas(16) float enter[4];
+            _mm_store_ps(enter, t_enter);
+
+            // Visit hit leaves right away and collect the hit inner nodes nearest first
+            Entry inner[4];
+            int inner_count = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                const int32_t child = node.child[slot];
+                if (!(mask & (1 << slot)) || child == EMPTY_SLOT) continue;
+                if (isLeaf(child)) {
+                    if (enter[slot] <= max_t) {
+                        max_t = visit(leafProxy(child), max_t);
+                    }
+                    continue;
+                }
+                _mm_prefetch(reinterpret_cast<const char*>(&m_nodes[child]), _MM_HINT_T0);
+                Entry hit = { child, enter[slot] };
+                int i = inner_count++;
+                while (i > 0 && inner[i - 1].t > hit.t) {
+                    inner[i] = inner[i - 1];
+                    --i;
+                }
+                inner[i] = hit;
+            }
+
+            // Push the farther inner nodes far to near, and step straight into the nearest
+            for (int i = inner_count; i-- > 1;) {
+                if (top < TRAVERSAL_STACK_SIZE) {
+                    stack[top++] = inner[i];
+                }
+                else {
+                    overflow.push_back(inner[i]);
+                }
+            }
+            if (inner_count > 0 && inner[0].t <= max_t) {
+                node_index = inner[0].node;
+                continue;
+            }
+
+            // Nothing to descend into here, pop until an entry is still in range
+            node_index = -1;
+            while (node_index < 0 && (top > 0 || !overflow.empty())) {
+                Entry entry;
+                if (!overflow.empty()) {
+                    entry = overflow.back();
+                    overflow.pop_back();
+                }
+                else {
+                    entry = stack[--top];
+                }
+                if (entry.t <= max_t) {
+                    node_index = entry.node;
+                }
+            }
+            if (node_index < 0) {
+                return;
+            }
+        }
+    }
+
+} // namespace gam300
+
+#endif // __BROADPHASE_H__
@@ -0,0 +1,270 @@
+/**
+ * @file Contact.cpp
+ * @brief Implementation of the narrowphase, contact islands and contact solver.
+ * @details Contains implementations for all functions declared in Contact.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Physics/Contact.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gam300 {
+
+    namespace {
+        constexpr float CONTACT_EPSILON = 1e-6f;
+        constexpr float BOUNCE_THRESHOLD = 1.0f;    // Closing speed below which contacts do not bounce
+        constexpr float PENETRATION_SLOP = 0.01f;   // Overlap allowed before positional correction kicks in
+        constexpr float CORRECTION_PERCENT = 0.8f;  // Fraction of the overlap removed per step
+
+        const Vector3D CONTACT_UP(0.0f, 1.0f, 0.0f);
+
+        // Normal points from the sphere towards the box
+        bool sphereBox(const Vector3D& center, float radius, const AABB& box, Vector3D& normal, float& penetration) {
+            Vector3D closest(std::clamp(center.x, box.min.x, box.max.x),
+                             std::clamp(center.y, box.min.y, box.max.y),
+                             std::clamp(center.z, box.min.z, box.max.z));
+            Vector3D delta = closest - center;
+            float dist_sq = delta.magnitudeSquared();
+
+            if (dist_sq > radius * radius) {
+                return false;
+            }
+
+            if (dist_sq > CONTACT_EPSILON) {
+                float dist = std::sqrt(dist_sq);
+                normal = delta / dist;
+                penetration = radius - dist;
+                return true;
+            }
+
+            // Center is inside the box, push out through the closest face
+            float faces[6] = {
+                center.x - box.min.x, box.max.x - center.x,
+                center.y - box.min.y, box.max.y - center.y,
+                center.z - box.min.z, box.max.z - center.z };
+            const Vector3D face_normals[6] = {
+                Vector3D(1.0f, 0.0f, 0.0f), Vector3D(-1.0f, 0.0f, 0.0f),
+                Vector3D(0.0f, 1.0f, 0.0f), Vector3D(0.0f, -1.0f, 0.0f),
+                Vector3D(0.0f, 0.0f, 1.0f), Vector3D(0.0f, 0.0f, -1.0f) };
+
+            int best = 0;
+            for (int i = 1; i < 6; ++i) {
+                if (faces[i] < faces[best]) best = i;
+            }
+            normal = face_normals[best];
+            penetration = faces[best] + radius;
+            return true;
+        }
+
+        bool boxBox(const AABB& a, const AABB& b, Vector3D& normal, float& penetration) {
+            float overlap_x = std::min(a.max.x, b.max.x) - std::max(a.min.x, b.min.x);
+            float overlap_y = std::min(a.max.y, b.max.y) - std::max(a.min.y, b.min.y);
+            float overlap_z = std::min(a.max.z, b.max.z) - std::max(a.min.z, b.min.z);
+
+            if (overlap_x < 0.0f || overlap_y < 0.0f || overlap_z < 0.0f) {
+                return false;
+            }
+
+            Vector3D delta = b.center() - a.center();
+            if (overlap_x <= overlap_y && overlap_x <= overlap_z) {
+                normal = Vector3D(delta.x < 0.0f ? -1.0f : 1.0f, 0.0f, 0.0f);
+                penetration = overlap_x;
+            }
+            else if (overlap_y <= overlap_z) {
+                normal = Vector3D(0.0f, delta.y < 0.0f ? -1.0f : 1.0f, 0.0f);
+                penetration = overlap_y;
+            }
+            else {
+                normal = Vector3D(0.0f, 0.0f, delta.z < 0.0f ? -1.0f : 1.0f);
+                penetration = overlap_z;
+            }
+            return true;
+        }
+
+        uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+    }
+
+    bool generateContact(const std::vector<PhysicsBody>& bodies, uint32_t a, uint32_t b, Contact& out_contact) {
+        const PhysicsBody& body_a = bodies[a];
+        const PhysicsBody& body_b = bodies[b];
+        if (!body_a.collider || !body_b.collider) {
+            return false;
+        }
+
+        ColliderShape shape_a = body_a.collider->getShape();
+        ColliderShape shape_b = body_b.collider->getShape();
+        Vector3D normal;
+        float penetration = 0.0f;
+        bool hit = false;
+
+        if (shape_a == ColliderShape::SPHERE && shape_b == ColliderShape::SPHERE) {
+            Vector3D delta = body_b.center - body_a.center;
+            float radii = body_a.radius + body_b.radius;
+            float dist_sq = delta.magnitudeSquared();
+            if (dist_sq <= radii * radii) {
+                float dist = std::sqrt(dist_sq);
+                normal = dist > CONTACT_EPSILON ? delta / dist : CONTACT_UP;
+                penetration = radii - dist;
+                hit = true;
+            }
+        }
+        else if (shape_a == ColliderShape::SPHERE) {
+            hit = sphereBox(body_a.center, body_a.radius, body_b.bounds, normal, penetration);
+        }
+        else if (shape_b == ColliderShape::SPHERE) {
+            hit = sphereBox(body_b.center, body_b.radius, body_a.bounds, normal, penetration);
+            normal = -normal;
+        }
+        else {
+            hit = boxBox(body_a.bounds, body_b.bounds, normal, penetration);
+        }
+
+        if (!hit) {
+            return false;
+        }
+
+        out_contact.a = a;
+        out_contact.b = b;
+        out_contact.normal = normal;
+        out_contact.penetration = penetration;
+        out_contact.restitution = std::max(body_a.collider->getRestitution(), body_b.collider->getRestitution());
+        out_contact.normal_impulse = 0.0f;
+        return true;
+    }
+
+    void buildContactIslands(const std::vector<PhysicsBody>& bodies, std::vector<Contact>& contacts,
+        std::vector<ContactIsland>& out_islands) {
+        out_islands.clear();
+        if (contacts.empty()) {
+            return;
+        }
+
+        // Union-find over dynamic bodies, the root is always the lowest index of the set
+        std::vector<uint32_t> parent(bodies.size());
+        for (uint32_t i = 0; i < parent.size(); ++i) {
+            parent[i] = i;
+        }
+
+        for (const Contact& contact : contacts) {
+            if (bodies[contact.a].inverse_mass <= 0.0f || bodies[contact.b].inverse_mass <= 0.0f) continue;
+            uint32_t root_a = findRoot(parent, contact.a);
+            uint32_t root_b = findRoot(parent, contact.b);
+            if (root_a < root_b) parent[root_b] = root_a;
+            else if (root_b < root_a) parent[root_a] = root_b;
+        }
+
+        // Island of a contact is the set of its dynamic body
+        std::vector<uint32_t> contact_root(contacts.size());
+        for (std::size_t i = 0; i < contacts.size(); ++i) {
+            uint32_t dynamic_body = bodies[contacts[i].a].inverse_mass > 0.0f ? contacts[i].a : contacts[i].b;
+            contact_root[i] = findRoot(parent, dynamic_body);
+        }
+
+        // Number islands in ascending root order
+        const uint32_t NO_ISLAND = UINT32_MAX;
+        std::vector<uint32_t> island_of_root(bodies.size(), NO_ISLAND);
+        for (uint32_t root : contact_root) {
+            island_of_root[root] = 0;
+        }
+        uint32_t island_count = 0;
+        for (uint32_t& island : island_of_root) {
+            if (island != NO_ISLAND) island = island_count++;
+        }
+
+        // Counting sort of the contacts by island, stable within an island
+        out_islands.resize(island_count);
+        for (uint32_t root : contact_root) {
+            ++out_islands[island_of_root[root]].contact_count;
+        }
+        uint32_t offset = 0;
+        for (ContactIsland& island : out_islands) {
+            island.first_contact = offset;
+            offset += island.contact_count;
+        }
+
+        std::vector<uint32_t> cursor(island_count);
+        for (uint32_t i = 0; i < island_count; ++i) {
+            cursor[i] = out_islands[i].first_contact;
+        }
+
+        std::vector<Contact> sorted(contacts.size());
+        for (std::size_t i = 0; i < contacts.size(); ++i) {
+            sorted[cursor[island_of_root[contact_root[i]]]++] = contacts[i];
+        }
+        contacts.swap(sorted);
+    }
+
+    void solveContactIsland(std::vector<PhysicsBody>& bodies, Contact* contacts, std::size_t count, int iterations) {
+
+        // Bounce target velocity from the closing speed before solving
+        std::vector<float> target_speed(count, 0.0f);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Contact& contact = contacts[i];
+            Vector3D relative = bodies[contact.b].rigid_body->getLinearVelocity() - bodies[contact.a].rigid_body->getLinearVelocity();
+            float closing = Vector3D::dot(relative, contact.normal);
+            if (closing < -BOUNCE_THRESHOLD) {
+                target_speed[i] = -contact.restitution * closing;
+            }
+        }
+
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            for (std::size_t i = 0; i < count; ++i) {
+                Contact& contact = contacts[i];
+                PhysicsBody& body_a = bodies[contact.a];
+                PhysicsBody& body_b = bodies[contact.b];
+
+                float inverse_mass_sum = body_a.inverse_mass + body_b.inverse_mass;
+                if (inverse_mass_sum <= 0.0f) continue;
+
+                Vector3D velocity_a = body_a.rigid_body->getLinearVelocity();
+                Vector3D velocity_b = body_b.rigid_body->getLinearVelocity();
+                float normal_speed = Vector3D::dot(velocity_b - velocity_a, contact.normal);
+
+                // Accumulated impulse is clamped so contacts can only push
+                float impulse = (target_speed[i] - normal_speed) / inverse_mass_sum;
+                float accumulated = std::max(contact.normal_impulse + impulse, 0.0f);
+                impulse = accumulated - contact.normal_impulse;
+                contact.normal_impulse = accumulated;
+
+                if (body_a.inverse_mass > 0.0f) {
+                    body_a.rigid_body->setLinearVelocity(velocity_a - contact.normal * (impulse * body_a.inverse_mass));
+                }
+                if (body_b.inverse_mass > 0.0f) {
+                    body_b.rigid_body->setLinearVelocity(velocity_b + contact.normal * (impulse * body_b.inverse_mass));
+                }
+            }
+        }
+
+        // Push overlapping bodies apart so resting contacts do not sink
+        for (std::size_t i = 0; i < count; ++i) {
+            const Contact& contact = contacts[i];
+            PhysicsBody& body_a = bodies[contact.a];
+            PhysicsBody& body_b = bodies[contact.b];
+
+            float inverse_mass_sum = body_a.inverse_mass + body_b.inverse_mass;
+            float depth = contact.penetration - PENETRATION_SLOP;
+            if (inverse_mass_sum <= 0.0f || depth <= 0.0f) continue;
+
+            Vector3D correction = contact.normal * (depth * CORRECTION_PERCENT / inverse_mass_sum);
+            if (body_a.inverse_mass > 0.0f) {
+                body_a.transform->setPosition(body_a.transform->getPosition() - correction * body_a.inverse_mass);
+            }
+            if (body_b.inverse_mass > 0.0f) {
+                body_b.transform->setPosition(body_b.transform->getPosition() + correction * body_b.inverse_mass);
+            }
+        }
+    }
+
+} // namespace gam300
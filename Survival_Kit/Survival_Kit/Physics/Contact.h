@@ -0,0 +1,110 @@
+/**
+ * @file Contact.h
+ * @brief Declaration of the narrowphase, contact islands and contact solver.
+ * @details Everything here works on plain arrays built by the PhysicsSystem each
+ *          step, so islands can be solved on the job system without touching the ECS.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __CONTACT_H__
+#define __CONTACT_H__
+
+#include <cstdint>
+#include <vector>
+#include "../Component/Collider.h"
+#include "../Component/RigidBody.h"
+#include "../Component/Transform3D.h"
+#include "../Physics/AABB.h"
+#include "../Utility/ECS_Variables.h"
+
+namespace gam300 {
+
+    /**
+     * @brief Per-step snapshot of one simulated entity.
+     */
+    struct PhysicsBody {
+        EntityID entity = INVALID_ENTITY_ID;
+        Transform3D* transform = nullptr;
+        RigidBody* rigid_body = nullptr;
+        Collider* collider = nullptr;   // Null for bodies without a collider
+        float inverse_mass = 0.0f;      // 0 for static and kinematic bodies
+        ColliderShape shape = ColliderShape::BOX;
+        uint32_t layer = 1u;
+        uint32_t mask = 0xFFFFFFFFu;
+        bool is_trigger = false;
+        Vector3D center;                // World-space collider center
+        float radius = 0.0f;            // World-space sphere radius (SPHERE only)
+        AABB bounds;                    // World-space collider bounds
+    };
+
+    /**
+     * @brief Contact between two bodies.
+     * @details The normal points from body a to body b.
+     */
+    struct Contact {
+        uint32_t a = 0;
+        uint32_t b = 0;
+        Vector3D normal;
+        float penetration = 0.0f;
+        float restitution = 0.0f;
+        float normal_impulse = 0.0f;    // Accumulated by the solver
+    };
+
+    /**
+     * @brief Overlap between a trigger collider and another collider.
+     */
+    struct TriggerEvent {
+        EntityID trigger = INVALID_ENTITY_ID;
+        EntityID other = INVALID_ENTITY_ID;
+    };
+
+    /**
+     * @brief Range of contacts belonging to one island.
+     */
+    struct ContactIsland {
+        uint32_t first_contact = 0;
+        uint32_t contact_count = 0;
+    };
+
+    /**
+     * @brief Generate a contact between two bodies with colliders.
+     * @param bodies The body array of the current step.
+     * @param a Index of the first body.
+     * @param b Index of the second body.
+     * @param out_contact Receives the contact when the shapes touch.
+     * @return True if the shapes are in contact.
+     */
+    bool generateContact(const std::vector<PhysicsBody>& bodies, uint32_t a, uint32_t b, Contact& out_contact);
+
+    /**
+     * @brief Group contacts into islands of dynamic bodies that touch each other.
+     * @details Static and kinematic bodies never join islands together, so two piles
+     *          resting on the same floor stay separate. Islands are ordered by their
+     *          lowest body index and keep the input contact order, so the result only
+     *          depends on the inputs.
+     * @param bodies The body array of the current step.
+     * @param contacts Contacts from the narrowphase, reordered by island on return.
+     * @param out_islands Receives one contact range per island.
+     */
+    void buildContactIslands(const std::vector<PhysicsBody>& bodies, std::vector<Contact>& contacts,
+        std::vector<ContactIsland>& out_islands);
+
+    /**
+     * @brief Resolve the contacts of one island.
+     * @details Sequential impulses on the linear velocity followed by a positional
+     *          correction pass. Only writes to the dynamic bodies of the island, so
+     *          different islands can be solved at the same time.
+     * @param bodies The body array of the current step.
+     * @param contacts First contact of the island.
+     * @param count Number of contacts in the island.
+     * @param iterations Number of velocity iterations.
+     */
+    void solveContactIsland(std::vector<PhysicsBody>& bodies, Contact* contacts, std::size_t count, int iterations);
+
+} // namespace gam300
+
+#endif // __CONTACT_H__
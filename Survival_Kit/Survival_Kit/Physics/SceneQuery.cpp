@@ -0,0 +1,138 @@
+/**
+ * @file SceneQuery.cpp
+ * @brief Implementation of the ray and shape query tests.
+ * @details Contains implementations for all functions declared in SceneQuery.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Physics/SceneQuery.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gam300 {
+
+    namespace {
+
+        bool raySphere(const Vector3D& origin, const Vector3D& direction, const Vector3D& center, float radius,
+            float max_distance, float& out_t, Vector3D& out_normal) {
+            Vector3D offset = origin - center;
+            float b = Vector3D::dot(offset, direction);
+            float c = offset.magnitudeSquared() - radius * radius;
+
+            // Outside and pointing away
+            if (c > 0.0f && b > 0.0f) {
+                return false;
+            }
+
+            if (c <= 0.0f) {
+                out_t = 0.0f;
+                out_normal = -direction;
+                return true;
+            }
+
+            float discriminant = b * b - c;
+            if (discriminant < 0.0f) {
+                return false;
+            }
+
+            float t = -b - std::sqrt(discriminant);
+            if (t > max_distance) {
+                return false;
+            }
+
+            out_t = std::max(t, 0.0f);
+            out_normal = (origin + direction * out_t - center) / radius;
+            return true;
+        }
+
+        bool rayBox(const Vector3D& origin, const Vector3D& direction, const AABB& box,
+            float max_distance, float& out_t, Vector3D& out_normal) {
+            const float o[3] = { origin.x, origin.y, origin.z };
+            const float d[3] = { direction.x, direction.y, direction.z };
+            const float lo[3] = { box.min.x, box.min.y, box.min.z };
+            const float hi[3] = { box.max.x, box.max.y, box.max.z };
+
+            float t_enter = 0.0f;
+            float t_exit = max_distance;
+            int enter_axis = -1;
+            float enter_sign = 0.0f;
+
+            for (int axis = 0; axis < 3; ++axis) {
+                if (std::fabs(d[axis]) < 1e-8f) {
+                    if (o[axis] < lo[axis] || o[axis] > hi[axis]) return false;
+                    continue;
+                }
+
+                float inv = 1.0f / d[axis];
+                float t1 = (lo[axis] - o[axis]) * inv;
+                float t2 = (hi[axis] - o[axis]) * inv;
+                float sign = -1.0f;
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                    sign = 1.0f;
+                }
+
+                if (t1 > t_enter) {
+                    t_enter = t1;
+                    enter_axis = axis;
+                    enter_sign = sign;
+                }
+                t_exit = std::min(t_exit, t2);
+                if (t_enter > t_exit) return false;
+            }
+
+            out_t = t_enter;
+            if (enter_axis < 0) {
+                out_normal = -direction;
+            }
+            else {
+                float n[3] = { 0.0f, 0.0f, 0.0f };
+                n[enter_axis] = enter_sign;
+                out_normal = Vector3D(n[0], n[1], n[2]);
+            }
+            return true;
+        }
+    }
+
+    bool intersectRayBody(const PhysicsBody& body, const Vector3D& origin, const Vector3D& direction,
+        float radius, float max_distance, RaycastHit& out_hit) {
+        float t = 0.0f;
+        Vector3D normal;
+        bool hit = false;
+
+        if (body.shape == ColliderShape::SPHERE) {
+            hit = raySphere(origin, direction, body.center, body.radius + radius, max_distance, t, normal);
+        }
+        else {
+            AABB grown(body.bounds.min - Vector3D(radius, radius, radius), body.bounds.max + Vector3D(radius, radius, radius));
+            hit = rayBox(origin, direction, grown, max_distance, t, normal);
+        }
+
+        if (!hit) {
+            return false;
+        }
+
+        out_hit.hit = true;
+        out_hit.entity = body.entity;
+        out_hit.distance = t;
+        out_hit.normal = normal;
+        out_hit.point = origin + direction * t - normal * radius;
+        return true;
+    }
+
+    bool overlapBoxBody(const PhysicsBody& body, const AABB& box) {
+        if (body.shape == ColliderShape::SPHERE) {
+            Vector3D closest(std::clamp(body.center.x, box.min.x, box.max.x),
+                             std::clamp(body.center.y, box.min.y, box.max.y),
+                             std::clamp(body.center.z, box.min.z, box.max.z));
+            return (closest - body.center).magnitudeSquared() <= body.radius * body.radius;
+        }
+        return body.bounds.overlaps(box);
+    }
+
+} // namespace gam300
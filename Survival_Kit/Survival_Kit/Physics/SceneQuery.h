@@ -0,0 +1,82 @@
+/**
+ * @file SceneQuery.h
+ * @brief Declaration of the ray and shape query types used by the PhysicsSystem.
+ * @details The PhysicsSystem finds candidate colliders through the broadphase, the
+ *          exact shape tests live here.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __SCENE_QUERY_H__
+#define __SCENE_QUERY_H__
+
+#include "../Physics/Contact.h"
+#include "../Utility/Vector3D.h"
+
+#include <limits>
+
+namespace gam300 {
+
+    /**
+     * @brief ignore_entity of a query that skips nothing.
+     * @details Entity IDs start at 0, so INVALID_ENTITY_ID is a real entity to a query.
+     */
+    constexpr EntityID IGNORE_NO_ENTITY = std::numeric_limits<EntityID>::max();
+
+    /**
+     * @brief One ray of a batched raycast.
+     */
+    struct Ray {
+        Vector3D origin;
+        Vector3D direction;             // Does not need to be normalized
+        float max_distance = 1000.0f;
+        EntityID ignore_entity = IGNORE_NO_ENTITY;     // Usually the entity casting the ray
+        uint32_t layer_mask = 0xFFFFFFFFu;             // Layers the ray can hit
+    };
+
+    /**
+     * @brief Result of a ray or shape cast.
+     */
+    struct RaycastHit {
+        bool hit = false;                       // False when nothing was hit, the other fields are then unset
+        EntityID entity = INVALID_ENTITY_ID;    // Entity of the collider hit
+        Vector3D point;                         // Hit point on the collider surface
+        Vector3D normal;                        // Surface normal at the hit point
+        float distance = 0.0f;                  // Distance travelled along the ray
+    };
+
+    /**
+     * @brief Layer bits used by scene queries, so any collider mask accepts them.
+     */
+    constexpr uint32_t QUERY_LAYER = 0xFFFFFFFFu;
+
+    /**
+     * @brief Intersect a ray or swept sphere with the collider of a body.
+     * @details Spheres are exact. Boxes are tested against their world-space bounds,
+     *          grown by the sphere radius for sphere casts. A ray starting inside a
+     *          shape hits at distance 0 with the normal facing back along the ray.
+     * @param body Body to test, must have a collider.
+     * @param origin Ray origin.
+     * @param direction Ray direction, normalized.
+     * @param radius Radius of the swept sphere, 0 for a plain ray.
+     * @param max_distance Length of the ray.
+     * @param out_hit Receives the hit (hit flag, entity, point, normal, distance).
+     * @return True if the ray hits within max_distance.
+     */
+    bool intersectRayBody(const PhysicsBody& body, const Vector3D& origin, const Vector3D& direction,
+        float radius, float max_distance, RaycastHit& out_hit);
+
+    /**
+     * @brief Check if a box overlaps the collider of a body.
+     * @param body Body to test, must have a collider.
+     * @param box Query box in world space.
+     * @return True if the shapes overlap.
+     */
+    bool overlapBoxBody(const PhysicsBody& body, const AABB& box);
+
+} // namespace gam300
+
+#endif // __SCENE_QUERY_H__
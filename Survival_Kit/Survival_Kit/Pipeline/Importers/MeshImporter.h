@@ -1,13 +1,82 @@
 #pragma once
 #include "../AssetImporter.h"
+#include "../../Graphics/MeshData.h"
+#include "../../Graphics/VertexLayout.h"
+#include "../../Resource/MeshBlob.h"
 
 namespace gam300 {
 
+    /**
+    * @brief Options of the mesh cooking steps.
+    */
+    struct MeshCookSettings {
+        bool weldVertices = true;           //!< Merge bit-identical vertices
+        bool optimize = true;               //!< Vertex cache, overdraw and vertex fetch ordering
+        uint32_t maxLods = 4;               //!< LOD 0 included
+        float lodReduction = 0.5f;          //!< Index count of each LOD relative to the previous one
+        float lodMaxError = 0.02f;          //!< Largest simplification error per LOD, relative to the mesh extent
+        VertexFormat vertexFormat = VertexFormat::QUANTIZED;
+    };
+
+    /**
+    * @brief What cooking did to the last mesh, for tools and logs.
+    */
+    struct MeshCookStats {
+        uint32_t sourceVertices = 0;        //!< Vertices before welding
+        uint32_t vertices = 0;              //!< Vertices in the blob
+        uint32_t indices = 0;               //!< Indices of LOD 0
+        uint32_t lods = 0;
+        float acmrBefore = 0.0f;            //!< FIFO 16 ACMR of LOD 0 in source order
+        float acmrAfter = 0.0f;             //!< FIFO 16 ACMR of LOD 0 once optimized
+    };
+
+    /**
+    * @brief Cooks .obj and .gltf/.glb files into mesh blobs.
+    * @details Parses the source, welds it, orders it for the vertex cache, overdraw and
+    * vertex fetch, builds a LOD chain by quadric simplification, packs the vertices
+    * in the runtime layout and writes one blob (see MeshBlob.h). FBX has no parser
+    * yet and is still copied as is.
+    */
     class MeshImporter : public IAssetImporter {
     public:
         bool CanImport(const std::string& ext) const override;
         ImportResult Import(const std::string& srcPath,
             const std::string& intermediateDir) override;
+
+        /**
+        * @brief Run every cooking step on a parsed mesh.
+        * @return The blob contents, ready for writeMeshBlob.
+        */
+        MeshBlobData Cook(MeshData mesh);
+
+        MeshCookSettings& GetSettings() { return m_settings; }
+        const MeshCookStats& GetLastStats() const { return m_stats; }
+
+        /**
+        * @brief Parse a Wavefront OBJ file, polygons are fanned into triangles.
+        */
+        static bool ParseObj(const std::string& path, MeshData& out, std::string& error);
+
+        /**
+        * @brief Parse the triangle primitives of a glTF 2.0 file (.gltf or .glb) into one mesh.
+        * @details Node transforms of the default scene are applied.
+        */
+        static bool ParseGltf(const std::string& path, MeshData& out, std::string& error);
+
+        /**
+        * @brief Cook a generated grid and check the blob it writes, needs no window or GL context.
+        * @details Checks the vertex and index counts read back from the blob, the LOD table,
+        * that vertex cache ordering lowers the ACMR of the shuffled source, and that malformed
+        * glTF documents fail with an error. main runs it with --validate-mesh-cook.
+        * @param workDir Directory the fixture and its blob are written to.
+        * @param report Receives one line per check.
+        * @return True if every check passed.
+        */
+        static bool Validate(const std::string& workDir, std::string& report);
+
+    private:
+        MeshCookSettings m_settings;
+        MeshCookStats m_stats;
     };
 
-} // end of namespace gam300
\ No newline at end of file
+} // end of namespace gam300
@@ -1,4 +1,6 @@
 #include "TextureImporter.h"
+#include "../../Graphics/stb_image.h"
+#include <algorithm>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -17,23 +19,43 @@ namespace gam300
         ImportResult r;
         try {
             fs::path src(srcPath);
-            fs::path out = fs::path(intermediateDir) / src.filename();
 
+            stbi_set_flip_vertically_on_load_thread(m_settings.flipVertical ? 1 : 0);
+            int w = 0, h = 0, channels = 0;
+            unsigned char* pixels = stbi_load(srcPath.c_str(), &w, &h, &channels, 4);
+            if (!pixels) {
+                r.ok = false;
+                r.error = std::string("Failed to decode image: ") + stbi_failure_reason();
+                return r;
+            }
+
+            TextureCompressor::Image image;
+            image.width = static_cast<uint32_t>(w);
+            image.height = static_cast<uint32_t>(h);
+            image.pixels.assign(pixels, pixels + static_cast<size_t>(w) * h * 4);
+            stbi_image_free(pixels);
+
+            TextureBlobData blob = Cook(image);
+
+            fs::path out = fs::path(intermediateDir) / (src.filename().string() + ".tex");
             fs::create_directories(out.parent_path());
-            fs::copy_file(src, out, fs::copy_options::overwrite_existing);
+            if (!writeTextureBlob(out.string(), blob)) {
+                r.ok = false;
+                r.error = "Failed to write " + out.string();
+                return r;
+            }
 
             r.ok = true;
             r.intermediatePath = out.string();
             r.type = AssetType::Texture;
 
-            // ----------- DEFAULT VALUES FOR NOW -----------
-            // for texture settings
+            // Settings the blob was actually cooked with
             TextureSettings ts;
-            ts.usageType = "COLOR";
-            ts.compression = "BC1";
+            ts.usageType = m_stats.format == TextureBlockFormat::BC5 ? "NORMAL" : "COLOR";
+            ts.compression = TextureCompressor::GetBlockFormatName(m_stats.format);
             ts.quality = 0.8f;
-            ts.generateMipmaps = true;
-            ts.srgb = true;
+            ts.generateMipmaps = m_settings.generateMipmaps;
+            ts.srgb = m_settings.srgb;
             ts.inputFiles = { src.filename().string() };
             r.textureSettings = std::move(ts);
         }
@@ -44,4 +66,37 @@ namespace gam300
         return r;
     }
 
-} //end of namepsace gam300
\ No newline at end of file
+    TextureBlobData TextureImporter::Cook(const TextureCompressor::Image& image) {
+        m_stats = TextureCookStats{};
+
+        // BC1 only keeps 1-bit alpha, anything softer needs the separate alpha block of BC3
+        TextureBlockFormat format = m_settings.format;
+        if (format == TextureBlockFormat::BC1 && TextureCompressor::HasAlpha(image)) {
+            format = TextureBlockFormat::BC3;
+        }
+
+        // BC5 holds data, not color, so it is never filtered as sRGB
+        const bool srgb = m_settings.srgb && format != TextureBlockFormat::BC5;
+        const std::vector<TextureCompressor::Image> mips =
+            TextureCompressor::GenerateMips(image, srgb, m_settings.generateMipmaps ? 0 : 1);
+
+        TextureBlobData blob;
+        blob.header.format = static_cast<uint32_t>(format);
+        blob.header.flags = srgb ? TEXTURE_BLOB_SRGB : 0;
+        blob.header.width = image.width;
+        blob.header.height = image.height;
+        blob.levels.reserve(mips.size());
+        for (const TextureCompressor::Image& level : mips) {
+            blob.levels.push_back(TextureCompressor::Compress(level, format));
+            m_stats.uncompressedBytes += level.pixels.size();
+            m_stats.cookedBytes += blob.levels.back().size();
+        }
+
+        m_stats.width = image.width;
+        m_stats.height = image.height;
+        m_stats.levels = static_cast<uint32_t>(mips.size());
+        m_stats.format = format;
+        return blob;
+    }
+
+} //end of namespace gam300
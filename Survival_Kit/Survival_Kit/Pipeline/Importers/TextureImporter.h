@@ -1,13 +1,55 @@
 #pragma once
 #include "../AssetImporter.h"
+#include "../TextureCompressor.h"
+#include "../../Resource/TextureBlob.h"
 
 namespace gam300
 {
 
+	/**
+	* @brief Options of the texture cooking steps.
+	*/
+	struct TextureCookSettings {
+		TextureBlockFormat format = TextureBlockFormat::BC1;	//!< BC1 becomes BC3 for images with alpha
+		bool generateMipmaps = true;
+		bool srgb = true;										//!< Color data, mips are filtered in linear light
+		bool flipVertical = true;								//!< Rows bottom to top, as GL samples them
+	};
+
+	/**
+	* @brief What cooking did to the last texture, for tools and logs.
+	*/
+	struct TextureCookStats {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t levels = 0;
+		TextureBlockFormat format = TextureBlockFormat::RGBA8;
+		uint64_t uncompressedBytes = 0;		//!< RGBA8 size of every level
+		uint64_t cookedBytes = 0;			//!< Size of every level in the blob
+	};
+
+	/**
+	* @brief Cooks .png, .jpg and .tga files into texture blobs.
+	* @details Decodes the source, builds the mip chain, block compresses every level
+	* and writes one blob (see TextureBlob.h), so the runtime never decodes an image.
+	*/
 	class TextureImporter : public IAssetImporter {
 		public:
 			bool CanImport(const std::string& ext) const override;
 			ImportResult Import(const std::string& srcPath, const std::string& intermediateDir) override;
+
+			/**
+			* @brief Run every cooking step on a decoded image.
+			* @return The blob contents, ready for writeTextureBlob.
+			*/
+			TextureBlobData Cook(const TextureCompressor::Image& image);
+
+			TextureCookSettings& GetSettings() { return m_settings; }
+			const TextureCookStats& GetLastStats() const { return m_stats; }
+
+		private:
+			TextureCookSettings m_settings;
+			TextureCookStats m_stats;
 	};
 
-} //end of namespace gam300
\ No newline at end of file
+} //end of namespace gam300
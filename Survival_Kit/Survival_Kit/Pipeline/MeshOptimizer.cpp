@@ -0,0 +1,663 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @brief Implementation of the offline mesh optimization passes.
+ * @details Contains implementations for all functions declared in MeshOptimizer.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_set>
+
+namespace gam300 {
+
+	namespace MeshOptimizer {
+
+		namespace {
+
+			constexpr uint32_t INVALID_INDEX = ~0u;
+
+			// Forsyth scoring constants, tuned for a 32 entry LRU cache
+			constexpr int   FORSYTH_CACHE_SIZE = 32;
+			constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+			constexpr float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+			constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+			constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+			// Cache used to find overdraw clusters, matches AnalyzeVertexCache
+			constexpr uint32_t OVERDRAW_CACHE_SIZE = 16;
+
+			// FNV-1a over raw bytes
+			uint64_t HashBytes(const void* data, size_t size) {
+				const unsigned char* bytes = static_cast<const unsigned char*>(data);
+				uint64_t hash = 1469598103934665603ull;
+				for (size_t i = 0; i < size; ++i) {
+					hash ^= bytes[i];
+					hash *= 1099511628211ull;
+				}
+				return hash;
+			}
+
+			// Open addressing table from a key of floats to the first vertex that had it
+			class VertexHashTable {
+			public:
+				VertexHashTable(size_t count, size_t key_floats) : m_key_floats(key_floats) {
+					size_t capacity = 1;
+					while (capacity < count * 2) capacity <<= 1;
+					m_slots.assign(capacity, INVALID_INDEX);
+				}
+
+				// Index of the first vertex with the same key, inserting this one if new
+				uint32_t FindOrInsert(uint32_t vertex, const std::vector<float>& keys) {
+					const float* key = &keys[static_cast<size_t>(vertex) * m_key_floats];
+					const size_t mask = m_slots.size() - 1;
+					size_t slot = static_cast<size_t>(HashBytes(key, m_key_floats * sizeof(float))) & mask;
+					while (m_slots[slot] != INVALID_INDEX) {
+						const float* other = &keys[static_cast<size_t>(m_slots[slot]) * m_key_floats];
+						if (std::memcmp(key, other, m_key_floats * sizeof(float)) == 0) {
+							return m_slots[slot];
+						}
+						slot = (slot + 1) & mask;
+					}
+					m_slots[slot] = vertex;
+					return vertex;
+				}
+
+			private:
+				std::vector<uint32_t> m_slots;
+				size_t m_key_floats;
+			};
+
+			// Map every vertex to the first vertex with the same position
+			std::vector<uint32_t> BuildPositionRemap(const std::vector<glm::vec3>& positions) {
+				std::vector<float> keys(positions.size() * 3);
+				for (size_t i = 0; i < positions.size(); ++i) {
+					// Adding +0 turns -0 into +0 so both hash the same
+					keys[i * 3 + 0] = positions[i].x + 0.0f;
+					keys[i * 3 + 1] = positions[i].y + 0.0f;
+					keys[i * 3 + 2] = positions[i].z + 0.0f;
+				}
+
+				VertexHashTable table(positions.size(), 3);
+				std::vector<uint32_t> remap(positions.size());
+				for (uint32_t i = 0; i < positions.size(); ++i) {
+					remap[i] = table.FindOrInsert(i, keys);
+				}
+				return remap;
+			}
+
+			// Triangles touching each vertex, in compressed rows
+			struct TriangleAdjacency {
+				std::vector<uint32_t> offsets;      // vertex_count + 1 entries
+				std::vector<uint32_t> triangles;
+
+				void Build(const std::vector<uint32_t>& indices, uint32_t vertex_count) {
+					offsets.assign(static_cast<size_t>(vertex_count) + 1, 0);
+					for (uint32_t index : indices) ++offsets[index + 1];
+					for (uint32_t v = 0; v < vertex_count; ++v) offsets[v + 1] += offsets[v];
+
+					triangles.resize(indices.size());
+					std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+					for (size_t i = 0; i < indices.size(); ++i) {
+						triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+					}
+				}
+			};
+
+			// FIFO cache simulation, a vertex is cached while fewer than size misses happened since it was loaded
+			struct FifoCache {
+				std::vector<uint32_t> timestamps;
+				uint32_t timestamp;
+				uint32_t size;
+
+				FifoCache(uint32_t vertex_count, uint32_t cache_size)
+					: timestamps(vertex_count, 0), timestamp(cache_size + 1), size(cache_size) {}
+
+				uint32_t Touch(uint32_t vertex) {
+					if (timestamp - timestamps[vertex] > size) {
+						timestamps[vertex] = timestamp++;
+						return 1;
+					}
+					return 0;
+				}
+
+				uint32_t Triangle(const uint32_t* triangle) {
+					return Touch(triangle[0]) + Touch(triangle[1]) + Touch(triangle[2]);
+				}
+
+				void Flush() { timestamp += size + 1; }
+			};
+
+			float ForsythVertexScore(int cache_position, uint32_t live_triangles) {
+				if (live_triangles == 0) {
+					return -1.0f;
+				}
+
+				float score = 0.0f;
+				if (cache_position >= 0) {
+					if (cache_position < 3) {
+						// The last triangle's vertices are penalised so strips don't go back on themselves
+						score = FORSYTH_LAST_TRIANGLE_SCORE;
+					}
+					else {
+						const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+						score = std::pow(1.0f - (cache_position - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+					}
+				}
+
+				// Vertices with few triangles left are finished first so they leave the cache
+				score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(live_triangles), -FORSYTH_VALENCE_BOOST_POWER);
+				return score;
+			}
+
+			// Symmetric 4x4 quadric of squared plane distances
+			struct Quadric {
+				double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+				double b0 = 0, b1 = 0, b2 = 0, c = 0;
+
+				void AddPlane(double nx, double ny, double nz, double d) {
+					a00 += nx * nx; a01 += nx * ny; a02 += nx * nz;
+					a11 += ny * ny; a12 += ny * nz; a22 += nz * nz;
+					b0 += nx * d; b1 += ny * d; b2 += nz * d;
+					c += d * d;
+				}
+
+				void Add(const Quadric& q) {
+					a00 += q.a00; a01 += q.a01; a02 += q.a02;
+					a11 += q.a11; a12 += q.a12; a22 += q.a22;
+					b0 += q.b0; b1 += q.b1; b2 += q.b2;
+					c += q.c;
+				}
+
+				double Evaluate(const glm::vec3& p) const {
+					const double x = p.x, y = p.y, z = p.z;
+					const double result = a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z
+						+ a11 * y * y + 2 * a12 * y * z + a22 * z * z
+						+ 2 * (b0 * x + b1 * y + b2 * z) + c;
+					return std::max(result, 0.0);
+				}
+			};
+
+			struct Collapse {
+				uint32_t from;
+				uint32_t to;
+				float cost;
+			};
+
+			template <typename T>
+			void Reorder(std::vector<T>& stream, const std::vector<uint32_t>& old_of_new) {
+				if (stream.empty()) return;
+				std::vector<T> reordered(old_of_new.size());
+				for (size_t i = 0; i < old_of_new.size(); ++i) {
+					reordered[i] = stream[old_of_new[i]];
+				}
+				stream.swap(reordered);
+			}
+
+		} // end of anonymous namespace
+
+		VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size) {
+			VertexCacheStats stats;
+			if (indices.empty()) return stats;
+
+			FifoCache cache(vertex_count, cache_size);
+			std::vector<unsigned char> used(vertex_count, 0);
+			uint32_t unique = 0;
+			for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+				stats.misses += cache.Triangle(&indices[i]);
+				for (size_t k = 0; k < 3; ++k) {
+					if (!used[indices[i + k]]) {
+						used[indices[i + k]] = 1;
+						++unique;
+					}
+				}
+			}
+
+			stats.acmr = static_cast<float>(stats.misses) / static_cast<float>(indices.size() / 3);
+			stats.atvr = unique ? static_cast<float>(stats.misses) / static_cast<float>(unique) : 0.0f;
+			return stats;
+		}
+
+		uint32_t WeldVertices(MeshData& mesh) {
+			const uint32_t vertex_count = static_cast<uint32_t>(mesh.positions.size());
+			const bool has_normals = mesh.normals.size() == vertex_count;
+			const bool has_colors = mesh.colors.size() == vertex_count;
+			const bool has_texcoords = mesh.texcoords.size() == vertex_count;
+
+			// Every attribute of a vertex side by side, the key compared when welding
+			const size_t key_floats = 3 + (has_normals ? 3 : 0) + (has_colors ? 3 : 0) + (has_texcoords ? 2 : 0);
+			std::vector<float> keys(static_cast<size_t>(vertex_count) * key_floats);
+			for (uint32_t v = 0; v < vertex_count; ++v) {
+				float* key = &keys[static_cast<size_t>(v) * key_floats];
+				auto push = [&key](float value) { *key++ = value + 0.0f; };
+
+				push(mesh.positions[v].x); push(mesh.positions[v].y); push(mesh.positions[v].z);
+				if (has_normals) { push(mesh.normals[v].x); push(mesh.normals[v].y); push(mesh.normals[v].z); }
+				if (has_colors) { push(mesh.colors[v].r); push(mesh.colors[v].g); push(mesh.colors[v].b); }
+				if (has_texcoords) { push(mesh.texcoords[v].x); push(mesh.texcoords[v].y); }
+			}
+
+			VertexHashTable table(vertex_count, key_floats);
+			std::vector<uint32_t> remap(vertex_count);
+			std::vector<uint32_t> old_of_new;
+			old_of_new.reserve(vertex_count);
+			for (uint32_t v = 0; v < vertex_count; ++v) {
+				const uint32_t first = table.FindOrInsert(v, keys);
+				if (first == v) {
+					remap[v] = static_cast<uint32_t>(old_of_new.size());
+					old_of_new.push_back(v);
+				}
+				else {
+					remap[v] = remap[first];
+				}
+			}
+
+			// Rewrite the indices, triangles that collapsed onto an edge are dropped
+			std::vector<uint32_t> indices;
+			indices.reserve(mesh.indices.size());
+			for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+				const uint32_t a = remap[mesh.indices[i + 0]];
+				const uint32_t b = remap[mesh.indices[i + 1]];
+				const uint32_t c = remap[mesh.indices[i + 2]];
+				if (a != b && b != c && a != c) {
+					indices.push_back(a);
+					indices.push_back(b);
+					indices.push_back(c);
+				}
+			}
+			mesh.indices.swap(indices);
+
+			Reorder(mesh.positions, old_of_new);
+			if (has_normals) Reorder(mesh.normals, old_of_new);
+			if (has_colors) Reorder(mesh.colors, old_of_new);
+			if (has_texcoords) Reorder(mesh.texcoords, old_of_new);
+
+			return static_cast<uint32_t>(old_of_new.size());
+		}
+
+		void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count) {
+			const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+			if (triangle_count == 0) return;
+
+			TriangleAdjacency adjacency;
+			adjacency.Build(indices, vertex_count);
+
+			// Live triangles of a vertex are the front of its adjacency row
+			std::vector<uint32_t> live(vertex_count);
+			for (uint32_t v = 0; v < vertex_count; ++v) {
+				live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+			}
+
+			std::vector<int> cache_position(vertex_count, -1);
+			std::vector<float> vertex_score(vertex_count);
+			for (uint32_t v = 0; v < vertex_count; ++v) {
+				vertex_score[v] = ForsythVertexScore(-1, live[v]);
+			}
+
+			std::vector<float> triangle_score(triangle_count);
+			std::vector<unsigned char> emitted(triangle_count, 0);
+			uint32_t best_triangle = 0;
+			float best_score = -1.0f;
+			for (uint32_t t = 0; t < triangle_count; ++t) {
+				triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+				if (triangle_score[t] > best_score) {
+					best_score = triangle_score[t];
+					best_triangle = t;
+				}
+			}
+
+			std::vector<uint32_t> result;
+			result.reserve(indices.size());
+			std::vector<uint32_t> cache, next_cache;
+			cache.reserve(FORSYTH_CACHE_SIZE + 3);
+			next_cache.reserve(FORSYTH_CACHE_SIZE + 3);
+			uint32_t cursor = 0;
+
+			while (result.size() < indices.size()) {
+				const uint32_t* triangle = &indices[static_cast<size_t>(best_triangle) * 3];
+				emitted[best_triangle] = 1;
+				result.insert(result.end(), triangle, triangle + 3);
+
+				// The emitted triangle is no longer live for its vertices
+				for (int k = 0; k < 3; ++k) {
+					const uint32_t v = triangle[k];
+					uint32_t* row = &adjacency.triangles[adjacency.offsets[v]];
+					for (uint32_t j = 0; j < live[v]; ++j) {
+						if (row[j] == best_triangle) {
+							std::swap(row[j], row[live[v] - 1]);
+							break;
+						}
+					}
+					--live[v];
+				}
+
+				// Emitted vertices move to the front of the cache
+				next_cache.assign(triangle, triangle + 3);
+				for (uint32_t v : cache) {
+					if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+						next_cache.push_back(v);
+					}
+				}
+
+				for (size_t i = 0; i < next_cache.size(); ++i) {
+					const uint32_t v = next_cache[i];
+					cache_position[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+					vertex_score[v] = ForsythVertexScore(cache_position[v], live[v]);
+				}
+
+				// Only triangles touching the cache changed score, the best of them goes next
+				best_score = -1.0f;
+				bool found = false;
+				for (uint32_t v : next_cache) {
+					for (uint32_t j = 0; j < live[v]; ++j) {
+						const uint32_t t = adjacency.triangles[adjacency.offsets[v] + j];
+						const float score = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+						triangle_score[t] = score;
+						if (score > best_score) {
+							best_score = score;
+							best_triangle = t;
+							found = true;
+						}
+					}
+				}
+
+				if (next_cache.size() > FORSYTH_CACHE_SIZE) {
+					next_cache.resize(FORSYTH_CACHE_SIZE);
+				}
+				cache.swap(next_cache);
+
+				// Dead end, continue with the next triangle in the original order
+				if (!found) {
+					while (cursor < triangle_count && emitted[cursor]) ++cursor;
+					if (cursor == triangle_count) break;
+					best_triangle = cursor;
+				}
+			}
+
+			indices.swap(result);
+		}
+
+		void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold) {
+			const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+			if (triangle_count == 0) return;
+			const uint32_t vertex_count = static_cast<uint32_t>(positions.size());
+
+			// Hard boundaries where the cache restarts, a triangle missing all three vertices
+			std::vector<uint32_t> hard;
+			{
+				FifoCache cache(vertex_count, OVERDRAW_CACHE_SIZE);
+				for (uint32_t t = 0; t < triangle_count; ++t) {
+					if (cache.Triangle(&indices[t * 3]) == 3 || t == 0) {
+						hard.push_back(t);
+					}
+				}
+				hard.push_back(triangle_count);
+			}
+
+			// Soft boundaries split a cluster once its running ACMR is close enough to the whole cluster's
+			std::vector<uint32_t> clusters;
+			{
+				FifoCache cache(vertex_count, OVERDRAW_CACHE_SIZE);
+				for (size_t h = 0; h + 1 < hard.size(); ++h) {
+					const uint32_t begin = hard[h];
+					const uint32_t end = hard[h + 1];
+
+					cache.Flush();
+					uint32_t cluster_misses = 0;
+					for (uint32_t t = begin; t < end; ++t) cluster_misses += cache.Triangle(&indices[t * 3]);
+					const float cluster_threshold = threshold * static_cast<float>(cluster_misses) / static_cast<float>(end - begin);
+
+					cache.Flush();
+					clusters.push_back(begin);
+					uint32_t running_misses = 0, running_triangles = 0;
+					for (uint32_t t = begin; t < end; ++t) {
+						running_misses += cache.Triangle(&indices[t * 3]);
+						++running_triangles;
+						if (t + 1 < end && static_cast<float>(running_misses) <= cluster_threshold * running_triangles) {
+							clusters.push_back(t + 1);
+							running_misses = running_triangles = 0;
+							cache.Flush();
+						}
+					}
+				}
+				clusters.push_back(triangle_count);
+			}
+
+			// Mesh centroid, then how much each cluster faces away from it
+			glm::dvec3 mesh_center(0.0);
+			double mesh_area = 0.0;
+			std::vector<float> sort_keys(clusters.size() - 1);
+			std::vector<glm::dvec3> cluster_center(clusters.size() - 1, glm::dvec3(0.0));
+			std::vector<glm::dvec3> cluster_normal(clusters.size() - 1, glm::dvec3(0.0));
+			for (size_t c = 0; c + 1 < clusters.size(); ++c) {
+				double cluster_area = 0.0;
+				for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+					const glm::dvec3 p0(positions[indices[t * 3]]);
+					const glm::dvec3 p1(positions[indices[t * 3 + 1]]);
+					const glm::dvec3 p2(positions[indices[t * 3 + 2]]);
+					const glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+					const double area = glm::length(normal);
+					cluster_center[c] += (p0 + p1 + p2) * (area / 3.0);
+					cluster_normal[c] += normal;
+					cluster_area += area;
+				}
+				mesh_center += cluster_center[c];
+				mesh_area += cluster_area;
+				if (cluster_area > 0.0) cluster_center[c] /= cluster_area;
+			}
+			if (mesh_area > 0.0) mesh_center /= mesh_area;
+
+			for (size_t c = 0; c < sort_keys.size(); ++c) {
+				const double length = glm::length(cluster_normal[c]);
+				const glm::dvec3 normal = length > 0.0 ? cluster_normal[c] / length : glm::dvec3(0.0);
+				sort_keys[c] = static_cast<float>(glm::dot(cluster_center[c] - mesh_center, normal));
+			}
+
+			std::vector<uint32_t> order(sort_keys.size());
+			std::iota(order.begin(), order.end(), 0u);
+			std::stable_sort(order.begin(), order.end(), [&sort_keys](uint32_t a, uint32_t b) { return sort_keys[a] > sort_keys[b]; });
+
+			std::vector<uint32_t> result;
+			result.reserve(indices.size());
+			for (uint32_t c : order) {
+				result.insert(result.end(), indices.begin() + static_cast<size_t>(clusters[c]) * 3, indices.begin() + static_cast<size_t>(clusters[c + 1]) * 3);
+			}
+			indices.swap(result);
+		}
+
+		uint32_t OptimizeVertexFetch(MeshData& mesh, std::vector<uint32_t>& indices) {
+			const uint32_t vertex_count = static_cast<uint32_t>(mesh.positions.size());
+			std::vector<uint32_t> remap(vertex_count, INVALID_INDEX);
+			std::vector<uint32_t> old_of_new;
+			old_of_new.reserve(vertex_count);
+
+			for (uint32_t& index : indices) {
+				if (remap[index] == INVALID_INDEX) {
+					remap[index] = static_cast<uint32_t>(old_of_new.size());
+					old_of_new.push_back(index);
+				}
+				index = remap[index];
+			}
+
+			const bool has_normals = mesh.normals.size() == vertex_count;
+			const bool has_colors = mesh.colors.size() == vertex_count;
+			const bool has_texcoords = mesh.texcoords.size() == vertex_count;
+			Reorder(mesh.positions, old_of_new);
+			if (has_normals) Reorder(mesh.normals, old_of_new);
+			if (has_colors) Reorder(mesh.colors, old_of_new);
+			if (has_texcoords) Reorder(mesh.texcoords, old_of_new);
+
+			return static_cast<uint32_t>(old_of_new.size());
+		}
+
+		std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions,
+			uint32_t target_index_count, float target_error, float* out_error) {
+			std::vector<uint32_t> result = indices;
+			double max_cost = 0.0;
+			if (out_error) *out_error = 0.0f;
+
+			const uint32_t vertex_count = static_cast<uint32_t>(positions.size());
+			if (result.size() <= target_index_count || vertex_count == 0) {
+				return result;
+			}
+
+			// Work in a unit sized copy so errors are relative to the mesh extent
+			glm::vec3 min_corner = positions[0], max_corner = positions[0];
+			for (const glm::vec3& p : positions) {
+				min_corner = glm::min(min_corner, p);
+				max_corner = glm::max(max_corner, p);
+			}
+			const glm::vec3 size = max_corner - min_corner;
+			const float extent = std::max(size.x, std::max(size.y, size.z));
+			if (extent <= 0.0f) {
+				return result;
+			}
+			std::vector<glm::vec3> unit(vertex_count);
+			for (uint32_t v = 0; v < vertex_count; ++v) {
+				unit[v] = (positions[v] - min_corner) / extent;
+			}
+
+			// Vertices sharing a position split an attribute seam, they stay where they are
+			const std::vector<uint32_t> position_of = BuildPositionRemap(positions);
+			std::vector<uint32_t> wedges(vertex_count, 0);
+			for (uint32_t v = 0; v < vertex_count; ++v) ++wedges[position_of[v]];
+
+			// So do borders, an edge with no opposite edge on another triangle
+			std::unordered_set<uint64_t> edges;
+			edges.reserve(result.size());
+			for (size_t i = 0; i < result.size(); i += 3) {
+				for (int k = 0; k < 3; ++k) {
+					const uint64_t a = position_of[result[i + k]];
+					const uint64_t b = position_of[result[i + (k + 1) % 3]];
+					edges.insert((a << 32) | b);
+				}
+			}
+
+			std::vector<unsigned char> locked(vertex_count, 0);
+			for (uint32_t v = 0; v < vertex_count; ++v) {
+				locked[v] = wedges[position_of[v]] > 1;
+			}
+			for (size_t i = 0; i < result.size(); i += 3) {
+				for (int k = 0; k < 3; ++k) {
+					const uint64_t a = position_of[result[i + k]];
+					const uint64_t b = position_of[result[i + (k + 1) % 3]];
+					if (edges.find((b << 32) | a) == edges.end()) {
+						locked[result[i + k]] = 1;
+						locked[result[i + (k + 1) % 3]] = 1;
+					}
+				}
+			}
+
+			// Quadric of every position from the planes of its triangles
+			std::vector<Quadric> quadrics(vertex_count);
+			for (size_t i = 0; i < result.size(); i += 3) {
+				const glm::dvec3 p0(unit[result[i]]), p1(unit[result[i + 1]]), p2(unit[result[i + 2]]);
+				glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+				const double length = glm::length(normal);
+				if (length <= 0.0) continue;
+				normal /= length;
+				const double d = -glm::dot(normal, p0);
+				for (int k = 0; k < 3; ++k) {
+					quadrics[position_of[result[i + k]]].AddPlane(normal.x, normal.y, normal.z, d);
+				}
+			}
+
+			const double cost_limit = static_cast<double>(target_error) * target_error;
+			TriangleAdjacency adjacency;
+			std::vector<Collapse> collapses;
+			std::vector<unsigned char> pass_locked(vertex_count);
+			std::vector<uint32_t> remap(vertex_count);
+
+			while (result.size() > target_index_count) {
+				adjacency.Build(result, vertex_count);
+
+				// Each edge once, in both directions where the vertex may move
+				collapses.clear();
+				for (size_t i = 0; i < result.size(); i += 3) {
+					for (int k = 0; k < 3; ++k) {
+						const uint32_t a = result[i + k];
+						const uint32_t b = result[i + (k + 1) % 3];
+						if (a > b) continue;
+
+						Quadric combined = quadrics[position_of[a]];
+						combined.Add(quadrics[position_of[b]]);
+						if (!locked[a]) collapses.push_back({ a, b, static_cast<float>(combined.Evaluate(unit[b])) });
+						if (!locked[b]) collapses.push_back({ b, a, static_cast<float>(combined.Evaluate(unit[a])) });
+					}
+				}
+				if (collapses.empty()) break;
+
+				std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r) {
+					if (l.cost != r.cost) return l.cost < r.cost;
+					if (l.from != r.from) return l.from < r.from;
+					return l.to < r.to;
+				});
+
+				// A collapse removes about two triangles, do roughly what is still needed this pass
+				const size_t goal = std::max<size_t>(1, (result.size() - target_index_count) / 6);
+				size_t performed = 0;
+				std::fill(pass_locked.begin(), pass_locked.end(), 0);
+				std::iota(remap.begin(), remap.end(), 0u);
+
+				for (const Collapse& collapse : collapses) {
+					if (collapse.cost > cost_limit) break;
+					if (pass_locked[collapse.from] || pass_locked[collapse.to]) continue;
+
+					// Reject collapses that would flip a remaining triangle
+					bool flips = false;
+					const glm::vec3& target = unit[collapse.to];
+					for (uint32_t j = adjacency.offsets[collapse.from]; j < adjacency.offsets[collapse.from + 1] && !flips; ++j) {
+						const uint32_t* triangle = &result[static_cast<size_t>(adjacency.triangles[j]) * 3];
+						if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) continue;
+
+						int k = triangle[0] == collapse.from ? 0 : (triangle[1] == collapse.from ? 1 : 2);
+						const glm::vec3& p1 = unit[triangle[(k + 1) % 3]];
+						const glm::vec3& p2 = unit[triangle[(k + 2) % 3]];
+						const glm::vec3 before = glm::cross(p1 - unit[collapse.from], p2 - unit[collapse.from]);
+						const glm::vec3 after = glm::cross(p1 - target, p2 - target);
+						flips = glm::dot(before, after) <= 0.0f;
+					}
+					if (flips) continue;
+
+					remap[collapse.from] = collapse.to;
+					quadrics[position_of[collapse.to]].Add(quadrics[position_of[collapse.from]]);
+					max_cost = std::max(max_cost, static_cast<double>(collapse.cost));
+
+					// Everything around the moved vertex waits for the next pass
+					pass_locked[collapse.from] = pass_locked[collapse.to] = 1;
+					for (uint32_t j = adjacency.offsets[collapse.from]; j < adjacency.offsets[collapse.from + 1]; ++j) {
+						const uint32_t* triangle = &result[static_cast<size_t>(adjacency.triangles[j]) * 3];
+						pass_locked[triangle[0]] = pass_locked[triangle[1]] = pass_locked[triangle[2]] = 1;
+					}
+
+					if (++performed >= goal) break;
+				}
+				if (performed == 0) break;
+
+				// Apply the pass, triangles that lost an edge are gone
+				size_t write = 0;
+				for (size_t i = 0; i < result.size(); i += 3) {
+					const uint32_t a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+					if (position_of[a] == position_of[b] || position_of[b] == position_of[c] || position_of[a] == position_of[c]) continue;
+					result[write++] = a;
+					result[write++] = b;
+					result[write++] = c;
+				}
+				result.resize(write);
+			}
+
+			if (out_error) *out_error = static_cast<float>(std::sqrt(max_cost));
+			return result;
+		}
+
+	} // end of namespace MeshOptimizer
+
+} // end of namespace gam300
@@ -0,0 +1,85 @@
+/**
+ * @file MeshOptimizer.h
+ * @brief Offline mesh optimization passes used when cooking meshes.
+ * @details Welding, vertex cache and overdraw ordering, vertex fetch ordering and
+ *          quadric error simplification for LOD chains. Every pass works on
+ *          MeshData streams and 32-bit triangle lists and is deterministic, so the
+ *          same source always cooks to the same blob.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __MESH_OPTIMIZER_H__
+#define __MESH_OPTIMIZER_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "../Graphics/MeshData.h"
+
+namespace gam300 {
+
+	namespace MeshOptimizer {
+
+		/**
+		* @brief Post-transform cache statistics of an index buffer.
+		*/
+		struct VertexCacheStats {
+			uint32_t misses = 0;    //!< Vertices transformed
+			float acmr = 0.0f;      //!< Average cache misses per triangle, 0.5 is ideal for large grids, 3 is worst
+			float atvr = 0.0f;      //!< Transformed vertices over unique vertices, 1 is ideal
+		};
+
+		/**
+		* @brief Simulate a FIFO post-transform cache over a triangle list.
+		* @param cache_size Entries of the simulated cache, 16 is typical of current GPUs.
+		*/
+		VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size = 16);
+
+		/**
+		* @brief Merge vertices whose every attribute is bit-identical and drop degenerate triangles.
+		* @details -0 and +0 compare equal. Indices are rewritten to the merged vertices.
+		* @return Number of vertices left.
+		*/
+		uint32_t WeldVertices(MeshData& mesh);
+
+		/**
+		* @brief Reorder triangles for the post-transform vertex cache (Forsyth).
+		*/
+		void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count);
+
+		/**
+		* @brief Reorder clusters of a cache optimized triangle list so outward facing clusters draw first.
+		* @details Clusters are split where the cache restarts, or where splitting keeps the
+		*          cluster ACMR within threshold times the original (Sander et al.). Call after
+		*          OptimizeVertexCache.
+		*/
+		void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold = 1.05f);
+
+		/**
+		* @brief Reorder vertices in first-use order of the indices and drop unreferenced ones.
+		* @details Every stream of the mesh is reordered, indices are rewritten.
+		* @return Number of vertices left.
+		*/
+		uint32_t OptimizeVertexFetch(MeshData& mesh, std::vector<uint32_t>& indices);
+
+		/**
+		* @brief Reduce a triangle list by quadric error edge collapses.
+		* @details Collapses move a vertex onto a neighbour, so the result indexes the same
+		*          vertex buffer. Borders and attribute seams are locked in place.
+		* @param target_index_count Stop once the list is this small.
+		* @param target_error Largest error allowed, relative to the mesh extent.
+		* @param out_error Error reached, relative to the mesh extent.
+		* @return The simplified triangle list.
+		*/
+		std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions,
+			uint32_t target_index_count, float target_error, float* out_error = nullptr);
+
+	} // end of namespace MeshOptimizer
+
+} // end of namespace gam300
+
+#endif // __MESH_OPTIMIZER_H__
@@ -0,0 +1,1004 @@
+/**
+ * @file TextureCompressor.cpp
+ * @brief Implementation of the offline texture passes.
+ * @details Contains implementations for all functions declared in TextureCompressor.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "TextureCompressor.h"
+#include "../Manager/JobManager.h"
+
+#include <xmmintrin.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace gam300 {
+
+	namespace TextureCompressor {
+
+		namespace {
+
+			// Block rows per parallelFor chunk, a row of a 4K level is 1024 blocks
+			constexpr size_t COMPRESS_GRAIN = 4;
+
+			// Power iterations for the principal axis of a block, converges well before this
+			constexpr int PCA_ITERATIONS = 8;
+
+			// Endpoint refinement passes, each one is a least squares fit to the chosen indices
+			constexpr int REFINE_ITERATIONS = 2;
+
+			// BC7 interpolation weights of 4-bit indices, out of 64
+			constexpr std::array<int, 16> BC7_WEIGHTS = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+			struct alignas(16) Color4 {
+				float v[4];
+			};
+
+			// Texels of a block one channel per row, so four texels fill an SSE register
+			struct alignas(16) BlockChannels {
+				float c[4][16];
+			};
+
+			void SplitChannels(const uint8_t* rgba, int channels, int stride, BlockChannels& out) {
+				for (int i = 0; i < 16; ++i) {
+					for (int c = 0; c < channels; ++c) out.c[c][i] = rgba[i * stride + c];
+				}
+			}
+
+			// All ones in the lanes of the first channels, zero past them
+			__m128 ChannelMask(int channels) {
+				return _mm_cmplt_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(static_cast<float>(channels)));
+			}
+
+			float SrgbToLinear(float c) {
+				return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+
+			float LinearToSrgb(float c) {
+				return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+			}
+
+			uint8_t ToByte(float c) {
+				return static_cast<uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+
+			// A 4x4 block at (bx, by), edge texels repeated
+			void FetchBlock(const Image& image, uint32_t bx, uint32_t by, uint8_t* block) {
+				for (uint32_t y = 0; y < 4; ++y) {
+					const uint32_t sy = std::min(by * 4 + y, image.height - 1);
+					for (uint32_t x = 0; x < 4; ++x) {
+						const uint32_t sx = std::min(bx * 4 + x, image.width - 1);
+						std::memcpy(block + (y * 4 + x) * 4, &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+					}
+				}
+			}
+
+			// Principal axis of the first channels of a block through its mean
+			void PrincipalAxis(const Color4* texels, int count, int channels, Color4& mean, Color4& axis) {
+				// Lanes past the channel count are zeroed, so they add nothing to the covariance
+				const __m128 lanes = ChannelMask(channels);
+				__m128 sum = _mm_setzero_ps();
+				for (int i = 0; i < count; ++i) sum = _mm_add_ps(sum, _mm_load_ps(texels[i].v));
+				const __m128 center = _mm_and_ps(lanes, _mm_div_ps(sum, _mm_set1_ps(static_cast<float>(count))));
+				_mm_store_ps(mean.v, center);
+
+				// Row a of the covariance is the sum of d * d[a]
+				__m128 row[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+				for (int i = 0; i < count; ++i) {
+					const __m128 d = _mm_and_ps(lanes, _mm_sub_ps(_mm_load_ps(texels[i].v), center));
+					row[0] = _mm_add_ps(row[0], _mm_mul_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 0, 0))));
+					row[1] = _mm_add_ps(row[1], _mm_mul_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 1, 1, 1))));
+					row[2] = _mm_add_ps(row[2], _mm_mul_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 2, 2, 2))));
+					row[3] = _mm_add_ps(row[3], _mm_mul_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3))));
+				}
+				alignas(16) float cov[4][4];
+				for (int a = 0; a < 4; ++a) _mm_store_ps(cov[a], row[a]);
+
+				// Start from the row of the largest variance, it is never orthogonal to the answer
+				int start = 0;
+				for (int c = 1; c < channels; ++c) {
+					if (cov[c][c] > cov[start][start]) start = c;
+				}
+				__m128 direction = row[start];
+
+				// The covariance is symmetric, so its rows double as its columns
+				for (int it = 0; it < PCA_ITERATIONS; ++it) {
+					alignas(16) float weight[4];
+					_mm_store_ps(weight, direction);
+					__m128 next = _mm_setzero_ps();
+					for (int b = 0; b < channels; ++b) next = _mm_add_ps(next, _mm_mul_ps(row[b], _mm_set1_ps(weight[b])));
+
+					alignas(16) float magnitude[4];
+					_mm_store_ps(magnitude, _mm_max_ps(next, _mm_sub_ps(_mm_setzero_ps(), next)));
+					float length = 0.0f;
+					for (int c = 0; c < channels; ++c) length = std::max(length, magnitude[c]);
+					if (length <= 0.0f) break;
+					direction = _mm_div_ps(next, _mm_set1_ps(length));
+				}
+				_mm_store_ps(axis.v, _mm_and_ps(lanes, direction));
+			}
+
+			// Lowest and highest position of the texels along an axis through the mean, 0 if none is lower or higher
+			void AxisRange(const Color4* texels, int count, int channels, const Color4& mean, const Color4& axis, float& low, float& high) {
+				__m128 lowest = _mm_setzero_ps();
+				__m128 highest = _mm_setzero_ps();
+				for (int i = 0; i < count; i += 4) {
+					// Four texels turned into one register per channel, a short tail repeats the last texel
+					__m128 channel[4];
+					for (int k = 0; k < 4; ++k) channel[k] = _mm_load_ps(texels[std::min(i + k, count - 1)].v);
+					_MM_TRANSPOSE4_PS(channel[0], channel[1], channel[2], channel[3]);
+
+					__m128 t = _mm_setzero_ps();
+					for (int c = 0; c < channels; ++c) {
+						t = _mm_add_ps(t, _mm_mul_ps(_mm_sub_ps(channel[c], _mm_set1_ps(mean.v[c])), _mm_set1_ps(axis.v[c])));
+					}
+					lowest = _mm_min_ps(lowest, t);
+					highest = _mm_max_ps(highest, t);
+				}
+				alignas(16) float lows[4], highs[4];
+				_mm_store_ps(lows, lowest);
+				_mm_store_ps(highs, highest);
+				low = std::min(std::min(lows[0], lows[1]), std::min(lows[2], lows[3]));
+				high = std::max(std::max(highs[0], highs[1]), std::max(highs[2], highs[3]));
+			}
+
+			// Nearest of the first entries of a palette for every texel, four texels per SSE op.
+			// Ties keep the lower entry, and every error is an exact integer well below 2^24
+			template<int CHANNELS>
+			void NearestEntries(const BlockChannels& block, const float (*palette)[4], int entries, uint8_t* indices, int* errors) {
+				__m128 best_error[4], best[4];
+				for (int g = 0; g < 4; ++g) {
+					best_error[g] = _mm_set1_ps(FLT_MAX);
+					best[g] = _mm_setzero_ps();
+				}
+				for (int p = 0; p < entries; ++p) {
+					__m128 entry[CHANNELS];
+					for (int c = 0; c < CHANNELS; ++c) entry[c] = _mm_set1_ps(palette[p][c]);
+					const __m128 index = _mm_set1_ps(static_cast<float>(p));
+					for (int g = 0; g < 4; ++g) {
+						__m128 error = _mm_setzero_ps();
+						for (int c = 0; c < CHANNELS; ++c) {
+							const __m128 d = _mm_sub_ps(_mm_load_ps(block.c[c] + g * 4), entry[c]);
+							error = _mm_add_ps(error, _mm_mul_ps(d, d));
+						}
+						const __m128 closer = _mm_cmplt_ps(error, best_error[g]);
+						best_error[g] = _mm_min_ps(error, best_error[g]);
+						best[g] = _mm_or_ps(_mm_and_ps(closer, index), _mm_andnot_ps(closer, best[g]));
+					}
+				}
+
+				alignas(16) float chosen[16], error[16];
+				for (int g = 0; g < 4; ++g) {
+					_mm_store_ps(chosen + g * 4, best[g]);
+					_mm_store_ps(error + g * 4, best_error[g]);
+				}
+				for (int i = 0; i < 16; ++i) {
+					indices[i] = static_cast<uint8_t>(chosen[i]);
+					errors[i] = static_cast<int>(error[i]);
+				}
+			}
+
+			// Least squares endpoints of a line given where each texel sits on it (0 at e0, 1 at e1)
+			bool FitEndpoints(const Color4* texels, const float* t, int count, int channels, Color4& e0, Color4& e1) {
+				float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+				__m128 sum_a = _mm_setzero_ps(), sum_b = _mm_setzero_ps();
+				for (int i = 0; i < count; ++i) {
+					const float a = 1.0f - t[i];
+					const float b = t[i];
+					aa += a * a; ab += a * b; bb += b * b;
+					const __m128 texel = _mm_load_ps(texels[i].v);
+					sum_a = _mm_add_ps(sum_a, _mm_mul_ps(_mm_set1_ps(a), texel));
+					sum_b = _mm_add_ps(sum_b, _mm_mul_ps(_mm_set1_ps(b), texel));
+				}
+				Color4 ax, bx;
+				_mm_store_ps(ax.v, sum_a);
+				_mm_store_ps(bx.v, sum_b);
+				const float det = aa * bb - ab * ab;
+				if (std::abs(det) < 1e-6f) return false;
+				for (int c = 0; c < channels; ++c) {
+					e0.v[c] = std::clamp((bb * ax.v[c] - ab * bx.v[c]) / det, 0.0f, 255.0f);
+					e1.v[c] = std::clamp((aa * bx.v[c] - ab * ax.v[c]) / det, 0.0f, 255.0f);
+				}
+				return true;
+			}
+
+			// ---------------------------------------------------------------- BC1
+
+			uint16_t To565(const Color4& c) {
+				const int r = static_cast<int>(std::clamp(c.v[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+				const int g = static_cast<int>(std::clamp(c.v[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+				const int b = static_cast<int>(std::clamp(c.v[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+				return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+			}
+
+			void From565(uint16_t c, int* rgb) {
+				const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+				rgb[0] = (r << 3) | (r >> 2);
+				rgb[1] = (g << 2) | (g >> 4);
+				rgb[2] = (b << 3) | (b >> 2);
+			}
+
+			// Palette of two 565 endpoints, 4 colors or 3 colors and transparent
+			void Bc1Palette(uint16_t c0, uint16_t c1, bool four_color, int palette[4][3]) {
+				From565(c0, palette[0]);
+				From565(c1, palette[1]);
+				for (int c = 0; c < 3; ++c) {
+					if (four_color) {
+						palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+						palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+					}
+					else {
+						palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+						palette[3][c] = 0;
+					}
+				}
+			}
+
+			// Nearest palette entry of every texel, returns the squared error of the block
+			int Bc1Indices(const BlockChannels& block, const bool* transparent, const int palette[4][3], bool four_color, uint8_t* indices) {
+				alignas(16) float entries[4][4] = {};
+				for (int p = 0; p < 4; ++p) {
+					for (int c = 0; c < 3; ++c) entries[p][c] = static_cast<float>(palette[p][c]);
+				}
+				int errors[16];
+				NearestEntries<3>(block, entries, four_color ? 4 : 3, indices, errors);
+
+				int total = 0;
+				for (int i = 0; i < 16; ++i) {
+					if (transparent[i]) {
+						indices[i] = 3;
+						continue;
+					}
+					total += errors[i];
+				}
+				return total;
+			}
+
+			// ---------------------------------------------------------------- BC4
+
+			void Bc4Palette(int a0, int a1, int palette[8]) {
+				palette[0] = a0;
+				palette[1] = a1;
+				if (a0 > a1) {
+					for (int i = 2; i < 8; ++i) palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+				}
+				else {
+					for (int i = 2; i < 6; ++i) palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+					palette[6] = 0;
+					palette[7] = 255;
+				}
+			}
+
+			int Bc4Indices(const BlockChannels& block, int a0, int a1, uint8_t* indices) {
+				int palette[8];
+				Bc4Palette(a0, a1, palette);
+				alignas(16) float entries[8][4] = {};
+				for (int p = 0; p < 8; ++p) entries[p][0] = static_cast<float>(palette[p]);
+				int errors[16];
+				NearestEntries<1>(block, entries, 8, indices, errors);
+
+				int total = 0;
+				for (int error : errors) total += error;
+				return total;
+			}
+
+			// ---------------------------------------------------------------- BC7
+
+			// 7-bit endpoint and the p-bit that decode closest to a color
+			void QuantizeBc7Endpoint(const Color4& color, int* quantized, int& pbit) {
+				int best_error = 1 << 30;
+				for (int p = 0; p < 2; ++p) {
+					int error = 0;
+					int q[4];
+					for (int c = 0; c < 4; ++c) {
+						q[c] = std::clamp(static_cast<int>((color.v[c] - p) / 2.0f + 0.5f), 0, 127);
+						const int d = ((q[c] << 1) | p) - static_cast<int>(color.v[c] + 0.5f);
+						error += d * d;
+					}
+					if (error < best_error) {
+						best_error = error;
+						pbit = p;
+						std::memcpy(quantized, q, sizeof(q));
+					}
+				}
+			}
+
+			int Bc7Indices(const BlockChannels& block, const int* e0, const int* e1, uint8_t* indices) {
+				alignas(16) float palette[16][4];
+				for (int i = 0; i < 16; ++i) {
+					for (int c = 0; c < 4; ++c) {
+						palette[i][c] = static_cast<float>(((64 - BC7_WEIGHTS[i]) * e0[c] + BC7_WEIGHTS[i] * e1[c] + 32) >> 6);
+					}
+				}
+				int errors[16];
+				NearestEntries<4>(block, palette, 16, indices, errors);
+
+				int total = 0;
+				for (int error : errors) total += error;
+				return total;
+			}
+
+			// Little endian bit stream of a 128-bit block
+			class BlockWriter {
+			public:
+				explicit BlockWriter(uint8_t* out) : m_out(out) { std::memset(m_out, 0, 16); }
+
+				void Write(uint32_t value, int bits) {
+					for (int i = 0; i < bits; ++i, ++m_bit) {
+						if (value & (1u << i)) m_out[m_bit >> 3] |= static_cast<uint8_t>(1u << (m_bit & 7));
+					}
+				}
+
+			private:
+				uint8_t* m_out;
+				int m_bit = 0;
+			};
+
+			// Reads back what BlockWriter wrote
+			class BlockReader {
+			public:
+				explicit BlockReader(const uint8_t* in) : m_in(in) {}
+
+				uint32_t Read(int bits) {
+					uint32_t value = 0;
+					for (int i = 0; i < bits; ++i, ++m_bit) {
+						if (m_in[m_bit >> 3] & (1u << (m_bit & 7))) value |= 1u << i;
+					}
+					return value;
+				}
+
+			private:
+				const uint8_t* m_in;
+				int m_bit = 0;
+			};
+
+			// ---------------------------------------------------------------- Validation
+
+			// PSNR floors of levels 0 and 2 of the validation image, about 2 dB under what the encoders reach.
+			// Level 2 packs the same edges into a quarter of the blocks, so it sits well below level 0
+			constexpr double BC1_MIN_PSNR[2] = { 38.0, 30.0 };
+			constexpr double BC3_MIN_PSNR[2] = { 39.0, 31.0 };
+			constexpr double BC5_MIN_PSNR[2] = { 49.0, 42.0 };
+			constexpr double BC7_MIN_PSNR[2] = { 41.0, 31.0 };
+
+			// Odd size on purpose, so the edge blocks are partial
+			constexpr uint32_t VALIDATE_WIDTH = 258;
+			constexpr uint32_t VALIDATE_HEIGHT = 194;
+
+			// Gradients, hard edged disks and a little noise, with a smooth alpha falloff
+			Image MakeValidationImage(uint32_t width, uint32_t height) {
+				Image image;
+				image.width = width;
+				image.height = height;
+				image.pixels.resize(static_cast<size_t>(width) * height * 4);
+				uint32_t seed = 12345u;
+				for (uint32_t y = 0; y < height; ++y) {
+					for (uint32_t x = 0; x < width; ++x) {
+						const float u = x / static_cast<float>(width), v = y / static_cast<float>(height);
+						float color[3] = { u, v, 0.5f + 0.5f * std::sin(u * 12.0f + v * 5.0f) };
+						for (int disk = 0; disk < 6; ++disk) {
+							const float dx = u - (0.15f + 0.14f * disk), dy = v - (0.3f + 0.08f * (disk % 3));
+							if (dx * dx + dy * dy < 0.004f) {
+								color[0] = (disk & 1) ? 0.9f : 0.1f;
+								color[1] = (disk & 2) ? 0.8f : 0.2f;
+								color[2] = (disk & 4) ? 0.7f : 0.3f;
+							}
+						}
+						uint8_t* pixel = &image.pixels[(static_cast<size_t>(y) * width + x) * 4];
+						for (int c = 0; c < 3; ++c) {
+							seed = seed * 1664525u + 1013904223u;
+							pixel[c] = ToByte(color[c] + ((seed >> 24) % 7 - 3.0f) / 255.0f);
+						}
+						const float dx = u - 0.5f, dy = v - 0.5f;
+						pixel[3] = ToByte(1.2f - 2.0f * std::sqrt(dx * dx + dy * dy));
+					}
+				}
+				return image;
+			}
+
+			// PSNR over the channels set in channel_mask, 99 dB for an exact match
+			double Psnr(const Image& a, const Image& b, int channel_mask) {
+				double error = 0.0;
+				size_t samples = 0;
+				for (size_t i = 0; i < a.pixels.size(); i += 4) {
+					for (int c = 0; c < 4; ++c) {
+						if (!(channel_mask & (1 << c))) continue;
+						const double d = static_cast<double>(a.pixels[i + c]) - b.pixels[i + c];
+						error += d * d;
+						++samples;
+					}
+				}
+				if (samples == 0 || error == 0.0) return 99.0;
+				return 10.0 * std::log10(255.0 * 255.0 * samples / error);
+			}
+
+		} // anonymous namespace
+
+		std::vector<Image> GenerateMips(const Image& base, bool srgb, uint32_t max_levels) {
+			std::vector<Image> levels;
+			if (base.width == 0 || base.height == 0) return levels;
+			levels.push_back(base);
+
+			// Filtering happens on linear floats, only the output of each level is rounded
+			std::array<float, 256> to_linear;
+			for (int i = 0; i < 256; ++i) {
+				to_linear[i] = srgb ? SrgbToLinear(i / 255.0f) : i / 255.0f;
+			}
+
+			uint32_t width = base.width, height = base.height;
+			std::vector<float> current(static_cast<size_t>(width) * height * 4);
+			for (size_t i = 0; i < current.size(); i += 4) {
+				for (int c = 0; c < 3; ++c) current[i + c] = to_linear[base.pixels[i + c]];
+				current[i + 3] = base.pixels[i + 3] / 255.0f;
+			}
+
+			while ((width > 1 || height > 1) && (max_levels == 0 || levels.size() < max_levels)) {
+				const uint32_t next_width = std::max(1u, width / 2);
+				const uint32_t next_height = std::max(1u, height / 2);
+				std::vector<float> next(static_cast<size_t>(next_width) * next_height * 4);
+
+				Image level;
+				level.width = next_width;
+				level.height = next_height;
+				level.pixels.resize(next.size());
+
+				for (uint32_t y = 0; y < next_height; ++y) {
+					for (uint32_t x = 0; x < next_width; ++x) {
+						// 2x2 box, clamped where a dimension is already 1
+						const uint32_t xs[2] = { std::min(x * 2, width - 1), std::min(x * 2 + 1, width - 1) };
+						const uint32_t ys[2] = { std::min(y * 2, height - 1), std::min(y * 2 + 1, height - 1) };
+
+						float color[3] = {}, plain[3] = {}, alpha = 0.0f;
+						for (uint32_t sy : ys) {
+							for (uint32_t sx : xs) {
+								const float* texel = &current[(static_cast<size_t>(sy) * width + sx) * 4];
+								for (int c = 0; c < 3; ++c) {
+									color[c] += texel[c] * texel[3];
+									plain[c] += texel[c];
+								}
+								alpha += texel[3];
+							}
+						}
+
+						float* out = &next[(static_cast<size_t>(y) * next_width + x) * 4];
+						for (int c = 0; c < 3; ++c) {
+							out[c] = alpha > 0.0f ? color[c] / alpha : plain[c] * 0.25f;
+						}
+						out[3] = alpha * 0.25f;
+
+						uint8_t* pixel = &level.pixels[(static_cast<size_t>(y) * next_width + x) * 4];
+						for (int c = 0; c < 3; ++c) {
+							pixel[c] = ToByte(srgb ? LinearToSrgb(out[c]) : out[c]);
+						}
+						pixel[3] = ToByte(out[3]);
+					}
+				}
+
+				levels.push_back(std::move(level));
+				current.swap(next);
+				width = next_width;
+				height = next_height;
+			}
+			return levels;
+		}
+
+		void CompressBlockBC1(const uint8_t* rgba, uint8_t* out, bool opaque_only) {
+			Color4 texels[16];
+			bool transparent[16];
+			bool any_transparent = false;
+			int opaque_count = 0;
+			Color4 opaque[16];
+			BlockChannels block;
+			SplitChannels(rgba, 3, 4, block);
+			for (int i = 0; i < 16; ++i) {
+				for (int c = 0; c < 4; ++c) texels[i].v[c] = rgba[i * 4 + c];
+				transparent[i] = !opaque_only && rgba[i * 4 + 3] < 128;
+				any_transparent |= transparent[i];
+				if (!transparent[i]) opaque[opaque_count++] = texels[i];
+			}
+
+			uint16_t c0 = 0, c1 = 0;
+			uint8_t indices[16] = {};
+			const bool four_color = !any_transparent;
+
+			if (opaque_count > 0) {
+				Color4 mean, axis;
+				PrincipalAxis(opaque, opaque_count, 3, mean, axis);
+
+				// Extremes along the axis are the starting endpoints
+				float low = 0.0f, high = 0.0f;
+				AxisRange(opaque, opaque_count, 3, mean, axis, low, high);
+				const float length = axis.v[0] * axis.v[0] + axis.v[1] * axis.v[1] + axis.v[2] * axis.v[2];
+				Color4 e0 = mean, e1 = mean;
+				if (length > 0.0f) {
+					for (int c = 0; c < 3; ++c) {
+						e0.v[c] = mean.v[c] + axis.v[c] * high / length;
+						e1.v[c] = mean.v[c] + axis.v[c] * low / length;
+					}
+				}
+
+				// Fraction toward c1 of each index, per mode
+				static const float four_t[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+				static const float three_t[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+				const float* index_t = four_color ? four_t : three_t;
+
+				int best_error = 1 << 30;
+				for (int it = 0; it <= REFINE_ITERATIONS; ++it) {
+					uint16_t q0 = To565(e0), q1 = To565(e1);
+					// The mode lives in the endpoint order, equal endpoints read as 3 colors
+					if (four_color ? q0 < q1 : q0 > q1) std::swap(q0, q1);
+					int palette[4][3];
+					Bc1Palette(q0, q1, four_color && q0 != q1, palette);
+					uint8_t candidate[16];
+					const int error = Bc1Indices(block, transparent, palette, four_color && q0 != q1, candidate);
+					if (error < best_error) {
+						best_error = error;
+						c0 = q0;
+						c1 = q1;
+						std::memcpy(indices, candidate, sizeof(indices));
+					}
+					if (error == 0 || it == REFINE_ITERATIONS) break;
+
+					float t[16];
+					int n = 0;
+					for (int i = 0; i < 16; ++i) {
+						if (!transparent[i]) t[n++] = index_t[candidate[i]];
+					}
+					Color4 f0 = {}, f1 = {};
+					if (!FitEndpoints(opaque, t, opaque_count, 3, f0, f1)) break;
+					e0 = f0;
+					e1 = f1;
+				}
+			}
+			else {
+				// Fully transparent, 3 color mode with every index transparent
+				for (int i = 0; i < 16; ++i) indices[i] = 3;
+			}
+
+			uint32_t bits = 0;
+			for (int i = 0; i < 16; ++i) bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+			out[0] = static_cast<uint8_t>(c0);
+			out[1] = static_cast<uint8_t>(c0 >> 8);
+			out[2] = static_cast<uint8_t>(c1);
+			out[3] = static_cast<uint8_t>(c1 >> 8);
+			std::memcpy(out + 4, &bits, 4);
+		}
+
+		void CompressBlockBC4(const uint8_t* values, uint8_t* out) {
+			int low = 255, high = 0, inner_low = 255, inner_high = 0;
+			for (int i = 0; i < 16; ++i) {
+				low = std::min<int>(low, values[i]);
+				high = std::max<int>(high, values[i]);
+				if (values[i] != 0 && values[i] != 255) {
+					inner_low = std::min<int>(inner_low, values[i]);
+					inner_high = std::max<int>(inner_high, values[i]);
+				}
+			}
+
+			BlockChannels block;
+			SplitChannels(values, 1, 1, block);
+
+			// 8 interpolated values over the full range, or 6 over the inner range plus exact 0 and 255
+			uint8_t indices[16];
+			int a0 = high, a1 = low;
+			int best_error = Bc4Indices(block, a0, a1, indices);
+			if (best_error > 0 && inner_low <= inner_high) {
+				uint8_t candidate[16];
+				const int error = Bc4Indices(block, inner_low, inner_high, candidate);
+				if (error < best_error) {
+					best_error = error;
+					a0 = inner_low;
+					a1 = inner_high;
+					std::memcpy(indices, candidate, sizeof(indices));
+				}
+			}
+
+			out[0] = static_cast<uint8_t>(a0);
+			out[1] = static_cast<uint8_t>(a1);
+			uint64_t bits = 0;
+			for (int i = 0; i < 16; ++i) bits |= static_cast<uint64_t>(indices[i]) << (i * 3);
+			for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+		}
+
+		void CompressBlockBC7(const uint8_t* rgba, uint8_t* out) {
+			Color4 texels[16];
+			for (int i = 0; i < 16; ++i) {
+				for (int c = 0; c < 4; ++c) texels[i].v[c] = rgba[i * 4 + c];
+			}
+			BlockChannels block;
+			SplitChannels(rgba, 4, 4, block);
+
+			Color4 mean, axis;
+			PrincipalAxis(texels, 16, 4, mean, axis);
+
+			float low = 0.0f, high = 0.0f, length = 0.0f;
+			for (int c = 0; c < 4; ++c) length += axis.v[c] * axis.v[c];
+			AxisRange(texels, 16, 4, mean, axis, low, high);
+			Color4 e0 = mean, e1 = mean;
+			if (length > 0.0f) {
+				for (int c = 0; c < 4; ++c) {
+					e0.v[c] = std::clamp(mean.v[c] + axis.v[c] * low / length, 0.0f, 255.0f);
+					e1.v[c] = std::clamp(mean.v[c] + axis.v[c] * high / length, 0.0f, 255.0f);
+				}
+			}
+
+			int q0[4] = {}, q1[4] = {}, p0 = 0, p1 = 0;
+			uint8_t indices[16] = {};
+			int best_error = 1 << 30;
+			for (int it = 0; it <= REFINE_ITERATIONS; ++it) {
+				int c0[4], c1[4], b0, b1;
+				QuantizeBc7Endpoint(e0, c0, b0);
+				QuantizeBc7Endpoint(e1, c1, b1);
+				int d0[4], d1[4];
+				for (int c = 0; c < 4; ++c) {
+					d0[c] = (c0[c] << 1) | b0;
+					d1[c] = (c1[c] << 1) | b1;
+				}
+
+				uint8_t candidate[16];
+				const int error = Bc7Indices(block, d0, d1, candidate);
+				if (error < best_error) {
+					best_error = error;
+					std::memcpy(q0, c0, sizeof(q0));
+					std::memcpy(q1, c1, sizeof(q1));
+					p0 = b0;
+					p1 = b1;
+					std::memcpy(indices, candidate, sizeof(indices));
+				}
+				if (error == 0 || it == REFINE_ITERATIONS) break;
+
+				float t[16];
+				for (int i = 0; i < 16; ++i) t[i] = BC7_WEIGHTS[candidate[i]] / 64.0f;
+				Color4 f0 = {}, f1 = {};
+				if (!FitEndpoints(texels, t, 16, 4, f0, f1)) break;
+				e0 = f0;
+				e1 = f1;
+			}
+
+			// The anchor index is stored without its top bit, flip the line if it is set
+			if (indices[0] & 8) {
+				std::swap(q0, q1);
+				std::swap(p0, p1);
+				for (uint8_t& index : indices) index = static_cast<uint8_t>(15 - index);
+			}
+
+			BlockWriter writer(out);
+			writer.Write(1u << 6, 7);               // Mode 6
+			for (int c = 0; c < 4; ++c) {
+				writer.Write(static_cast<uint32_t>(q0[c]), 7);
+				writer.Write(static_cast<uint32_t>(q1[c]), 7);
+			}
+			writer.Write(static_cast<uint32_t>(p0), 1);
+			writer.Write(static_cast<uint32_t>(p1), 1);
+			writer.Write(indices[0], 3);
+			for (int i = 1; i < 16; ++i) writer.Write(indices[i], 4);
+		}
+
+		std::vector<uint8_t> Compress(const Image& image, TextureBlockFormat format) {
+			std::vector<uint8_t> out(getTextureLevelSize(format, image.width, image.height));
+			if (format == TextureBlockFormat::RGBA8) {
+				std::memcpy(out.data(), image.pixels.data(), out.size());
+				return out;
+			}
+
+			const uint32_t blocks_x = (image.width + 3) / 4;
+			const uint32_t blocks_y = (image.height + 3) / 4;
+			const size_t block_size = format == TextureBlockFormat::BC1 ? 8 : 16;
+
+			// Each block writes its own bytes, so the output does not depend on the chunking
+			JM.parallelFor(blocks_y, COMPRESS_GRAIN, [&](size_t begin, size_t end) {
+				uint8_t block[64];
+				uint8_t channel[16];
+				for (size_t by = begin; by < end; ++by) {
+					for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+						FetchBlock(image, bx, static_cast<uint32_t>(by), block);
+						uint8_t* dst = out.data() + (by * blocks_x + bx) * block_size;
+						switch (format) {
+						case TextureBlockFormat::BC1:
+							CompressBlockBC1(block, dst);
+							break;
+						case TextureBlockFormat::BC3:
+							for (int i = 0; i < 16; ++i) channel[i] = block[i * 4 + 3];
+							CompressBlockBC4(channel, dst);
+							CompressBlockBC1(block, dst + 8, true);
+							break;
+						case TextureBlockFormat::BC5:
+							for (int c = 0; c < 2; ++c) {
+								for (int i = 0; i < 16; ++i) channel[i] = block[i * 4 + c];
+								CompressBlockBC4(channel, dst + c * 8);
+							}
+							break;
+						case TextureBlockFormat::BC7:
+							CompressBlockBC7(block, dst);
+							break;
+						default:
+							break;
+						}
+					}
+				}
+			});
+			return out;
+		}
+
+		void DecompressBlockBC1(const uint8_t* in, uint8_t* rgba, bool opaque_only) {
+			const uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+			const uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+			const bool four_color = opaque_only || c0 > c1;
+			int palette[4][3];
+			Bc1Palette(c0, c1, four_color, palette);
+
+			uint32_t bits;
+			std::memcpy(&bits, in + 4, 4);
+			for (int i = 0; i < 16; ++i) {
+				const uint32_t index = (bits >> (i * 2)) & 3;
+				for (int c = 0; c < 3; ++c) rgba[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+				rgba[i * 4 + 3] = !four_color && index == 3 ? 0 : 255;
+			}
+		}
+
+		void DecompressBlockBC4(const uint8_t* in, uint8_t* values) {
+			int palette[8];
+			Bc4Palette(in[0], in[1], palette);
+			uint64_t bits = 0;
+			for (int i = 0; i < 6; ++i) bits |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+			for (int i = 0; i < 16; ++i) values[i] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+		}
+
+		bool DecompressBlockBC7(const uint8_t* in, uint8_t* rgba) {
+			// Mode 6 is six 0 bits and a 1, the top bit of the byte already belongs to the endpoints
+			if ((in[0] & 0x7F) != (1u << 6)) {
+				std::memset(rgba, 0, 64);
+				return false;
+			}
+
+			BlockReader reader(in);
+			reader.Read(7);
+			int e0[4], e1[4];
+			for (int c = 0; c < 4; ++c) {
+				e0[c] = static_cast<int>(reader.Read(7)) << 1;
+				e1[c] = static_cast<int>(reader.Read(7)) << 1;
+			}
+			const int p0 = static_cast<int>(reader.Read(1)), p1 = static_cast<int>(reader.Read(1));
+			for (int c = 0; c < 4; ++c) {
+				e0[c] |= p0;
+				e1[c] |= p1;
+			}
+			for (int i = 0; i < 16; ++i) {
+				const int weight = BC7_WEIGHTS[reader.Read(i == 0 ? 3 : 4)];
+				for (int c = 0; c < 4; ++c) {
+					rgba[i * 4 + c] = static_cast<uint8_t>(((64 - weight) * e0[c] + weight * e1[c] + 32) >> 6);
+				}
+			}
+			return true;
+		}
+
+		Image Decompress(const std::vector<uint8_t>& data, uint32_t width, uint32_t height, TextureBlockFormat format) {
+			Image image;
+			image.width = width;
+			image.height = height;
+			image.pixels.resize(static_cast<size_t>(width) * height * 4);
+			if (data.size() < getTextureLevelSize(format, width, height)) return image;
+			if (format == TextureBlockFormat::RGBA8) {
+				std::memcpy(image.pixels.data(), data.data(), image.pixels.size());
+				return image;
+			}
+
+			const uint32_t blocks_x = (width + 3) / 4;
+			const uint32_t blocks_y = (height + 3) / 4;
+			const size_t block_size = format == TextureBlockFormat::BC1 ? 8 : 16;
+			uint8_t block[64];
+			uint8_t channel[16];
+			for (uint32_t by = 0; by < blocks_y; ++by) {
+				for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+					const uint8_t* src = data.data() + (static_cast<size_t>(by) * blocks_x + bx) * block_size;
+					switch (format) {
+					case TextureBlockFormat::BC1:
+						DecompressBlockBC1(src, block);
+						break;
+					case TextureBlockFormat::BC3:
+						DecompressBlockBC1(src + 8, block, true);
+						DecompressBlockBC4(src, channel);
+						for (int i = 0; i < 16; ++i) block[i * 4 + 3] = channel[i];
+						break;
+					case TextureBlockFormat::BC5:
+						for (int c = 0; c < 2; ++c) {
+							DecompressBlockBC4(src + c * 8, channel);
+							for (int i = 0; i < 16; ++i) block[i * 4 + c] = channel[i];
+						}
+						for (int i = 0; i < 16; ++i) {
+							block[i * 4 + 2] = 0;
+							block[i * 4 + 3] = 255;
+						}
+						break;
+					case TextureBlockFormat::BC7:
+						DecompressBlockBC7(src, block);
+						break;
+					default:
+						break;
+					}
+
+					// Texels past the edge only exist in the block
+					for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+						for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+							std::memcpy(&image.pixels[((static_cast<size_t>(by) * 4 + y) * width + bx * 4 + x) * 4], block + (y * 4 + x) * 4, 4);
+						}
+					}
+				}
+			}
+			return image;
+		}
+
+		bool Validate(std::string& report) {
+			std::ostringstream log;
+			bool ok = true;
+			auto check = [&](bool condition, const std::string& what) {
+				log << (condition ? "  ok    " : "  FAIL  ") << what << "\n";
+				ok = ok && condition;
+			};
+			auto decibels = [](double value) {
+				std::ostringstream text;
+				text.setf(std::ios::fixed);
+				text.precision(1);
+				text << value << " dB";
+				return text.str();
+			};
+
+			// Color formats cook an sRGB chain, BC5 a linear one like a normal map
+			const Image source = MakeValidationImage(VALIDATE_WIDTH, VALIDATE_HEIGHT);
+			const std::vector<Image> srgb_mips = GenerateMips(source, true, 3);
+			const std::vector<Image> linear_mips = GenerateMips(source, false, 3);
+			log << "  " << VALIDATE_WIDTH << "x" << VALIDATE_HEIGHT << " image, levels 0 and 2\n";
+
+			struct FormatCase {
+				TextureBlockFormat format;
+				int channel_mask;
+				const double* min_psnr;
+			};
+			const FormatCase cases[] = {
+				{ TextureBlockFormat::BC1, 0x7, BC1_MIN_PSNR },
+				{ TextureBlockFormat::BC3, 0xF, BC3_MIN_PSNR },
+				{ TextureBlockFormat::BC5, 0x3, BC5_MIN_PSNR },
+				{ TextureBlockFormat::BC7, 0xF, BC7_MIN_PSNR },
+			};
+			for (const FormatCase& test : cases) {
+				const std::vector<Image>& mips = test.format == TextureBlockFormat::BC5 ? linear_mips : srgb_mips;
+				Image opaque = mips[0];
+				if (test.format == TextureBlockFormat::BC1) {
+					for (size_t i = 3; i < opaque.pixels.size(); i += 4) opaque.pixels[i] = 255;
+				}
+
+				const auto start = std::chrono::steady_clock::now();
+				const std::vector<uint8_t> level0 = Compress(test.format == TextureBlockFormat::BC1 ? opaque : mips[0], test.format);
+				const auto end = std::chrono::steady_clock::now();
+				const double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+				Image level2 = mips[2];
+				if (test.format == TextureBlockFormat::BC1) {
+					for (size_t i = 3; i < level2.pixels.size(); i += 4) level2.pixels[i] = 255;
+				}
+				const double psnr0 = Psnr(test.format == TextureBlockFormat::BC1 ? opaque : mips[0],
+					Decompress(level0, mips[0].width, mips[0].height, test.format), test.channel_mask);
+				const double psnr2 = Psnr(level2, Decompress(Compress(level2, test.format), level2.width, level2.height, test.format), test.channel_mask);
+
+				log << "  " << GetBlockFormatName(test.format) << " " << decibels(psnr0) << " / " << decibels(psnr2)
+					<< ", level 0 in " << milliseconds << " ms\n";
+				check(psnr0 >= test.min_psnr[0] && psnr2 >= test.min_psnr[1], std::string(GetBlockFormatName(test.format)) +
+					" PSNR at least " + decibels(test.min_psnr[0]) + " / " + decibels(test.min_psnr[1]));
+			}
+
+			// BC1 alpha is a cutout at 128, and the cutout has to survive exactly
+			{
+				Image cutout = source;
+				for (uint32_t y = 0; y < cutout.height; ++y) {
+					for (uint32_t x = 0; x < cutout.width; ++x) {
+						cutout.pixels[(static_cast<size_t>(y) * cutout.width + x) * 4 + 3] = ((x / 3 + y / 5) % 3) ? 255 : 0;
+					}
+				}
+				const Image decoded = Decompress(Compress(cutout, TextureBlockFormat::BC1), cutout.width, cutout.height, TextureBlockFormat::BC1);
+				size_t mismatches = 0;
+				for (size_t i = 3; i < cutout.pixels.size(); i += 4) {
+					mismatches += (cutout.pixels[i] >= 128) != (decoded.pixels[i] == 255);
+				}
+				check(mismatches == 0, "BC1 punch-through alpha, " + std::to_string(mismatches) + " texels flipped");
+			}
+
+			// An opaque image keeps exactly 255 alpha in BC3
+			{
+				Image opaque = source;
+				for (size_t i = 3; i < opaque.pixels.size(); i += 4) opaque.pixels[i] = 255;
+				const Image decoded = Decompress(Compress(opaque, TextureBlockFormat::BC3), opaque.width, opaque.height, TextureBlockFormat::BC3);
+				bool exact = true;
+				for (size_t i = 3; i < decoded.pixels.size(); i += 4) exact = exact && decoded.pixels[i] == 255;
+				check(exact, "BC3 alpha of an opaque image stays 255");
+			}
+
+			// A mask with hard 0 and 255 texels picks the 6 value mode, which stores both exactly
+			{
+				uint8_t values[16];
+				for (int i = 0; i < 16; ++i) values[i] = i < 4 ? 0 : (i < 8 ? 255 : static_cast<uint8_t>(100 + i * 3));
+				uint8_t block[8], decoded[16];
+				CompressBlockBC4(values, block);
+				DecompressBlockBC4(block, decoded);
+				bool exact = true;
+				for (int i = 0; i < 8; ++i) exact = exact && decoded[i] == values[i];
+				check(exact, "BC4 keeps 0 and 255 exact next to mid range values");
+			}
+
+			// A black and white checker averages to half the light, which is 188 in sRGB
+			{
+				Image checker;
+				checker.width = checker.height = 2;
+				checker.pixels = { 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255 };
+				const std::vector<Image> srgb = GenerateMips(checker, true);
+				const std::vector<Image> linear = GenerateMips(checker, false);
+				check(srgb.size() == 2 && srgb[1].pixels[0] == 188 && linear.size() == 2 && linear[1].pixels[0] == 128,
+					"2x2 checker mips to 188 in sRGB and 128 in linear");
+			}
+
+			// Every block writes its own bytes, so splitting the work must not change them
+			{
+				const Image& level = srgb_mips[0];
+				const std::vector<uint8_t> parallel = Compress(level, TextureBlockFormat::BC7);
+				std::vector<uint8_t> serial(parallel.size());
+				uint8_t block[64];
+				const uint32_t blocks_x = (level.width + 3) / 4;
+				for (uint32_t by = 0; by < (level.height + 3) / 4; ++by) {
+					for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+						FetchBlock(level, bx, by, block);
+						CompressBlockBC7(block, serial.data() + (static_cast<size_t>(by) * blocks_x + bx) * 16);
+					}
+				}
+				check(parallel == serial, "BC7 level is the same on the JobManager as block by block");
+			}
+
+			report = log.str();
+			return ok;
+		}
+
+		bool HasAlpha(const Image& image) {
+			for (size_t i = 3; i < image.pixels.size(); i += 4) {
+				if (image.pixels[i] != 255) return true;
+			}
+			return false;
+		}
+
+		bool ParseBlockFormat(const std::string& name, TextureBlockFormat& out) {
+			std::string upper = name;
+			std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+
+			if (upper == "BC1" || upper == "DXT1") out = TextureBlockFormat::BC1;
+			else if (upper == "BC3" || upper == "DXT5") out = TextureBlockFormat::BC3;
+			else if (upper == "BC5") out = TextureBlockFormat::BC5;
+			else if (upper == "BC7") out = TextureBlockFormat::BC7;
+			else if (upper == "NONE" || upper == "RGBA8") out = TextureBlockFormat::RGBA8;
+			else {
+				out = TextureBlockFormat::RGBA8;
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBlockFormatName(TextureBlockFormat format) {
+			switch (format) {
+			case TextureBlockFormat::BC1: return "BC1";
+			case TextureBlockFormat::BC3: return "BC3";
+			case TextureBlockFormat::BC5: return "BC5";
+			case TextureBlockFormat::BC7: return "BC7";
+			case TextureBlockFormat::RGBA8:
+			default: return "RGBA8";
+			}
+		}
+
+	} // namespace TextureCompressor
+
+} // end of namespace gam300
@@ -0,0 +1,123 @@
+/**
+ * @file TextureCompressor.h
+ * @brief Offline texture passes used when cooking textures.
+ * @details Mip chain generation and BC1/BC3/BC5/BC7 block compression of RGBA8 images.
+ *          Every pass runs on the CPU and is deterministic, so the same source always
+ *          cooks to the same blob whatever the machine or number of threads.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __TEXTURE_COMPRESSOR_H__
+#define __TEXTURE_COMPRESSOR_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Resource/TextureBlob.h"
+
+namespace gam300 {
+
+	namespace TextureCompressor {
+
+		/**
+		* @brief Tightly packed RGBA8 pixels, rows top to bottom as stored in the blob.
+		*/
+		struct Image {
+			uint32_t width = 0;
+			uint32_t height = 0;
+			std::vector<uint8_t> pixels;
+		};
+
+		/**
+		* @brief Halve an image down to 1x1, the base level included.
+		* @details Pixels are filtered in linear light when srgb is set, and color is
+		*          weighted by alpha so transparent texels do not bleed into their
+		*          neighbours. Each level is filtered from the unrounded previous level.
+		* @param max_levels Stop after this many levels, 0 for the full chain.
+		*/
+		std::vector<Image> GenerateMips(const Image& base, bool srgb, uint32_t max_levels = 0);
+
+		/**
+		* @brief Compress a whole level, blocks are spread over the JobManager.
+		* @details Partial blocks at the right and bottom edges repeat the last texel. Within a
+		*          block the endpoint search and the palette error loops run on SSE, four texels
+		*          at a time, and give the same bytes as the plain per-texel loops.
+		* @return Level data, getTextureLevelSize bytes.
+		*/
+		std::vector<uint8_t> Compress(const Image& image, TextureBlockFormat format);
+
+		/**
+		* @brief Compress a 4x4 block of RGBA8 texels (row major) into 8 bytes.
+		* @details Texels with alpha below 128 make the block use the 3 color mode with
+		*          transparent black. With opaque_only the block is always 4 color, as
+		*          the color half of BC3 requires.
+		*/
+		void CompressBlockBC1(const uint8_t* rgba, uint8_t* out, bool opaque_only = false);
+
+		/**
+		* @brief Compress 16 single channel values into an 8 byte BC4 block (alpha of BC3, channels of BC5).
+		*/
+		void CompressBlockBC4(const uint8_t* values, uint8_t* out);
+
+		/**
+		* @brief Compress a 4x4 block of RGBA8 texels into a 16 byte BC7 block.
+		* @details Mode 6 only: one RGBA line with 7-bit endpoints and a p-bit, 16 levels.
+		*/
+		void CompressBlockBC7(const uint8_t* rgba, uint8_t* out);
+
+		/**
+		* @brief Decode an 8 byte BC1 block into 4x4 RGBA8 texels.
+		* @details With opaque_only the block is always read as 4 color, as in the color half of BC3.
+		*/
+		void DecompressBlockBC1(const uint8_t* in, uint8_t* rgba, bool opaque_only = false);
+
+		/**
+		* @brief Decode an 8 byte BC4 block into 16 single channel values.
+		*/
+		void DecompressBlockBC4(const uint8_t* in, uint8_t* values);
+
+		/**
+		* @brief Decode a 16 byte BC7 block into 4x4 RGBA8 texels.
+		* @details Mode 6 only, the one CompressBlockBC7 writes.
+		* @return false, and the block left black, for any other mode.
+		*/
+		bool DecompressBlockBC7(const uint8_t* in, uint8_t* rgba);
+
+		/**
+		* @brief Decode a whole level back to RGBA8, the inverse of Compress.
+		* @details Channels a format does not store read as 0 for color and 255 for alpha.
+		*/
+		Image Decompress(const std::vector<uint8_t>& data, uint32_t width, uint32_t height, TextureBlockFormat format);
+
+		/**
+		* @brief Cook a generated image in every format and check what decodes back, needs no window or GL context.
+		* @details Checks the PSNR of levels 0 and 2 of each format against a floor, BC1 punch-through
+		* alpha, opaque BC3 alpha, exact BC4 endpoints, sRGB aware mip filtering and that the output
+		* does not depend on the JobManager. main runs it with --validate-texture-cook.
+		* @param report Receives one line per check, with the PSNR and timing of each format.
+		* @return True if every check passed.
+		*/
+		bool Validate(std::string& report);
+
+		/**
+		* @brief True if any texel is not fully opaque.
+		*/
+		bool HasAlpha(const Image& image);
+
+		/**
+		* @brief Format of a TextureSettings compression name (BC1/DXT1, BC3/DXT5, BC5, BC7, NONE/RGBA8).
+		* @return false and RGBA8 if the name is unknown.
+		*/
+		bool ParseBlockFormat(const std::string& name, TextureBlockFormat& out);
+
+		const char* GetBlockFormatName(TextureBlockFormat format);
+
+	} // namespace TextureCompressor
+
+} // end of namespace gam300
+#endif // __TEXTURE_COMPRESSOR_H__
@@ -0,0 +1,151 @@
+/**
+ * @file MeshBlob.cpp
+ * @brief Implementation of the cooked mesh blob reader and writer.
+ * @details Contains implementations for all functions declared in MeshBlob.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+//include header files here
+#include "MeshBlob.h"
+
+//include libraries
+#include <cstring>
+#include <fstream>
+
+
+namespace gam300 {
+
+    namespace {
+
+        uint32_t alignUp(uint32_t value) {
+            return (value + MESH_BLOB_ALIGNMENT - 1) / MESH_BLOB_ALIGNMENT * MESH_BLOB_ALIGNMENT;
+        }
+
+        // True if [offset, offset + size) lies inside the blob
+        bool inside(uint64_t offset, uint64_t size, uint64_t total) {
+            return offset <= total && size <= total - offset;
+        }
+    }
+
+    std::vector<uint8_t> serializeMeshBlob(MeshBlobData& data) {
+        MeshBlobHeader& header = data.header;
+        header.magic = MESH_BLOB_MAGIC;
+        header.version = MESH_BLOB_VERSION;
+        header.lodCount = static_cast<uint32_t>(data.lods.size());
+
+        // Header, LOD table, vertices then indices, each on an aligned boundary
+        header.lodOffset = alignUp(sizeof(MeshBlobHeader));
+        header.vertexOffset = alignUp(header.lodOffset + static_cast<uint32_t>(data.lods.size() * sizeof(MeshBlobLod)));
+        header.indexOffset = alignUp(header.vertexOffset + static_cast<uint32_t>(data.vertices.size()));
+        header.totalSize = header.indexOffset + static_cast<uint32_t>(data.indices.size());
+
+        std::vector<uint8_t> bytes(header.totalSize, 0);
+        std::memcpy(bytes.data(), &header, sizeof(MeshBlobHeader));
+        if (!data.lods.empty()) {
+            std::memcpy(bytes.data() + header.lodOffset, data.lods.data(), data.lods.size() * sizeof(MeshBlobLod));
+        }
+        if (!data.vertices.empty()) {
+            std::memcpy(bytes.data() + header.vertexOffset, data.vertices.data(), data.vertices.size());
+        }
+        if (!data.indices.empty()) {
+            std::memcpy(bytes.data() + header.indexOffset, data.indices.data(), data.indices.size());
+        }
+        return bytes;
+    }
+
+    bool writeMeshBlob(const std::string& path, MeshBlobData& data) {
+        // Assembled in memory so the file is written with one call as well
+        const std::vector<uint8_t> bytes = serializeMeshBlob(data);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool MeshBlob::load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+
+        const std::streamsize size = file.tellg();
+        if (size < static_cast<std::streamsize>(sizeof(MeshBlobHeader))) {
+            return false;
+        }
+        file.seekg(0, std::ios::beg);
+
+        std::vector<uint8_t> bytes(static_cast<size_t>(size));
+        if (!file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+            return false;
+        }
+        return assign(std::move(bytes));
+    }
+
+    bool MeshBlob::assign(std::vector<uint8_t>&& bytes) {
+        m_data.clear();
+        if (bytes.size() < sizeof(MeshBlobHeader)) {
+            return false;
+        }
+
+        MeshBlobHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(MeshBlobHeader));
+        if (header.magic != MESH_BLOB_MAGIC || header.version != MESH_BLOB_VERSION || header.totalSize != bytes.size()) {
+            return false;
+        }
+        if (header.indexSize != 2 && header.indexSize != 4) {
+            return false;
+        }
+
+        // Every section must fit and every LOD must stay inside the index section
+        const uint64_t total = bytes.size();
+        const uint64_t vertex_bytes = static_cast<uint64_t>(header.vertexCount) * header.vertexStride;
+        const uint64_t index_bytes = static_cast<uint64_t>(header.indexCount) * header.indexSize;
+        if (!inside(header.lodOffset, static_cast<uint64_t>(header.lodCount) * sizeof(MeshBlobLod), total) ||
+            !inside(header.vertexOffset, vertex_bytes, total) ||
+            !inside(header.indexOffset, index_bytes, total)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < header.lodCount; ++i) {
+            MeshBlobLod lod;
+            std::memcpy(&lod, bytes.data() + header.lodOffset + i * sizeof(MeshBlobLod), sizeof(MeshBlobLod));
+            if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > header.indexCount) {
+                return false;
+            }
+        }
+
+        m_data = std::move(bytes);
+        return true;
+    }
+
+    const MeshBlobHeader& MeshBlob::getHeader() const {
+        return *reinterpret_cast<const MeshBlobHeader*>(m_data.data());
+    }
+
+    const MeshBlobLod* MeshBlob::getLods() const {
+        return reinterpret_cast<const MeshBlobLod*>(m_data.data() + getHeader().lodOffset);
+    }
+
+    const uint8_t* MeshBlob::getVertices() const {
+        return m_data.data() + getHeader().vertexOffset;
+    }
+
+    const uint8_t* MeshBlob::getIndices() const {
+        return m_data.data() + getHeader().indexOffset;
+    }
+
+    size_t MeshBlob::getVertexBytes() const {
+        return static_cast<size_t>(getHeader().vertexCount) * getHeader().vertexStride;
+    }
+
+    size_t MeshBlob::getIndexBytes() const {
+        return static_cast<size_t>(getHeader().indexCount) * getHeader().indexSize;
+    }
+
+} // namespace gam300
@@ -0,0 +1,125 @@
+/**
+ * @file MeshBlob.h
+ * @brief Binary format of cooked meshes.
+ * @details The MeshImporter writes one blob per source mesh: a fixed header, the LOD
+ *          table, then GPU ready vertices and indices. The runtime reads the whole
+ *          file with a single read and uploads the sections in place.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#pragma once
+
+#ifndef _MESH_BLOB_H
+#define _MESH_BLOB_H
+
+//c++ libraries
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gam300 {
+
+	constexpr uint32_t MESH_BLOB_MAGIC = 0x424D4B53;	// "SKMB"
+	constexpr uint32_t MESH_BLOB_VERSION = 1;
+	constexpr uint32_t MESH_BLOB_ALIGNMENT = 16;		// Sections start on this boundary
+
+	/**
+	 * @brief Fixed size header at the start of a blob.
+	 * @details Offsets are in bytes from the start of the file.
+	 */
+	struct MeshBlobHeader {
+		uint32_t magic = MESH_BLOB_MAGIC;
+		uint32_t version = MESH_BLOB_VERSION;
+		uint32_t totalSize = 0;
+
+		uint32_t vertexFormat = 0;      // VertexFormat of the vertices
+		uint32_t vertexStride = 0;
+		uint32_t vertexCount = 0;
+		uint32_t indexSize = 4;         // 2 or 4 bytes
+		uint32_t indexCount = 0;        // Every LOD together
+		uint32_t lodCount = 0;
+
+		uint32_t lodOffset = 0;
+		uint32_t vertexOffset = 0;
+		uint32_t indexOffset = 0;
+
+		float positionOffset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };	// Position dequantization
+		float positionScale[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		float boundsCenter[3] = { 0.0f, 0.0f, 0.0f };
+		float boundsExtents[3] = { 0.0f, 0.0f, 0.0f };
+		float boundsRadius = 0.0f;
+		uint32_t reserved = 0;
+	};
+
+	/**
+	 * @brief Index range of one level of detail, LOD 0 is the full mesh.
+	 */
+	struct MeshBlobLod {
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		float error = 0.0f;             // Simplification error relative to the mesh extent
+		uint32_t reserved = 0;
+	};
+
+	static_assert(sizeof(MeshBlobHeader) % MESH_BLOB_ALIGNMENT == 0, "MeshBlobHeader must keep the sections aligned");
+	static_assert(sizeof(MeshBlobLod) == 16, "MeshBlobLod must be tightly packed");
+
+	/**
+	 * @brief Everything that goes into a blob, offsets and sizes are filled in when written.
+	 */
+	struct MeshBlobData {
+		MeshBlobHeader header;
+		std::vector<MeshBlobLod> lods;
+		std::vector<uint8_t> vertices;
+		std::vector<uint8_t> indices;
+	};
+
+	/**
+	 * @brief Lay a blob out in memory, fills in the offsets and sizes of the header.
+	 */
+	std::vector<uint8_t> serializeMeshBlob(MeshBlobData& data);
+
+	/**
+	 * @brief Write a blob.
+	 * @return True if the whole file was written.
+	 */
+	bool writeMeshBlob(const std::string& path, MeshBlobData& data);
+
+	/**
+	 * @brief A cooked mesh read back with a single read.
+	 * @details The sections are views into one buffer, nothing is copied after the read.
+	 */
+	class MeshBlob {
+	public:
+
+		/**
+		 * @brief Read and validate a blob.
+		 * @return False if the file is missing, truncated or not a blob of this version.
+		 */
+		bool load(const std::string& path);
+
+		/**
+		 * @brief Validate a blob already in memory and take ownership of it.
+		 */
+		bool assign(std::vector<uint8_t>&& bytes);
+
+		bool isLoaded() const { return !m_data.empty(); }
+		const MeshBlobHeader& getHeader() const;
+		const MeshBlobLod* getLods() const;
+		const uint8_t* getVertices() const;
+		const uint8_t* getIndices() const;
+		size_t getVertexBytes() const;
+		size_t getIndexBytes() const;
+
+	private:
+		std::vector<uint8_t> m_data;
+	};
+
+} // namespace gam300
+
+#endif // _MESH_BLOB_H
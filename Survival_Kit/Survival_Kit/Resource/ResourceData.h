@@ -3,7 +3,9 @@
 #define __RESOURCE_DATA_H__
 
 #include "ResourceTypes.h"
+#include "MeshBlob.h"
 #include "../include/xresource_mgr/xresource_mgr.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -11,6 +13,7 @@ namespace gam300 {
 
     // Forward declaration
     class ResourceManager;
+    struct TextureUpload;
 
     // ========== RUNTIME RESOURCE DATA STRUCTURES ==========
 
@@ -21,20 +24,21 @@ namespace gam300 {
         int width = 0;
         int height = 0;
         int channels = 0;
-        unsigned int textureID = 0;  // OpenGL texture ID
         std::string format;
+        std::shared_ptr<TextureUpload> upload;  // Decoded and uploaded in the background, owns the texture
+        unsigned int streamID = 0;              // Cooked textures are streamed by mip level instead, see TextureStreamer
 
-        ~TextureResource() {
-            // TODO: Release OpenGL texture if needed
-        }
+        /**
+         * @brief OpenGL texture ID, 0 until the upload completes or if it failed.
+         */
+        unsigned int getTextureID() const;
     };
 
     /**
      * @brief Runtime mesh resource data.
      */
     struct MeshResource {
-        std::vector<float> vertices;
-        std::vector<unsigned int> indices;
+        MeshBlob blob;         // Cooked vertices, indices and LODs, see MeshBlob.h
         unsigned int VAO = 0;  // Vertex Array Object
         unsigned int VBO = 0;  // Vertex Buffer Object
         unsigned int EBO = 0;  // Element Buffer Object
@@ -12,6 +12,10 @@
 #include "ResourceData.h"
 #include "../Manager/ResourceManager.h"
 #include "../Manager/LogManager.h"
+#include "../Manager/GraphicsManager.h"
+#include "../Graphics/TextureUploader.h"
+#include "../Graphics/stb_image.h"
+#include "../Pipeline/TextureCompressor.h"
 #include <fstream>
 #include <memory>
 
@@ -30,6 +34,13 @@ namespace gam300 {
         return &mgr.getUserData<ResourceManager>();
     }
 
+    unsigned int TextureResource::getTextureID() const {
+        if (streamID != 0) {
+            return GFXM.getTextureStreamer().get_handle(streamID);
+        }
+        return upload ? upload->gl_handle() : 0;
+    }
+
 } // namespace gam300
 
 // ========== TEXTURE LOADER IMPLEMENTATION ==========
@@ -60,18 +71,41 @@ xresource::loader<gam300::ResourceGUID::texture_type_guid_v>::Load(xresource::mg
         return nullptr;
     }
 
-    // Create texture resource
+    // Only the header is read here, the levels are read or decoded on a worker
     auto texture = std::make_unique<data_type>();
+    gam300::TextureBlobHeader header;
+    std::vector<gam300::TextureBlobLevel> levels;
+    const bool cooked = gam300::readTextureBlobInfo(intermediate_path, header, levels);
+    if (cooked) {
+        texture->width = static_cast<int>(header.width);
+        texture->height = static_cast<int>(header.height);
+        texture->format = gam300::TextureCompressor::GetBlockFormatName(static_cast<gam300::TextureBlockFormat>(header.format));
+    }
+    else {
+        // Not cooked, decoded at load time
+        int width = 0, height = 0, channels = 0;
+        if (!stbi_info(intermediate_path.c_str(), &width, &height, &channels)) {
+            LM.writeLog("TextureLoader::Load() - Unsupported image %s: %s", intermediate_path.c_str(), stbi_failure_reason());
+            return nullptr;
+        }
+        texture->width = width;
+        texture->height = height;
+        texture->format = "RGBA8";
+    }
+    texture->channels = 4;
 
-    // TODO: Implement actual texture loading using stb_image or similar
-    // For now, create a placeholder texture
-    texture->width = tex_props->maxWidth;
-    texture->height = tex_props->maxHeight;
-    texture->channels = 4; // RGBA
-    texture->textureID = 0; // TODO: Generate OpenGL texture
-    texture->format = tex_props->compressionFormat;
+    // Cooked textures start with their mip tail and get larger levels as the screen needs them
+    if (cooked) {
+        texture->streamID = GFXM.getTextureStreamer().add(intermediate_path);
+    }
+    else {
+        gam300::TextureDesc desc;
+        desc.srgb = tex_props->srgb;
+        desc.generate_mips = tex_props->generateMipmaps;
+        texture->upload = GFXM.getTextureUploader().request(intermediate_path, desc);
+    }
 
-    LM.writeLog("TextureLoader::Load() - Loaded texture: %s (%dx%d)",
+    LM.writeLog("TextureLoader::Load() - Loading texture: %s (%dx%d)",
         tex_props->resourceName.c_str(), texture->width, texture->height);
 
     return texture.release();
@@ -79,6 +113,8 @@ xresource::loader<gam300::ResourceGUID::texture_type_guid_v>::Load(xresource::mg
 
 void xresource::loader<gam300::ResourceGUID::texture_type_guid_v>::Destroy(xresource::mgr& /*mgr*/, data_type&& data, const full_guid& guid) {
    LM.writeLog("TextureLoader::Destroy() - Destroying texture GUID: %llX", guid.m_Instance.m_Value);
+    // Deletes the GL texture, or tells the uploader to drop it if it is still on its way
+    GFXM.getTextureStreamer().remove(data.streamID);
     delete& data;
 }
 
@@ -112,20 +148,18 @@ xresource::loader<gam300::ResourceGUID::mesh_type_guid_v>::Load(xresource::mgr&
     // Create mesh resource
     auto mesh = std::make_unique<data_type>();
 
-    // TODO: Implement actual mesh loading using Assimp or similar
-    // For now, create a placeholder triangle
-    mesh->vertices = {
-        -0.5f, -0.5f, 0.0f,
-         0.5f, -0.5f, 0.0f,
-         0.0f,  0.5f, 0.0f
-    };
-    mesh->indices = { 0, 1, 2 };
+    // Cooked by the MeshImporter, the whole blob comes in with one read
+    if (!mesh->blob.load(intermediate_path)) {
+        LM.writeLog("MeshLoader::Load() - Not a valid cooked mesh: %s", intermediate_path.c_str());
+        return nullptr;
+    }
     mesh->VAO = 0; // TODO: Generate OpenGL VAO
     mesh->VBO = 0; // TODO: Generate OpenGL VBO
     mesh->EBO = 0; // TODO: Generate OpenGL EBO
 
-    LM.writeLog("MeshLoader::Load() - Loaded mesh: %s (%zu vertices)",
-        mesh_props->resourceName.c_str(), mesh->vertices.size() / 3);
+    const gam300::MeshBlobHeader& header = mesh->blob.getHeader();
+    LM.writeLog("MeshLoader::Load() - Loaded mesh: %s (%u vertices, %u indices, %u LODs)",
+        mesh_props->resourceName.c_str(), header.vertexCount, header.indexCount, header.lodCount);
 
     return mesh.release();
 }
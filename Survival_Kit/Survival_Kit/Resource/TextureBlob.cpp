@@ -0,0 +1,137 @@
+/**
+ * @file TextureBlob.cpp
+ * @brief Implementation of the cooked texture blob reader and writer.
+ * @details Contains implementations for all functions declared in TextureBlob.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+//include header files here
+#include "TextureBlob.h"
+
+//include libraries
+#include <cstring>
+#include <fstream>
+
+
+namespace gam300 {
+
+    namespace {
+
+        uint32_t alignUp(uint32_t value) {
+            return (value + TEXTURE_BLOB_ALIGNMENT - 1) / TEXTURE_BLOB_ALIGNMENT * TEXTURE_BLOB_ALIGNMENT;
+        }
+
+        // True if [offset, offset + size) lies inside the blob
+        bool inside(uint64_t offset, uint64_t size, uint64_t total) {
+            return offset <= total && size <= total - offset;
+        }
+    }
+
+    uint32_t getTextureLevelSize(TextureBlockFormat format, uint32_t width, uint32_t height) {
+        const uint32_t blocks = ((width + 3) / 4) * ((height + 3) / 4);
+        switch (format) {
+        case TextureBlockFormat::BC1:
+            return blocks * 8;
+        case TextureBlockFormat::BC3:
+        case TextureBlockFormat::BC5:
+        case TextureBlockFormat::BC7:
+            return blocks * 16;
+        case TextureBlockFormat::RGBA8:
+        default:
+            return width * height * 4;
+        }
+    }
+
+    std::vector<uint8_t> serializeTextureBlob(TextureBlobData& data) {
+        TextureBlobHeader& header = data.header;
+        header.magic = TEXTURE_BLOB_MAGIC;
+        header.version = TEXTURE_BLOB_VERSION;
+        header.levelCount = static_cast<uint32_t>(data.levels.size());
+        header.levelOffset = alignUp(sizeof(TextureBlobHeader));
+        header.dataOffset = alignUp(header.levelOffset + header.levelCount * static_cast<uint32_t>(sizeof(TextureBlobLevel)));
+
+        // Index largest first, data smallest first, like KTX2
+        std::vector<TextureBlobLevel> index(data.levels.size());
+        uint32_t offset = header.dataOffset;
+        for (size_t i = data.levels.size(); i-- > 0;) {
+            index[i].offset = offset;
+            index[i].size = static_cast<uint32_t>(data.levels[i].size());
+            index[i].width = header.width >> i ? header.width >> i : 1;
+            index[i].height = header.height >> i ? header.height >> i : 1;
+            offset = alignUp(offset + index[i].size);
+        }
+        header.totalSize = offset;
+
+        std::vector<uint8_t> bytes(header.totalSize, 0);
+        std::memcpy(bytes.data(), &header, sizeof(TextureBlobHeader));
+        if (!index.empty()) {
+            std::memcpy(bytes.data() + header.levelOffset, index.data(), index.size() * sizeof(TextureBlobLevel));
+        }
+        for (size_t i = 0; i < data.levels.size(); ++i) {
+            if (!data.levels[i].empty()) {
+                std::memcpy(bytes.data() + index[i].offset, data.levels[i].data(), data.levels[i].size());
+            }
+        }
+        return bytes;
+    }
+
+    bool writeTextureBlob(const std::string& path, TextureBlobData& data) {
+        // Assembled in memory so the file is written with one call as well
+        const std::vector<uint8_t> bytes = serializeTextureBlob(data);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool readTextureBlobInfo(const std::string& path, TextureBlobHeader& header, std::vector<TextureBlobLevel>& levels) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+
+        const std::streamsize size = file.tellg();
+        if (size < static_cast<std::streamsize>(sizeof(TextureBlobHeader))) {
+            return false;
+        }
+        file.seekg(0, std::ios::beg);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(TextureBlobHeader))) {
+            return false;
+        }
+        if (header.magic != TEXTURE_BLOB_MAGIC || header.version != TEXTURE_BLOB_VERSION ||
+            header.totalSize != static_cast<uint64_t>(size) || header.format > static_cast<uint32_t>(TextureBlockFormat::BC7) ||
+            header.levelCount == 0 || header.width == 0 || header.height == 0) {
+            return false;
+        }
+
+        const uint64_t total = header.totalSize;
+        if (!inside(header.levelOffset, static_cast<uint64_t>(header.levelCount) * sizeof(TextureBlobLevel), total) ||
+            header.dataOffset > total) {
+            return false;
+        }
+
+        levels.resize(header.levelCount);
+        file.seekg(header.levelOffset, std::ios::beg);
+        if (!file.read(reinterpret_cast<char*>(levels.data()), static_cast<std::streamsize>(levels.size() * sizeof(TextureBlobLevel)))) {
+            return false;
+        }
+
+        // Every level must sit in the data section and be exactly as large as its format says
+        const TextureBlockFormat format = static_cast<TextureBlockFormat>(header.format);
+        for (const TextureBlobLevel& level : levels) {
+            if (level.offset < header.dataOffset || !inside(level.offset, level.size, total) ||
+                level.size != getTextureLevelSize(format, level.width, level.height)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace gam300
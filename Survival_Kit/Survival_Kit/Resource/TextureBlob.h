@@ -0,0 +1,112 @@
+/**
+ * @file TextureBlob.h
+ * @brief Binary format of cooked textures.
+ * @details The TextureImporter writes one blob per source image, laid out like a KTX2
+ *          file: a fixed header, the level index (largest level first), then the
+ *          block compressed levels stored smallest first so a partial read already
+ *          holds a usable mip tail. The runtime reads the level data into a pixel
+ *          unpack buffer and uploads every level as is.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#pragma once
+
+#ifndef _TEXTURE_BLOB_H
+#define _TEXTURE_BLOB_H
+
+//c++ libraries
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gam300 {
+
+	constexpr uint32_t TEXTURE_BLOB_MAGIC = 0x58544B53;	// "SKTX"
+	constexpr uint32_t TEXTURE_BLOB_VERSION = 1;
+	constexpr uint32_t TEXTURE_BLOB_ALIGNMENT = 16;		// Levels start on this boundary
+	constexpr uint32_t TEXTURE_BLOB_SRGB = 1u << 0;		// Header flag, color channels are sRGB encoded
+
+	/**
+	 * @brief Pixel layout of every level of a blob.
+	 */
+	enum class TextureBlockFormat : uint32_t {
+		RGBA8 = 0,      // Uncompressed, 4 bytes per pixel
+		BC1 = 1,        // RGB + 1-bit alpha, 8 bytes per 4x4 block
+		BC3 = 2,        // RGBA, 16 bytes per 4x4 block
+		BC5 = 3,        // Two channels (normal maps), 16 bytes per 4x4 block
+		BC7 = 4         // RGBA, high quality, 16 bytes per 4x4 block
+	};
+
+	/**
+	 * @brief Bytes of one level of a format.
+	 */
+	uint32_t getTextureLevelSize(TextureBlockFormat format, uint32_t width, uint32_t height);
+
+	/**
+	 * @brief Fixed size header at the start of a blob.
+	 * @details Offsets are in bytes from the start of the file.
+	 */
+	struct TextureBlobHeader {
+		uint32_t magic = TEXTURE_BLOB_MAGIC;
+		uint32_t version = TEXTURE_BLOB_VERSION;
+		uint32_t totalSize = 0;
+
+		uint32_t format = 0;            // TextureBlockFormat of every level
+		uint32_t flags = 0;             // TEXTURE_BLOB_ flags
+		uint32_t width = 0;             // Size of level 0
+		uint32_t height = 0;
+		uint32_t levelCount = 0;
+
+		uint32_t levelOffset = 0;       // Level index
+		uint32_t dataOffset = 0;        // First byte of level data, everything up to totalSize is levels
+		uint32_t reserved[2] = { 0, 0 };
+	};
+
+	/**
+	 * @brief Where one level lives, level 0 is the largest.
+	 */
+	struct TextureBlobLevel {
+		uint32_t offset = 0;
+		uint32_t size = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	static_assert(sizeof(TextureBlobHeader) % TEXTURE_BLOB_ALIGNMENT == 0, "TextureBlobHeader must keep the levels aligned");
+	static_assert(sizeof(TextureBlobLevel) == 16, "TextureBlobLevel must be tightly packed");
+
+	/**
+	 * @brief Everything that goes into a blob, offsets and sizes are filled in when written.
+	 * @details levels[i] holds the data of level i, largest first.
+	 */
+	struct TextureBlobData {
+		TextureBlobHeader header;
+		std::vector<std::vector<uint8_t>> levels;
+	};
+
+	/**
+	 * @brief Lay a blob out in memory, fills in the offsets and sizes of the header.
+	 */
+	std::vector<uint8_t> serializeTextureBlob(TextureBlobData& data);
+
+	/**
+	 * @brief Write a blob.
+	 * @return True if the whole file was written.
+	 */
+	bool writeTextureBlob(const std::string& path, TextureBlobData& data);
+
+	/**
+	 * @brief Read and validate the header and level index of a blob, not the levels.
+	 * @details Lets the caller read the level data wherever it wants it, in one read
+	 *          of [dataOffset, totalSize).
+	 * @return False if the file is missing, truncated or not a blob of this version.
+	 */
+	bool readTextureBlobInfo(const std::string& path, TextureBlobHeader& header, std::vector<TextureBlobLevel>& levels);
+
+} // namespace gam300
+
+#endif // _TEXTURE_BLOB_H
@@ -2,17 +2,82 @@
 #include "../Manager/ComponentManager.h"
 #include "../Manager/LogManager.h"
 #include "../Manager/ECSManager.h"
+#include "../Manager/JobManager.h"
+#include "../Component/Collider.h"
 #include <glm-0.9.9.8/glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
 
 namespace gam300 {
 
-	PhysicsSystem::PhysicsSystem() : ComponentSystem<RigidBody>("PhysicsSystem"), PhysicsEcsRef(EM) {
-		//set_priority(101);
+	namespace {
+		constexpr std::size_t BODY_GRAIN = 128;		// Bodies per job for integration
+		constexpr std::size_t PAIR_GRAIN = 64;		// Pairs per job for the narrowphase
+		constexpr std::size_t ISLAND_GRAIN = 4;		// Islands per job for the solver
+		constexpr int SOLVER_ITERATIONS = 8;
+		constexpr float SWEEP_CORE_SCALE = 0.5f;	// Swept core sphere size relative to the collider
+		constexpr int REBUILD_INTERVAL = 60;		// Steps between full broadphase rebuilds, refit in between
+		constexpr std::size_t RAY_GRAIN = 256;		// Rays per job for batched raycasts
+		constexpr std::size_t RAY_SORT_MIN = 1024;	// Batches at least this big are sorted by midpoint first
+		constexpr std::size_t RAY_PREFETCH_DISTANCE = 8;	// Casts ahead that a batched ray is loaded
+
+		// Scene and target of benchmarkRaycast
+		constexpr uint32_t BENCH_BODIES = 50000;
+		constexpr uint32_t BENCH_RAYS = 1000000;
+		constexpr uint32_t BENCH_CHECKED_RAYS = 500;
+		constexpr float BENCH_WORLD_SIZE = 200.0f;
+		constexpr float BENCH_RAY_LENGTH = 50.0f;
+		constexpr double BENCH_TARGET_MRAYS = 1.0;
+
+		// Spread the low 10 bits of v so two zero bits sit between each of them
+		uint32_t spreadBits(uint32_t v) {
+			v &= 0x3FF;
+			v = (v | (v << 16)) & 0x030000FF;
+			v = (v | (v << 8)) & 0x0300F00F;
+			v = (v | (v << 4)) & 0x030C30C3;
+			v = (v | (v << 2)) & 0x09249249;
+			return v;
+		}
+
+		// 30-bit Morton code of a point inside the given bounds
+		uint32_t mortonCode(const Vector3D& point, const AABB& bounds) {
+			Vector3D size = bounds.max - bounds.min;
+			auto cell = [](float value, float min, float size) {
+				float n = size > 0.0f ? (value - min) / size : 0.0f;
+				return static_cast<uint32_t>(std::clamp(n, 0.0f, 1.0f) * 1023.0f);
+			};
+			return spreadBits(cell(point.x, bounds.min.x, size.x))
+				| (spreadBits(cell(point.y, bounds.min.y, size.y)) << 1)
+				| (spreadBits(cell(point.z, bounds.min.z, size.z)) << 2);
+		}
+
+		// Sort keys by the Morton code in their upper 32 bits, in three stable 10-bit passes
+		void sortByMorton(std::vector<uint64_t>& keys) {
+			std::vector<uint64_t> scratch(keys.size());
+			for (int shift = 32; shift < 62; shift += 10) {
+				std::size_t offsets[1025] = {};
+				for (uint64_t key : keys) {
+					++offsets[((key >> shift) & 0x3FF) + 1];
+				}
+				for (int digit = 1; digit <= 1024; ++digit) {
+					offsets[digit] += offsets[digit - 1];
+				}
+				for (uint64_t key : keys) {
+					scratch[offsets[(key >> shift) & 0x3FF]++] = key;
+				}
+				keys.swap(scratch);
+			}
+		}
 	}
 
-	bool PhysicsSystem::init(SystemManager&) {
+	PhysicsSystem::PhysicsSystem() : ComponentSystem<Transform3D, RigidBody>("PhysicsSystem"), PhysicsEcsRef(EM), m_steps_since_build(0) {
+		// Run after MovementSystem so forces applied there are integrated this frame
+		set_priority(90);
+	}
 
-		//Find a way to register the system
+	bool PhysicsSystem::init(SystemManager&) {
 
 		LM.writeLog("PhysicsSystem::init() - Physics System Initialized");
 		return true;
@@ -20,26 +85,469 @@ namespace gam300 {
 
 	void PhysicsSystem::update(float dt) {
 
-		(void)dt;
+		gatherBodies();
 
-		for (EntityID entity_id : m_entities) {
-			process_entity(entity_id, dt);
-		}
+		// Integrate forces and refresh collider bounds
+		JM.parallelFor(m_bodies.size(), BODY_GRAIN, [this, dt](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				PhysicsBody& body = m_bodies[i];
+				body.rigid_body->integrateForces(dt);
+				body.rigid_body->clearAccumulators();
+
+				if (body.collider) {
+					body.shape = body.collider->getShape();
+					body.layer = body.collider->getLayer();
+					body.mask = body.collider->getMask();
+					body.is_trigger = body.collider->isTrigger();
+					body.center = body.collider->getWorldCenter(*body.transform);
+					body.radius = body.collider->getWorldRadius(*body.transform);
+					body.bounds = body.collider->computeWorldAABB(*body.transform);
+				}
+			}
+		});
+
+		updateBroadphase();
+		generateContacts();
+		updateTriggerEvents();
+		buildContactIslands(m_bodies, m_contacts, m_islands);
+
+		// Islands share no dynamic bodies, so each one can be solved on its own
+		JM.parallelFor(m_islands.size(), ISLAND_GRAIN, [this](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				const ContactIsland& island = m_islands[i];
+				solveContactIsland(m_bodies, m_contacts.data() + island.first_contact, island.contact_count, SOLVER_ITERATIONS);
+			}
+		});
+
+		// Sweeps only read collider bounds from the start of the step, so they can run
+		// while other bodies are being moved
+		JM.parallelFor(m_bodies.size(), BODY_GRAIN, [this, dt](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				PhysicsBody& body = m_bodies[i];
+				if (body.collider && !body.is_trigger && body.inverse_mass > 0.0f && body.rigid_body->getContinuousCollision() && sweepBody(body, dt)) {
+					continue;
+				}
+				body.rigid_body->integrateVelocity(*body.transform, dt);
+			}
+		});
 	}
 
 	void PhysicsSystem::shutdown() {
-		LM.writeLog("TransformSystem::shutdown() - Transform System shut down");
+		LM.writeLog("PhysicsSystem::shutdown() - Physics System shut down");
+	}
+
+	void PhysicsSystem::process_entity(EntityID entity_id) {
+		// Bodies are stepped together in update()
+		(void)entity_id;
 	}
 
-	void PhysicsSystem::process_entity(EntityID entity_id, float dt) {
-		if (PhysicsEcsRef.hasComponent<Transform3D>(entity_id) && PhysicsEcsRef.hasComponent<RigidBody>(entity_id)) {
+	void PhysicsSystem::gatherBodies() {
+		m_bodies.clear();
+		m_bodies.reserve(m_entities.size());
+
+		for (EntityID entity_id : m_entities) {
 			Transform3D* transform = PhysicsEcsRef.getComponent<Transform3D>(entity_id);
 			RigidBody* rigidBody = PhysicsEcsRef.getComponent<RigidBody>(entity_id);
+			if (!transform || !rigidBody) {
+				continue;
+			}
+
+			PhysicsBody body;
+			body.entity = entity_id;
+			body.transform = transform;
+			body.rigid_body = rigidBody;
+			body.collider = PhysicsEcsRef.hasComponent<Collider>(entity_id) ? PhysicsEcsRef.getComponent<Collider>(entity_id) : nullptr;
+
+			// Body type and mass can be edited at runtime, so do not trust the cached inverse mass
+			body.inverse_mass = (rigidBody->isDynamic() && rigidBody->getMass() > 0.0f) ? 1.0f / rigidBody->getMass() : 0.0f;
+
+			m_bodies.push_back(body);
+		}
+	}
+
+	void PhysicsSystem::updateBroadphase() {
+		std::vector<BroadphaseProxy>& proxies = m_broadphase.getProxies();
+
+		// Rebuild when the set of colliders changed, or every so often to keep the tree tight
+		bool rebuild = ++m_steps_since_build >= REBUILD_INTERVAL;
+		std::size_t collider_count = 0;
+		for (const PhysicsBody& body : m_bodies) {
+			if (!body.collider) continue;
+			if (collider_count >= m_proxy_entities.size() || m_proxy_entities[collider_count] != body.entity) {
+				rebuild = true;
+			}
+			++collider_count;
+		}
+		if (collider_count != m_proxy_entities.size()) {
+			rebuild = true;
+		}
+
+		if (rebuild) {
+			proxies.clear();
+			m_proxy_entities.clear();
+		}
+
+		uint32_t proxy_index = 0;
+		for (uint32_t i = 0; i < m_bodies.size(); ++i) {
+			const PhysicsBody& body = m_bodies[i];
+			if (!body.collider) continue;
+
+			if (rebuild) {
+				proxies.emplace_back();
+				m_proxy_entities.push_back(body.entity);
+			}
+
+			BroadphaseProxy& proxy = proxies[proxy_index];
+			proxy.bounds = body.bounds;
+			proxy.entity = body.entity;
+			proxy.body = i;
+			proxy.layer = body.layer;
+			proxy.mask = body.mask;
+			proxy.is_static = body.rigid_body->isStatic();
+			++proxy_index;
+		}
+
+		if (rebuild) {
+			m_broadphase.build();
+			m_steps_since_build = 0;
+		}
+		else {
+			m_broadphase.refit();
+		}
+	}
+
+	void PhysicsSystem::generateContacts() {
+		m_broadphase.findPairs(m_pairs);
+		m_contacts.clear();
+		m_trigger_overlaps.clear();
+		if (m_pairs.empty()) {
+			return;
+		}
+
+		// Per-chunk output keeps the contacts in pair order whatever the thread count
+		const std::size_t chunk_count = JobManager::chunkCount(m_pairs.size(), PAIR_GRAIN);
+		std::vector<std::vector<Contact>> chunk_contacts(chunk_count);
+		std::vector<std::vector<uint64_t>> chunk_triggers(chunk_count);
+		const std::vector<BroadphaseProxy>& proxies = m_broadphase.getProxies();
+
+		JM.parallelFor(m_pairs.size(), PAIR_GRAIN, [this, &chunk_contacts, &chunk_triggers, &proxies](std::size_t begin, std::size_t end) {
+			std::vector<Contact>& local = chunk_contacts[begin / PAIR_GRAIN];
+			std::vector<uint64_t>& local_triggers = chunk_triggers[begin / PAIR_GRAIN];
+			for (std::size_t i = begin; i < end; ++i) {
+				uint32_t a = proxies[m_pairs[i].a].body;
+				uint32_t b = proxies[m_pairs[i].b].body;
+				const PhysicsBody& body_a = m_bodies[a];
+				const PhysicsBody& body_b = m_bodies[b];
+
+				// Triggers only report overlaps, and two triggers ignore each other
+				if (body_a.is_trigger || body_b.is_trigger) {
+					Contact overlap;
+					if (body_a.is_trigger != body_b.is_trigger && generateContact(m_bodies, a, b, overlap)) {
+						EntityID trigger = body_a.is_trigger ? body_a.entity : body_b.entity;
+						EntityID other = body_a.is_trigger ? body_b.entity : body_a.entity;
+						local_triggers.push_back((static_cast<uint64_t>(trigger) << 32) | other);
+					}
+					continue;
+				}
+
+				// Nothing to resolve between two bodies that cannot move in response
+				if (body_a.inverse_mass <= 0.0f && body_b.inverse_mass <= 0.0f) continue;
+
+				Contact contact;
+				if (generateContact(m_bodies, a, b, contact)) {
+					local.push_back(contact);
+				}
+			}
+		});
+
+		for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+			m_contacts.insert(m_contacts.end(), chunk_contacts[chunk].begin(), chunk_contacts[chunk].end());
+			m_trigger_overlaps.insert(m_trigger_overlaps.end(), chunk_triggers[chunk].begin(), chunk_triggers[chunk].end());
+		}
+	}
+
+	void PhysicsSystem::updateTriggerEvents() {
+		m_trigger_enter.clear();
+		m_trigger_stay.clear();
+		m_trigger_exit.clear();
+
+		std::sort(m_trigger_overlaps.begin(), m_trigger_overlaps.end());
+
+		auto toEvent = [](uint64_t key) {
+			TriggerEvent event;
+			event.trigger = static_cast<EntityID>(key >> 32);
+			event.other = static_cast<EntityID>(key & 0xFFFFFFFFu);
+			return event;
+		};
+
+		// Both lists are sorted, so one merge pass splits them into enter, stay and exit
+		std::size_t prev = 0;
+		std::size_t curr = 0;
+		while (prev < m_prev_trigger_overlaps.size() || curr < m_trigger_overlaps.size()) {
+			if (curr == m_trigger_overlaps.size() ||
+				(prev < m_prev_trigger_overlaps.size() && m_prev_trigger_overlaps[prev] < m_trigger_overlaps[curr])) {
+				m_trigger_exit.push_back(toEvent(m_prev_trigger_overlaps[prev++]));
+			}
+			else if (prev == m_prev_trigger_overlaps.size() || m_trigger_overlaps[curr] < m_prev_trigger_overlaps[prev]) {
+				m_trigger_enter.push_back(toEvent(m_trigger_overlaps[curr++]));
+			}
+			else {
+				m_trigger_stay.push_back(toEvent(m_trigger_overlaps[curr++]));
+				++prev;
+			}
+		}
+
+		m_prev_trigger_overlaps.swap(m_trigger_overlaps);
+	}
+
+	bool PhysicsSystem::sweepBody(PhysicsBody& body, float dt) const {
+		const Vector3D velocity = body.rigid_body->getLinearVelocity();
+		const Vector3D motion = velocity * dt;
+		const float distance = motion.magnitude();
+
+		// Sweep a core sphere well inside the collider, so resting and sliding contacts
+		// are left to the regular contact step
+		float core_radius = body.radius;
+		if (body.shape == ColliderShape::BOX) {
+			Vector3D half = body.bounds.extents();
+			core_radius = std::min(half.x, std::min(half.y, half.z));
+		}
+		core_radius *= SWEEP_CORE_SCALE;
+
+		// Slow enough that the contact step cannot miss anything
+		if (distance <= core_radius) {
+			return false;
+		}
+
+		RaycastHit hit;
+		if (!castClosest(body.center, motion, core_radius, distance, hit, body.entity, body.layer, body.mask) || hit.distance <= 0.0f) {
+			return false;
+		}
+
+		// Conservative advancement: stop at the time of impact and drop the rest of the step,
+		// the contact step resolves the remaining overlap next frame
+		float time_of_impact = hit.distance / distance;
+		body.transform->setPosition(body.transform->getPosition() + motion * time_of_impact);
+		body.transform->setRotation(body.transform->getRotation() + body.rigid_body->getAngularVelocity() * dt);
+
+		float into_surface = Vector3D::dot(velocity, hit.normal);
+		if (into_surface < 0.0f) {
+			float restitution = body.collider->getRestitution();
+			body.rigid_body->setLinearVelocity(velocity - hit.normal * (into_surface * (1.0f + restitution)));
+		}
+		return true;
+	}
+
+	bool PhysicsSystem::raycast(const Vector3D& origin, const Vector3D& direction, float max_distance,
+		RaycastHit& out_hit, EntityID ignore_entity, uint32_t layer_mask) const {
+		return castClosest(origin, direction, 0.0f, max_distance, out_hit, ignore_entity, QUERY_LAYER, layer_mask);
+	}
+
+	bool PhysicsSystem::sphereCast(const Vector3D& origin, float radius, const Vector3D& direction, float max_distance,
+		RaycastHit& out_hit, EntityID ignore_entity, uint32_t layer_mask) const {
+		return castClosest(origin, direction, radius, max_distance, out_hit, ignore_entity, QUERY_LAYER, layer_mask);
+	}
+
+	bool PhysicsSystem::castClosest(const Vector3D& origin, const Vector3D& direction, float radius, float max_distance,
+		RaycastHit& out_hit, EntityID ignore_entity, uint32_t layer, uint32_t layer_mask) const {
+		out_hit = RaycastHit();
+
+		float length = direction.magnitude();
+		if (length <= 0.0f || max_distance < 0.0f) {
+			return false;
+		}
+		const Vector3D unit_direction = direction / length;
+		const std::vector<BroadphaseProxy>& proxies = m_broadphase.getProxies();
+
+		// Each hit shortens the ray so farther nodes are skipped
+		bool found = false;
+		m_broadphase.castRay(origin, unit_direction, max_distance, radius, [&](uint32_t proxy, float max_t) {
+			const PhysicsBody& body = m_bodies[proxies[proxy].body];
+			if (body.is_trigger || body.entity == ignore_entity || !layersInteract(layer, layer_mask, body.layer, body.mask)) {
+				return max_t;
+			}
 
-			rigidBody->clearAccumulators();
-			rigidBody->integrateForces(dt);
-			rigidBody->integrateVelocity(*transform, dt);
+			RaycastHit hit;
+			if (intersectRayBody(body, origin, unit_direction, radius, max_t, hit)) {
+				out_hit = hit;
+				found = true;
+				return hit.distance;
+			}
+			return max_t;
+		});
+
+		return found;
+	}
+
+	std::size_t PhysicsSystem::raycastAll(const Vector3D& origin, const Vector3D& direction, float max_distance,
+		std::vector<RaycastHit>& out_hits, EntityID ignore_entity, uint32_t layer_mask) const {
+		out_hits.clear();
+
+		float length = direction.magnitude();
+		if (length <= 0.0f || max_distance < 0.0f) {
+			return 0;
 		}
+		const Vector3D unit_direction = direction / length;
+		const std::vector<BroadphaseProxy>& proxies = m_broadphase.getProxies();
+
+		m_broadphase.castRay(origin, unit_direction, max_distance, 0.0f, [&](uint32_t proxy, float max_t) {
+			const PhysicsBody& body = m_bodies[proxies[proxy].body];
+			if (body.is_trigger || body.entity == ignore_entity || !layersInteract(QUERY_LAYER, layer_mask, body.layer, body.mask)) {
+				return max_t;
+			}
+
+			RaycastHit hit;
+			if (intersectRayBody(body, origin, unit_direction, 0.0f, max_t, hit)) {
+				out_hits.push_back(hit);
+			}
+			return max_t;
+		});
+
+		std::sort(out_hits.begin(), out_hits.end(), [](const RaycastHit& lhs, const RaycastHit& rhs) {
+			return lhs.distance < rhs.distance || (lhs.distance == rhs.distance && lhs.entity < rhs.entity);
+		});
+		return out_hits.size();
+	}
+
+	std::size_t PhysicsSystem::overlapBox(const Vector3D& center, const Vector3D& half_extents,
+		std::vector<EntityID>& out_entities, uint32_t layer_mask) const {
+		out_entities.clear();
+
+		AABB box = AABB::fromCenterExtents(center, half_extents);
+		std::vector<uint32_t> candidates;
+		m_broadphase.queryOverlaps(box, candidates);
+		std::sort(candidates.begin(), candidates.end());
+
+		const std::vector<BroadphaseProxy>& proxies = m_broadphase.getProxies();
+		for (uint32_t proxy : candidates) {
+			const PhysicsBody& body = m_bodies[proxies[proxy].body];
+			if (!body.is_trigger && layersInteract(QUERY_LAYER, layer_mask, body.layer, body.mask) && overlapBoxBody(body, box)) {
+				out_entities.push_back(body.entity);
+			}
+		}
+		return out_entities.size();
+	}
+
+	void PhysicsSystem::raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& out_hits) const {
+		out_hits.resize(rays.size());
+
+		// Rays that pass through the same region walk the same nodes, so casting them in
+		// Morton order of their midpoints keeps the tree in cache. Results still go to the
+		// input slot. Long rays are measured up to the scene size so the midpoint stays near it.
+		std::vector<uint64_t> order(rays.size());
+		if (rays.size() >= RAY_SORT_MIN) {
+			AABB bounds = m_broadphase.getBounds();
+			const float scene_size = (bounds.max - bounds.min).magnitude();
+			for (std::size_t i = 0; i < rays.size(); ++i) {
+				const Ray& ray = rays[i];
+				const float length = ray.direction.magnitude();
+				Vector3D midpoint = ray.origin;
+				if (length > 0.0f) {
+					midpoint += ray.direction * (0.5f * std::min(ray.max_distance, scene_size) / length);
+				}
+				order[i] = (static_cast<uint64_t>(mortonCode(midpoint, bounds)) << 32) | i;
+			}
+			sortByMorton(order);
+		}
+		else {
+			for (std::size_t i = 0; i < rays.size(); ++i) {
+				order[i] = i;
+			}
+		}
+
+		JM.parallelFor(rays.size(), RAY_GRAIN, [this, &rays, &out_hits, &order](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				// The sorted order jumps around the input, so start loading rays a few casts ahead
+				if (i + RAY_PREFETCH_DISTANCE < end) {
+					std::size_t ahead = static_cast<std::size_t>(order[i + RAY_PREFETCH_DISTANCE] & 0xFFFFFFFFu);
+					_mm_prefetch(reinterpret_cast<const char*>(&rays[ahead]), _MM_HINT_T0);
+					_mm_prefetch(reinterpret_cast<const char*>(&out_hits[ahead]), _MM_HINT_T0);
+				}
+
+				std::size_t index = static_cast<std::size_t>(order[i] & 0xFFFFFFFFu);
+				const Ray& ray = rays[index];
+				castClosest(ray.origin, ray.direction, 0.0f, ray.max_distance, out_hits[index], ray.ignore_entity, QUERY_LAYER, ray.layer_mask);
+			}
+		});
+	}
+
+	bool PhysicsSystem::benchmarkRaycast(std::string& report) {
+		std::ostringstream log;
+		PhysicsSystem system;
+
+		// Half unit boxes and spheres of radius 0.5, the same seed every run
+		std::mt19937 rng(2u);
+		std::uniform_real_distribution<float> position(0.0f, BENCH_WORLD_SIZE);
+		std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+		system.m_bodies.resize(BENCH_BODIES);
+		std::vector<BroadphaseProxy>& proxies = system.m_broadphase.getProxies();
+		proxies.resize(BENCH_BODIES);
+		for (uint32_t i = 0; i < BENCH_BODIES; ++i) {
+			PhysicsBody& body = system.m_bodies[i];
+			body.entity = static_cast<EntityID>(i);
+			body.shape = i % 2 ? ColliderShape::SPHERE : ColliderShape::BOX;
+			body.center = Vector3D(position(rng), position(rng), position(rng));
+			body.radius = 0.5f;
+			body.bounds = AABB::fromCenterExtents(body.center, Vector3D(0.5f, 0.5f, 0.5f));
+			proxies[i].bounds = body.bounds;
+			proxies[i].body = i;
+			proxies[i].entity = body.entity;
+		}
+		system.m_broadphase.build();
+
+		std::vector<Ray> rays(BENCH_RAYS);
+		for (Ray& ray : rays) {
+			ray.origin = Vector3D(position(rng), position(rng), position(rng));
+			ray.direction = Vector3D(axis(rng), axis(rng), axis(rng));
+			ray.max_distance = BENCH_RAY_LENGTH;
+		}
+
+		std::vector<RaycastHit> hits;
+		const auto start = std::chrono::steady_clock::now();
+		system.raycastBatch(rays, hits);
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::size_t hit_count = 0;
+		for (const RaycastHit& hit : hits) {
+			hit_count += hit.hit ? 1 : 0;
+		}
+
+		// The closest hit of the first rays, from every body
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < BENCH_CHECKED_RAYS; ++i) {
+			const Ray& ray = rays[i];
+			const Vector3D direction = ray.direction / ray.direction.magnitude();
+			RaycastHit closest;
+			for (const PhysicsBody& body : system.m_bodies) {
+				RaycastHit hit;
+				if (intersectRayBody(body, ray.origin, direction, 0.0f, ray.max_distance, hit) &&
+					(!closest.hit || hit.distance < closest.distance)) {
+					closest = hit;
+				}
+			}
+			if (closest.hit != hits[i].hit || (closest.hit && std::fabs(closest.distance - hits[i].distance) > 1e-4f)) {
+				++mismatches;
+			}
+		}
+
+		const double mrays = BENCH_RAYS / seconds / 1e6;
+		log << "  " << BENCH_BODIES << " bodies, " << BENCH_RAYS << " rays of " << BENCH_RAY_LENGTH << " m, "
+			<< hit_count << " hit\n";
+		log << "  " << seconds * 1000.0 << " ms on " << (JM.getWorkerCount() ? JM.getWorkerCount() + 1 : 1) << " thread(s), "
+			<< mrays << " M rays/s\n";
+		log << (mrays >= BENCH_TARGET_MRAYS ? "  ok    " : "  SLOW  ") << "target " << BENCH_TARGET_MRAYS << " M rays/s";
+		if (mrays < BENCH_TARGET_MRAYS) {
+			log << ", short by " << (1.0 - mrays / BENCH_TARGET_MRAYS) * 100.0 << "%";
+		}
+		log << "\n";
+		log << (mismatches == 0 ? "  ok    " : "  FAIL  ") << BENCH_CHECKED_RAYS << " rays match the brute force";
+		if (mismatches) {
+			log << ", " << mismatches << " differ";
+		}
+		log << "\n";
+
+		report = log.str();
+		return mismatches == 0;
 	}
 
-}
\ No newline at end of file
+}
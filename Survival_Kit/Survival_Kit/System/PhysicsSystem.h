@@ -1,7 +1,9 @@
 /**
- * @file ...
- * @brief ...
- * @details ...
+ * @file PhysicsSystem.h
+ * @brief Declaration of the Physics System for the Entity Component System.
+ * @details Steps every entity with a Transform3D and RigidBody. Bodies that also own a
+ *          Collider take part in collision detection and response. The step is split
+ *          into phases that each run on the job system.
  * @author
  * @date
  * Copyright (C) 2025 DigiPen Institute of Technology.
@@ -16,15 +18,53 @@
 #include "../System/System.h"
 #include "../Component/Transform3D.h"
 #include "../Component/RigidBody.h"
+#include "../Physics/Broadphase.h"
+#include "../Physics/Contact.h"
+#include "../Physics/SceneQuery.h"
 #include <glm-0.9.9.8/glm/gtx/quaternion.hpp>
 
 namespace gam300 {
 
-    //IDK how Transform3D also fits into this
-    class PhysicsSystem : ComponentSystem<RigidBody> {
+    class PhysicsSystem : public ComponentSystem<Transform3D, RigidBody> {
 
     private:
         class ECSManager& PhysicsEcsRef;
+
+        std::vector<PhysicsBody> m_bodies;              // Bodies of the current step, in m_entities order
+        Broadphase m_broadphase;
+        std::vector<BroadphasePair> m_pairs;
+        std::vector<Contact> m_contacts;
+        std::vector<ContactIsland> m_islands;
+        std::vector<EntityID> m_proxy_entities;         // Proxy owners at the last build, to detect changes
+        int m_steps_since_build;
+
+        std::vector<uint64_t> m_trigger_overlaps;       // Trigger << 32 | other, for this step
+        std::vector<uint64_t> m_prev_trigger_overlaps;  // Same for the previous step, sorted
+        std::vector<TriggerEvent> m_trigger_enter;
+        std::vector<TriggerEvent> m_trigger_stay;
+        std::vector<TriggerEvent> m_trigger_exit;
+
+        // Collect the bodies and colliders for this step
+        void gatherBodies();
+
+        // Build or refit the broadphase tree over the current collider bounds
+        void updateBroadphase();
+
+        // Run the narrowphase over the broadphase pairs, collecting trigger overlaps on the side
+        void generateContacts();
+
+        // Turn this step's trigger overlaps into enter, stay and exit events
+        void updateTriggerEvents();
+
+        // Move a continuous collision body to its first hit along this step's motion,
+        // returns false if the body should be integrated normally
+        bool sweepBody(PhysicsBody& body, float dt) const;
+
+        // Closest hit of a ray or swept sphere, shared by raycast, sphereCast and sweeps.
+        // Triggers are skipped, and the caster's layer and mask must interact with the hit collider's.
+        bool castClosest(const Vector3D& origin, const Vector3D& direction, float radius, float max_distance,
+            RaycastHit& out_hit, EntityID ignore_entity, uint32_t layer, uint32_t layer_mask) const;
+
     public:
         /**
          * @brief Constructor for PhysicsSystem.
@@ -40,6 +80,9 @@ namespace gam300 {
 
         /**
          * @brief Update the system, processing all relevant entities.
+         * @details Integrates forces, finds and resolves contacts island by island,
+         *          then integrates velocities. The result does not depend on the number
+         *          of worker threads.
          * @param dt Delta time since the last update.
          */
         void update(float dt) override;
@@ -49,9 +92,110 @@ namespace gam300 {
          */
         void shutdown() override;
 
-        //void process_entity(EntityID entity_id) override;
+        /**
+         * @brief Process a specific entity.
+         * @details Bodies are stepped together in update(), this does nothing on its own.
+         * @param entity_id The ID of the entity to process.
+         */
+        void process_entity(EntityID entity_id) override;
+
+        /**
+         * @brief Find the closest collider hit by a ray.
+         * @details Scene queries run against the collider positions of the last physics
+         *          step and are safe to call from jobs. Trigger colliders are never hit.
+         * @param origin Ray origin in world space.
+         * @param direction Ray direction, does not need to be normalized.
+         * @param max_distance Length of the ray.
+         * @param out_hit Receives the closest hit.
+         * @param ignore_entity Entity to skip, usually the one casting the ray, IGNORE_NO_ENTITY for none.
+         * @param layer_mask Layers the ray can hit.
+         * @return True if anything was hit.
+         */
+        bool raycast(const Vector3D& origin, const Vector3D& direction, float max_distance,
+            RaycastHit& out_hit, EntityID ignore_entity = IGNORE_NO_ENTITY, uint32_t layer_mask = 0xFFFFFFFFu) const;
+
+        /**
+         * @brief Find every collider hit by a ray.
+         * @param origin Ray origin in world space.
+         * @param direction Ray direction, does not need to be normalized.
+         * @param max_distance Length of the ray.
+         * @param out_hits Receives the hits sorted by distance, cleared first.
+         * @param ignore_entity Entity to skip, usually the one casting the ray, IGNORE_NO_ENTITY for none.
+         * @param layer_mask Layers the ray can hit.
+         * @return Number of hits.
+         */
+        std::size_t raycastAll(const Vector3D& origin, const Vector3D& direction, float max_distance,
+            std::vector<RaycastHit>& out_hits, EntityID ignore_entity = IGNORE_NO_ENTITY, uint32_t layer_mask = 0xFFFFFFFFu) const;
 
-        void process_entity(EntityID entity_id, float dt);
+        /**
+         * @brief Sweep a sphere along a ray and find the first collider it touches.
+         * @param origin Start position of the sphere center.
+         * @param radius Radius of the sphere.
+         * @param direction Sweep direction, does not need to be normalized.
+         * @param max_distance Length of the sweep.
+         * @param out_hit Receives the first hit, distance is how far the center travelled.
+         * @param ignore_entity Entity to skip, usually the one casting the sphere, IGNORE_NO_ENTITY for none.
+         * @param layer_mask Layers the sphere can hit.
+         * @return True if anything was hit.
+         */
+        bool sphereCast(const Vector3D& origin, float radius, const Vector3D& direction, float max_distance,
+            RaycastHit& out_hit, EntityID ignore_entity = IGNORE_NO_ENTITY, uint32_t layer_mask = 0xFFFFFFFFu) const;
+
+        /**
+         * @brief Find every collider overlapping a box.
+         * @param center Box center in world space.
+         * @param half_extents Box half size.
+         * @param out_entities Receives the overlapping entities, cleared first.
+         * @param layer_mask Layers to look for.
+         * @return Number of overlapping entities.
+         */
+        std::size_t overlapBox(const Vector3D& center, const Vector3D& half_extents,
+            std::vector<EntityID>& out_entities, uint32_t layer_mask = 0xFFFFFFFFu) const;
+
+        /**
+         * @brief Cast many rays at once on the job system.
+         * @details Meant for large batches such as AI line of sight or audio occlusion.
+         * @param rays Rays to cast.
+         * @param out_hits Receives one result per ray, hit is false on a miss.
+         */
+        void raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& out_hits) const;
+
+        /**
+         * @brief Time raycastBatch on the calling thread over a generated scene, needs no window or entities.
+         * @details 50000 boxes and spheres scattered in a 200 m cube take 1000000 rays of 50 m
+         *          from random points in random directions. The first rays are checked against
+         *          every body. main runs it with --bench-raycast, before the job system starts.
+         * @param report Receives the timing and how it compares to 1M rays per second.
+         * @return True if the checked rays hit what the brute force hits.
+         */
+        static bool benchmarkRaycast(std::string& report);
+
+        /**
+         * @brief Access the broadphase, for scene queries and debugging.
+         */
+        const Broadphase& getBroadphase() const { return m_broadphase; }
+
+        /**
+         * @brief Contacts resolved during the last step, ordered by island.
+         */
+        const std::vector<Contact>& getContacts() const { return m_contacts; }
+
+        /**
+         * @brief Trigger overlaps that started during the last step.
+         * @details Each event list is sorted by trigger entity, then by the other entity.
+         */
+        const std::vector<TriggerEvent>& getTriggerEnterEvents() const { return m_trigger_enter; }
+
+        /**
+         * @brief Trigger overlaps that were already there and still are.
+         */
+        const std::vector<TriggerEvent>& getTriggerStayEvents() const { return m_trigger_stay; }
+
+        /**
+         * @brief Trigger overlaps that ended during the last step.
+         * @details Also reported when either entity lost its collider or was destroyed.
+         */
+        const std::vector<TriggerEvent>& getTriggerExitEvents() const { return m_trigger_exit; }
     };
 }
 
@@ -0,0 +1,51 @@
+#include "../System/SpatialGridSystem.h"
+#include "../Manager/ComponentManager.h"
+#include "../Manager/LogManager.h"
+#include "../Manager/JobManager.h"
+
+namespace gam300 {
+
+	namespace {
+		constexpr std::size_t GATHER_GRAIN = 2048;	// Entities per job when reading positions
+	}
+
+	SpatialGridSystem::SpatialGridSystem() : ComponentSystem<Transform3D>("SpatialGridSystem") {
+		// Run after PhysicsSystem so the grid sees this frame's final positions
+		set_priority(80);
+	}
+
+	bool SpatialGridSystem::init(SystemManager&) {
+
+		LM.writeLog("SpatialGridSystem::init() - Spatial Grid System Initialized");
+		return true;
+	}
+
+	void SpatialGridSystem::update(float dt) {
+
+		(void)dt;
+
+		m_grid_entities.assign(m_entities.begin(), m_entities.end());
+		m_grid_positions.resize(m_entities.size());
+
+		// Component lookups only read the pools, so they can run in parallel
+		JM.parallelFor(m_grid_entities.size(), GATHER_GRAIN, [this](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				Transform3D* transform = CM.get_component<Transform3D>(m_grid_entities[i]);
+				m_grid_positions[i] = transform ? transform->getPosition() : Vector3D::ZERO;
+			}
+		});
+
+		m_grid.build(m_grid_entities, m_grid_positions);
+	}
+
+	void SpatialGridSystem::shutdown() {
+		m_grid.clear();
+		LM.writeLog("SpatialGridSystem::shutdown() - Spatial Grid System shut down");
+	}
+
+	void SpatialGridSystem::process_entity(EntityID entity_id) {
+		// The grid is rebuilt for all entities in update()
+		(void)entity_id;
+	}
+
+}
@@ -0,0 +1,73 @@
+/**
+ * @file SpatialGridSystem.h
+ * @brief Declaration of the Spatial Grid System for the Entity Component System.
+ * @details Rebuilds a spatial hash grid from Transform3D positions every tick, so
+ *          gameplay code can ask for "entities within r of p" without a linear scan.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+
+#ifndef __SPATIAL_GRID_SYSTEM_H__
+#define __SPATIAL_GRID_SYSTEM_H__
+
+#include "../System/System.h"
+#include "../Component/Transform3D.h"
+#include "../Utility/SpatialHashGrid.h"
+
+namespace gam300 {
+
+    class SpatialGridSystem : public ComponentSystem<Transform3D> {
+
+    public:
+        /**
+         * @brief Constructor for SpatialGridSystem.
+         */
+        SpatialGridSystem();
+
+        /**
+         * @brief Initialize the system.
+         * @param system_manager Reference to the system manager.
+         * @return True if initialization was successful, false otherwise.
+         */
+        bool init(SystemManager& system_manager) override;
+
+        /**
+         * @brief Rebuild the grid from the current Transform3D positions.
+         * @param dt Delta time since the last update.
+         */
+        void update(float dt) override;
+
+        /**
+         * @brief Clean up the system when shutting down.
+         */
+        void shutdown() override;
+
+        /**
+         * @brief Process a specific entity.
+         * @details The grid is rebuilt for all entities at once in update(), this does nothing on its own.
+         * @param entity_id The ID of the entity to process.
+         */
+        void process_entity(EntityID entity_id) override;
+
+        /**
+         * @brief Access the grid, as of the last update.
+         */
+        const SpatialHashGrid& getGrid() const { return m_grid; }
+
+        /**
+         * @brief Set the grid cell size, takes effect on the next update.
+         */
+        void setCellSize(float cell_size) { m_grid.setCellSize(cell_size); }
+
+    private:
+        SpatialHashGrid m_grid;
+        std::vector<EntityID> m_grid_entities;    // Scratch input for the rebuild
+        std::vector<Vector3D> m_grid_positions;
+    };
+}
+
+#endif // !__SPATIAL_GRID_SYSTEM_H__
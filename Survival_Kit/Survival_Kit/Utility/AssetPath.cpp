@@ -116,6 +116,21 @@ namespace gam300 {
         return intermediatePath.generic_string();
     }
 
+    //get directory for program binaries, they only hold for the driver that made them
+    std::string getShaderCachePath()
+    {
+        fs::path shaderCachePath = fs::path(getLocalCachePath()) / "Shaders";
+
+        //create directory if it dosen't exist
+        if (!fs::exists(shaderCachePath))
+        {
+            std::error_code ec;
+            fs::create_directories(shaderCachePath, ec);
+        }
+
+        return shaderCachePath.generic_string();
+    }
+
     std::string getDescriptorsPath() {
         // Get the base Assets path and append Descriptors
         std::string assetsPath = getAssetsPath();
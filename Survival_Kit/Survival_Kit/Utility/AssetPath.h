@@ -46,6 +46,12 @@ namespace gam300 {
      */
     std::string getIntermediatePath();
 
+    /**
+     * @brief Get the directory for linked shader program binaries.
+     * @return The absolute path to the shader cache directory.
+     */
+    std::string getShaderCachePath();
+
     /**
      * @brief Get the descriptors folder path (Assets/Descriptors/).
      * @return The absolute path to the descriptors folder.
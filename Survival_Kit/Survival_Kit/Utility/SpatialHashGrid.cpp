@@ -0,0 +1,417 @@
+/**
+ * @file SpatialHashGrid.cpp
+ * @brief Implementation of the uniform spatial hash grid.
+ * @details Contains implementations for all member functions declared in SpatialHashGrid.h.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+
+#include "../Utility/SpatialHashGrid.h"
+#include "../Manager/JobManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
+
+namespace gam300 {
+
+    namespace {
+        constexpr std::size_t POINT_GRAIN = 2048;     // Points per job for the build passes
+
+        // Scene of benchmark
+        constexpr uint32_t BENCH_POINTS = 100000;
+        constexpr int BENCH_FRAMES = 30;
+        constexpr float BENCH_WORLD_SIZE = 200.0f;
+        constexpr float BENCH_MAX_SPEED = 5.0f;        // Meters per second
+        constexpr float BENCH_FRAME_TIME = 1.0f / 60.0f;
+        constexpr float BENCH_CELL_SIZE = 4.0f;
+        constexpr float BENCH_RADIUS = 4.0f;
+        constexpr std::size_t BENCH_NEAREST = 8;
+        constexpr uint32_t BENCH_RADIUS_QUERIES = 10000;
+        constexpr uint32_t BENCH_NEAREST_QUERIES = 2000;
+        constexpr uint32_t BENCH_CHECKED_QUERIES = 200;
+
+        bool entryLess(const SpatialGridEntry& lhs, const SpatialGridEntry& rhs) {
+            if (lhs.cell_x != rhs.cell_x) return lhs.cell_x < rhs.cell_x;
+            if (lhs.cell_y != rhs.cell_y) return lhs.cell_y < rhs.cell_y;
+            if (lhs.cell_z != rhs.cell_z) return lhs.cell_z < rhs.cell_z;
+            return lhs.entity < rhs.entity;
+        }
+    }
+
+    SpatialHashGrid::SpatialHashGrid(float cell_size) :
+        m_cell_size(1.0f),
+        m_inv_cell_size(1.0f),
+        m_bucket_mask(0),
+        m_min_cell{ 0, 0, 0 },
+        m_max_cell{ 0, 0, 0 }
+    {
+        setCellSize(cell_size);
+    }
+
+    void SpatialHashGrid::setCellSize(float cell_size) {
+        m_cell_size = cell_size > 0.0f ? cell_size : 1.0f;
+        m_inv_cell_size = 1.0f / m_cell_size;
+    }
+
+    uint32_t SpatialHashGrid::bucketOf(int32_t cell_x, int32_t cell_y, int32_t cell_z) const {
+        uint32_t hash = (static_cast<uint32_t>(cell_x) * 73856093u)
+            ^ (static_cast<uint32_t>(cell_y) * 19349663u)
+            ^ (static_cast<uint32_t>(cell_z) * 83492791u);
+        return hash & m_bucket_mask;
+    }
+
+    void SpatialHashGrid::clear() {
+        m_entries.clear();
+        m_bucket_start.clear();
+        m_bucket_mask = 0;
+    }
+
+    void SpatialHashGrid::build(const std::vector<EntityID>& entities, const std::vector<Vector3D>& positions) {
+        const std::size_t count = std::min(entities.size(), positions.size());
+        if (count == 0) {
+            clear();
+            return;
+        }
+
+        // Twice as many buckets as points keeps collisions rare
+        uint32_t bucket_bits = 4;
+        while ((std::size_t(1) << bucket_bits) < count * 2) {
+            ++bucket_bits;
+        }
+        const std::size_t bucket_count = std::size_t(1) << bucket_bits;
+        m_bucket_mask = static_cast<uint32_t>(bucket_count - 1);
+
+        // Pass 1: cell and bucket of every point
+        m_scratch.resize(count);
+        m_keys.resize(count);
+        m_sorted_keys.resize(count);
+        m_order.resize(count);
+        m_sorted_order.resize(count);
+        JM.parallelFor(count, POINT_GRAIN, [this, &entities, &positions](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                SpatialGridEntry& entry = m_scratch[i];
+                entry.entity = entities[i];
+                entry.position = positions[i];
+                entry.cell_x = cellCoord(positions[i].x);
+                entry.cell_y = cellCoord(positions[i].y);
+                entry.cell_z = cellCoord(positions[i].z);
+                m_keys[i] = bucketOf(entry.cell_x, entry.cell_y, entry.cell_z);
+                m_order[i] = static_cast<uint32_t>(i);
+            }
+        });
+
+        // Pass 2: stable radix sort of the points by bucket, two digits. Each chunk
+        // writes to its own slice of every digit, so the result is the same on any
+        // number of threads, and the streaming writes stay cache friendly.
+        const std::size_t chunk_count = JobManager::chunkCount(count, POINT_GRAIN);
+        const uint32_t digit_bits = (bucket_bits + 1) / 2;
+        const std::size_t digit_count = std::size_t(1) << digit_bits;
+        m_histogram.resize(chunk_count * digit_count);
+
+        for (uint32_t shift = 0; shift < bucket_bits; shift += digit_bits) {
+            const uint32_t digit_mask = static_cast<uint32_t>(digit_count - 1);
+
+            JM.parallelFor(count, POINT_GRAIN, [&, shift, digit_mask](std::size_t begin, std::size_t end) {
+                uint32_t* histogram = m_histogram.data() + (begin / POINT_GRAIN) * digit_count;
+                std::fill(histogram, histogram + digit_count, 0u);
+                for (std::size_t i = begin; i < end; ++i) {
+                    ++histogram[(m_keys[i] >> shift) & digit_mask];
+                }
+            });
+
+            // Offsets ordered by digit first, then by chunk
+            uint32_t offset = 0;
+            for (std::size_t digit = 0; digit < digit_count; ++digit) {
+                for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                    uint32_t& slot = m_histogram[chunk * digit_count + digit];
+                    uint32_t bucket_size = slot;
+                    slot = offset;
+                    offset += bucket_size;
+                }
+            }
+
+            JM.parallelFor(count, POINT_GRAIN, [&, shift, digit_mask](std::size_t begin, std::size_t end) {
+                uint32_t* cursor = m_histogram.data() + (begin / POINT_GRAIN) * digit_count;
+                for (std::size_t i = begin; i < end; ++i) {
+                    uint32_t slot = cursor[(m_keys[i] >> shift) & digit_mask]++;
+                    m_sorted_keys[slot] = m_keys[i];
+                    m_sorted_order[slot] = m_order[i];
+                }
+            });
+
+            m_keys.swap(m_sorted_keys);
+            m_order.swap(m_sorted_order);
+        }
+
+        // Pass 3: gather the entries in bucket order and mark where each bucket starts
+        m_entries.resize(count);
+        m_bucket_start.resize(bucket_count + 1);
+        JM.parallelFor(count, POINT_GRAIN, [this, count](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                m_entries[i] = m_scratch[m_order[i]];
+
+                // Buckets between the previous key and this one start here
+                uint32_t first = i == 0 ? 0 : m_keys[i - 1] + 1;
+                for (uint32_t bucket = first; bucket <= m_keys[i]; ++bucket) {
+                    m_bucket_start[bucket] = static_cast<uint32_t>(i);
+                }
+            }
+        });
+        for (std::size_t bucket = m_keys[count - 1] + 1; bucket <= bucket_count; ++bucket) {
+            m_bucket_start[bucket] = static_cast<uint32_t>(count);
+        }
+
+        // Pass 4: buckets shared by several cells get their cells grouped together, and
+        // every cell lists its points by entity
+        JM.parallelFor(count, POINT_GRAIN, [this, count](std::size_t begin, std::size_t end) {
+            std::size_t i = begin;
+            while (i > 0 && i < end && m_keys[i] == m_keys[i - 1]) {
+                ++i;    // Bucket started in the previous chunk, which sorts it
+            }
+            while (i < end) {
+                std::size_t run_end = i + 1;
+                while (run_end < count && m_keys[run_end] == m_keys[i]) {
+                    ++run_end;
+                }
+                if (run_end - i > 1) {
+                    std::sort(m_entries.begin() + i, m_entries.begin() + run_end, entryLess);
+                }
+                i = run_end;
+            }
+        });
+
+        // Occupied cell bounds, used to stop nearest queries early
+        for (int axis = 0; axis < 3; ++axis) {
+            m_min_cell[axis] = INT32_MAX;
+            m_max_cell[axis] = INT32_MIN;
+        }
+        for (const SpatialGridEntry& entry : m_entries) {
+            m_min_cell[0] = std::min(m_min_cell[0], entry.cell_x); m_max_cell[0] = std::max(m_max_cell[0], entry.cell_x);
+            m_min_cell[1] = std::min(m_min_cell[1], entry.cell_y); m_max_cell[1] = std::max(m_max_cell[1], entry.cell_y);
+            m_min_cell[2] = std::min(m_min_cell[2], entry.cell_z); m_max_cell[2] = std::max(m_max_cell[2], entry.cell_z);
+        }
+    }
+
+    std::size_t SpatialHashGrid::queryRadius(const Vector3D& center, float radius, std::vector<EntityID>& out_entities) const {
+        out_entities.clear();
+        if (m_entries.empty() || radius < 0.0f) {
+            return 0;
+        }
+
+        const float radius_sq = radius * radius;
+        auto test = [&](const SpatialGridEntry& entry) {
+            if ((entry.position - center).magnitudeSquared() <= radius_sq) {
+                out_entities.push_back(entry.entity);
+            }
+        };
+
+        const int32_t min_x = std::max(cellCoord(center.x - radius), m_min_cell[0]);
+        const int32_t min_y = std::max(cellCoord(center.y - radius), m_min_cell[1]);
+        const int32_t min_z = std::max(cellCoord(center.z - radius), m_min_cell[2]);
+        const int32_t max_x = std::min(cellCoord(center.x + radius), m_max_cell[0]);
+        const int32_t max_y = std::min(cellCoord(center.y + radius), m_max_cell[1]);
+        const int32_t max_z = std::min(cellCoord(center.z + radius), m_max_cell[2]);
+        if (min_x > max_x || min_y > max_y || min_z > max_z) {
+            return 0;
+        }
+
+        // A query that covers more cells than there are points is cheaper as a flat scan
+        const double cell_count = static_cast<double>(max_x - min_x + 1) * (max_y - min_y + 1) * (max_z - min_z + 1);
+        if (cell_count > static_cast<double>(m_entries.size())) {
+            for (const SpatialGridEntry& entry : m_entries) {
+                test(entry);
+            }
+            return out_entities.size();
+        }
+
+        for (int32_t z = min_z; z <= max_z; ++z) {
+            for (int32_t y = min_y; y <= max_y; ++y) {
+                for (int32_t x = min_x; x <= max_x; ++x) {
+                    visitCell(x, y, z, test);
+                }
+            }
+        }
+        return out_entities.size();
+    }
+
+    std::size_t SpatialHashGrid::queryNearest(const Vector3D& center, std::size_t k, std::vector<EntityID>& out_entities,
+        float max_radius) const {
+        out_entities.clear();
+        if (m_entries.empty() || k == 0) {
+            return 0;
+        }
+
+        // Max-heap of the best candidates so far, farthest on top
+        struct Candidate {
+            float distance_sq;
+            EntityID entity;
+            bool operator<(const Candidate& other) const {
+                return distance_sq < other.distance_sq || (distance_sq == other.distance_sq && entity < other.entity);
+            }
+        };
+        std::vector<Candidate> best;
+        best.reserve(k + 1);
+
+        const float max_radius_sq = max_radius < FLT_MAX ? max_radius * max_radius : FLT_MAX;
+        auto test = [&](const SpatialGridEntry& entry) {
+            Candidate candidate = { (entry.position - center).magnitudeSquared(), entry.entity };
+            if (candidate.distance_sq > max_radius_sq) return;
+            if (best.size() < k) {
+                best.push_back(candidate);
+                std::push_heap(best.begin(), best.end());
+            }
+            else if (candidate < best.front()) {
+                std::pop_heap(best.begin(), best.end());
+                best.back() = candidate;
+                std::push_heap(best.begin(), best.end());
+            }
+        };
+
+        const int32_t center_x = cellCoord(center.x);
+        const int32_t center_y = cellCoord(center.y);
+        const int32_t center_z = cellCoord(center.z);
+
+        // Rings past this one cannot contain any occupied cell
+        int32_t last_ring = 0;
+        last_ring = std::max(last_ring, std::max(center_x - m_min_cell[0], m_max_cell[0] - center_x));
+        last_ring = std::max(last_ring, std::max(center_y - m_min_cell[1], m_max_cell[1] - center_y));
+        last_ring = std::max(last_ring, std::max(center_z - m_min_cell[2], m_max_cell[2] - center_z));
+
+        for (int32_t ring = 0; ring <= last_ring; ++ring) {
+
+            // Everything in this ring is at least (ring - 1) cells away from the center
+            float ring_distance = std::max(0, ring - 1) * m_cell_size;
+            float ring_distance_sq = ring_distance * ring_distance;
+            if (ring_distance_sq > max_radius_sq) break;
+            if (best.size() == k && ring_distance_sq > best.front().distance_sq) break;
+
+            // Visit only the shell of the cube, the inside was covered by earlier rings
+            for (int32_t z = center_z - ring; z <= center_z + ring; ++z) {
+                for (int32_t y = center_y - ring; y <= center_y + ring; ++y) {
+                    bool on_face = z == center_z - ring || z == center_z + ring || y == center_y - ring || y == center_y + ring;
+                    int32_t step = on_face ? 1 : std::max(1, 2 * ring);
+                    for (int32_t x = center_x - ring; x <= center_x + ring; x += step) {
+                        visitCell(x, y, z, test);
+                    }
+                }
+            }
+        }
+
+        std::sort_heap(best.begin(), best.end());
+        for (const Candidate& candidate : best) {
+            out_entities.push_back(candidate.entity);
+        }
+        return out_entities.size();
+    }
+
+    bool SpatialHashGrid::benchmark(std::string& report) {
+        std::ostringstream log;
+        bool ok = true;
+
+        std::mt19937 rng(3u);
+        std::uniform_real_distribution<float> position(0.0f, BENCH_WORLD_SIZE);
+        std::uniform_real_distribution<float> speed(-BENCH_MAX_SPEED, BENCH_MAX_SPEED);
+
+        std::vector<EntityID> entities(BENCH_POINTS);
+        std::vector<Vector3D> positions(BENCH_POINTS);
+        std::vector<Vector3D> velocities(BENCH_POINTS);
+        for (uint32_t i = 0; i < BENCH_POINTS; ++i) {
+            entities[i] = static_cast<EntityID>(i);
+            positions[i] = Vector3D(position(rng), position(rng), position(rng));
+            velocities[i] = Vector3D(speed(rng), speed(rng), speed(rng));
+        }
+
+        // Move everything, wrapping around the world, and rebuild every frame
+        SpatialHashGrid grid(BENCH_CELL_SIZE);
+        double build_total = 0.0;
+        double build_worst = 0.0;
+        for (int frame = 0; frame < BENCH_FRAMES; ++frame) {
+            for (uint32_t i = 0; i < BENCH_POINTS; ++i) {
+                Vector3D& point = positions[i];
+                point += velocities[i] * BENCH_FRAME_TIME;
+                point.x = std::fmod(point.x + BENCH_WORLD_SIZE, BENCH_WORLD_SIZE);
+                point.y = std::fmod(point.y + BENCH_WORLD_SIZE, BENCH_WORLD_SIZE);
+                point.z = std::fmod(point.z + BENCH_WORLD_SIZE, BENCH_WORLD_SIZE);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            grid.build(entities, positions);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            build_total += seconds;
+            build_worst = std::max(build_worst, seconds);
+        }
+
+        std::vector<Vector3D> centers(std::max(BENCH_RADIUS_QUERIES, BENCH_NEAREST_QUERIES));
+        for (Vector3D& center : centers) {
+            center = Vector3D(position(rng), position(rng), position(rng));
+        }
+
+        std::vector<EntityID> found;
+        std::size_t radius_found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_RADIUS_QUERIES; ++i) {
+            radius_found += grid.queryRadius(centers[i], BENCH_RADIUS, found);
+        }
+        const double radius_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_NEAREST_QUERIES; ++i) {
+            grid.queryNearest(centers[i], BENCH_NEAREST, found);
+        }
+        const double nearest_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // The first queries again, against a scan of every point
+        uint32_t radius_mismatches = 0;
+        uint32_t nearest_mismatches = 0;
+        std::vector<EntityID> expected;
+        std::vector<std::pair<float, EntityID>> by_distance(BENCH_POINTS);
+        for (uint32_t i = 0; i < BENCH_CHECKED_QUERIES; ++i) {
+            const Vector3D& center = centers[i];
+
+            expected.clear();
+            for (uint32_t point = 0; point < BENCH_POINTS; ++point) {
+                if ((positions[point] - center).magnitudeSquared() <= BENCH_RADIUS * BENCH_RADIUS) {
+                    expected.push_back(entities[point]);
+                }
+            }
+            grid.queryRadius(center, BENCH_RADIUS, found);
+            std::sort(found.begin(), found.end());
+            radius_mismatches += found != expected ? 1 : 0;
+
+            for (uint32_t point = 0; point < BENCH_POINTS; ++point) {
+                by_distance[point] = { (positions[point] - center).magnitudeSquared(), entities[point] };
+            }
+            std::partial_sort(by_distance.begin(), by_distance.begin() + BENCH_NEAREST, by_distance.end());
+            expected.clear();
+            for (std::size_t n = 0; n < BENCH_NEAREST; ++n) {
+                expected.push_back(by_distance[n].second);
+            }
+            grid.queryNearest(center, BENCH_NEAREST, found);
+            nearest_mismatches += found != expected ? 1 : 0;
+        }
+
+        log << "  " << BENCH_POINTS << " points in a " << BENCH_WORLD_SIZE << " m cube, cells of " << BENCH_CELL_SIZE
+            << " m, " << (JM.getWorkerCount() + 1) << " thread(s)\n";
+        log << "  build " << build_total / BENCH_FRAMES * 1000.0 << " ms average, " << build_worst * 1000.0
+            << " ms worst over " << BENCH_FRAMES << " frames of movement\n";
+        log << "  radius " << BENCH_RADIUS << " m query " << radius_seconds / BENCH_RADIUS_QUERIES * 1e6 << " us, "
+            << static_cast<double>(radius_found) / BENCH_RADIUS_QUERIES << " points found on average\n";
+        log << "  " << BENCH_NEAREST << " nearest query " << nearest_seconds / BENCH_NEAREST_QUERIES * 1e6 << " us\n";
+
+        auto check = [&](bool condition, const std::string& what) {
+            log << (condition ? "  ok    " : "  FAIL  ") << what << "\n";
+            ok = ok && condition;
+        };
+        check(radius_mismatches == 0, std::to_string(BENCH_CHECKED_QUERIES) + " radius queries match the scan");
+        check(nearest_mismatches == 0, std::to_string(BENCH_CHECKED_QUERIES) + " nearest queries match the scan");
+
+        report = log.str();
+        return ok;
+    }
+
+} // namespace gam300
@@ -0,0 +1,193 @@
+/**
+ * @file SpatialHashGrid.h
+ * @brief Declaration of a uniform spatial hash grid for proximity queries.
+ * @details Points are bucketed by the cell they fall in, so "everything within r of p"
+ *          only looks at the few cells around p instead of every entity.
+ * @author
+ * @date
+ * Copyright (C) 2025 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+#pragma once
+#ifndef __SPATIAL_HASH_GRID_H__
+#define __SPATIAL_HASH_GRID_H__
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../Utility/ECS_Variables.h"
+#include "../Utility/Vector3D.h"
+
+namespace gam300 {
+
+    /**
+     * @brief One point stored in the grid.
+     */
+    struct SpatialGridEntry {
+        EntityID entity = INVALID_ENTITY_ID;
+        Vector3D position;
+        int32_t cell_x = 0;
+        int32_t cell_y = 0;
+        int32_t cell_z = 0;
+    };
+
+    /**
+     * @brief Uniform grid of cubic cells, stored as a hash table over cell coordinates.
+     * @details The grid is rebuilt from scratch with build(), a radix sort of the points
+     *          by hash bucket that runs on the job system. Entries of one cell are stored
+     *          next to each other and sorted by entity, so query results do not depend on
+     *          the number of threads.
+     */
+    class SpatialHashGrid {
+    public:
+
+        /**
+         * @brief Constructor for SpatialHashGrid.
+         * @param cell_size Edge length of a cell. Around the most common query radius works best.
+         */
+        explicit SpatialHashGrid(float cell_size = 4.0f);
+
+        float getCellSize() const { return m_cell_size; }
+
+        /**
+         * @brief Change the cell size, takes effect on the next build().
+         */
+        void setCellSize(float cell_size);
+
+        /**
+         * @brief Rebuild the grid from a set of points.
+         * @param entities Entity of each point.
+         * @param positions Position of each point, same size as entities.
+         */
+        void build(const std::vector<EntityID>& entities, const std::vector<Vector3D>& positions);
+
+        /**
+         * @brief Remove every point.
+         */
+        void clear();
+
+        /**
+         * @brief Number of points in the grid.
+         */
+        std::size_t size() const { return m_entries.size(); }
+
+        /**
+         * @brief Find every point within a radius.
+         * @param center Query center.
+         * @param radius Query radius.
+         * @param out_entities Receives the entities, cleared first.
+         * @return Number of entities found.
+         */
+        std::size_t queryRadius(const Vector3D& center, float radius, std::vector<EntityID>& out_entities) const;
+
+        /**
+         * @brief Find the k points closest to a position.
+         * @details Searches outwards one ring of cells at a time and stops as soon as no
+         *          unsearched cell can hold anything closer.
+         * @param center Query center.
+         * @param k Maximum number of points to return.
+         * @param out_entities Receives the entities, nearest first, cleared first.
+         * @param max_radius Ignore points farther than this.
+         * @return Number of entities found.
+         */
+        std::size_t queryNearest(const Vector3D& center, std::size_t k, std::vector<EntityID>& out_entities,
+            float max_radius = FLT_MAX) const;
+
+        /**
+         * @brief Call func(entry) for every point in one cell.
+         */
+        template<typename Func>
+        void forEachInCell(int32_t cell_x, int32_t cell_y, int32_t cell_z, Func&& func) const;
+
+        /**
+         * @brief Call func(cell_x, cell_y, cell_z, begin, end) once for every non-empty cell.
+         * @details begin and end delimit the SpatialGridEntry range of the cell.
+         */
+        template<typename Func>
+        void forEachCell(Func&& func) const;
+
+        /**
+         * @brief Cell coordinate of a position along one axis.
+         */
+        int32_t cellCoord(float value) const { return static_cast<int32_t>(std::floor(value * m_inv_cell_size)); }
+
+        /**
+         * @brief Time builds and queries over 100000 moving points, needs no window or entities.
+         * @details The points move for a number of frames with a rebuild each frame, then
+         *          radius and nearest queries run from random points. The first queries are
+         *          checked against a scan of every point. main runs it with --bench-spatial-grid.
+         * @param report Receives the timings.
+         * @return True if the checked queries return what the scan returns.
+         */
+        static bool benchmark(std::string& report);
+
+    private:
+
+        // Hash table bucket of a cell
+        uint32_t bucketOf(int32_t cell_x, int32_t cell_y, int32_t cell_z) const;
+
+        // Visit every point of a cell
+        template<typename Func>
+        void visitCell(int32_t cell_x, int32_t cell_y, int32_t cell_z, Func&& func) const;
+
+        float m_cell_size;
+        float m_inv_cell_size;
+        uint32_t m_bucket_mask;                         // Bucket count - 1, bucket count is a power of two
+
+        std::vector<SpatialGridEntry> m_entries;        // Sorted by bucket, then cell, then entity
+        std::vector<uint32_t> m_bucket_start;           // First entry of each bucket, plus one end marker
+
+        // Scratch buffers kept between builds
+        std::vector<SpatialGridEntry> m_scratch;        // Entries in input order
+        std::vector<uint32_t> m_keys;                   // Bucket of each entry, sorted by the build
+        std::vector<uint32_t> m_sorted_keys;
+        std::vector<uint32_t> m_order;                  // Input index of each sorted entry
+        std::vector<uint32_t> m_sorted_order;
+        std::vector<uint32_t> m_histogram;              // Per-chunk radix digit counts
+
+        int32_t m_min_cell[3];                          // Bounds of the occupied cells
+        int32_t m_max_cell[3];
+    };
+
+    template<typename Func>
+    void SpatialHashGrid::visitCell(int32_t cell_x, int32_t cell_y, int32_t cell_z, Func&& func) const {
+        uint32_t bucket = bucketOf(cell_x, cell_y, cell_z);
+
+        // Buckets can hold several cells, skip the ones that do not match
+        for (uint32_t i = m_bucket_start[bucket]; i < m_bucket_start[bucket + 1]; ++i) {
+            const SpatialGridEntry& entry = m_entries[i];
+            if (entry.cell_x == cell_x && entry.cell_y == cell_y && entry.cell_z == cell_z) {
+                func(entry);
+            }
+        }
+    }
+
+    template<typename Func>
+    void SpatialHashGrid::forEachInCell(int32_t cell_x, int32_t cell_y, int32_t cell_z, Func&& func) const {
+        if (m_entries.empty()) {
+            return;
+        }
+        visitCell(cell_x, cell_y, cell_z, func);
+    }
+
+    template<typename Func>
+    void SpatialHashGrid::forEachCell(Func&& func) const {
+        std::size_t begin = 0;
+        while (begin < m_entries.size()) {
+            const SpatialGridEntry& first = m_entries[begin];
+            std::size_t end = begin + 1;
+            while (end < m_entries.size() && m_entries[end].cell_x == first.cell_x &&
+                m_entries[end].cell_y == first.cell_y && m_entries[end].cell_z == first.cell_z) {
+                ++end;
+            }
+            func(first.cell_x, first.cell_y, first.cell_z, m_entries.data() + begin, m_entries.data() + end);
+            begin = end;
+        }
+    }
+
+} // namespace gam300
+
+#endif // __SPATIAL_HASH_GRID_H__